@@ -18,6 +18,7 @@
 #include "common/Platform.h"
 #include "utils/BackendBinding.h"
 #include "utils/TerribleCommandBuffer.h"
+#include "utils/TracingPlatform.h"
 
 #include <dawn/dawn.h>
 #include <dawn/dawn_wsi.h>
@@ -25,9 +26,11 @@
 #include <dawn_native/DawnNative.h>
 #include <dawn_wire/WireClient.h>
 #include <dawn_wire/WireServer.h>
+#include <dawn_wire/WireTrace.h>
 #include "GLFW/glfw3.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 
@@ -86,6 +89,21 @@ static dawn_wire::WireServer* wireServer = nullptr;
 static dawn_wire::WireClient* wireClient = nullptr;
 static utils::TerribleCommandBuffer* c2sBuf = nullptr;
 static utils::TerribleCommandBuffer* s2cBuf = nullptr;
+static dawn_wire::CommandSerializer* s2cSerializer = nullptr;
+
+static const char* wireTracePath = nullptr;
+static std::unique_ptr<dawn_wire::WireTraceWriter> wireTraceWriter;
+
+// The tracing platform is never destroyed because the device can still record trace events while
+// the globals of the samples are destroyed.
+static const char* traceFilePath = nullptr;
+static utils::TracingPlatform* tracingPlatform = nullptr;
+
+void WriteTraceFile() {
+    if (!tracingPlatform->WriteTraceFile(traceFilePath)) {
+        fprintf(stderr, "Failed to write the trace file %s\n", traceFilePath);
+    }
+}
 
 dawn::Device CreateCppDawnDevice() {
     glfwSetErrorCallback(PrintGLFWError);
@@ -101,6 +119,11 @@ dawn::Device CreateCppDawnDevice() {
     }
 
     instance = std::make_unique<dawn_native::Instance>();
+    if (traceFilePath != nullptr) {
+        tracingPlatform = new utils::TracingPlatform();
+        instance->SetPlatform(tracingPlatform);
+        std::atexit(WriteTraceFile);
+    }
     utils::DiscoverAdapter(instance.get(), window, backendType);
 
     // Get an adapter for the backend to use, and create the device.
@@ -138,16 +161,34 @@ dawn::Device CreateCppDawnDevice() {
                 c2sBuf = new utils::TerribleCommandBuffer();
                 s2cBuf = new utils::TerribleCommandBuffer();
 
+                dawn_wire::CommandSerializer* c2sSerializer = c2sBuf;
+                s2cSerializer = s2cBuf;
+                if (wireTracePath != nullptr) {
+                    wireTraceWriter = dawn_wire::WireTraceWriter::Create(wireTracePath);
+                    if (wireTraceWriter == nullptr) {
+                        fprintf(stderr, "Couldn't create the wire trace %s\n", wireTracePath);
+                        return dawn::Device();
+                    }
+                    c2sSerializer = new dawn_wire::RecordingCommandSerializer(
+                        c2sBuf, wireTraceWriter.get(),
+                        dawn_wire::WireTraceDirection::ClientToServer);
+                    s2cSerializer = new dawn_wire::RecordingCommandSerializer(
+                        s2cBuf, wireTraceWriter.get(),
+                        dawn_wire::WireTraceDirection::ServerToClient);
+                }
+
                 dawn_wire::WireServerDescriptor serverDesc = {};
                 serverDesc.device = backendDevice;
                 serverDesc.procs = &backendProcs;
-                serverDesc.serializer = s2cBuf;
+                serverDesc.serializer = s2cSerializer;
+                serverDesc.platform = tracingPlatform;
 
                 wireServer = new dawn_wire::WireServer(serverDesc);
                 c2sBuf->SetHandler(wireServer);
 
                 dawn_wire::WireClientDescriptor clientDesc = {};
-                clientDesc.serializer = c2sBuf;
+                clientDesc.serializer = c2sSerializer;
+                clientDesc.coalesceReleases = true;
 
                 wireClient = new dawn_wire::WireClient(clientDesc);
                 DawnDevice clientDevice = wireClient->GetDevice();
@@ -235,10 +276,30 @@ bool InitSample(int argc, const char** argv) {
             fprintf(stderr, "--command-buffer expects a command buffer name (none, terrible)\n");
             return false;
         }
+        if (std::string("--wire-trace") == argv[i]) {
+            i++;
+            if (i < argc) {
+                wireTracePath = argv[i];
+                continue;
+            }
+            fprintf(stderr, "--wire-trace expects a file name\n");
+            return false;
+        }
+        if (std::string("--trace-file") == argv[i]) {
+            i++;
+            if (i < argc) {
+                traceFilePath = argv[i];
+                continue;
+            }
+            fprintf(stderr, "--trace-file expects a file name\n");
+            return false;
+        }
         if (std::string("-h") == argv[i] || std::string("--help") == argv[i]) {
-            printf("Usage: %s [-b BACKEND] [-c COMMAND_BUFFER] [-t TRIANGLE_PER_FRAME] [-f FRAME_NUMBER]\n", argv[0]);
+            printf("Usage: %s [-b BACKEND] [-c COMMAND_BUFFER] [-t TRIANGLE_PER_FRAME] [-f FRAME_NUMBER] [--wire-trace FILE] [--trace-file FILE]\n", argv[0]);
             printf("  BACKEND is one of: d3d12, metal, null, opengl, vulkan\n");
             printf("  COMMAND_BUFFER is one of: none, terrible\n");
+            printf("  --wire-trace records the wire commands in FILE for dawn_wire_replay\n");
+            printf("  --trace-file writes the trace events of Dawn to FILE for chrome://tracing\n");
 	    printf("  TRIANGLE_PER_FRAME is the triangle numbers per frame for Animometer example\n");
 	    printf("  FRAME_NUMBER is the how many frame does the example run for Animometer example\n");
             return false;
@@ -249,11 +310,14 @@ bool InitSample(int argc, const char** argv) {
 
 void DoFlush() {
     if (cmdBufType == CmdBufType::Terrible) {
-        bool c2sSuccess = c2sBuf->Flush();
-        bool s2cSuccess = s2cBuf->Flush();
+        bool c2sSuccess = wireClient->Flush();
+        bool s2cSuccess = s2cSerializer->Flush();
 
         ASSERT(c2sSuccess && s2cSuccess);
     }
+    if (tracingPlatform != nullptr) {
+        tracingPlatform->CollectTraceEvents();
+    }
     glfwPollEvents();
 }
 
@@ -79,6 +79,8 @@ class Proc:
         if element.find('alias') != None:
             self.alias = element.find('alias').attrib['name']
 
+        self.state_tracked = False
+
     def glProcName(self):
         return self.gl_name
 
@@ -89,6 +91,13 @@ class Proc:
     def PFNGLPROCNAME(self):
         return 'PFN' + self.gl_name.upper() + 'PROC'
 
+    # The name of the member holding the proc. The state tracked procs are called through a
+    # wrapper that has the name of the proc, so the proc itself is stored in a private member.
+    def MemberName(self):
+        if self.state_tracked:
+            return 'm' + self.ProcName()
+        return self.ProcName()
+
     def __repr__(self):
         return 'Proc("{}")'.format(self.gl_name)
 
@@ -102,7 +111,7 @@ def parse_version(version):
     return Version(*map(int, version.split('.')))
 
 
-def compute_params(root, supported_extensions):
+def compute_params(root, supported_extensions, state_tracked_proc_names):
     # Parse all the commands and enums
     all_procs = {}
     for command in root.findall('''commands[@namespace='GL']/command'''):
@@ -110,6 +119,15 @@ def compute_params(root, supported_extensions):
         assert(proc.gl_name not in all_procs)
         all_procs[proc.gl_name] = proc
 
+    # The state tracked procs are wrapped in functions that don't return the result of the
+    # call when it is filtered, so they must not return anything.
+    state_tracked_procs = []
+    for proc_name in state_tracked_proc_names:
+        proc = all_procs[proc_name]
+        assert(proc.return_type == 'void')
+        proc.state_tracked = True
+        state_tracked_procs.append(proc)
+
     all_enums = {}
     for enum in root.findall('''enums[@namespace='GL']/enum'''):
         enum_name = enum.attrib['name']
@@ -154,7 +172,7 @@ def compute_params(root, supported_extensions):
         for command in section.findall('./require/command'):
             proc_name = command.attrib['name']
             assert(all_procs[proc_name].alias == None)
-            if proc_name not in removed_procs:
+            if proc_name not in core_removed_procs:
                 section_procs.append(all_procs[proc_name])
 
         section_enums = []
@@ -210,6 +228,7 @@ def compute_params(root, supported_extensions):
         'extension_desktop_gl_blocks': extension_desktop_gl_blocks,
         'extension_gles_blocks': extension_gles_blocks,
         'header_blocks': header_blocks,
+        'state_tracked_procs': state_tracked_procs,
     }
 
 class OpenGLLoaderGenerator(Generator):
@@ -218,15 +237,16 @@ class OpenGLLoaderGenerator(Generator):
 
     def add_commandline_arguments(self, parser):
         parser.add_argument('--gl-xml', required=True, type=str, help='The Khronos gl.xml to use.')
-        parser.add_argument('--supported-extensions', required=True, type=str, help ='The JSON file that defines the OpenGL and GLES extensions to use.')
+        parser.add_argument('--supported-extensions', required=True, type=str, help ='The JSON file that defines the OpenGL and GLES extensions to use and the procs whose state is tracked.')
 
     def get_file_renders(self, args):
         supported_extensions = []
         with open(args.supported_extensions) as f:
             supported_extensions_json = json.loads(f.read())
             supported_extensions = supported_extensions_json['supported_extensions']
+            state_tracked_procs = supported_extensions_json['state_tracked_procs']
 
-        params = compute_params(etree.parse(args.gl_xml).getroot(), supported_extensions)
+        params = compute_params(etree.parse(args.gl_xml).getroot(), supported_extensions, state_tracked_procs)
 
         return [
             FileRender('opengl/OpenGLFunctionsBase.cpp', 'src/dawn_native/opengl/OpenGLFunctionsBase_autogen.cpp', [params]),
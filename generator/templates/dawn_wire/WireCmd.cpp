@@ -441,6 +441,17 @@ namespace dawn_wire {
         {% endfor %}
     }  // anonymous namespace
 
+    const char* GetWireCmdName(WireCmd command) {
+        switch (command) {
+            {% for command in cmd_records["command"] %}
+                case WireCmd::{{command.name.CamelCase()}}:
+                    return "{{command.name.CamelCase()}}";
+            {% endfor %}
+            default:
+                return "Unknown";
+        }
+    }
+
     {% for command in cmd_records["command"] %}
         {{ write_command_serialization_methods(command, False) }}
     {% endfor %}
@@ -76,6 +76,9 @@ namespace dawn_wire {
         {% endfor %}
     };
 
+    //* Returns the name of a command, used by tools like dawn_wire_replay.
+    const char* GetWireCmdName(WireCmd command);
+
     //* Enum used as a prefix to each command on the return wire format.
     enum class ReturnWireCmd : uint32_t {
         {% for command in cmd_records["return command"] %}
@@ -71,15 +71,11 @@ namespace dawn_wire { namespace client {
                     return;
                 }
 
-                DestroyObjectCmd cmd;
-                cmd.objectType = ObjectType::{{type.name.CamelCase()}};
-                cmd.objectId = obj->id;
-
-                size_t requiredSize = cmd.GetRequiredSize();
-                char* allocatedBuffer = static_cast<char*>(obj->device->GetClient()->GetCmdSpace(requiredSize));
-                cmd.Serialize(allocatedBuffer);
-
-                obj->device->GetClient()->{{type.name.CamelCase()}}Allocator().Free(obj);
+                //* The destruction is serialized now, or coalesced with other releases when the
+                //* client is configured to.
+                Client* client = obj->device->GetClient();
+                client->{{type.name.CamelCase()}}Allocator().Free(obj);
+                client->OnObjectFreed();
             }
 
             void Client{{as_MethodSuffix(type.name, Name("reference"))}}({{cType}} cObj) {
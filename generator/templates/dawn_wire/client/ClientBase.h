@@ -38,6 +38,19 @@ namespace dawn_wire { namespace client {
             }
         {% endfor %}
 
+      protected:
+        //* Calls |serialize| with the object type and IDs of the objects of each type freed since
+        //* the last call, then makes the IDs available for reuse.
+        template <typename F>
+        void TakePendingDestroys(F&& serialize) {
+            {% for type in by_category["object"] %}
+                if (!m{{type.name.CamelCase()}}Allocator.GetPendingDestroys().empty()) {
+                    serialize(ObjectType::{{type.name.CamelCase()}}, m{{type.name.CamelCase()}}Allocator.GetPendingDestroys());
+                    m{{type.name.CamelCase()}}Allocator.ClearPendingDestroys();
+                }
+            {% endfor %}
+        }
+
       private:
         // Implementation of the ObjectIdProvider interface
         {% for type in by_category["object"] %}
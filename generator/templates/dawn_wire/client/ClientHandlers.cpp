@@ -54,6 +54,7 @@ namespace dawn_wire { namespace client {
     {% endfor %}
 
     const volatile char* Client::HandleCommands(const volatile char* commands, size_t size) {
+        mBytesIn.fetch_add(size, std::memory_order_relaxed);
         while (size >= sizeof(ReturnWireCmd)) {
             ReturnWireCmd cmdId = *reinterpret_cast<const volatile ReturnWireCmd*>(commands);
 
@@ -65,11 +65,14 @@ namespace dawn_wire { namespace server {
     {% endfor %}
 
     bool Server::DoDestroyObject(ObjectType objectType, ObjectId objectId) {
-        //* ID 0 are reserved for nullptr and cannot be destroyed.
-        if (objectId == 0) {
-            return false;
-        }
+        return DoDestroyObjects(objectType, 1, &objectId);
+    }
 
+    bool Server::DoDestroyObjects(ObjectType objectType,
+                                  uint32_t objectCount,
+                                  const ObjectId* objectIds) {
+        //* The switch is done once for the whole batch so that the loop over the IDs only frees
+        //* objects of a single type.
         switch(objectType) {
             {% for type in by_category["object"] %}
                 case ObjectType::{{type.name.CamelCase()}}: {
@@ -77,17 +80,42 @@ namespace dawn_wire { namespace server {
                         //* Freeing the device has to be done out of band.
                         return false;
                     {% else %}
-                        auto* data = {{type.name.CamelCase()}}Objects().Get(objectId);
-                        if (data == nullptr) {
+                        auto& known = {{type.name.CamelCase()}}Objects();
+
+                        //* Validate the whole batch before destroying anything so that an invalid
+                        //* command doesn't leave it partially applied. The IDs are freed while
+                        //* validating so that an ID present twice is rejected, and are allocated
+                        //* again afterwards.
+                        uint32_t validCount = 0;
+                        while (validCount < objectCount) {
+                            ObjectId objectId = objectIds[validCount];
+
+                            //* ID 0 are reserved for nullptr and cannot be destroyed.
+                            if (objectId == 0 || known.Get(objectId) == nullptr) {
+                                break;
+                            }
+                            known.Free(objectId);
+                            validCount++;
+                        }
+                        for (uint32_t i = 0; i < validCount; ++i) {
+                            known.Unfree(objectIds[i]);
+                        }
+                        if (validCount != objectCount) {
                             return false;
                         }
-                        {% if type.name.CamelCase() in server_reverse_lookup_objects %}
-                            {{type.name.CamelCase()}}ObjectIdTable().Remove(data->handle);
-                        {% endif %}
-                        if (data->handle != nullptr) {
-                            mProcs.{{as_varName(type.name, Name("release"))}}(data->handle);
+
+                        for (uint32_t i = 0; i < objectCount; ++i) {
+                            ObjectId objectId = objectIds[i];
+                            auto* data = known.Get(objectId);
+                            ASSERT(data != nullptr);
+                            {% if type.name.CamelCase() in server_reverse_lookup_objects %}
+                                {{type.name.CamelCase()}}ObjectIdTable().Remove(data->handle);
+                            {% endif %}
+                            if (data->handle != nullptr) {
+                                mProcs.{{as_varName(type.name, Name("release"))}}(data->handle);
+                            }
+                            known.Free(objectId);
                         }
-                        {{type.name.CamelCase()}}Objects().Free(objectId);
                         return true;
                     {% endif %}
                 }
@@ -95,8 +123,6 @@ namespace dawn_wire { namespace server {
             default:
                 return false;
         }
-
-        return true;
     }
 
 }}  // namespace dawn_wire::server
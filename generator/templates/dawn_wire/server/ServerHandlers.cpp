@@ -13,6 +13,7 @@
 //* limitations under the License.
 
 #include "common/Assert.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 #include "dawn_wire/server/Server.h"
 
 namespace dawn_wire { namespace server {
@@ -92,6 +93,18 @@ namespace dawn_wire { namespace server {
     {% endfor %}
 
     const volatile char* Server::HandleCommands(const volatile char* commands, size_t size) {
+        //* The category flag of the trace point is shared by all the servers, so it may be enabled
+        //* by the platform of another server.
+        if (mPlatform == nullptr) {
+            return HandleCommandsImpl(commands, size);
+        }
+        TRACE_EVENT1(mPlatform, TRACE_DISABLED_BY_DEFAULT("gpu.dawn"), "WireServer::HandleCommands",
+                     "size", size);
+        return HandleCommandsImpl(commands, size);
+    }
+
+    const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
+        mBytesIn.fetch_add(size, std::memory_order_relaxed);
         mProcs.deviceTick(DeviceObjects().Get(1)->handle);
 
         while (size >= sizeof(WireCmd)) {
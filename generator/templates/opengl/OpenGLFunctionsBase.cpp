@@ -30,7 +30,7 @@ MaybeError OpenGLFunctionsBase::LoadOpenGLESProcs(GetProcAddress getProc, int ma
         // OpenGL ES {{block.version.major}}.{{block.version.minor}}
         if (majorVersion > {{block.version.major}} || (majorVersion == {{block.version.major}} && minorVersion >= {{block.version.minor}})) {
             {% for proc in block.procs %}
-                DAWN_TRY(LoadProc(getProc, &{{proc.ProcName()}}, "{{proc.glProcName()}}"));
+                DAWN_TRY(LoadProc(getProc, &{{proc.MemberName()}}, "{{proc.glProcName()}}"));
             {% endfor %}
         }
 
@@ -43,7 +43,33 @@ MaybeError OpenGLFunctionsBase::LoadDesktopGLProcs(GetProcAddress getProc, int m
         // Desktop OpenGL {{block.version.major}}.{{block.version.minor}}
         if (majorVersion > {{block.version.major}} || (majorVersion == {{block.version.major}} && minorVersion >= {{block.version.minor}})) {
             {% for proc in block.procs %}
-                DAWN_TRY(LoadProc(getProc, &{{proc.ProcName()}}, "{{proc.glProcName()}}"));
+                DAWN_TRY(LoadProc(getProc, &{{proc.MemberName()}}, "{{proc.glProcName()}}"));
+            {% endfor %}
+        }
+
+    {% endfor %}
+    return {};
+}
+
+MaybeError OpenGLFunctionsBase::LoadDesktopGLExtensionProcs(GetProcAddress getProc, const std::unordered_set<std::string>& extensions) {
+    {% for block in extension_desktop_gl_blocks if block.procs %}
+        // {{block.extension}}
+        if (extensions.count("{{block.extension}}") != 0) {
+            {% for proc in block.procs %}
+                DAWN_TRY(LoadProc(getProc, &{{proc.MemberName()}}, "{{proc.glProcName()}}"));
+            {% endfor %}
+        }
+
+    {% endfor %}
+    return {};
+}
+
+MaybeError OpenGLFunctionsBase::LoadOpenGLESExtensionProcs(GetProcAddress getProc, const std::unordered_set<std::string>& extensions) {
+    {% for block in extension_gles_blocks if block.procs %}
+        // {{block.extension}}
+        if (extensions.count("{{block.extension}}") != 0) {
+            {% for proc in block.procs %}
+                DAWN_TRY(LoadProc(getProc, &{{proc.MemberName()}}, "{{proc.glProcName()}}"));
             {% endfor %}
         }
 
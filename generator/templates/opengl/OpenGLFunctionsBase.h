@@ -13,8 +13,13 @@
 //* limitations under the License.
 
 #include "dawn_native/Error.h"
+#include "dawn_native/opengl/OpenGLStateTracker.h"
 #include "dawn_native/opengl/opengl_platform.h"
 
+#include <memory>
+#include <string>
+#include <unordered_set>
+
 namespace dawn_native { namespace opengl {
     using GetProcAddress = void* (*) (const char*);
 
@@ -23,7 +28,30 @@ namespace dawn_native { namespace opengl {
         {% for block in header_blocks %}
             // {{block.description}}
             {% for proc in block.procs %}
-                {{proc.PFNGLPROCNAME()}} {{proc.ProcName()}} = nullptr;
+                {% if proc.state_tracked %}
+                    void {{proc.ProcName()}}(
+                        {%- for param in proc.params -%}
+                            {%- if not loop.first %}, {% endif -%}
+                            {{param.type}} {{param.name}}
+                        {%- endfor -%}
+                    ) const {
+                        if (mStateTracker->{{proc.ProcName()}}(
+                            {%- for param in proc.params -%}
+                                {%- if not loop.first %}, {% endif -%}
+                                {{param.name}}
+                            {%- endfor -%}
+                        )) {
+                            {{proc.MemberName()}}(
+                                {%- for param in proc.params -%}
+                                    {%- if not loop.first %}, {% endif -%}
+                                    {{param.name}}
+                                {%- endfor -%}
+                            );
+                        }
+                    }
+                {% else %}
+                    {{proc.PFNGLPROCNAME()}} {{proc.ProcName()}} = nullptr;
+                {% endif %}
             {% endfor %}
 
         {% endfor%}
@@ -31,10 +59,23 @@ namespace dawn_native { namespace opengl {
       protected:
         MaybeError LoadDesktopGLProcs(GetProcAddress getProc, int majorVersion, int minorVersion);
         MaybeError LoadOpenGLESProcs(GetProcAddress getProc, int majorVersion, int minorVersion);
+        MaybeError LoadDesktopGLExtensionProcs(GetProcAddress getProc,
+                                               const std::unordered_set<std::string>& extensions);
+        MaybeError LoadOpenGLESExtensionProcs(GetProcAddress getProc,
+                                              const std::unordered_set<std::string>& extensions);
+
+        // Filters the calls to the state tracked procs. It is shared by the copies of the
+        // functions that the devices make, since they all use the same GL context.
+        std::shared_ptr<OpenGLStateTracker> mStateTracker = std::make_shared<OpenGLStateTracker>();
 
       private:
         template<typename T>
         MaybeError LoadProc(GetProcAddress getProc, T* memberProc, const char* name);
+
+        // The procs called by the wrappers of the state tracked procs.
+        {% for proc in state_tracked_procs %}
+            {{proc.PFNGLPROCNAME()}} {{proc.MemberName()}} = nullptr;
+        {% endfor %}
     };
 
 }}  // namespace dawn_native::opengl
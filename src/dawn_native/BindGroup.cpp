@@ -129,7 +129,7 @@ namespace dawn_native {
 
             // Check that we can set this binding.
             if (bindingIndex >= kMaxBindingsPerGroup) {
-                return DAWN_VALIDATION_ERROR("binding index too high");
+                return DAWN_VALIDATION_ERROR("binding index %u too high", bindingIndex);
             }
 
             if (!layoutInfo.mask[bindingIndex]) {
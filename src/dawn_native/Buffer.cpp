@@ -115,6 +115,7 @@ namespace dawn_native {
           mSize(descriptor->size),
           mUsage(descriptor->usage),
           mState(BufferState::Unmapped) {
+        device->GetMemoryTracker()->Allocate(MemoryCategory::Buffer, mSize);
     }
 
     BufferBase::BufferBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -127,6 +128,9 @@ namespace dawn_native {
             CallMapReadCallback(mMapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_UNKNOWN, nullptr, 0u);
             CallMapWriteCallback(mMapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_UNKNOWN, nullptr, 0u);
         }
+        if (!IsError() && mState != BufferState::Destroyed) {
+            GetDevice()->GetMemoryTracker()->Free(MemoryCategory::Buffer, mSize);
+        }
     }
 
     // static
@@ -168,6 +172,7 @@ namespace dawn_native {
         // TODO(enga): Suballocate and reuse memory from a larger staging buffer so we don't create
         // many small buffers.
         DAWN_TRY_ASSIGN(mStagingBuffer, GetDevice()->CreateStagingBuffer(GetSize()));
+        mStagingBuffer->TrackMemory(GetDevice()->GetMemoryTracker(), MemoryCategory::Staging);
 
         ASSERT(mStagingBuffer->GetMappedPointer() != nullptr);
         *mappedPointer = reinterpret_cast<uint8_t*>(mStagingBuffer->GetMappedPointer());
@@ -426,6 +431,7 @@ namespace dawn_native {
     void BufferBase::DestroyInternal() {
         if (mState != BufferState::Destroyed) {
             DestroyImpl();
+            GetDevice()->GetMemoryTracker()->Free(MemoryCategory::Buffer, mSize);
         }
         mState = BufferState::Destroyed;
     }
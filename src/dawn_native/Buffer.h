@@ -78,9 +78,12 @@ namespace dawn_native {
 
         void DestroyInternal();
 
+        // Uploads the data through the device's dynamic uploader, backends that can write to the
+        // buffer directly override it.
+        virtual MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data);
+
       private:
         virtual MaybeError MapAtCreationImpl(uint8_t** mappedPointer) = 0;
-        virtual MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data);
         virtual MaybeError MapReadAsyncImpl(uint32_t serial) = 0;
         virtual MaybeError MapWriteAsyncImpl(uint32_t serial) = 0;
         virtual void UnmapImpl() = 0;
@@ -16,6 +16,7 @@
 
 #include "common/Assert.h"
 #include "common/Math.h"
+#include "dawn_native/DeviceStatistics.h"
 
 #include <algorithm>
 #include <climits>
@@ -26,6 +27,16 @@ namespace dawn_native {
     constexpr uint32_t EndOfBlock = UINT_MAX;          // std::numeric_limits<uint32_t>::max();
     constexpr uint32_t AdditionalData = UINT_MAX - 1;  // std::numeric_limits<uint32_t>::max() - 1;
 
+    // The blocks move from the CommandAllocators to the CommandIterators and can be freed on any
+    // thread, so they are counted for the whole process instead of for each device.
+    namespace {
+        Counter gBlockBytes;
+    }  // anonymous namespace
+
+    uint64_t GetCommandAllocatorBlockBytes() {
+        return gBlockBytes.Get();
+    }
+
     // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
     CommandIterator::CommandIterator() : mEndOfBlock(EndOfBlock) {
@@ -37,6 +48,7 @@ namespace dawn_native {
 
         if (!IsEmpty()) {
             for (auto& block : mBlocks) {
+                gBlockBytes.Decrement(block.size);
                 free(block.block);
             }
         }
@@ -242,6 +254,7 @@ namespace dawn_native {
             return false;
         }
 
+        gBlockBytes.Increment(mLastAllocationSize);
         mBlocks.push_back({mLastAllocationSize, block});
         mCurrentPtr = AlignPtr(block, alignof(uint32_t));
         mEndPtr = block + mLastAllocationSize;
@@ -162,6 +162,10 @@ namespace dawn_native {
         uint32_t mDummyEnum[1] = {0};
     };
 
+    // Returns the bytes of the command blocks of all the CommandAllocators of the process that
+    // aren't freed yet.
+    uint64_t GetCommandAllocatorBlockBytes();
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_COMMAND_ALLOCATOR_H_
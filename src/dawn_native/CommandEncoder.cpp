@@ -39,11 +39,13 @@ namespace dawn_native {
                                                  const Extent3D& copySize) {
             const TextureBase* texture = textureCopy.texture.Get();
             if (textureCopy.mipLevel >= texture->GetNumMipLevels()) {
-                return DAWN_VALIDATION_ERROR("Copy mipLevel out of range");
+                return DAWN_VALIDATION_ERROR("Copy mipLevel %u out of range",
+                                             textureCopy.mipLevel);
             }
 
             if (textureCopy.arrayLayer >= texture->GetArrayLayers()) {
-                return DAWN_VALIDATION_ERROR("Copy arrayLayer out of range");
+                return DAWN_VALIDATION_ERROR("Copy arrayLayer %u out of range",
+                                             textureCopy.arrayLayer);
             }
 
             Extent3D extent = texture->GetMipLevelPhysicalSize(textureCopy.mipLevel);
@@ -715,7 +717,9 @@ namespace dawn_native {
         }
         ASSERT(!IsError());
 
-        return GetDevice()->CreateCommandBuffer(this, descriptor);
+        CommandBufferBase* commandBuffer = GetDevice()->CreateCommandBuffer(this, descriptor);
+        commandBuffer->TrackLiveObject(ObjectType::CommandBuffer);
+        return commandBuffer;
     }
 
     // Implementation of the command buffer validation that can be precomputed before submit
@@ -144,7 +144,8 @@ namespace dawn_native {
                 } break;
 
                 default:
-                    return DAWN_VALIDATION_ERROR(disallowedMessage);
+                    return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::Validation,
+                                                        disallowedMessage);
             }
 
             return {};
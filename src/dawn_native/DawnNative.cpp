@@ -134,4 +134,22 @@ namespace dawn_native {
         return deviceBase->GetLazyClearCountForTesting();
     }
 
+    DeviceStatistics GetDeviceStatistics(DawnDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetStatistics();
+    }
+
+    MemoryUsage GetMemoryUsage(DawnDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetMemoryTracker()->GetMemoryUsage();
+    }
+
+    void SetMemoryBudget(DawnDevice device,
+                         uint64_t budget,
+                         MemoryPressureCallback callback,
+                         void* userdata) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        deviceBase->GetMemoryTracker()->SetBudget(budget, callback, userdata);
+    }
+
 }  // namespace dawn_native
@@ -19,6 +19,7 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/ComputePipeline.h"
@@ -31,6 +32,7 @@
 #include "dawn_native/Instance.h"
 #include "dawn_native/PipelineLayout.h"
 #include "dawn_native/Queue.h"
+#include "dawn_native/RenderBundle.h"
 #include "dawn_native/RenderBundleEncoder.h"
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_native/Sampler.h"
@@ -38,6 +40,7 @@
 #include "dawn_native/SwapChain.h"
 #include "dawn_native/Texture.h"
 #include "dawn_native/ValidationUtils_autogen.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <unordered_set>
 
@@ -95,6 +98,10 @@ namespace dawn_native {
     }
 
     void DeviceBase::HandleError(dawn::ErrorType type, const char* message) {
+        HandleError(type, ErrorMessage(std::string(message)));
+    }
+
+    void DeviceBase::HandleError(dawn::ErrorType type, const ErrorMessage& message) {
         mCurrentErrorScope->HandleError(type, message);
     }
 
@@ -103,7 +110,8 @@ namespace dawn_native {
             return;
         }
         if (DAWN_UNLIKELY(type == dawn::ErrorType::NoError)) {
-            HandleError(dawn::ErrorType::Validation, "Invalid injected error NoError");
+            HandleError(dawn::ErrorType::Validation,
+                        DAWN_ERROR_MESSAGE("Invalid injected error NoError"));
             return;
         }
         HandleError(type, message);
@@ -111,7 +119,7 @@ namespace dawn_native {
 
     void DeviceBase::ConsumeError(ErrorData* error) {
         ASSERT(error != nullptr);
-        HandleError(error->GetType(), error->GetMessage().c_str());
+        HandleError(error->GetType(), error->GetErrorMessage());
         delete error;
     }
 
@@ -194,12 +202,15 @@ namespace dawn_native {
 
         auto iter = mCaches->bindGroupLayouts.find(&blueprint);
         if (iter != mCaches->bindGroupLayouts.end()) {
+            mCounters.CacheHits(ObjectCacheType::BindGroupLayout).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::BindGroupLayout).Increment();
 
         BindGroupLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateBindGroupLayoutImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::BindGroupLayout);
         mCaches->bindGroupLayouts.insert(backendObj);
         return backendObj;
     }
@@ -215,12 +226,15 @@ namespace dawn_native {
 
         auto iter = mCaches->computePipelines.find(&blueprint);
         if (iter != mCaches->computePipelines.end()) {
+            mCounters.CacheHits(ObjectCacheType::ComputePipeline).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::ComputePipeline).Increment();
 
         ComputePipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateComputePipelineImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::ComputePipeline);
         mCaches->computePipelines.insert(backendObj);
         return backendObj;
     }
@@ -236,12 +250,15 @@ namespace dawn_native {
 
         auto iter = mCaches->pipelineLayouts.find(&blueprint);
         if (iter != mCaches->pipelineLayouts.end()) {
+            mCounters.CacheHits(ObjectCacheType::PipelineLayout).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::PipelineLayout).Increment();
 
         PipelineLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreatePipelineLayoutImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::PipelineLayout);
         mCaches->pipelineLayouts.insert(backendObj);
         return backendObj;
     }
@@ -257,12 +274,15 @@ namespace dawn_native {
 
         auto iter = mCaches->renderPipelines.find(&blueprint);
         if (iter != mCaches->renderPipelines.end()) {
+            mCounters.CacheHits(ObjectCacheType::RenderPipeline).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::RenderPipeline).Increment();
 
         RenderPipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateRenderPipelineImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::RenderPipeline);
         mCaches->renderPipelines.insert(backendObj);
         return backendObj;
     }
@@ -278,12 +298,15 @@ namespace dawn_native {
 
         auto iter = mCaches->samplers.find(&blueprint);
         if (iter != mCaches->samplers.end()) {
+            mCounters.CacheHits(ObjectCacheType::Sampler).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::Sampler).Increment();
 
         SamplerBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateSamplerImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::Sampler);
         mCaches->samplers.insert(backendObj);
         return backendObj;
     }
@@ -299,12 +322,15 @@ namespace dawn_native {
 
         auto iter = mCaches->shaderModules.find(&blueprint);
         if (iter != mCaches->shaderModules.end()) {
+            mCounters.CacheHits(ObjectCacheType::ShaderModule).Increment();
             (*iter)->Reference();
             return *iter;
         }
+        mCounters.CacheMisses(ObjectCacheType::ShaderModule).Increment();
 
         ShaderModuleBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateShaderModuleImpl(descriptor));
+        backendObj->TrackLiveObject(ObjectType::ShaderModule);
         mCaches->shaderModules.insert(backendObj);
         return backendObj;
     }
@@ -318,8 +344,10 @@ namespace dawn_native {
         AttachmentStateBlueprint* blueprint) {
         auto iter = mCaches->attachmentStates.find(blueprint);
         if (iter != mCaches->attachmentStates.end()) {
+            mCounters.CacheHits(ObjectCacheType::AttachmentState).Increment();
             return static_cast<AttachmentState*>(*iter);
         }
+        mCounters.CacheMisses(ObjectCacheType::AttachmentState).Increment();
 
         Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
         mCaches->attachmentStates.insert(attachmentState.Get());
@@ -352,6 +380,8 @@ namespace dawn_native {
     // Object creation API methods
 
     BindGroupBase* DeviceBase::CreateBindGroup(const BindGroupDescriptor* descriptor) {
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DeviceBase::CreateBindGroup");
         BindGroupBase* result = nullptr;
 
         if (ConsumedError(CreateBindGroupInternal(&result, descriptor))) {
@@ -432,10 +462,14 @@ namespace dawn_native {
     }
     CommandEncoderBase* DeviceBase::CreateCommandEncoder(
         const CommandEncoderDescriptor* descriptor) {
-        return new CommandEncoderBase(this, descriptor);
+        CommandEncoderBase* result = new CommandEncoderBase(this, descriptor);
+        result->TrackLiveObject(ObjectType::CommandEncoder);
+        return result;
     }
     ComputePipelineBase* DeviceBase::CreateComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DeviceBase::CreateComputePipeline");
         ComputePipelineBase* result = nullptr;
 
         if (ConsumedError(CreateComputePipelineInternal(&result, descriptor))) {
@@ -475,6 +509,13 @@ namespace dawn_native {
 
         return result;
     }
+    RenderBundleBase* DeviceBase::CreateRenderBundle(RenderBundleEncoderBase* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     AttachmentState* attachmentState,
+                                                     PassResourceUsage resourceUsage) {
+        return new RenderBundleBase(encoder, descriptor, attachmentState, std::move(resourceUsage));
+    }
+
     RenderBundleEncoderBase* DeviceBase::CreateRenderBundleEncoder(
         const RenderBundleEncoderDescriptor* descriptor) {
         RenderBundleEncoderBase* result = nullptr;
@@ -487,6 +528,8 @@ namespace dawn_native {
     }
     RenderPipelineBase* DeviceBase::CreateRenderPipeline(
         const RenderPipelineDescriptor* descriptor) {
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DeviceBase::CreateRenderPipeline");
         RenderPipelineBase* result = nullptr;
 
         if (ConsumedError(CreateRenderPipelineInternal(&result, descriptor))) {
@@ -496,6 +539,8 @@ namespace dawn_native {
         return result;
     }
     ShaderModuleBase* DeviceBase::CreateShaderModule(const ShaderModuleDescriptor* descriptor) {
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DeviceBase::CreateShaderModule");
         ShaderModuleBase* result = nullptr;
 
         if (ConsumedError(CreateShaderModuleInternal(&result, descriptor))) {
@@ -536,9 +581,14 @@ namespace dawn_native {
     // Other Device API methods
 
     void DeviceBase::Tick() {
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"), "DeviceBase::Tick");
         if (ConsumedError(TickImpl()))
             return;
 
+        TRACE_COUNTER1(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                       "DeviceBase::SerialsInFlight",
+                       GetLastSubmittedCommandSerial() - GetCompletedCommandSerial());
+
         {
             auto deferredResults = std::move(mDeferredCreateBufferMappedAsyncResults);
             for (const auto& deferred : deferredResults) {
@@ -547,6 +597,7 @@ namespace dawn_native {
         }
         mErrorScopeTracker->Tick(GetCompletedCommandSerial());
         mFenceSignalTracker->Tick(GetCompletedCommandSerial());
+        mMemoryTracker.Tick();
     }
 
     void DeviceBase::Reference() {
@@ -604,11 +655,90 @@ namespace dawn_native {
     }
 
     size_t DeviceBase::GetLazyClearCountForTesting() {
-        return mLazyClearCountForTesting;
+        return static_cast<size_t>(mCounters.lazyClears.Get());
     }
 
     void DeviceBase::IncrementLazyClearCountForTesting() {
-        ++mLazyClearCountForTesting;
+        mCounters.lazyClears.Increment();
+    }
+
+    DeviceCounters* DeviceBase::GetCounters() {
+        return &mCounters;
+    }
+
+    MemoryTracker* DeviceBase::GetMemoryTracker() {
+        return &mMemoryTracker;
+    }
+
+    DeviceStatistics DeviceBase::GetStatistics() {
+        DeviceStatistics statistics;
+
+        DeviceStatistics::LiveObjectCounts& liveObjects = statistics.liveObjects;
+        liveObjects.bindGroups = mCounters.LiveObjects(ObjectType::BindGroup).Get();
+        liveObjects.bindGroupLayouts = mCounters.LiveObjects(ObjectType::BindGroupLayout).Get();
+        liveObjects.buffers = mCounters.LiveObjects(ObjectType::Buffer).Get();
+        liveObjects.commandBuffers = mCounters.LiveObjects(ObjectType::CommandBuffer).Get();
+        liveObjects.commandEncoders = mCounters.LiveObjects(ObjectType::CommandEncoder).Get();
+        liveObjects.computePipelines = mCounters.LiveObjects(ObjectType::ComputePipeline).Get();
+        liveObjects.fences = mCounters.LiveObjects(ObjectType::Fence).Get();
+        liveObjects.pipelineLayouts = mCounters.LiveObjects(ObjectType::PipelineLayout).Get();
+        liveObjects.queues = mCounters.LiveObjects(ObjectType::Queue).Get();
+        liveObjects.renderBundles = mCounters.LiveObjects(ObjectType::RenderBundle).Get();
+        liveObjects.renderBundleEncoders =
+            mCounters.LiveObjects(ObjectType::RenderBundleEncoder).Get();
+        liveObjects.renderPipelines = mCounters.LiveObjects(ObjectType::RenderPipeline).Get();
+        liveObjects.samplers = mCounters.LiveObjects(ObjectType::Sampler).Get();
+        liveObjects.shaderModules = mCounters.LiveObjects(ObjectType::ShaderModule).Get();
+        liveObjects.swapChains = mCounters.LiveObjects(ObjectType::SwapChain).Get();
+        liveObjects.textures = mCounters.LiveObjects(ObjectType::Texture).Get();
+        liveObjects.textureViews = mCounters.LiveObjects(ObjectType::TextureView).Get();
+
+        auto GetCacheStatistics = [&](ObjectCacheType type, size_t size) {
+            ObjectCacheStatistics cache;
+            cache.size = size;
+            cache.hits = mCounters.CacheHits(type).Get();
+            cache.misses = mCounters.CacheMisses(type).Get();
+            return cache;
+        };
+        statistics.attachmentStateCache = GetCacheStatistics(ObjectCacheType::AttachmentState,
+                                                             mCaches->attachmentStates.size());
+        statistics.bindGroupLayoutCache = GetCacheStatistics(ObjectCacheType::BindGroupLayout,
+                                                             mCaches->bindGroupLayouts.size());
+        statistics.computePipelineCache = GetCacheStatistics(ObjectCacheType::ComputePipeline,
+                                                             mCaches->computePipelines.size());
+        statistics.pipelineLayoutCache = GetCacheStatistics(ObjectCacheType::PipelineLayout,
+                                                            mCaches->pipelineLayouts.size());
+        statistics.renderPipelineCache = GetCacheStatistics(ObjectCacheType::RenderPipeline,
+                                                            mCaches->renderPipelines.size());
+        statistics.samplerCache =
+            GetCacheStatistics(ObjectCacheType::Sampler, mCaches->samplers.size());
+        statistics.shaderModuleCache =
+            GetCacheStatistics(ObjectCacheType::ShaderModule, mCaches->shaderModules.size());
+
+        statistics.commandAllocatorBytes = GetCommandAllocatorBlockBytes();
+
+        if (mDynamicUploader != nullptr) {
+            statistics.uploadRingBufferCount = mDynamicUploader->GetRingBufferCount();
+            statistics.uploadRingBufferBytes = mDynamicUploader->GetRingBufferSize();
+            statistics.uploadRingBufferUsedBytes = mDynamicUploader->GetRingBufferUsedSize();
+        }
+        statistics.uploadRingBufferGrowths = mCounters.uploadRingBufferGrowths.Get();
+        statistics.stagingBytesUploaded = mCounters.stagingBytesUploaded.Get();
+
+        statistics.lazyClearCount = mCounters.lazyClears.Get();
+
+        statistics.glStateCallsIssued = mCounters.glStateCallsIssued.Get();
+        statistics.glStateCallsFiltered = mCounters.glStateCallsFiltered.Get();
+
+        statistics.vulkanBarriersIssued = mCounters.vulkanBarriersIssued.Get();
+        statistics.vulkanBarriersMerged = mCounters.vulkanBarriersMerged.Get();
+
+        statistics.lastSubmittedSerial = GetLastSubmittedCommandSerial();
+        statistics.completedSerial = GetCompletedCommandSerial();
+
+        statistics.memoryUsage = mMemoryTracker.GetMemoryUsage();
+
+        return statistics;
     }
 
     void DeviceBase::SetDefaultToggles() {
@@ -622,6 +752,7 @@ namespace dawn_native {
                                                    const BindGroupDescriptor* descriptor) {
         DAWN_TRY(ValidateBindGroupDescriptor(this, descriptor));
         DAWN_TRY_ASSIGN(*result, CreateBindGroupImpl(descriptor));
+        (*result)->TrackLiveObject(ObjectType::BindGroup);
         return {};
     }
 
@@ -637,6 +768,7 @@ namespace dawn_native {
                                                 const BufferDescriptor* descriptor) {
         DAWN_TRY(ValidateBufferDescriptor(this, descriptor));
         DAWN_TRY_ASSIGN(*result, CreateBufferImpl(descriptor));
+        (*result)->TrackLiveObject(ObjectType::Buffer);
         return {};
     }
 
@@ -658,6 +790,7 @@ namespace dawn_native {
 
     MaybeError DeviceBase::CreateQueueInternal(QueueBase** result) {
         DAWN_TRY_ASSIGN(*result, CreateQueueImpl());
+        (*result)->TrackLiveObject(ObjectType::Queue);
         return {};
     }
 
@@ -666,6 +799,7 @@ namespace dawn_native {
         const RenderBundleEncoderDescriptor* descriptor) {
         DAWN_TRY(ValidateRenderBundleEncoderDescriptor(this, descriptor));
         *result = new RenderBundleEncoderBase(this, descriptor);
+        (*result)->TrackLiveObject(ObjectType::RenderBundleEncoder);
         return {};
     }
 
@@ -695,6 +829,7 @@ namespace dawn_native {
                                                    const SwapChainDescriptor* descriptor) {
         DAWN_TRY(ValidateSwapChainDescriptor(this, descriptor));
         DAWN_TRY_ASSIGN(*result, CreateSwapChainImpl(descriptor));
+        (*result)->TrackLiveObject(ObjectType::SwapChain);
         return {};
     }
 
@@ -702,6 +837,7 @@ namespace dawn_native {
                                                  const TextureDescriptor* descriptor) {
         DAWN_TRY(ValidateTextureDescriptor(this, descriptor));
         DAWN_TRY_ASSIGN(*result, CreateTextureImpl(descriptor));
+        (*result)->TrackLiveObject(ObjectType::Texture);
         return {};
     }
 
@@ -712,6 +848,7 @@ namespace dawn_native {
         TextureViewDescriptor desc = GetTextureViewDescriptorWithDefaults(texture, descriptor);
         DAWN_TRY(ValidateTextureViewDescriptor(texture, &desc));
         DAWN_TRY_ASSIGN(*result, CreateTextureViewImpl(texture, &desc));
+        (*result)->TrackLiveObject(ObjectType::TextureView);
         return {};
     }
 
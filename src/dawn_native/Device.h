@@ -16,11 +16,14 @@
 #define DAWNNATIVE_DEVICE_H_
 
 #include "common/Serial.h"
+#include "dawn_native/DeviceStatistics.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Extensions.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/Forward.h"
+#include "dawn_native/MemoryTracker.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/PassResourceUsage.h"
 #include "dawn_native/Toggles.h"
 
 #include "dawn_native/DawnNative.h"
@@ -46,7 +49,9 @@ namespace dawn_native {
         DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor);
         virtual ~DeviceBase();
 
+        // Copies |message|, which is only meant for the messages that aren't known statically.
         void HandleError(dawn::ErrorType type, const char* message);
+        void HandleError(dawn::ErrorType type, const ErrorMessage& message);
 
         bool ConsumedError(MaybeError maybeError) {
             if (DAWN_UNLIKELY(maybeError.IsError())) {
@@ -88,6 +93,13 @@ namespace dawn_native {
             CommandEncoderBase* encoder,
             const CommandBufferDescriptor* descriptor) = 0;
 
+        // Render bundles are created by the frontend as they only contain commands. Backends that
+        // keep state for them, like pre-recorded command buffers, return their own subclass.
+        virtual RenderBundleBase* CreateRenderBundle(RenderBundleEncoderBase* encoder,
+                                                     const RenderBundleDescriptor* descriptor,
+                                                     AttachmentState* attachmentState,
+                                                     PassResourceUsage resourceUsage);
+
         virtual Serial GetCompletedCommandSerial() const = 0;
         virtual Serial GetLastSubmittedCommandSerial() const = 0;
         virtual Serial GetPendingCommandSerial() const = 0;
@@ -165,6 +177,9 @@ namespace dawn_native {
 
         void SetUncapturedErrorCallback(dawn::ErrorCallback callback, void* userdata);
         void PushErrorScope(dawn::ErrorFilter filter);
+        // A null |callback| drops the result of the scope without formatting its error message.
+        // It is meant for internal scopes whose result is ignored, like the ones the wire server
+        // pops for removed clients.
         bool PopErrorScope(dawn::ErrorCallback callback, void* userdata);
         ErrorScope* GetCurrentErrorScope();
 
@@ -188,6 +203,17 @@ namespace dawn_native {
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
 
+        DeviceCounters* GetCounters();
+        DeviceStatistics GetStatistics();
+        MemoryTracker* GetMemoryTracker();
+
+      private:
+        // The counters and the memory tracker are updated when API objects and uploader memory
+        // are destroyed. Members are destroyed in the reverse order of their declaration, so
+        // they must be declared before all the members that own or reference API objects.
+        DeviceCounters mCounters;
+        MemoryTracker mMemoryTracker;
+
       protected:
         void SetToggle(Toggle toggle, bool isEnabled);
         void ApplyToggleOverrides(const DeviceDescriptor* deviceDescriptor);
@@ -276,7 +302,6 @@ namespace dawn_native {
         FormatTable mFormatTable;
 
         TogglesSet mTogglesSet;
-        size_t mLazyClearCountForTesting = 0;
 
         ExtensionsSet mEnabledExtensions;
     };
@@ -0,0 +1,109 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_DEVICESTATISTICS_H_
+#define DAWNNATIVE_DEVICESTATISTICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dawn_native {
+
+    // The types of the objects counted in the live object counts of the device.
+    enum class ObjectType : uint8_t {
+        BindGroup,
+        BindGroupLayout,
+        Buffer,
+        CommandBuffer,
+        CommandEncoder,
+        ComputePipeline,
+        Fence,
+        PipelineLayout,
+        Queue,
+        RenderBundle,
+        RenderBundleEncoder,
+        RenderPipeline,
+        Sampler,
+        ShaderModule,
+        SwapChain,
+        Texture,
+        TextureView,
+
+        EnumCount,
+        InvalidEnum = EnumCount,
+    };
+
+    // The object caches of the device, see DeviceBase::GetOrCreateBindGroupLayout.
+    enum class ObjectCacheType : uint8_t {
+        AttachmentState,
+        BindGroupLayout,
+        ComputePipeline,
+        PipelineLayout,
+        RenderPipeline,
+        Sampler,
+        ShaderModule,
+
+        EnumCount,
+    };
+
+    // A counter that can be updated from any thread. The updates are relaxed because the counters
+    // are only read to report statistics and don't order any other memory access.
+    class Counter {
+      public:
+        // Returns the value before the increment.
+        uint64_t Increment(uint64_t value = 1) {
+            return mValue.fetch_add(value, std::memory_order_relaxed);
+        }
+        void Decrement(uint64_t value = 1) {
+            mValue.fetch_sub(value, std::memory_order_relaxed);
+        }
+        uint64_t Get() const {
+            return mValue.load(std::memory_order_relaxed);
+        }
+
+      private:
+        std::atomic<uint64_t> mValue = {0};
+    };
+
+    struct DeviceCounters {
+        std::array<Counter, static_cast<size_t>(ObjectType::EnumCount)> liveObjects;
+        std::array<Counter, static_cast<size_t>(ObjectCacheType::EnumCount)> cacheHits;
+        std::array<Counter, static_cast<size_t>(ObjectCacheType::EnumCount)> cacheMisses;
+
+        Counter stagingBytesUploaded;
+        Counter uploadRingBufferGrowths;
+        Counter lazyClears;
+
+        Counter glStateCallsIssued;
+        Counter glStateCallsFiltered;
+
+        Counter vulkanBarriersIssued;
+        Counter vulkanBarriersMerged;
+
+        Counter& LiveObjects(ObjectType type) {
+            return liveObjects[static_cast<size_t>(type)];
+        }
+        Counter& CacheHits(ObjectCacheType type) {
+            return cacheHits[static_cast<size_t>(type)];
+        }
+        Counter& CacheMisses(ObjectCacheType type) {
+            return cacheMisses[static_cast<size_t>(type)];
+        }
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_DEVICESTATISTICS_H_
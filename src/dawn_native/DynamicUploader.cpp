@@ -15,6 +15,7 @@
 #include "dawn_native/DynamicUploader.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native {
 
@@ -29,6 +30,9 @@ namespace dawn_native {
     }
 
     ResultOrError<UploadHandle> DynamicUploader::Allocate(size_t allocationSize, Serial serial) {
+        TRACE_EVENT1(mDevice->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DynamicUploader::Allocate", "size", allocationSize);
+
         // Note: Validation ensures size is already aligned.
         // First-fit: find next smallest buffer large enough to satisfy the allocation request.
         RingBuffer* targetRingBuffer = mRingBuffers.back().get();
@@ -58,6 +62,10 @@ namespace dawn_native {
                 newMaxSize *= 2;
             }
 
+            TRACE_EVENT_INSTANT1(mDevice->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                 "DynamicUploader::AddRingBuffer", "size", newMaxSize);
+            mDevice->GetCounters()->uploadRingBufferGrowths.Increment();
+
             // TODO(bryan.bernhart@intel.com): Fall-back to no sub-allocations should this fail.
             mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
                 new RingBuffer{nullptr, RingBufferAllocator(newMaxSize)}));
@@ -74,6 +82,8 @@ namespace dawn_native {
             std::unique_ptr<StagingBufferBase> stagingBuffer;
             DAWN_TRY_ASSIGN(stagingBuffer,
                             mDevice->CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
+            stagingBuffer->TrackMemory(mDevice->GetMemoryTracker(),
+                                       MemoryCategory::UploadRingBuffer);
             targetRingBuffer->mStagingBuffer = std::move(stagingBuffer);
         }
 
@@ -85,6 +95,7 @@ namespace dawn_native {
             static_cast<uint8_t*>(uploadHandle.stagingBuffer->GetMappedPointer()) + startOffset;
         uploadHandle.startOffset = startOffset;
 
+        mDevice->GetCounters()->stagingBytesUploaded.Increment(allocationSize);
         return uploadHandle;
     }
 
@@ -102,4 +113,24 @@ namespace dawn_native {
         }
         mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
     }
+
+    size_t DynamicUploader::GetRingBufferCount() const {
+        return mRingBuffers.size();
+    }
+
+    size_t DynamicUploader::GetRingBufferSize() const {
+        size_t size = 0;
+        for (const auto& ringBuffer : mRingBuffers) {
+            size += ringBuffer->mAllocator.GetSize();
+        }
+        return size;
+    }
+
+    size_t DynamicUploader::GetRingBufferUsedSize() const {
+        size_t usedSize = 0;
+        for (const auto& ringBuffer : mRingBuffers) {
+            usedSize += ringBuffer->mAllocator.GetUsedSize();
+        }
+        return usedSize;
+    }
 }  // namespace dawn_native
\ No newline at end of file
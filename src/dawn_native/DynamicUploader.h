@@ -43,6 +43,10 @@ namespace dawn_native {
         ResultOrError<UploadHandle> Allocate(size_t allocationSize, Serial serial);
         void Deallocate(Serial lastCompletedSerial);
 
+        size_t GetRingBufferCount() const;
+        size_t GetRingBufferSize() const;
+        size_t GetRingBufferUsedSize() const;
+
       private:
         // TODO(bryan.bernhart@intel.com): Figure out this value.
         static constexpr size_t kBaseUploadBufferSize = 64000;
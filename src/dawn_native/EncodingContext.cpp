@@ -45,7 +45,7 @@ namespace dawn_native {
         return &mIterator;
     }
 
-    void EncodingContext::HandleError(dawn::ErrorType type, const char* message) {
+    void EncodingContext::HandleError(dawn::ErrorType type, const ErrorMessage& message) {
         if (!IsFinished()) {
             // If the encoding context is not finished, errors are deferred until
             // Finish() is called.
@@ -90,7 +90,7 @@ namespace dawn_native {
         mTopLevelEncoder = nullptr;
 
         if (mGotError) {
-            return DAWN_VALIDATION_ERROR(mErrorMessage);
+            return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::Validation, mErrorMessage);
         }
         if (currentEncoder != topLevelEncoder) {
             return DAWN_VALIDATION_ERROR("Command buffer recording ended mid-pass");
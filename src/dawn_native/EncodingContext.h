@@ -20,8 +20,6 @@
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/dawn_platform.h"
 
-#include <string>
-
 namespace dawn_native {
 
     class ObjectBase;
@@ -38,10 +36,10 @@ namespace dawn_native {
         CommandIterator* GetIterator();
 
         // Functions to handle encoder errors
-        void HandleError(dawn::ErrorType type, const char* message);
+        void HandleError(dawn::ErrorType type, const ErrorMessage& message);
 
         inline void ConsumeError(ErrorData* error) {
-            HandleError(error->GetType(), error->GetMessage().c_str());
+            HandleError(error->GetType(), error->GetErrorMessage());
             delete error;
         }
 
@@ -59,10 +57,11 @@ namespace dawn_native {
                 if (mCurrentEncoder != mTopLevelEncoder) {
                     // The top level encoder was used when a pass encoder was current.
                     HandleError(dawn::ErrorType::Validation,
-                                "Command cannot be recorded inside a pass");
+                                DAWN_ERROR_MESSAGE("Command cannot be recorded inside a pass"));
                 } else {
-                    HandleError(dawn::ErrorType::Validation,
-                                "Recording in an error or already ended pass encoder");
+                    HandleError(
+                        dawn::ErrorType::Validation,
+                        DAWN_ERROR_MESSAGE("Recording in an error or already ended pass encoder"));
                 }
                 return false;
             }
@@ -96,7 +95,7 @@ namespace dawn_native {
         bool mWereCommandsAcquired = false;
 
         bool mGotError = false;
-        std::string mErrorMessage;
+        ErrorMessage mErrorMessage;
     };
 
 }  // namespace dawn_native
@@ -19,11 +19,11 @@
 namespace dawn_native {
 
     ErrorData* MakeError(InternalErrorType type,
-                         std::string message,
+                         ErrorMessage message,
                          const char* file,
                          const char* function,
                          int line) {
-        ErrorData* error = new ErrorData(type, message);
+        ErrorData* error = new ErrorData(type, std::move(message));
         error->AppendBacktrace(file, function, line);
         return error;
     }
@@ -16,6 +16,7 @@
 #define DAWNNATIVE_ERROR_H_
 
 #include "common/Result.h"
+#include "dawn_native/ErrorMessage.h"
 
 #include <string>
 
@@ -43,12 +44,22 @@ namespace dawn_native {
     //
     // but shorthand version for specific error types are preferred:
     //   return DAWN_VALIDATION_ERROR("My error message");
-#define DAWN_MAKE_ERROR(TYPE, MESSAGE) \
-    ::dawn_native::MakeError(TYPE, MESSAGE, __FILE__, __func__, __LINE__)
-#define DAWN_VALIDATION_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::Validation, MESSAGE)
-#define DAWN_DEVICE_LOST_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::DeviceLost, MESSAGE)
-#define DAWN_UNIMPLEMENTED_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::Unimplemented, MESSAGE)
-#define DAWN_OUT_OF_MEMORY_ERROR(MESSAGE) DAWN_MAKE_ERROR(InternalErrorType::OutOfMemory, MESSAGE)
+    //
+    // The message is a string literal formatted only when it is delivered to the application, and
+    // can take integer arguments, see ErrorMessage:
+    //   return DAWN_VALIDATION_ERROR("Binding %u is out of bounds", binding);
+    //
+    // Messages computed at runtime are copied in the error instead:
+    //   return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::DeviceLost, message);
+#define DAWN_MAKE_ERROR(TYPE, ...) \
+    ::dawn_native::MakeError(TYPE, DAWN_ERROR_MESSAGE(__VA_ARGS__), __FILE__, __func__, __LINE__)
+#define DAWN_MAKE_ERROR_WITH_MESSAGE(TYPE, MESSAGE)                                           \
+    ::dawn_native::MakeError(TYPE, ::dawn_native::ErrorMessage(MESSAGE), __FILE__, __func__, \
+                             __LINE__)
+#define DAWN_VALIDATION_ERROR(...) DAWN_MAKE_ERROR(InternalErrorType::Validation, __VA_ARGS__)
+#define DAWN_DEVICE_LOST_ERROR(...) DAWN_MAKE_ERROR(InternalErrorType::DeviceLost, __VA_ARGS__)
+#define DAWN_UNIMPLEMENTED_ERROR(...) DAWN_MAKE_ERROR(InternalErrorType::Unimplemented, __VA_ARGS__)
+#define DAWN_OUT_OF_MEMORY_ERROR(...) DAWN_MAKE_ERROR(InternalErrorType::OutOfMemory, __VA_ARGS__)
 
 #define DAWN_CONCAT1(x, y) x##y
 #define DAWN_CONCAT2(x, y) DAWN_CONCAT1(x, y)
@@ -89,7 +100,7 @@ namespace dawn_native {
 
     // Implementation detail of DAWN_MAKE_ERROR
     ErrorData* MakeError(InternalErrorType type,
-                         std::string message,
+                         ErrorMessage message,
                          const char* file,
                          const char* function,
                          int line);
@@ -21,7 +21,7 @@ namespace dawn_native {
 
     ErrorData::ErrorData() = default;
 
-    ErrorData::ErrorData(InternalErrorType type, std::string message)
+    ErrorData::ErrorData(InternalErrorType type, ErrorMessage message)
         : mType(type), mMessage(std::move(message)) {
     }
 
@@ -51,10 +51,14 @@ namespace dawn_native {
         }
     }
 
-    const std::string& ErrorData::GetMessage() const {
+    const ErrorMessage& ErrorData::GetErrorMessage() const {
         return mMessage;
     }
 
+    std::string ErrorData::GetMessage() const {
+        return mMessage.Format();
+    }
+
     const std::vector<ErrorData::BacktraceRecord>& ErrorData::GetBacktrace() const {
         return mBacktrace;
     }
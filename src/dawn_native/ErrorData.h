@@ -15,6 +15,8 @@
 #ifndef DAWNNATIVE_ERRORDATA_H_
 #define DAWNNATIVE_ERRORDATA_H_
 
+#include "dawn_native/ErrorMessage.h"
+
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -30,7 +32,7 @@ namespace dawn_native {
     class ErrorData {
       public:
         ErrorData();
-        ErrorData(InternalErrorType type, std::string message);
+        ErrorData(InternalErrorType type, ErrorMessage message);
 
         struct BacktraceRecord {
             const char* file;
@@ -41,12 +43,14 @@ namespace dawn_native {
 
         InternalErrorType GetInternalType() const;
         dawn::ErrorType GetType() const;
-        const std::string& GetMessage() const;
+        const ErrorMessage& GetErrorMessage() const;
+        // Formats the message, prefer passing the ErrorMessage along when it may not be used.
+        std::string GetMessage() const;
         const std::vector<BacktraceRecord>& GetBacktrace() const;
 
       private:
         InternalErrorType mType;
-        std::string mMessage;
+        ErrorMessage mMessage;
         std::vector<BacktraceRecord> mBacktrace;
     };
 
@@ -0,0 +1,51 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dawn_native/ErrorMessage.h"
+
+#include "common/Assert.h"
+
+namespace dawn_native {
+
+    ErrorMessage::ErrorMessage() = default;
+
+    ErrorMessage::ErrorMessage(std::string message) : mMessage(std::move(message)) {
+    }
+
+    std::string ErrorMessage::Format() const {
+        if (mFormat == nullptr) {
+            return mMessage;
+        }
+
+        std::string message;
+        uint32_t argumentIndex = 0;
+        // A "%u" without a matching argument is kept as is.
+        for (const char* c = mFormat; *c != '\0'; ++c) {
+            if (c[0] == '%' && c[1] == 'u' && argumentIndex < mArgumentCount) {
+                message += std::to_string(mArguments[argumentIndex++]);
+                ++c;
+            } else if (c[0] == '%' && c[1] == '%') {
+                message += '%';
+                ++c;
+            } else {
+                message += *c;
+            }
+        }
+        ASSERT(argumentIndex == mArgumentCount);
+
+        return message;
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,68 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_ERRORMESSAGE_H_
+#define DAWNNATIVE_ERRORMESSAGE_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace dawn_native {
+
+    // The message of an error, kept unformatted until it is delivered to the application. Most
+    // errors are validation errors that are handled inside error scopes, or by applications that
+    // probe the validation and don't look at the message, so building the message string for
+    // each error would be wasted work.
+    //
+    // A message is either a string literal used as a format with integer arguments, or a string
+    // copied when the message is computed at runtime. The format replaces each "%u" with the next
+    // argument, and "%%" with "%".
+    class ErrorMessage {
+      public:
+        static constexpr size_t kMaxArguments = 4;
+
+        ErrorMessage();
+        explicit ErrorMessage(std::string message);
+
+        // The format is kept by pointer so it must be a string literal. Use DAWN_ERROR_MESSAGE
+        // that checks it at compile time instead of calling this directly.
+        template <size_t N, typename... Args>
+        static ErrorMessage FromLiteral(const char (&format)[N], Args... args) {
+            static_assert(sizeof...(Args) <= kMaxArguments, "Too many error message arguments");
+            ErrorMessage message;
+            message.mFormat = format;
+            message.mArguments = {{static_cast<uint64_t>(args)...}};
+            message.mArgumentCount = sizeof...(Args);
+            return message;
+        }
+
+        std::string Format() const;
+
+      private:
+        const char* mFormat = nullptr;
+        std::string mMessage;
+        std::array<uint64_t, kMaxArguments> mArguments = {};
+        uint32_t mArgumentCount = 0;
+    };
+
+}  // namespace dawn_native
+
+// Makes an ErrorMessage from a format that must be a string literal, followed by its arguments:
+//   DAWN_ERROR_MESSAGE("Binding %u is out of bounds", binding)
+// Concatenating the format with "" fails to compile for anything that isn't a literal.
+#define DAWN_ERROR_MESSAGE(...) ::dawn_native::ErrorMessage::FromLiteral("" __VA_ARGS__)
+
+#endif  // DAWNNATIVE_ERRORMESSAGE_H_
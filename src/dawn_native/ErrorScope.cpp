@@ -29,7 +29,12 @@ namespace dawn_native {
         if (mCallback == nullptr || IsRoot()) {
             return;
         }
-        mCallback(static_cast<DawnErrorType>(mErrorType), mErrorMessage.c_str(), mUserdata);
+        if (mErrorType == dawn::ErrorType::NoError) {
+            mCallback(DAWN_ERROR_TYPE_NO_ERROR, "", mUserdata);
+            return;
+        }
+        std::string message = mErrorMessage.Format();
+        mCallback(static_cast<DawnErrorType>(mErrorType), message.c_str(), mUserdata);
     }
 
     void ErrorScope::SetCallback(dawn::ErrorCallback callback, void* userdata) {
@@ -45,12 +50,14 @@ namespace dawn_native {
         return mParent.Get() == nullptr;
     }
 
-    void ErrorScope::HandleError(dawn::ErrorType type, const char* message) {
+    void ErrorScope::HandleError(dawn::ErrorType type, const ErrorMessage& message) {
         HandleErrorImpl(this, type, message);
     }
 
     // static
-    void ErrorScope::HandleErrorImpl(ErrorScope* scope, dawn::ErrorType type, const char* message) {
+    void ErrorScope::HandleErrorImpl(ErrorScope* scope,
+                                     dawn::ErrorType type,
+                                     const ErrorMessage& message) {
         ErrorScope* currentScope = scope;
         for (; !currentScope->IsRoot(); currentScope = currentScope->GetParent()) {
             ASSERT(currentScope != nullptr);
@@ -100,7 +107,8 @@ namespace dawn_native {
         // The root error scope captures all uncaptured errors.
         ASSERT(currentScope->IsRoot());
         if (currentScope->mCallback) {
-            currentScope->mCallback(static_cast<DawnErrorType>(type), message,
+            std::string formattedMessage = message.Format();
+            currentScope->mCallback(static_cast<DawnErrorType>(type), formattedMessage.c_str(),
                                     currentScope->mUserdata);
         }
     }
@@ -108,7 +116,7 @@ namespace dawn_native {
     void ErrorScope::Destroy() {
         if (!IsRoot()) {
             mErrorType = dawn::ErrorType::Unknown;
-            mErrorMessage = "Error scope destroyed";
+            mErrorMessage = DAWN_ERROR_MESSAGE("Error scope destroyed");
         }
     }
 
@@ -17,17 +17,18 @@
 
 #include "dawn_native/dawn_platform.h"
 
+#include "dawn_native/ErrorMessage.h"
 #include "dawn_native/RefCounted.h"
 
-#include <string>
-
 namespace dawn_native {
 
     // Errors can be recorded into an ErrorScope by calling |HandleError|.
     // Because an error scope should not resolve until contained
     // commands are complete, calling the callback is deferred until it is destructed.
     // In-flight commands or asynchronous events should hold a reference to the
-    // ErrorScope for their duration.
+    // ErrorScope for their duration. The message of the recorded error is only formatted if the
+    // scope has a callback to deliver it to: a scope popped without a callback, like the internal
+    // scopes whose result is ignored, drops its error without formatting it.
     //
     // Because parent ErrorScopes should not resolve before child ErrorScopes,
     // ErrorScopes hold a reference to their parent.
@@ -44,13 +45,15 @@ namespace dawn_native {
         void SetCallback(dawn::ErrorCallback callback, void* userdata);
         ErrorScope* GetParent();
 
-        void HandleError(dawn::ErrorType type, const char* message);
+        void HandleError(dawn::ErrorType type, const ErrorMessage& message);
 
         void Destroy();
 
       private:
         bool IsRoot() const;
-        static void HandleErrorImpl(ErrorScope* scope, dawn::ErrorType type, const char* message);
+        static void HandleErrorImpl(ErrorScope* scope,
+                                    dawn::ErrorType type,
+                                    const ErrorMessage& message);
 
         dawn::ErrorFilter mErrorFilter = dawn::ErrorFilter::None;
         Ref<ErrorScope> mParent = nullptr;
@@ -59,7 +62,7 @@ namespace dawn_native {
         void* mUserdata = nullptr;
 
         dawn::ErrorType mErrorType = dawn::ErrorType::NoError;
-        std::string mErrorMessage = "";
+        ErrorMessage mErrorMessage;
     };
 
 }  // namespace dawn_native
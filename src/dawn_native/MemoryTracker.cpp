@@ -0,0 +1,89 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/MemoryTracker.h"
+
+#include "common/Assert.h"
+
+namespace dawn_native {
+
+    void MemoryTracker::Allocate(MemoryCategory category, uint64_t bytes) {
+        mUsage[static_cast<size_t>(category)].Increment(bytes);
+
+        // The total before this allocation is returned by the increment itself so that concurrent
+        // allocations can't both see the usage under the budget, or both miss crossing it.
+        uint64_t previousTotal = mTotalUsage.Increment(bytes);
+
+        // Only crossing the budget triggers the callback so that it isn't called for every
+        // allocation made while the usage stays over the budget.
+        uint64_t budget = mBudget.load(std::memory_order_relaxed);
+        if (previousTotal <= budget && previousTotal + bytes > budget) {
+            mPressurePending.store(true);
+        }
+    }
+
+    void MemoryTracker::Free(MemoryCategory category, uint64_t bytes) {
+        ASSERT(GetUsage(category) >= bytes);
+        mUsage[static_cast<size_t>(category)].Decrement(bytes);
+        mTotalUsage.Decrement(bytes);
+    }
+
+    uint64_t MemoryTracker::GetUsage(MemoryCategory category) const {
+        return mUsage[static_cast<size_t>(category)].Get();
+    }
+
+    uint64_t MemoryTracker::GetTotalUsage() const {
+        return mTotalUsage.Get();
+    }
+
+    MemoryUsage MemoryTracker::GetMemoryUsage() const {
+        MemoryUsage usage;
+        usage.buffers = GetUsage(MemoryCategory::Buffer);
+        usage.textures = GetUsage(MemoryCategory::Texture);
+        usage.staging = GetUsage(MemoryCategory::Staging);
+        usage.uploadRingBuffers = GetUsage(MemoryCategory::UploadRingBuffer);
+        usage.descriptorPools = GetUsage(MemoryCategory::DescriptorPool);
+        usage.total = GetTotalUsage();
+        return usage;
+    }
+
+    void MemoryTracker::SetBudget(uint64_t budget,
+                                  MemoryPressureCallback callback,
+                                  void* userdata) {
+        mBudget.store(budget, std::memory_order_relaxed);
+        mPressureCallback = callback;
+        mPressureUserdata = userdata;
+
+        // A budget set below the current usage is under pressure right away.
+        mPressurePending.store(GetTotalUsage() > budget);
+    }
+
+    uint64_t MemoryTracker::GetBudget() const {
+        return mBudget.load(std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::Tick() {
+        if (!mPressurePending.exchange(false)) {
+            return;
+        }
+
+        // The usage may have gone back under the budget since the allocation that crossed it.
+        uint64_t usage = GetTotalUsage();
+        uint64_t budget = GetBudget();
+        if (mPressureCallback != nullptr && usage > budget) {
+            mPressureCallback(usage, budget, mPressureUserdata);
+        }
+    }
+
+}  // namespace dawn_native
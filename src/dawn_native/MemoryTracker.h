@@ -0,0 +1,74 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_MEMORYTRACKER_H_
+#define DAWNNATIVE_MEMORYTRACKER_H_
+
+#include "dawn_native/DawnNative.h"
+#include "dawn_native/DeviceStatistics.h"
+
+#include <array>
+#include <atomic>
+
+namespace dawn_native {
+
+    enum class MemoryCategory : uint8_t {
+        Buffer,
+        Texture,
+        Staging,
+        UploadRingBuffer,
+        DescriptorPool,
+
+        EnumCount,
+    };
+
+    // Accounts for the GPU memory used by a device and notifies the application when the usage
+    // goes over its budget. The frontend objects account for their memory themselves, so that
+    // the accounting is the same for all backends, and backends only add the memory that has no
+    // frontend object like the descriptor pools.
+    //
+    // The pressure callback isn't called from inside the allocation that crosses the budget, as
+    // the application would then release objects while the device is in the middle of creating
+    // one. It is called on the next device tick instead.
+    class MemoryTracker {
+      public:
+        void Allocate(MemoryCategory category, uint64_t bytes);
+        void Free(MemoryCategory category, uint64_t bytes);
+
+        uint64_t GetUsage(MemoryCategory category) const;
+        uint64_t GetTotalUsage() const;
+        MemoryUsage GetMemoryUsage() const;
+
+        void SetBudget(uint64_t budget, MemoryPressureCallback callback, void* userdata);
+        uint64_t GetBudget() const;
+
+        // Calls the pressure callback if the usage went over the budget since the last tick.
+        void Tick();
+
+      private:
+        std::array<Counter, static_cast<size_t>(MemoryCategory::EnumCount)> mUsage;
+        Counter mTotalUsage;
+
+        // Read by allocations that can happen on any thread. The callback is only used on the
+        // device thread, by SetBudget and Tick.
+        std::atomic<uint64_t> mBudget = {kNoMemoryBudget};
+        MemoryPressureCallback mPressureCallback = nullptr;
+        void* mPressureUserdata = nullptr;
+        // Set by allocations that can happen on any thread.
+        std::atomic<bool> mPressurePending = {false};
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_MEMORYTRACKER_H_
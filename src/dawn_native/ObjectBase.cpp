@@ -14,6 +14,9 @@
 
 #include "dawn_native/ObjectBase.h"
 
+#include "common/Assert.h"
+#include "dawn_native/Device.h"
+
 namespace dawn_native {
 
     ObjectBase::ObjectBase(DeviceBase* device) : mDevice(device), mIsError(false) {
@@ -23,6 +26,9 @@ namespace dawn_native {
     }
 
     ObjectBase::~ObjectBase() {
+        if (mLiveObjectType != ObjectType::InvalidEnum) {
+            mDevice->GetCounters()->LiveObjects(mLiveObjectType).Decrement();
+        }
     }
 
     DeviceBase* ObjectBase::GetDevice() const {
@@ -33,4 +39,11 @@ namespace dawn_native {
         return mIsError;
     }
 
+    void ObjectBase::TrackLiveObject(ObjectType type) {
+        ASSERT(mLiveObjectType == ObjectType::InvalidEnum);
+        ASSERT(type != ObjectType::InvalidEnum);
+        mLiveObjectType = type;
+        mDevice->GetCounters()->LiveObjects(type).Increment();
+    }
+
 }  // namespace dawn_native
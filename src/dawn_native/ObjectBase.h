@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_OBJECTBASE_H_
 #define DAWNNATIVE_OBJECTBASE_H_
 
+#include "dawn_native/DeviceStatistics.h"
 #include "dawn_native/RefCounted.h"
 
 namespace dawn_native {
@@ -33,12 +34,17 @@ namespace dawn_native {
         DeviceBase* GetDevice() const;
         bool IsError() const;
 
+        // Counts the object in the live objects of |type| of the device until it is destroyed.
+        // This is only done for the objects created by the application.
+        void TrackLiveObject(ObjectType type);
+
       private:
         DeviceBase* mDevice;
         // TODO(cwallez@chromium.org): This most likely adds 4 bytes to most Dawn objects, see if
         // that bit can be hidden in the refcount once it is a single 64bit refcount.
         // See https://bugs.chromium.org/p/dawn/issues/detail?id=105
         bool mIsError;
+        ObjectType mLiveObjectType = ObjectType::InvalidEnum;
     };
 
 }  // namespace dawn_native
@@ -78,7 +78,7 @@ namespace dawn_native {
             DAWN_TRY(GetDevice()->ValidateObject(group));
 
             if (groupIndex >= kMaxBindGroups) {
-                return DAWN_VALIDATION_ERROR("Setting bind group over the max");
+                return DAWN_VALIDATION_ERROR("Setting bind group %u over the max", groupIndex);
             }
 
             // Dynamic offsets count must match the number required by the layout perfectly.
@@ -64,7 +64,9 @@ namespace dawn_native {
             return FenceBase::MakeError(GetDevice());
         }
 
-        return new FenceBase(this, descriptor);
+        FenceBase* fence = new FenceBase(this, descriptor);
+        fence->TrackLiveObject(ObjectType::Fence);
+        return fence;
     }
 
     MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
@@ -106,8 +106,10 @@ namespace dawn_native {
         }
         ASSERT(!IsError());
 
-        return new RenderBundleBase(this, descriptor, mAttachmentState.Get(),
-                                    std::move(mResourceUsage));
+        RenderBundleBase* renderBundle = GetDevice()->CreateRenderBundle(
+            this, descriptor, mAttachmentState.Get(), std::move(mResourceUsage));
+        renderBundle->TrackLiveObject(ObjectType::RenderBundle);
+        return renderBundle;
     }
 
     MaybeError RenderBundleEncoderBase::ValidateFinish(const RenderBundleDescriptor* descriptor) {
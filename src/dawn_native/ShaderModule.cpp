@@ -76,7 +76,7 @@ namespace dawn_native {
         });
 
         if (!spirvTools.Validate(descriptor->code, descriptor->codeSize)) {
-            return DAWN_VALIDATION_ERROR(errorStream.str().c_str());
+            return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::Validation, errorStream.str());
         }
 
         return {};
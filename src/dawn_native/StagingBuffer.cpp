@@ -14,11 +14,19 @@
 
 #include "dawn_native/StagingBuffer.h"
 
+#include "common/Assert.h"
+
 namespace dawn_native {
 
     StagingBufferBase::StagingBufferBase(size_t size) : mBufferSize(size) {
     }
 
+    StagingBufferBase::~StagingBufferBase() {
+        if (mMemoryTracker != nullptr) {
+            mMemoryTracker->Free(mMemoryCategory, mBufferSize);
+        }
+    }
+
     size_t StagingBufferBase::GetSize() const {
         return mBufferSize;
     }
@@ -26,4 +34,11 @@ namespace dawn_native {
     void* StagingBufferBase::GetMappedPointer() const {
         return mMappedPointer;
     }
+
+    void StagingBufferBase::TrackMemory(MemoryTracker* tracker, MemoryCategory category) {
+        ASSERT(mMemoryTracker == nullptr);
+        mMemoryTracker = tracker;
+        mMemoryCategory = category;
+        mMemoryTracker->Allocate(mMemoryCategory, mBufferSize);
+    }
 }  // namespace dawn_native
\ No newline at end of file
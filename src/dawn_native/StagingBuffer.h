@@ -16,24 +16,31 @@
 #define DAWNNATIVE_STAGINGBUFFER_H_
 
 #include "dawn_native/Error.h"
+#include "dawn_native/MemoryTracker.h"
 
 namespace dawn_native {
 
     class StagingBufferBase {
       public:
         StagingBufferBase(size_t size);
-        virtual ~StagingBufferBase() = default;
+        virtual ~StagingBufferBase();
 
         virtual MaybeError Initialize() = 0;
 
         void* GetMappedPointer() const;
         size_t GetSize() const;
 
+        // Accounts for the memory of the staging buffer in |category| until it is destroyed.
+        void TrackMemory(MemoryTracker* tracker, MemoryCategory category);
+
       protected:
         void* mMappedPointer = nullptr;
 
       private:
         const size_t mBufferSize;
+
+        MemoryTracker* mMemoryTracker = nullptr;
+        MemoryCategory mMemoryCategory;
     };
 
 }  // namespace dawn_native
@@ -336,6 +336,18 @@ namespace dawn_native {
         uint32_t subresourceCount =
             GetSubresourceIndex(descriptor->mipLevelCount, descriptor->arrayLayerCount);
         mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
+
+        if (mState == TextureState::OwnedInternal) {
+            device->GetMemoryTracker()->Allocate(MemoryCategory::Texture,
+                                                 GetEstimatedMemorySize());
+        }
+    }
+
+    TextureBase::~TextureBase() {
+        if (!IsError() && mState == TextureState::OwnedInternal) {
+            GetDevice()->GetMemoryTracker()->Free(MemoryCategory::Texture,
+                                                  GetEstimatedMemorySize());
+        }
     }
 
     static Format kUnusedFormat;
@@ -483,10 +495,23 @@ namespace dawn_native {
     void TextureBase::DestroyInternal() {
         if (mState == TextureState::OwnedInternal) {
             DestroyImpl();
+            GetDevice()->GetMemoryTracker()->Free(MemoryCategory::Texture,
+                                                  GetEstimatedMemorySize());
         }
         mState = TextureState::Destroyed;
     }
 
+    uint64_t TextureBase::GetEstimatedMemorySize() const {
+        uint64_t size = 0;
+        for (uint32_t level = 0; level < mMipLevelCount; ++level) {
+            Extent3D extent = GetMipLevelPhysicalSize(level);
+            uint64_t blockCount = static_cast<uint64_t>(extent.width / mFormat.blockWidth) *
+                                  (extent.height / mFormat.blockHeight) * extent.depth;
+            size += blockCount * mFormat.blockByteSize;
+        }
+        return size * mArrayLayerCount * mSampleCount;
+    }
+
     MaybeError TextureBase::ValidateDestroy() const {
         DAWN_TRY(GetDevice()->ValidateObject(this));
         return {};
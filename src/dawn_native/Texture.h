@@ -46,6 +46,7 @@ namespace dawn_native {
         enum class TextureState { OwnedInternal, OwnedExternal, Destroyed };
         enum class ClearValue { Zero, NonZero };
         TextureBase(DeviceBase* device, const TextureDescriptor* descriptor, TextureState state);
+        ~TextureBase();
 
         static TextureBase* MakeError(DeviceBase* device);
 
@@ -91,6 +92,10 @@ namespace dawn_native {
         TextureBase(DeviceBase* device, ObjectBase::ErrorTag tag);
         virtual void DestroyImpl();
 
+        // The memory accounted for the textures owned by Dawn. The driver can add padding for
+        // alignment or compression that isn't counted.
+        uint64_t GetEstimatedMemorySize() const;
+
         MaybeError ValidateDestroy() const;
         dawn::TextureDimension mDimension;
         // TODO(cwallez@chromium.org): This should be deduplicated in the Device
@@ -68,6 +68,11 @@ namespace dawn_native {
         using BackendType = typename BackendTraits::QueueType;
     };
 
+    template <typename BackendTraits>
+    struct ToBackendTraits<RenderBundleBase, BackendTraits> {
+        using BackendType = typename BackendTraits::RenderBundleType;
+    };
+
     template <typename BackendTraits>
     struct ToBackendTraits<RenderPipelineBase, BackendTraits> {
         using BackendType = typename BackendTraits::RenderPipelineType;
@@ -65,7 +65,32 @@ namespace dawn_native {
                "workaround is enabled by default on all Vulkan drivers to solve an issue in the "
                "Vulkan SPEC about the texture-to-texture copies with compressed formats. See #1005 "
                "(https://github.com/KhronosGroup/Vulkan-Docs/issues/1005) for more details.",
-               "https://bugs.chromium.org/p/dawn/issues/detail?id=42"}}}};
+               "https://bugs.chromium.org/p/dawn/issues/detail?id=42"}},
+             {Toggle::FilterRedundantGLStateCalls,
+              {"filter_redundant_gl_state_calls",
+               "Skips the OpenGL calls that set bindings, enable bits, or blend and depth state to "
+               "the value they already have, by shadowing that state on the CPU. This is only "
+               "correct if the application doesn't change that state on the GL context used by "
+               "Dawn, so it is disabled by default. Filtering stops as soon as a second device is "
+               "created on the same context, since the devices share the context state.",
+               "https://bugs.chromium.org/p/dawn/issues/list"}},
+             {Toggle::AsyncGLShaderCompilation,
+              {"async_gl_shader_compilation",
+               "Translates shaders to GLSL on worker threads, and only waits for the OpenGL "
+               "programs of pipelines to be linked when they are first used or when the device "
+               "ticks. With KHR_parallel_shader_compile or ARB_parallel_shader_compile, the driver "
+               "also compiles them on its own threads. Creating a pipeline still waits for the "
+               "translation of its shader modules, so only the modules created well before their "
+               "pipelines are translated in the background. It is disabled by default because it "
+               "uses additional threads.",
+               "https://bugs.chromium.org/p/dawn/issues/list"}},
+             {Toggle::RecordVulkanCommandsInParallel,
+              {"record_vulkan_commands_in_parallel",
+               "Records the render passes of submits with several command buffers in Vulkan "
+               "secondary command buffers on worker threads, one command buffer per thread, "
+               "before recording the rest of the commands. It is disabled by default because it "
+               "uses additional threads.",
+               "https://bugs.chromium.org/p/dawn/issues/list"}}}};
 
     }  // anonymous namespace
 
@@ -29,6 +29,9 @@ namespace dawn_native {
         AlwaysResolveIntoZeroLevelAndLayer,
         LazyClearResourceOnFirstUse,
         UseTemporaryBufferInCompressedTextureToTextureCopy,
+        FilterRedundantGLStateCalls,
+        AsyncGLShaderCompilation,
+        RecordVulkanCommandsInParallel,
 
         EnumCount,
         InvalidEnum = EnumCount,
@@ -0,0 +1,86 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dawn_native/WorkerPool.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    WorkerPool::WorkerPool(uint32_t threadCount) {
+        ASSERT(threadCount > 0);
+        mThreads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i) {
+            mThreads.emplace_back([this]() { ThreadMain(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (std::thread& thread : mThreads) {
+            thread.join();
+        }
+        ASSERT(mTasks.empty());
+    }
+
+    std::future<void> WorkerPool::PostTask(std::function<void()> task) {
+        std::packaged_task<void()> packagedTask(std::move(task));
+        std::future<void> future = packagedTask.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(!mStopping);
+            mTasks.push_back(std::move(packagedTask));
+        }
+        mCondition.notify_one();
+        return future;
+    }
+
+    uint32_t WorkerPool::GetThreadCount() const {
+        return static_cast<uint32_t>(mThreads.size());
+    }
+
+    // static
+    uint32_t WorkerPool::GetDefaultThreadCount() {
+        // hardware_concurrency returns 0 when the number of cores isn't known.
+        uint32_t coreCount = std::thread::hardware_concurrency();
+        return std::max(coreCount, 2u) - 1;
+    }
+
+    void WorkerPool::ThreadMain() {
+        while (true) {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return mStopping || !mTasks.empty(); });
+
+                // The tasks posted before stopping still run so that none of their futures is
+                // left without a result.
+                if (mTasks.empty()) {
+                    return;
+                }
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+
+}  // namespace dawn_native
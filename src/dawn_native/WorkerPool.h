@@ -0,0 +1,60 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_WORKERPOOL_H_
+#define DAWNNATIVE_WORKERPOOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dawn_native {
+
+    // A fixed set of threads that run the tasks posted to them, in the order they were posted,
+    // for the CPU work a backend can do off the thread using the device, like translating shaders.
+    class WorkerPool {
+      public:
+        explicit WorkerPool(uint32_t threadCount);
+        // Waits for the tasks that were posted to finish running.
+        ~WorkerPool();
+
+        // The returned future is ready once |task| has run, or holds the exception it threw.
+        std::future<void> PostTask(std::function<void()> task);
+
+        uint32_t GetThreadCount() const;
+
+        // The number of threads to use for a pool that shouldn't compete with the thread using
+        // the device: one less than the number of cores, but at least one.
+        static uint32_t GetDefaultThreadCount();
+
+      private:
+        void ThreadMain();
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<std::packaged_task<void()>> mTasks;
+        bool mStopping = false;
+
+        std::vector<std::thread> mThreads;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_WORKERPOOL_H_
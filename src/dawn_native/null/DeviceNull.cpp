@@ -18,9 +18,12 @@
 #include "dawn_native/Commands.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Instance.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <spirv_cross.hpp>
 
+#include <algorithm>
+
 namespace dawn_native { namespace null {
 
     // Implementation of pre-Device objects: the null adapter, null backend connection and Connect()
@@ -85,9 +88,12 @@ namespace dawn_native { namespace null {
     }
 
     Device::~Device() {
+        mTimeline = nullptr;
+
         mDynamicUploader = nullptr;
 
         mPendingOperations.clear();
+        mOperationsInFlight.ClearUpTo(mLastSubmittedSerial);
         ASSERT(mMemoryUsage == 0);
     }
 
@@ -167,6 +173,9 @@ namespace dawn_native { namespace null {
         operation->size = size;
 
         AddPendingOperation(std::move(operation));
+        if (mTimeline != nullptr) {
+            mPendingCopySize += size;
+        }
 
         return {};
     }
@@ -198,21 +207,169 @@ namespace dawn_native { namespace null {
     }
 
     MaybeError Device::TickImpl() {
-        SubmitPendingOperations();
+        if (mTimeline == nullptr) {
+            SubmitPendingOperations();
+            return {};
+        }
+
+        CheckPassedSerials();
+
+        if (!mPendingOperations.empty()) {
+            SubmitPendingOperations();
+        } else if (mCompletedSerial == mLastSubmittedSerial) {
+            // If there's no GPU work in flight we still need to artificially increment the
+            // serial so that CPU operations waiting on GPU completion can know they don't have
+            // to wait.
+            mCompletedSerial++;
+            mLastSubmittedSerial++;
+        }
+
+        // With the simulated GPU, the staging memory of uploads is only released once the
+        // serials using it complete.
+        mDynamicUploader->Deallocate(mCompletedSerial);
         return {};
     }
 
     void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
         mPendingOperations.emplace_back(std::move(operation));
     }
+
+    void Device::SubmitCommandBuffers(uint32_t commandCount, CommandBufferBase* const* commands) {
+        if (mTimeline != nullptr) {
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                ToBackend(commands[i])
+                    ->CountSimulatedWork(&mPendingCommandCount, &mPendingCopySize);
+            }
+        }
+        SubmitPendingOperations();
+    }
+
     void Device::SubmitPendingOperations() {
+        if (mTimeline == nullptr) {
+            for (auto& operation : mPendingOperations) {
+                operation->Execute();
+            }
+            mPendingOperations.clear();
+
+            mCompletedSerial = mLastSubmittedSerial;
+            mLastSubmittedSerial++;
+            return;
+        }
+
+        mLastSubmittedSerial++;
+
+        // The end is recorded by the simulated GPU when it completes the serial, which can happen
+        // as soon as the work is submitted, so the begin must be recorded first.
+        TRACE_EVENT_ASYNC_BEGIN0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                 "DeviceNull::SubmitPendingOperations", mLastSubmittedSerial);
+        mTimeline->Submit(mLastSubmittedSerial, mPendingCommandCount, mPendingCopySize);
+
         for (auto& operation : mPendingOperations) {
-            operation->Execute();
+            mOperationsInFlight.Enqueue(std::move(operation), mLastSubmittedSerial);
         }
         mPendingOperations.clear();
+        mPendingCommandCount = 0;
+        mPendingCopySize = 0;
+    }
+
+    void Device::CheckPassedSerials() {
+        mCompletedSerial = std::max(mCompletedSerial, mTimeline->GetCompletedSerial());
+
+        // Take the completed operations out of the queue before executing them because their
+        // callbacks can submit more work.
+        std::vector<std::unique_ptr<PendingOperation>> completedOperations;
+        for (auto& operation : mOperationsInFlight.IterateUpTo(mCompletedSerial)) {
+            completedOperations.push_back(std::move(operation));
+        }
+        mOperationsInFlight.ClearUpTo(mCompletedSerial);
 
+        for (auto& operation : completedOperations) {
+            operation->Execute();
+        }
+    }
+
+    bool Device::HasSimulatedGPUTimeline() const {
+        return mTimeline != nullptr;
+    }
+
+    void Device::EnableSimulatedGPUTimeline(const SimulatedGPUTimelineDescriptor& descriptor) {
+        ASSERT(mTimeline == nullptr);
+
+        // Everything submitted so far has been executed, so the timeline starts idle.
         mCompletedSerial = mLastSubmittedSerial;
-        mLastSubmittedSerial++;
+        mTimeline =
+            std::make_unique<SimulatedGPUTimeline>(GetPlatform(), descriptor, mCompletedSerial);
+    }
+
+    // SimulatedGPUTimeline
+
+    SimulatedGPUTimeline::SimulatedGPUTimeline(dawn_platform::Platform* platform,
+                                               const SimulatedGPUTimelineDescriptor& descriptor,
+                                               Serial completedSerial)
+        : mPlatform(platform), mCostModel(descriptor), mCompletedSerial(completedSerial) {
+        mThread = std::thread([this]() { ThreadMain(); });
+    }
+
+    SimulatedGPUTimeline::~SimulatedGPUTimeline() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_one();
+        mThread.join();
+    }
+
+    void SimulatedGPUTimeline::Submit(Serial serial, uint64_t commandCount, uint64_t copySize) {
+        Clock::duration cost = ComputeCost(commandCount, copySize);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mSubmittedWork.push_back({serial, cost, Clock::now()});
+        }
+        mCondition.notify_one();
+    }
+
+    Serial SimulatedGPUTimeline::GetCompletedSerial() const {
+        return mCompletedSerial.load(std::memory_order_acquire);
+    }
+
+    void SimulatedGPUTimeline::ThreadMain() {
+        // The time at which the simulated GPU finishes the work it was given so far. Work starts
+        // when both the GPU is free and it has been submitted, so oversleeping doesn't
+        // accumulate error over the timeline.
+        Clock::time_point gpuTime = Clock::now();
+
+        while (true) {
+            SubmittedWork work;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return mStopping || !mSubmittedWork.empty(); });
+                if (mStopping) {
+                    return;
+                }
+                work = std::move(mSubmittedWork.front());
+                mSubmittedWork.pop_front();
+            }
+
+            gpuTime = std::max(gpuTime, work.submitTime) + work.cost;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                if (mCondition.wait_until(lock, gpuTime, [this]() { return mStopping; })) {
+                    return;
+                }
+            }
+            TRACE_EVENT_ASYNC_END0(mPlatform, TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                   "DeviceNull::SubmitPendingOperations", work.serial);
+            mCompletedSerial.store(work.serial, std::memory_order_release);
+        }
+    }
+
+    SimulatedGPUTimeline::Clock::duration SimulatedGPUTimeline::ComputeCost(
+        uint64_t commandCount,
+        uint64_t copySize) const {
+        uint64_t cost = mCostModel.submitCost + commandCount * mCostModel.commandCost +
+                        copySize * mCostModel.copyCostPerKilobyte / 1024;
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(cost));
     }
 
     // Buffer
@@ -311,6 +468,19 @@ namespace dawn_native { namespace null {
         FreeCommands(&mCommands);
     }
 
+    void CommandBuffer::CountSimulatedWork(uint64_t* commandCount, uint64_t* copySize) {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            (*commandCount)++;
+            if (type == Command::CopyBufferToBuffer) {
+                *copySize += mCommands.NextCommand<CopyBufferToBufferCmd>()->size;
+            } else {
+                SkipCommand(&mCommands, type);
+            }
+        }
+        mCommands.Reset();
+    }
+
     // Queue
 
     Queue::Queue(Device* device) : QueueBase(device) {
@@ -319,8 +489,8 @@ namespace dawn_native { namespace null {
     Queue::~Queue() {
     }
 
-    MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
-        ToBackend(GetDevice())->SubmitPendingOperations();
+    MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
+        ToBackend(GetDevice())->SubmitCommandBuffers(commandCount, commands);
         return {};
     }
 
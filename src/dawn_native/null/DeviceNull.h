@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_NULL_DEVICENULL_H_
 #define DAWNNATIVE_NULL_DEVICENULL_H_
 
+#include "common/SerialQueue.h"
 #include "dawn_native/Adapter.h"
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
@@ -35,6 +36,15 @@
 #include "dawn_native/ToBackend.h"
 #include "dawn_native/dawn_platform.h"
 
+#include "dawn_native/NullBackend.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace dawn_native { namespace null {
 
     class Adapter;
@@ -81,6 +91,44 @@ namespace dawn_native { namespace null {
         virtual void Execute() = 0;
     };
 
+    // Executes the work submitted to a null device on a worker thread, one serial at a time, and
+    // retires each serial once its simulated execution time has elapsed.
+    class SimulatedGPUTimeline {
+      public:
+        SimulatedGPUTimeline(dawn_platform::Platform* platform,
+                             const SimulatedGPUTimelineDescriptor& descriptor,
+                             Serial completedSerial);
+        ~SimulatedGPUTimeline();
+
+        // The cost of the work is computed on the calling thread so that the worker thread never
+        // reads the command buffers.
+        void Submit(Serial serial, uint64_t commandCount, uint64_t copySize);
+        Serial GetCompletedSerial() const;
+
+      private:
+        using Clock = std::chrono::steady_clock;
+
+        struct SubmittedWork {
+            Serial serial;
+            Clock::duration cost;
+            Clock::time_point submitTime;
+        };
+
+        void ThreadMain();
+        Clock::duration ComputeCost(uint64_t commandCount, uint64_t copySize) const;
+
+        dawn_platform::Platform* mPlatform;
+        SimulatedGPUTimelineDescriptor mCostModel;
+        std::atomic<Serial> mCompletedSerial;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<SubmittedWork> mSubmittedWork;
+        bool mStopping = false;
+
+        std::thread mThread;
+    };
+
     class Device : public DeviceBase {
       public:
         Device(Adapter* adapter, const DeviceDescriptor* descriptor);
@@ -95,8 +143,12 @@ namespace dawn_native { namespace null {
         MaybeError TickImpl() override;
 
         void AddPendingOperation(std::unique_ptr<PendingOperation> operation);
+        void SubmitCommandBuffers(uint32_t commandCount, CommandBufferBase* const* commands);
         void SubmitPendingOperations();
 
+        void EnableSimulatedGPUTimeline(const SimulatedGPUTimelineDescriptor& descriptor);
+        bool HasSimulatedGPUTimeline() const;
+
         ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
         MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
                                            uint64_t sourceOffset,
@@ -130,10 +182,19 @@ namespace dawn_native { namespace null {
             TextureBase* texture,
             const TextureViewDescriptor* descriptor) override;
 
+        void CheckPassedSerials();
+
         Serial mCompletedSerial = 0;
         Serial mLastSubmittedSerial = 0;
         std::vector<std::unique_ptr<PendingOperation>> mPendingOperations;
 
+        // Only used with a simulated GPU timeline. The operations are kept until the serial they
+        // were submitted in is completed.
+        std::unique_ptr<SimulatedGPUTimeline> mTimeline;
+        uint64_t mPendingCommandCount = 0;
+        uint64_t mPendingCopySize = 0;
+        SerialQueue<std::unique_ptr<PendingOperation>> mOperationsInFlight;
+
         static constexpr size_t kMaxMemoryUsage = 256 * 1024 * 1024;
         size_t mMemoryUsage = 0;
     };
@@ -181,6 +242,10 @@ namespace dawn_native { namespace null {
         CommandBuffer(CommandEncoderBase* encoder, const CommandBufferDescriptor* descriptor);
         ~CommandBuffer();
 
+        // Called on submit to know how much work the command buffer holds for the simulated GPU
+        // timeline.
+        void CountSimulatedWork(uint64_t* commandCount, uint64_t* copySize);
+
       private:
         CommandIterator mCommands;
     };
@@ -18,6 +18,7 @@
 #include "dawn_native/NullBackend.h"
 
 #include "common/SwapChainUtils.h"
+#include "dawn_native/Adapter.h"
 #include "dawn_native/null/DeviceNull.h"
 
 namespace dawn_native { namespace null {
@@ -29,4 +30,19 @@ namespace dawn_native { namespace null {
         return impl;
     }
 
+    bool EnableSimulatedGPUTimeline(DawnDevice cDevice,
+                                    const SimulatedGPUTimelineDescriptor* descriptor) {
+        DeviceBase* deviceBase = reinterpret_cast<DeviceBase*>(cDevice);
+        if (deviceBase->GetAdapter()->GetBackendType() != BackendType::Null) {
+            return false;
+        }
+
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        if (device->HasSimulatedGPUTimeline()) {
+            return false;
+        }
+        device->EnableSimulatedGPUTimeline(*descriptor);
+        return true;
+    }
+
 }}  // namespace dawn_native::null
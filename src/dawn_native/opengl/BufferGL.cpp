@@ -16,6 +16,8 @@
 
 #include "dawn_native/opengl/DeviceGL.h"
 
+#include <vector>
+
 namespace dawn_native { namespace opengl {
 
     // Buffer
@@ -36,9 +38,13 @@ namespace dawn_native { namespace opengl {
     }
 
     bool Buffer::IsMapWritable() const {
-        // TODO(enga): All buffers in GL can be mapped. Investigate if mapping them will cause the
-        // driver to migrate it to shared memory.
-        return true;
+        // All buffers in GL can be mapped, but mapping one that isn't used for mapping might
+        // cause the driver to migrate it to shared memory. When the staging buffers are
+        // persistently mapped, write these buffers through one instead.
+        if (!ToBackend(GetDevice())->UsesPersistentStagingBuffers()) {
+            return true;
+        }
+        return GetUsage() & (dawn::BufferUsage::MapRead | dawn::BufferUsage::MapWrite);
     }
 
     MaybeError Buffer::MapAtCreationImpl(uint8_t** mappedPointer) {
@@ -47,49 +53,139 @@ namespace dawn_native { namespace opengl {
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
         void* data = gl.MapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
         *mappedPointer = reinterpret_cast<uint8_t*>(data);
+        mIsMapped = true;
         return {};
     }
 
     MaybeError Buffer::SetSubDataImpl(uint32_t start, uint32_t count, const void* data) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+
+        // Copying from the persistently mapped upload ring doesn't make the driver wait for the
+        // commands using the buffer, unlike glBufferSubData can.
+        if (device->UsesPersistentStagingBuffers()) {
+            return BufferBase::SetSubDataImpl(start, count, data);
+        }
 
+        const OpenGLFunctions& gl = device->gl;
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
         gl.BufferSubData(GL_ARRAY_BUFFER, start, count, data);
         return {};
     }
 
     MaybeError Buffer::MapReadAsyncImpl(uint32_t serial) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
-
-        // TODO(cwallez@chromium.org): this does GPU->CPU synchronization, we could require a high
-        // version of OpenGL that would let us map the buffer unsynchronized.
-        gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
-        void* data = gl.MapBuffer(GL_ARRAY_BUFFER, GL_READ_ONLY);
-        CallMapReadCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+        RequestMap(serial, false);
         return {};
     }
 
     MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial) {
+        RequestMap(serial, true);
+        return {};
+    }
+
+    void Buffer::RequestMap(uint32_t serial, bool isWrite) {
+        Device* device = ToBackend(GetDevice());
+
+        mHasPendingMapRequest = true;
+        mPendingMapSerial = serial;
+
+        // The commands using the buffer were all sent to GL, either at a submit or directly for
+        // SetSubData, so they are finished when a fence submitted now is passed. Submitting one
+        // also makes the request complete without waiting for the next submit.
+        device->SubmitFenceSync();
+        device->GetMapRequestTracker()->Track(this, serial, isWrite);
+    }
+
+    bool Buffer::IsPendingMapRequest(uint32_t mapSerial) const {
+        return mHasPendingMapRequest && mPendingMapSerial == mapSerial;
+    }
+
+    void Buffer::OnMapReadCommandSerialFinished(uint32_t mapSerial) {
+        if (!IsPendingMapRequest(mapSerial)) {
+            return;
+        }
+        mHasPendingMapRequest = false;
+
+        // The GPU is done with the buffer so the mapping doesn't stall.
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
+        void* data = gl.MapBufferRange(GL_ARRAY_BUFFER, 0, GetSize(), GL_MAP_READ_BIT);
+        mIsMapped = true;
+
+        CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+    }
 
-        // TODO(cwallez@chromium.org): this does GPU->CPU synchronization, we could require a high
-        // version of OpenGL that would let us map the buffer unsynchronized.
+    void Buffer::OnMapWriteCommandSerialFinished(uint32_t mapSerial) {
+        if (!IsPendingMapRequest(mapSerial)) {
+            return;
+        }
+        mHasPendingMapRequest = false;
+
+        // The GPU is done with the buffer, so the driver doesn't need to synchronize the mapping
+        // with it. The buffer isn't invalidated because its content must be preserved.
+        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
-        void* data = gl.MapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-        CallMapWriteCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
-        return {};
+        void* data = gl.MapBufferRange(GL_ARRAY_BUFFER, 0, GetSize(),
+                                       GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        mIsMapped = true;
+
+        CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
     }
 
     void Buffer::UnmapImpl() {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        mHasPendingMapRequest = false;
+        if (!mIsMapped) {
+            return;
+        }
 
+        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
         gl.BindBuffer(GL_ARRAY_BUFFER, mBuffer);
         gl.UnmapBuffer(GL_ARRAY_BUFFER);
+        mIsMapped = false;
     }
 
     void Buffer::DestroyImpl() {
+        // Deleting the buffer unmaps it.
+        mHasPendingMapRequest = false;
+        mIsMapped = false;
+
         ToBackend(GetDevice())->gl.DeleteBuffers(1, &mBuffer);
         mBuffer = 0;
     }
 
+    // MapRequestTracker
+
+    MapRequestTracker::MapRequestTracker(Device* device) : mDevice(device) {
+    }
+
+    MapRequestTracker::~MapRequestTracker() {
+        ASSERT(mInflightRequests.Empty());
+    }
+
+    void MapRequestTracker::Track(Buffer* buffer, uint32_t mapSerial, bool isWrite) {
+        Request request;
+        request.buffer = buffer;
+        request.mapSerial = mapSerial;
+        request.isWrite = isWrite;
+
+        mInflightRequests.Enqueue(std::move(request), mDevice->GetLastSubmittedCommandSerial());
+    }
+
+    void MapRequestTracker::Tick(Serial finishedSerial) {
+        // The callbacks can make new map requests, so the finished requests are removed from the
+        // queue before the callbacks are called.
+        std::vector<Request> finishedRequests;
+        for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
+            finishedRequests.push_back(std::move(request));
+        }
+        mInflightRequests.ClearUpTo(finishedSerial);
+
+        for (Request& request : finishedRequests) {
+            if (request.isWrite) {
+                request.buffer->OnMapWriteCommandSerialFinished(request.mapSerial);
+            } else {
+                request.buffer->OnMapReadCommandSerialFinished(request.mapSerial);
+            }
+        }
+    }
+
 }}  // namespace dawn_native::opengl
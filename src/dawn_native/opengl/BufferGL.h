@@ -17,6 +17,7 @@
 
 #include "dawn_native/Buffer.h"
 
+#include "common/SerialQueue.h"
 #include "dawn_native/opengl/opengl_platform.h"
 
 namespace dawn_native { namespace opengl {
@@ -30,6 +31,9 @@ namespace dawn_native { namespace opengl {
 
         GLuint GetHandle() const;
 
+        void OnMapReadCommandSerialFinished(uint32_t mapSerial);
+        void OnMapWriteCommandSerialFinished(uint32_t mapSerial);
+
       private:
         // Dawn API
         MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data) override;
@@ -41,7 +45,37 @@ namespace dawn_native { namespace opengl {
         bool IsMapWritable() const override;
         MaybeError MapAtCreationImpl(uint8_t** mappedPointer) override;
 
+        void RequestMap(uint32_t serial, bool isWrite);
+        bool IsPendingMapRequest(uint32_t mapSerial) const;
+
         GLuint mBuffer = 0;
+        bool mIsMapped = false;
+
+        // The map request waiting for the GPU to be done with the buffer, if any. Unmapping or
+        // destroying the buffer cancels it.
+        bool mHasPendingMapRequest = false;
+        uint32_t mPendingMapSerial = 0;
+    };
+
+    // Mapping a buffer in GL stalls the CPU until the GPU is done with the buffer, so the map
+    // requests are only completed once the commands submitted before them are finished.
+    class MapRequestTracker {
+      public:
+        MapRequestTracker(Device* device);
+        ~MapRequestTracker();
+
+        void Track(Buffer* buffer, uint32_t mapSerial, bool isWrite);
+        void Tick(Serial finishedSerial);
+
+      private:
+        Device* mDevice;
+
+        struct Request {
+            Ref<Buffer> buffer;
+            uint32_t mapSerial;
+            bool isWrite;
+        };
+        SerialQueue<Request> mInflightRequests;
     };
 
 }}  // namespace dawn_native::opengl
@@ -23,6 +23,7 @@
 #include "dawn_native/opengl/ComputePipelineGL.h"
 #include "dawn_native/opengl/DeviceGL.h"
 #include "dawn_native/opengl/Forward.h"
+#include "dawn_native/opengl/FramebufferCache.h"
 #include "dawn_native/opengl/PersistentPipelineStateGL.h"
 #include "dawn_native/opengl/PipelineLayoutGL.h"
 #include "dawn_native/opengl/RenderPipelineGL.h"
@@ -47,96 +48,19 @@ namespace dawn_native { namespace opengl {
             }
         }
 
-        GLenum VertexFormatType(dawn::VertexFormat format) {
-            switch (format) {
-                case dawn::VertexFormat::UChar2:
-                case dawn::VertexFormat::UChar4:
-                case dawn::VertexFormat::UChar2Norm:
-                case dawn::VertexFormat::UChar4Norm:
-                    return GL_UNSIGNED_BYTE;
-                case dawn::VertexFormat::Char2:
-                case dawn::VertexFormat::Char4:
-                case dawn::VertexFormat::Char2Norm:
-                case dawn::VertexFormat::Char4Norm:
-                    return GL_BYTE;
-                case dawn::VertexFormat::UShort2:
-                case dawn::VertexFormat::UShort4:
-                case dawn::VertexFormat::UShort2Norm:
-                case dawn::VertexFormat::UShort4Norm:
-                    return GL_UNSIGNED_SHORT;
-                case dawn::VertexFormat::Short2:
-                case dawn::VertexFormat::Short4:
-                case dawn::VertexFormat::Short2Norm:
-                case dawn::VertexFormat::Short4Norm:
-                    return GL_SHORT;
-                case dawn::VertexFormat::Half2:
-                case dawn::VertexFormat::Half4:
-                    return GL_HALF_FLOAT;
-                case dawn::VertexFormat::Float:
-                case dawn::VertexFormat::Float2:
-                case dawn::VertexFormat::Float3:
-                case dawn::VertexFormat::Float4:
-                    return GL_FLOAT;
-                case dawn::VertexFormat::UInt:
-                case dawn::VertexFormat::UInt2:
-                case dawn::VertexFormat::UInt3:
-                case dawn::VertexFormat::UInt4:
-                    return GL_UNSIGNED_INT;
-                case dawn::VertexFormat::Int:
-                case dawn::VertexFormat::Int2:
-                case dawn::VertexFormat::Int3:
-                case dawn::VertexFormat::Int4:
-                    return GL_INT;
-                default:
-                    UNREACHABLE();
-            }
-        }
-
-        GLboolean VertexFormatIsNormalized(dawn::VertexFormat format) {
-            switch (format) {
-                case dawn::VertexFormat::UChar2Norm:
-                case dawn::VertexFormat::UChar4Norm:
-                case dawn::VertexFormat::Char2Norm:
-                case dawn::VertexFormat::Char4Norm:
-                case dawn::VertexFormat::UShort2Norm:
-                case dawn::VertexFormat::UShort4Norm:
-                case dawn::VertexFormat::Short2Norm:
-                case dawn::VertexFormat::Short4Norm:
-                    return GL_TRUE;
-                default:
-                    return GL_FALSE;
-            }
-        }
-
-        bool VertexFormatIsInt(dawn::VertexFormat format) {
-            switch (format) {
-                case dawn::VertexFormat::UChar2:
-                case dawn::VertexFormat::UChar4:
-                case dawn::VertexFormat::Char2:
-                case dawn::VertexFormat::Char4:
-                case dawn::VertexFormat::UShort2:
-                case dawn::VertexFormat::UShort4:
-                case dawn::VertexFormat::Short2:
-                case dawn::VertexFormat::Short4:
-                case dawn::VertexFormat::UInt:
-                case dawn::VertexFormat::UInt2:
-                case dawn::VertexFormat::UInt3:
-                case dawn::VertexFormat::UInt4:
-                case dawn::VertexFormat::Int:
-                case dawn::VertexFormat::Int2:
-                case dawn::VertexFormat::Int3:
-                case dawn::VertexFormat::Int4:
-                    return true;
-                default:
-                    return false;
-            }
-        }
-
         // Vertex buffers and index buffers are implemented as part of an OpenGL VAO that
         // corresponds to an VertexInput. On the contrary in Dawn they are part of the global state.
         // This means that we have to re-apply these buffers on an VertexInput change.
+        //
+        // With vertex attrib binding, the attribute formats are set once in the VAO and a vertex
+        // buffer is applied with a single glBindVertexBuffer. Otherwise all the attributes using
+        // the buffer are specified again with glVertexAttribPointer.
         class InputBufferTracker {
           public:
+            explicit InputBufferTracker(bool useVertexAttribBinding)
+                : mUseVertexAttribBinding(useVertexAttribBinding) {
+            }
+
             void OnSetIndexBuffer(BufferBase* buffer) {
                 mIndexBufferDirty = true;
                 mIndexBuffer = ToBackend(buffer);
@@ -170,6 +94,14 @@ namespace dawn_native { namespace opengl {
 
                 for (uint32_t slot :
                      IterateBitSet(mDirtyVertexBuffers & mLastPipeline->GetInputsSetMask())) {
+                    if (mUseVertexAttribBinding) {
+                        GLsizei stride = static_cast<GLsizei>(mLastPipeline->GetInput(slot).stride);
+                        gl.BindVertexBuffer(slot, mVertexBuffers[slot]->GetHandle(),
+                                            static_cast<GLintptr>(mVertexBufferOffsets[slot]),
+                                            stride);
+                        continue;
+                    }
+
                     for (uint32_t location :
                          IterateBitSet(mLastPipeline->GetAttributesUsingInput(slot))) {
                         auto attribute = mLastPipeline->GetAttribute(location);
@@ -200,6 +132,8 @@ namespace dawn_native { namespace opengl {
             }
 
           private:
+            bool mUseVertexAttribBinding;
+
             bool mIndexBufferDirty = false;
             Buffer* mIndexBuffer = nullptr;
 
@@ -691,79 +625,32 @@ namespace dawn_native { namespace opengl {
     }
 
     void CommandBuffer::ExecuteRenderPass(BeginRenderPassCmd* renderPass) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
-        GLuint fbo = 0;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
 
-        // Create the framebuffer used for this render pass and calls the correct glDrawBuffers
+        // Bind the framebuffer used for this render pass, which also has the correct draw buffers.
         {
             // TODO(kainino@chromium.org): This is added to possibly work around an issue seen on
             // Windows/Intel. It should break any feedback loop before the clears, even if there
             // shouldn't be any negative effects from this. Investigate whether it's actually
             // needed.
             gl.BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-            // TODO(kainino@chromium.org): possible future optimization: create these framebuffers
-            // at Framebuffer build time (or maybe CommandBuffer build time) so they don't have to
-            // be created and destroyed at draw time.
-            gl.GenFramebuffers(1, &fbo);
-            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
 
-            // Mapping from attachmentSlot to GL framebuffer attachment points. Defaults to zero
-            // (GL_NONE).
-            std::array<GLenum, kMaxColorAttachments> drawBuffers = {};
-
-            // Construct GL framebuffer
-
-            unsigned int attachmentCount = 0;
+            FramebufferCacheQuery query;
             for (uint32_t i :
                  IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                 TextureViewBase* textureView = renderPass->colorAttachments[i].view.Get();
-                GLuint texture = ToBackend(textureView->GetTexture())->GetHandle();
-
-                // Attach color buffers.
-                if (textureView->GetTexture()->GetArrayLayers() == 1) {
-                    GLenum target = ToBackend(textureView->GetTexture())->GetGLTarget();
-                    gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, target,
-                                            texture, textureView->GetBaseMipLevel());
-                } else {
-                    gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
-                                               texture, textureView->GetBaseMipLevel(),
-                                               textureView->GetBaseArrayLayer());
-                }
-                drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
-                attachmentCount = i + 1;
+                query.SetColor(i, ToBackend(textureView->GetTexture()),
+                               textureView->GetBaseMipLevel(), textureView->GetBaseArrayLayer());
             }
-            gl.DrawBuffers(attachmentCount, drawBuffers.data());
-
             if (renderPass->attachmentState->HasDepthStencilAttachment()) {
                 TextureViewBase* textureView = renderPass->depthStencilAttachment.view.Get();
-                GLuint texture = ToBackend(textureView->GetTexture())->GetHandle();
-                const Format& format = textureView->GetTexture()->GetFormat();
-
-                // Attach depth/stencil buffer.
-                GLenum glAttachment = 0;
-                // TODO(kainino@chromium.org): it may be valid to just always use
-                // GL_DEPTH_STENCIL_ATTACHMENT here.
-                switch (format.aspect) {
-                    case Format::Aspect::Depth:
-                        glAttachment = GL_DEPTH_ATTACHMENT;
-                        break;
-                    case Format::Aspect::Stencil:
-                        glAttachment = GL_STENCIL_ATTACHMENT;
-                        break;
-                    case Format::Aspect::DepthStencil:
-                        glAttachment = GL_DEPTH_STENCIL_ATTACHMENT;
-                        break;
-                    default:
-                        UNREACHABLE();
-                        break;
-                }
-
-                GLenum target = ToBackend(textureView->GetTexture())->GetGLTarget();
-                gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment, target, texture, 0);
+                query.SetDepthStencil(ToBackend(textureView->GetTexture()));
             }
-        }
 
-        ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+            GLuint fbo = device->GetFramebufferCache()->GetFramebuffer(query);
+            gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+        }
 
         // Set defaults for dynamic state before executing clears and commands.
         PersistentPipelineState persistentPipelineState;
@@ -855,7 +742,7 @@ namespace dawn_native { namespace opengl {
         RenderPipeline* lastPipeline = nullptr;
         uint64_t indexBufferBaseOffset = 0;
 
-        InputBufferTracker inputBuffers;
+        InputBufferTracker inputBuffers(device->UsesVertexAttribBinding());
         BindGroupTracker bindGroupTracker = {};
 
         auto DoRenderBundleCommand = [&](CommandIterator* iter, Command type) {
@@ -988,7 +875,6 @@ namespace dawn_native { namespace opengl {
                     if (renderPass->attachmentState->GetSampleCount() > 1) {
                         ResolveMultisampledRenderTargets(gl, renderPass);
                     }
-                    gl.DeleteFramebuffers(1, &fbo);
                     return;
                 } break;
 
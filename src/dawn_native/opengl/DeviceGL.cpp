@@ -21,13 +21,17 @@
 #include "dawn_native/opengl/BufferGL.h"
 #include "dawn_native/opengl/CommandBufferGL.h"
 #include "dawn_native/opengl/ComputePipelineGL.h"
+#include "dawn_native/opengl/FramebufferCache.h"
+#include "dawn_native/opengl/PipelineGL.h"
 #include "dawn_native/opengl/PipelineLayoutGL.h"
 #include "dawn_native/opengl/QueueGL.h"
 #include "dawn_native/opengl/RenderPipelineGL.h"
 #include "dawn_native/opengl/SamplerGL.h"
 #include "dawn_native/opengl/ShaderModuleGL.h"
+#include "dawn_native/opengl/StagingBufferGL.h"
 #include "dawn_native/opengl/SwapChainGL.h"
 #include "dawn_native/opengl/TextureGL.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace opengl {
 
@@ -38,21 +42,49 @@ namespace dawn_native { namespace opengl {
         if (descriptor != nullptr) {
             ApplyToggleOverrides(descriptor);
         }
+        gl.AddDeviceToStateTracker(GetCounters(),
+                                   IsToggleEnabled(Toggle::FilterRedundantGLStateCalls));
         mFormatTable = BuildGLFormatTable();
+        mUsesPersistentStagingBuffers = gl.IsAtLeastGL(4, 4);
+        mUsesVertexAttribBinding = gl.IsAtLeastGL(4, 3) || gl.IsAtLeastGLES(3, 1);
+        mUsesParallelShaderCompile = gl.IsGLExtensionSupported("GL_KHR_parallel_shader_compile") ||
+                                     gl.IsGLExtensionSupported("GL_ARB_parallel_shader_compile");
+        mFramebufferCache = std::make_unique<FramebufferCache>(this);
+        mMapRequestTracker = std::make_unique<MapRequestTracker>(this);
+
+        if (IsToggleEnabled(Toggle::AsyncGLShaderCompilation)) {
+            mWorkerPool = std::make_unique<WorkerPool>(WorkerPool::GetDefaultThreadCount());
+
+            // Let the driver use as many threads as it wants to compile and link.
+            if (gl.MaxShaderCompilerThreadsKHR != nullptr) {
+                gl.MaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            }
+        }
     }
 
     Device::~Device() {
+        // Wait for the GPU so that all the fences are passed.
+        gl.Finish();
         CheckPassedFences();
         ASSERT(mFencesInFlight.empty());
 
         // Some operations might have been started since the last submit and waiting
         // on a serial that doesn't have a corresponding fence enqueued. Force all
         // operations to look as if they were completed (because they were).
+        mHasPendingUploads = false;
         mCompletedSerial = mLastSubmittedSerial + 1;
 
+        Tick();
+
         mDynamicUploader = nullptr;
+        mFramebufferCache = nullptr;
+        mMapRequestTracker = nullptr;
 
-        Tick();
+        ASSERT(mPendingLinks.empty());
+        mWorkerPool = nullptr;
+
+        // The calls made after this point, when the base device is destroyed, aren't counted.
+        gl.RemoveDeviceFromStateTracker();
     }
 
     const GLFormat& Device::GetGLFormat(const Format& format) {
@@ -64,6 +96,39 @@ namespace dawn_native { namespace opengl {
         return result;
     }
 
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
+    }
+
+    MapRequestTracker* Device::GetMapRequestTracker() const {
+        return mMapRequestTracker.get();
+    }
+
+    WorkerPool* Device::GetWorkerPool() const {
+        return mWorkerPool.get();
+    }
+
+    void Device::AddPendingLink(PipelineGL* pipeline) {
+        mPendingLinks.insert(pipeline);
+    }
+
+    void Device::RemovePendingLink(PipelineGL* pipeline) {
+        ASSERT(mPendingLinks.count(pipeline) != 0);
+        mPendingLinks.erase(pipeline);
+    }
+
+    void Device::FinishCompletedLinks() {
+        for (auto it = mPendingLinks.begin(); it != mPendingLinks.end();) {
+            PipelineGL* pipeline = *it;
+            if (!pipeline->IsLinkCompleted(gl)) {
+                ++it;
+                continue;
+            }
+            pipeline->FinishLink(gl);
+            it = mPendingLinks.erase(it);
+        }
+    }
+
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
         return new BindGroup(this, descriptor);
@@ -114,10 +179,33 @@ namespace dawn_native { namespace opengl {
         return new TextureView(texture, descriptor);
     }
 
+    bool Device::UsesPersistentStagingBuffers() const {
+        return mUsesPersistentStagingBuffers;
+    }
+
+    bool Device::UsesVertexAttribBinding() const {
+        return mUsesVertexAttribBinding;
+    }
+
+    bool Device::UsesParallelShaderCompile() const {
+        return mUsesParallelShaderCompile;
+    }
+
+    void Device::TrackPendingUploads() {
+        mHasPendingUploads = true;
+    }
+
     void Device::SubmitFenceSync() {
+        // The fence covers all the commands issued so far, including the uploads.
+        mHasPendingUploads = false;
+
         GLsync sync = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
         mLastSubmittedSerial++;
         mFencesInFlight.emplace(sync, mLastSubmittedSerial);
+
+        // The end is recorded when the sync is seen as signaled by CheckPassedFences.
+        TRACE_EVENT_ASYNC_BEGIN0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                 "DeviceGL::SubmitFenceSync", mLastSubmittedSerial);
     }
 
     Serial Device::GetCompletedCommandSerial() const {
@@ -133,7 +221,16 @@ namespace dawn_native { namespace opengl {
     }
 
     MaybeError Device::TickImpl() {
+        // Uploads done outside of a submit, like SetSubData, need a fence for the uploader to
+        // know when their part of the ring buffer can be reused.
+        if (mHasPendingUploads) {
+            SubmitFenceSync();
+        }
+
         CheckPassedFences();
+        FinishCompletedLinks();
+        mDynamicUploader->Deallocate(mCompletedSerial);
+        mMapRequestTracker->Tick(mCompletedSerial);
         return {};
     }
 
@@ -146,20 +243,26 @@ namespace dawn_native { namespace opengl {
             // as we see one that's not ready.
             GLenum result = gl.ClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
             if (result == GL_TIMEOUT_EXPIRED) {
-                continue;
+                return;
             }
 
             gl.DeleteSync(sync);
 
             mFencesInFlight.pop();
 
+            TRACE_EVENT_ASYNC_END0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                   "DeviceGL::SubmitFenceSync", fenceSerial);
+
             ASSERT(fenceSerial > mCompletedSerial);
             mCompletedSerial = fenceSerial;
         }
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
-        return DAWN_UNIMPLEMENTED_ERROR("Device unable to create staging buffer.");
+        std::unique_ptr<StagingBufferBase> stagingBuffer =
+            std::make_unique<StagingBuffer>(size, this);
+        DAWN_TRY(stagingBuffer->Initialize());
+        return std::move(stagingBuffer);
     }
 
     MaybeError Device::CopyFromStagingToBuffer(StagingBufferBase* source,
@@ -167,7 +270,23 @@ namespace dawn_native { namespace opengl {
                                                BufferBase* destination,
                                                uint64_t destinationOffset,
                                                uint64_t size) {
-        return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
+        StagingBuffer* staging = ToBackend(source);
+        GLuint buffer = ToBackend(destination)->GetHandle();
+
+        if (staging->GetHandle() != 0) {
+            gl.BindBuffer(GL_COPY_READ_BUFFER, staging->GetHandle());
+            gl.BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            gl.CopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset,
+                                 destinationOffset, size);
+        } else {
+            // GL copies the data out of CPU memory before glBufferSubData returns.
+            const uint8_t* data = static_cast<const uint8_t*>(staging->GetMappedPointer());
+            gl.BindBuffer(GL_ARRAY_BUFFER, buffer);
+            gl.BufferSubData(GL_ARRAY_BUFFER, destinationOffset, size, data + sourceOffset);
+        }
+
+        TrackPendingUploads();
+        return {};
     }
 
 }}  // namespace dawn_native::opengl
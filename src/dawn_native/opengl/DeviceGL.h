@@ -19,11 +19,14 @@
 
 #include "common/Platform.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/WorkerPool.h"
 #include "dawn_native/opengl/Forward.h"
 #include "dawn_native/opengl/GLFormat.h"
 #include "dawn_native/opengl/OpenGLFunctions.h"
 
+#include <memory>
 #include <queue>
+#include <set>
 
 // Remove windows.h macros after glad's include of windows.h
 #if defined(DAWN_PLATFORM_WINDOWS)
@@ -32,6 +35,10 @@
 
 namespace dawn_native { namespace opengl {
 
+    class FramebufferCache;
+    class MapRequestTracker;
+    class PipelineGL;
+
     class Device : public DeviceBase {
       public:
         Device(AdapterBase* adapter,
@@ -43,9 +50,26 @@ namespace dawn_native { namespace opengl {
         const OpenGLFunctions gl;
 
         const GLFormat& GetGLFormat(const Format& format);
+        FramebufferCache* GetFramebufferCache() const;
+        MapRequestTracker* GetMapRequestTracker() const;
+        // The pool that translates shaders, nullptr unless async_gl_shader_compilation is enabled.
+        WorkerPool* GetWorkerPool() const;
+
+        // The pipelines whose program link isn't finished yet. Each tick finishes the links
+        // that the driver completed.
+        void AddPendingLink(PipelineGL* pipeline);
+        void RemovePendingLink(PipelineGL* pipeline);
 
         void SubmitFenceSync();
 
+        // Whether the staging buffers are persistently mapped GL buffers instead of CPU memory,
+        // which requires glBufferStorage.
+        bool UsesPersistentStagingBuffers() const;
+        // Whether vertex buffers are bound with glBindVertexBuffer, which requires
+        // ARB_vertex_attrib_binding.
+        bool UsesVertexAttribBinding() const;
+        bool UsesParallelShaderCompile() const;
+
         // Dawn API
         CommandBufferBase* CreateCommandBuffer(CommandEncoderBase* encoder,
                                                const CommandBufferDescriptor* descriptor) override;
@@ -62,6 +86,10 @@ namespace dawn_native { namespace opengl {
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
 
+        // Records that GL commands reading from the upload ring were issued, so that the next
+        // tick submits a fence for them if no submit does it first.
+        void TrackPendingUploads();
+
       private:
         ResultOrError<BindGroupBase*> CreateBindGroupImpl(
             const BindGroupDescriptor* descriptor) override;
@@ -86,12 +114,22 @@ namespace dawn_native { namespace opengl {
             const TextureViewDescriptor* descriptor) override;
 
         void CheckPassedFences();
+        void FinishCompletedLinks();
 
         Serial mCompletedSerial = 0;
         Serial mLastSubmittedSerial = 0;
         std::queue<std::pair<GLsync, Serial>> mFencesInFlight;
+        bool mHasPendingUploads = false;
+        bool mUsesPersistentStagingBuffers = false;
+        bool mUsesVertexAttribBinding = false;
+        bool mUsesParallelShaderCompile = false;
 
         GLFormatTable mFormatTable;
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
+        std::unique_ptr<MapRequestTracker> mMapRequestTracker;
+
+        std::unique_ptr<WorkerPool> mWorkerPool;
+        std::set<PipelineGL*> mPendingLinks;
     };
 
 }}  // namespace dawn_native::opengl
@@ -0,0 +1,186 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dawn_native/opengl/FramebufferCache.h"
+
+#include "common/BitSetIterator.h"
+#include "common/HashUtils.h"
+#include "dawn_native/opengl/DeviceGL.h"
+#include "dawn_native/opengl/TextureGL.h"
+
+namespace dawn_native { namespace opengl {
+
+    // FramebufferCacheQuery
+
+    void FramebufferCacheQuery::SetColor(uint32_t index,
+                                         Texture* texture,
+                                         uint32_t mipLevel,
+                                         uint32_t arrayLayer) {
+        colorMask.set(index);
+        colorTextures[index] = texture;
+        colorMipLevels[index] = mipLevel;
+        colorArrayLayers[index] = arrayLayer;
+    }
+
+    void FramebufferCacheQuery::SetDepthStencil(Texture* texture) {
+        hasDepthStencil = true;
+        depthStencilTexture = texture;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(Device* device) : mDevice(device) {
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        for (auto it : mCache) {
+            mDevice->gl.DeleteFramebuffers(1, &it.second);
+        }
+        mCache.clear();
+    }
+
+    GLuint FramebufferCache::GetFramebuffer(const FramebufferCacheQuery& query) {
+        auto it = mCache.find(query);
+        if (it != mCache.end()) {
+            return it->second;
+        }
+
+        GLuint framebuffer = CreateFramebufferForQuery(query);
+        mCache.emplace(query, framebuffer);
+        return framebuffer;
+    }
+
+    void FramebufferCache::OnTextureDestroyed(const Texture* texture) {
+        for (auto it = mCache.begin(); it != mCache.end();) {
+            const FramebufferCacheQuery& query = it->first;
+
+            bool usesTexture = query.hasDepthStencil && query.depthStencilTexture == texture;
+            for (uint32_t i : IterateBitSet(query.colorMask)) {
+                usesTexture = usesTexture || query.colorTextures[i] == texture;
+            }
+
+            if (usesTexture) {
+                mDevice->gl.DeleteFramebuffers(1, &it->second);
+                it = mCache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    GLuint FramebufferCache::CreateFramebufferForQuery(const FramebufferCacheQuery& query) const {
+        const OpenGLFunctions& gl = mDevice->gl;
+
+        GLuint framebuffer = 0;
+        gl.GenFramebuffers(1, &framebuffer);
+        gl.BindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+
+        // Mapping from attachmentSlot to GL framebuffer attachment points. Defaults to zero
+        // (GL_NONE).
+        std::array<GLenum, kMaxColorAttachments> drawBuffers = {};
+
+        unsigned int attachmentCount = 0;
+        for (uint32_t i : IterateBitSet(query.colorMask)) {
+            Texture* texture = query.colorTextures[i];
+
+            // Attach color buffers.
+            if (texture->GetArrayLayers() == 1) {
+                gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
+                                        texture->GetGLTarget(), texture->GetHandle(),
+                                        query.colorMipLevels[i]);
+            } else {
+                gl.FramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i,
+                                           texture->GetHandle(), query.colorMipLevels[i],
+                                           query.colorArrayLayers[i]);
+            }
+            drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+            attachmentCount = i + 1;
+        }
+        gl.DrawBuffers(attachmentCount, drawBuffers.data());
+
+        if (query.hasDepthStencil) {
+            Texture* texture = query.depthStencilTexture;
+            const Format& format = texture->GetFormat();
+
+            // Attach depth/stencil buffer.
+            GLenum glAttachment = 0;
+            // TODO(kainino@chromium.org): it may be valid to just always use
+            // GL_DEPTH_STENCIL_ATTACHMENT here.
+            switch (format.aspect) {
+                case Format::Aspect::Depth:
+                    glAttachment = GL_DEPTH_ATTACHMENT;
+                    break;
+                case Format::Aspect::Stencil:
+                    glAttachment = GL_STENCIL_ATTACHMENT;
+                    break;
+                case Format::Aspect::DepthStencil:
+                    glAttachment = GL_DEPTH_STENCIL_ATTACHMENT;
+                    break;
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+
+            gl.FramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment, texture->GetGLTarget(),
+                                    texture->GetHandle(), 0);
+        }
+
+        ASSERT(gl.CheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+
+        return framebuffer;
+    }
+
+    size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+        size_t hash = Hash(query.colorMask);
+
+        for (uint32_t i : IterateBitSet(query.colorMask)) {
+            HashCombine(&hash, query.colorTextures[i], query.colorMipLevels[i],
+                        query.colorArrayLayers[i]);
+        }
+
+        HashCombine(&hash, query.hasDepthStencil);
+        if (query.hasDepthStencil) {
+            HashCombine(&hash, query.depthStencilTexture);
+        }
+
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                                  const FramebufferCacheQuery& b) const {
+        if (a.colorMask != b.colorMask) {
+            return false;
+        }
+
+        for (uint32_t i : IterateBitSet(a.colorMask)) {
+            if ((a.colorTextures[i] != b.colorTextures[i]) ||
+                (a.colorMipLevels[i] != b.colorMipLevels[i]) ||
+                (a.colorArrayLayers[i] != b.colorArrayLayers[i])) {
+                return false;
+            }
+        }
+
+        if (a.hasDepthStencil != b.hasDepthStencil) {
+            return false;
+        }
+
+        if (a.hasDepthStencil && a.depthStencilTexture != b.depthStencilTexture) {
+            return false;
+        }
+
+        return true;
+    }
+
+}}  // namespace dawn_native::opengl
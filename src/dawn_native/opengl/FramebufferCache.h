@@ -0,0 +1,82 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_OPENGL_FRAMEBUFFERCACHE_H_
+#define DAWNNATIVE_OPENGL_FRAMEBUFFERCACHE_H_
+
+#include "common/Constants.h"
+#include "dawn_native/opengl/opengl_platform.h"
+
+#include <array>
+#include <bitset>
+#include <unordered_map>
+
+namespace dawn_native { namespace opengl {
+
+    class Device;
+    class Texture;
+
+    // This is a key to query the FramebufferCache. Like RenderPassCacheQuery in the Vulkan
+    // backend, it is sparse and only the attachments set in colorMask or hasDepthStencil need to
+    // be initialized.
+    struct FramebufferCacheQuery {
+        void SetColor(uint32_t index, Texture* texture, uint32_t mipLevel, uint32_t arrayLayer);
+        void SetDepthStencil(Texture* texture);
+
+        std::bitset<kMaxColorAttachments> colorMask;
+        std::array<Texture*, kMaxColorAttachments> colorTextures;
+        std::array<uint32_t, kMaxColorAttachments> colorMipLevels;
+        std::array<uint32_t, kMaxColorAttachments> colorArrayLayers;
+
+        bool hasDepthStencil = false;
+        Texture* depthStencilTexture;
+    };
+
+    // Caches the framebuffer objects of render passes so that render passes to the same
+    // attachments reuse a complete framebuffer instead of creating, validating and deleting one
+    // each time. The framebuffers are keyed by the textures attached to them, and are deleted
+    // when one of these textures is destroyed so that a texture allocated at the same address
+    // can't be attached through a stale framebuffer. Texture views don't need to invalidate the
+    // cache because only the texture, mip level and array layer they select are attached.
+    class FramebufferCache {
+      public:
+        FramebufferCache(Device* device);
+        ~FramebufferCache();
+
+        // Returns a complete framebuffer with the attachments of |query|, and its draw buffers
+        // set for the color attachments.
+        GLuint GetFramebuffer(const FramebufferCacheQuery& query);
+
+        void OnTextureDestroyed(const Texture* texture);
+
+      private:
+        // Does the actual framebuffer creation on a cache miss.
+        GLuint CreateFramebufferForQuery(const FramebufferCacheQuery& query) const;
+
+        // Implements the functors necessary for to use FramebufferCacheQueries as unordered_map
+        // keys.
+        struct CacheFuncs {
+            size_t operator()(const FramebufferCacheQuery& query) const;
+            bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+        };
+        using Cache = std::unordered_map<FramebufferCacheQuery, GLuint, CacheFuncs, CacheFuncs>;
+
+        Device* mDevice = nullptr;
+        Cache mCache;
+    };
+
+}}  // namespace dawn_native::opengl
+
+#endif  // DAWNNATIVE_OPENGL_FRAMEBUFFERCACHE_H_
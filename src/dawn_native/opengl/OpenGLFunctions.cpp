@@ -54,7 +54,14 @@ namespace dawn_native { namespace opengl {
             DAWN_TRY(LoadDesktopGLProcs(getProc, mMajorVersion, mMinorVersion));
         }
 
+        // The extension procs can only be loaded once the extensions are known, which needs the
+        // core procs.
         InitializeSupportedGLExtensions();
+        if (mStandard == Standard::ES) {
+            DAWN_TRY(LoadOpenGLESExtensionProcs(getProc, mSupportedGLExtensionsSet));
+        } else {
+            DAWN_TRY(LoadDesktopGLExtensionProcs(getProc, mSupportedGLExtensionsSet));
+        }
 
         return {};
     }
@@ -74,12 +81,21 @@ namespace dawn_native { namespace opengl {
         return mSupportedGLExtensionsSet.count(extension) != 0;
     }
 
-    bool OpenGLFunctions::IsAtLeastGL(uint32_t majorVersion, uint32_t minorVersion) {
+    void OpenGLFunctions::AddDeviceToStateTracker(DeviceCounters* counters,
+                                                  bool filterRedundantCalls) const {
+        mStateTracker->AddDevice(counters, filterRedundantCalls);
+    }
+
+    void OpenGLFunctions::RemoveDeviceFromStateTracker() const {
+        mStateTracker->RemoveDevice();
+    }
+
+    bool OpenGLFunctions::IsAtLeastGL(uint32_t majorVersion, uint32_t minorVersion) const {
         return mStandard == Standard::Desktop &&
                std::tie(mMajorVersion, mMinorVersion) >= std::tie(majorVersion, minorVersion);
     }
 
-    bool OpenGLFunctions::IsAtLeastGLES(uint32_t majorVersion, uint32_t minorVersion) {
+    bool OpenGLFunctions::IsAtLeastGLES(uint32_t majorVersion, uint32_t minorVersion) const {
         return mStandard == Standard::ES &&
                std::tie(mMajorVersion, mMinorVersion) >= std::tie(majorVersion, minorVersion);
     }
@@ -25,11 +25,16 @@ namespace dawn_native { namespace opengl {
       public:
         MaybeError Initialize(GetProcAddress getProc);
 
-        bool IsAtLeastGL(uint32_t majorVersion, uint32_t minorVersion);
-        bool IsAtLeastGLES(uint32_t majorVersion, uint32_t minorVersion);
+        bool IsAtLeastGL(uint32_t majorVersion, uint32_t minorVersion) const;
+        bool IsAtLeastGLES(uint32_t majorVersion, uint32_t minorVersion) const;
 
         bool IsGLExtensionSupported(const char* extension) const;
 
+        // Register the devices using the context with the state tracker, which filters the
+        // redundant calls that set state while a single device is alive, see OpenGLStateTracker.
+        void AddDeviceToStateTracker(DeviceCounters* counters, bool filterRedundantCalls) const;
+        void RemoveDeviceFromStateTracker() const;
+
       private:
         void InitializeSupportedGLExtensions();
 
@@ -0,0 +1,535 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/opengl/OpenGLStateTracker.h"
+
+#include "dawn_native/DeviceStatistics.h"
+
+namespace dawn_native { namespace opengl {
+
+    namespace {
+
+        // The index used for the targets, units and caps that aren't tracked.
+        constexpr uint32_t kUntracked = 0xFFFFFFFF;
+
+        uint32_t BufferTargetIndex(GLenum target) {
+            switch (target) {
+                case GL_ARRAY_BUFFER:
+                    return 0;
+                case GL_ELEMENT_ARRAY_BUFFER:
+                    return 1;
+                case GL_UNIFORM_BUFFER:
+                    return 2;
+                case GL_SHADER_STORAGE_BUFFER:
+                    return 3;
+                case GL_PIXEL_PACK_BUFFER:
+                    return 4;
+                case GL_PIXEL_UNPACK_BUFFER:
+                    return 5;
+                case GL_COPY_READ_BUFFER:
+                    return 6;
+                case GL_COPY_WRITE_BUFFER:
+                    return 7;
+                case GL_DRAW_INDIRECT_BUFFER:
+                    return 8;
+                case GL_DISPATCH_INDIRECT_BUFFER:
+                    return 9;
+                case GL_TRANSFORM_FEEDBACK_BUFFER:
+                    return 10;
+                case GL_ATOMIC_COUNTER_BUFFER:
+                    return 11;
+                case GL_TEXTURE_BUFFER:
+                    return 12;
+                case GL_QUERY_BUFFER:
+                    return 13;
+                default:
+                    return kUntracked;
+            }
+        }
+
+        uint32_t IndexedBufferTargetIndex(GLenum target) {
+            switch (target) {
+                case GL_UNIFORM_BUFFER:
+                    return 0;
+                case GL_SHADER_STORAGE_BUFFER:
+                    return 1;
+                default:
+                    return kUntracked;
+            }
+        }
+
+        uint32_t TextureTargetIndex(GLenum target) {
+            switch (target) {
+                case GL_TEXTURE_1D:
+                    return 0;
+                case GL_TEXTURE_2D:
+                    return 1;
+                case GL_TEXTURE_2D_ARRAY:
+                    return 2;
+                case GL_TEXTURE_2D_MULTISAMPLE:
+                    return 3;
+                case GL_TEXTURE_3D:
+                    return 4;
+                case GL_TEXTURE_CUBE_MAP:
+                    return 5;
+                case GL_TEXTURE_CUBE_MAP_ARRAY:
+                    return 6;
+                case GL_TEXTURE_BUFFER:
+                    return 7;
+                default:
+                    return kUntracked;
+            }
+        }
+
+        uint32_t CapIndex(GLenum cap) {
+            switch (cap) {
+                case GL_BLEND:
+                    return 0;
+                case GL_CULL_FACE:
+                    return 1;
+                case GL_DEPTH_TEST:
+                    return 2;
+                case GL_STENCIL_TEST:
+                    return 3;
+                case GL_SCISSOR_TEST:
+                    return 4;
+                case GL_PRIMITIVE_RESTART_FIXED_INDEX:
+                    return 5;
+                case GL_MULTISAMPLE:
+                    return 6;
+                case GL_FRAMEBUFFER_SRGB:
+                    return 7;
+                case GL_RASTERIZER_DISCARD:
+                    return 8;
+                case GL_POLYGON_OFFSET_FILL:
+                    return 9;
+                default:
+                    return kUntracked;
+            }
+        }
+
+    }  // anonymous namespace
+
+    void OpenGLStateTracker::StartTracking(DeviceCounters* counters) {
+        ASSERT(counters != nullptr);
+        ForgetAllState();
+        mCounters = counters;
+    }
+
+    void OpenGLStateTracker::StopTracking() {
+        ForgetAllState();
+        mCounters = nullptr;
+    }
+
+    void OpenGLStateTracker::AddDevice(DeviceCounters* counters, bool filterRedundantCalls) {
+        mDeviceCount++;
+        if (mDeviceCount == 1 && filterRedundantCalls) {
+            StartTracking(counters);
+        } else if (IsTracking()) {
+            // The shadow state of the first device would go stale when the new device changes
+            // the state of the context.
+            StopTracking();
+        }
+    }
+
+    void OpenGLStateTracker::RemoveDevice() {
+        ASSERT(mDeviceCount > 0);
+        mDeviceCount--;
+        if (mDeviceCount == 0 && IsTracking()) {
+            StopTracking();
+        }
+    }
+
+    void OpenGLStateTracker::ForgetAllState() {
+        mActiveTexture.Forget();
+        mBuffers = {};
+        mIndexedBuffers = {};
+        mDrawFramebuffer.Forget();
+        mReadFramebuffer.Forget();
+        mSamplers = {};
+        mTextures = {};
+        mVertexArray.Forget();
+        mProgram.Forget();
+        mCaps = {};
+        mBlendCaps = {};
+        mBlendColor.Forget();
+        mBlendEquations = {};
+        mBlendFuncs = {};
+        mColorMasks = {};
+        mDepthFunc.Forget();
+        mDepthMask.Forget();
+    }
+
+    bool OpenGLStateTracker::IsTracking() const {
+        return mCounters != nullptr;
+    }
+
+    bool OpenGLStateTracker::Filter(bool changed) {
+        if (changed) {
+            mCounters->glStateCallsIssued.Increment();
+        } else {
+            mCounters->glStateCallsFiltered.Increment();
+        }
+        return changed;
+    }
+
+    bool OpenGLStateTracker::ActiveTexture(GLenum texture) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return Filter(mActiveTexture.Set(texture));
+    }
+
+    bool OpenGLStateTracker::BindBuffer(GLenum target, GLuint buffer) {
+        if (!IsTracking()) {
+            return true;
+        }
+        uint32_t targetIndex = BufferTargetIndex(target);
+        if (targetIndex == kUntracked) {
+            return Filter(true);
+        }
+        return Filter(mBuffers[targetIndex].Set(buffer));
+    }
+
+    bool OpenGLStateTracker::BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+        if (!IsTracking()) {
+            return true;
+        }
+        // Binding the whole buffer doesn't depend on its size, so the call is always issued.
+        uint32_t indexedTargetIndex = IndexedBufferTargetIndex(target);
+        if (indexedTargetIndex != kUntracked && index < kMaxIndexedBufferBindings) {
+            mIndexedBuffers[indexedTargetIndex][index].Forget();
+        }
+        uint32_t targetIndex = BufferTargetIndex(target);
+        if (targetIndex != kUntracked) {
+            mBuffers[targetIndex].Set(buffer);
+        }
+        return Filter(true);
+    }
+
+    bool OpenGLStateTracker::BindBufferRange(GLenum target,
+                                             GLuint index,
+                                             GLuint buffer,
+                                             GLintptr offset,
+                                             GLsizeiptr size) {
+        if (!IsTracking()) {
+            return true;
+        }
+        uint32_t indexedTargetIndex = IndexedBufferTargetIndex(target);
+        if (indexedTargetIndex == kUntracked || index >= kMaxIndexedBufferBindings) {
+            // The generic binding point changes too and must be forgotten.
+            uint32_t targetIndex = BufferTargetIndex(target);
+            if (targetIndex != kUntracked) {
+                mBuffers[targetIndex].Forget();
+            }
+            return Filter(true);
+        }
+
+        std::array<uint64_t, 3> range = {buffer, static_cast<uint64_t>(offset),
+                                         static_cast<uint64_t>(size)};
+        if (!mIndexedBuffers[indexedTargetIndex][index].Set(range)) {
+            return Filter(false);
+        }
+        // Binding an indexed binding point also binds the buffer to the generic binding point.
+        mBuffers[BufferTargetIndex(target)].Set(buffer);
+        return Filter(true);
+    }
+
+    bool OpenGLStateTracker::BindFramebuffer(GLenum target, GLuint framebuffer) {
+        if (!IsTracking()) {
+            return true;
+        }
+        switch (target) {
+            case GL_DRAW_FRAMEBUFFER:
+                return Filter(mDrawFramebuffer.Set(framebuffer));
+            case GL_READ_FRAMEBUFFER:
+                return Filter(mReadFramebuffer.Set(framebuffer));
+            case GL_FRAMEBUFFER: {
+                bool drawChanged = mDrawFramebuffer.Set(framebuffer);
+                bool readChanged = mReadFramebuffer.Set(framebuffer);
+                return Filter(drawChanged || readChanged);
+            }
+            default:
+                UNREACHABLE();
+                return true;
+        }
+    }
+
+    bool OpenGLStateTracker::BindSampler(GLuint unit, GLuint sampler) {
+        if (!IsTracking()) {
+            return true;
+        }
+        if (unit >= kMaxTextureUnits) {
+            return Filter(true);
+        }
+        return Filter(mSamplers[unit].Set(sampler));
+    }
+
+    bool OpenGLStateTracker::BindTexture(GLenum target, GLuint texture) {
+        if (!IsTracking()) {
+            return true;
+        }
+        uint32_t targetIndex = TextureTargetIndex(target);
+        if (targetIndex == kUntracked) {
+            return Filter(true);
+        }
+
+        // GL_TEXTURE0 + i is the texture unit i, the subtraction wraps for invalid values.
+        uint32_t unit = mActiveTexture.IsKnown() ? mActiveTexture.Get() - GL_TEXTURE0 : 0;
+        if (!mActiveTexture.IsKnown() || unit >= kMaxTextureUnits) {
+            // The binding of an unknown texture unit changes so all the bindings to the target
+            // become unknown.
+            for (auto& unitBindings : mTextures) {
+                unitBindings[targetIndex].Forget();
+            }
+            return Filter(true);
+        }
+        return Filter(mTextures[unit][targetIndex].Set(texture));
+    }
+
+    bool OpenGLStateTracker::BindVertexArray(GLuint array) {
+        if (!IsTracking()) {
+            return true;
+        }
+        if (!mVertexArray.Set(array)) {
+            return Filter(false);
+        }
+        // The element array buffer binding is part of the vertex array state.
+        mBuffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)].Forget();
+        return Filter(true);
+    }
+
+    bool OpenGLStateTracker::BlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return Filter(mBlendColor.Set({red, green, blue, alpha}));
+    }
+
+    bool OpenGLStateTracker::BlendEquationSeparatei(GLuint buf, GLenum modeRGB, GLenum modeAlpha) {
+        if (!IsTracking()) {
+            return true;
+        }
+        if (buf >= kMaxColorAttachments) {
+            return Filter(true);
+        }
+        return Filter(mBlendEquations[buf].Set({modeRGB, modeAlpha}));
+    }
+
+    bool OpenGLStateTracker::BlendFuncSeparatei(GLuint buf,
+                                                GLenum srcRGB,
+                                                GLenum dstRGB,
+                                                GLenum srcAlpha,
+                                                GLenum dstAlpha) {
+        if (!IsTracking()) {
+            return true;
+        }
+        if (buf >= kMaxColorAttachments) {
+            return Filter(true);
+        }
+        return Filter(mBlendFuncs[buf].Set({srcRGB, dstRGB, srcAlpha, dstAlpha}));
+    }
+
+    bool OpenGLStateTracker::ColorMaski(GLuint index,
+                                        GLboolean r,
+                                        GLboolean g,
+                                        GLboolean b,
+                                        GLboolean a) {
+        if (!IsTracking()) {
+            return true;
+        }
+        if (index >= kMaxColorAttachments) {
+            return Filter(true);
+        }
+        return Filter(mColorMasks[index].Set({r, g, b, a}));
+    }
+
+    bool OpenGLStateTracker::DepthFunc(GLenum func) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return Filter(mDepthFunc.Set(func));
+    }
+
+    bool OpenGLStateTracker::DepthMask(GLboolean flag) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return Filter(mDepthMask.Set(flag));
+    }
+
+    bool OpenGLStateTracker::SetCap(GLenum cap, bool enabled) {
+        uint32_t capIndex = CapIndex(cap);
+        if (capIndex == kUntracked) {
+            return Filter(true);
+        }
+        if (!mCaps[capIndex].Set(enabled)) {
+            return Filter(false);
+        }
+        // Enabling or disabling a cap changes it for all the indices.
+        if (cap == GL_BLEND) {
+            for (auto& blendCap : mBlendCaps) {
+                blendCap.Set(enabled);
+            }
+        }
+        return Filter(true);
+    }
+
+    bool OpenGLStateTracker::SetIndexedCap(GLenum target, GLuint index, bool enabled) {
+        if (target != GL_BLEND || index >= kMaxColorAttachments) {
+            // The cap without an index may no longer have the same value for all the indices.
+            uint32_t capIndex = CapIndex(target);
+            if (capIndex != kUntracked) {
+                mCaps[capIndex].Forget();
+            }
+            return Filter(true);
+        }
+        if (!mBlendCaps[index].Set(enabled)) {
+            return Filter(false);
+        }
+        // The cap without an index stands for all the indices, which may no longer have the
+        // same value.
+        mCaps[CapIndex(GL_BLEND)].Forget();
+        return Filter(true);
+    }
+
+    bool OpenGLStateTracker::Disable(GLenum cap) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return SetCap(cap, false);
+    }
+
+    bool OpenGLStateTracker::Disablei(GLenum target, GLuint index) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return SetIndexedCap(target, index, false);
+    }
+
+    bool OpenGLStateTracker::Enable(GLenum cap) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return SetCap(cap, true);
+    }
+
+    bool OpenGLStateTracker::Enablei(GLenum target, GLuint index) {
+        if (!IsTracking()) {
+            return true;
+        }
+        return SetIndexedCap(target, index, true);
+    }
+
+    bool OpenGLStateTracker::UseProgram(GLuint program) {
+        if (!IsTracking()) {
+            return true;
+        }
+        // Deleting the current program doesn't change the binding, GL keeps the program alive
+        // until it is no longer current, so DeleteProgram doesn't need to be tracked.
+        return Filter(mProgram.Set(program));
+    }
+
+    bool OpenGLStateTracker::DeleteBuffers(GLsizei n, const GLuint* buffers) {
+        if (!IsTracking()) {
+            return true;
+        }
+        for (GLsizei i = 0; i < n; ++i) {
+            if (buffers[i] == 0) {
+                continue;
+            }
+            for (auto& binding : mBuffers) {
+                if (binding.Is(buffers[i])) {
+                    binding.Set(0);
+                }
+            }
+            for (auto& targetBindings : mIndexedBuffers) {
+                for (auto& binding : targetBindings) {
+                    if (binding.IsKnown() && binding.Get()[0] == buffers[i]) {
+                        binding.Set({0, 0, 0});
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLStateTracker::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+        if (!IsTracking()) {
+            return true;
+        }
+        for (GLsizei i = 0; i < n; ++i) {
+            if (framebuffers[i] == 0) {
+                continue;
+            }
+            if (mDrawFramebuffer.Is(framebuffers[i])) {
+                mDrawFramebuffer.Set(0);
+            }
+            if (mReadFramebuffer.Is(framebuffers[i])) {
+                mReadFramebuffer.Set(0);
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLStateTracker::DeleteSamplers(GLsizei count, const GLuint* samplers) {
+        if (!IsTracking()) {
+            return true;
+        }
+        for (GLsizei i = 0; i < count; ++i) {
+            if (samplers[i] == 0) {
+                continue;
+            }
+            for (auto& binding : mSamplers) {
+                if (binding.Is(samplers[i])) {
+                    binding.Set(0);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLStateTracker::DeleteTextures(GLsizei n, const GLuint* textures) {
+        if (!IsTracking()) {
+            return true;
+        }
+        for (GLsizei i = 0; i < n; ++i) {
+            if (textures[i] == 0) {
+                continue;
+            }
+            for (auto& unitBindings : mTextures) {
+                for (auto& binding : unitBindings) {
+                    if (binding.Is(textures[i])) {
+                        binding.Set(0);
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    bool OpenGLStateTracker::DeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+        if (!IsTracking()) {
+            return true;
+        }
+        for (GLsizei i = 0; i < n; ++i) {
+            if (arrays[i] != 0 && mVertexArray.Is(arrays[i])) {
+                mVertexArray.Set(0);
+                mBuffers[BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)].Forget();
+            }
+        }
+        return true;
+    }
+
+}}  // namespace dawn_native::opengl
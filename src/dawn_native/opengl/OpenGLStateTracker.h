@@ -0,0 +1,174 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_OPENGL_OPENGLSTATETRACKER_H_
+#define DAWNNATIVE_OPENGL_OPENGLSTATETRACKER_H_
+
+#include "common/Assert.h"
+#include "common/Constants.h"
+#include "dawn_native/opengl/opengl_platform.h"
+
+#include <array>
+
+namespace dawn_native {
+    struct DeviceCounters;
+}  // namespace dawn_native
+
+namespace dawn_native { namespace opengl {
+
+    // Shadows the GL state that the backend sets the most often so that the calls setting it to
+    // the value it already has are skipped: the buffer, texture, sampler and framebuffer bind
+    // points, the current program and vertex array, the enable bits, and the blend and depth
+    // state. The generated OpenGLFunctions call the method with the name of each proc listed in
+    // the state_tracked_procs of supported_extensions.json and only call the proc if it returns
+    // true. The Delete* methods are never filtered, they only update the bindings that GL resets
+    // when the bound object is deleted. The state is kept in flat arrays indexed by target, unit
+    // or index; the calls for targets, units or caps outside of them are always issued.
+    //
+    // Tracking is disabled until StartTracking is called. All the state starts unknown because
+    // the context comes from the application, and it stays correct only as long as all the calls
+    // changing it go through the same tracker. The application must not change that state on the
+    // context it gives to Dawn.
+    //
+    // A single tracker is shared by all the devices created on a GL context, since they share its
+    // state. An OpenGL device enables tracking in AddDevice when the
+    // filter_redundant_gl_state_calls toggle is enabled, but only while it is the only device
+    // alive on the context: the calls of the other devices would not be counted in its counters.
+    class OpenGLStateTracker {
+      public:
+        // Starts tracking the state and counting the issued and filtered calls in |counters|.
+        void StartTracking(DeviceCounters* counters);
+        // Stops tracking and forgets all the state.
+        void StopTracking();
+
+        // Called when a device is created on or removed from the context of the tracker.
+        void AddDevice(DeviceCounters* counters, bool filterRedundantCalls);
+        void RemoveDevice();
+
+        bool ActiveTexture(GLenum texture);
+        bool BindBuffer(GLenum target, GLuint buffer);
+        bool BindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        bool BindBufferRange(GLenum target,
+                             GLuint index,
+                             GLuint buffer,
+                             GLintptr offset,
+                             GLsizeiptr size);
+        bool BindFramebuffer(GLenum target, GLuint framebuffer);
+        bool BindSampler(GLuint unit, GLuint sampler);
+        bool BindTexture(GLenum target, GLuint texture);
+        bool BindVertexArray(GLuint array);
+        bool BlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+        bool BlendEquationSeparatei(GLuint buf, GLenum modeRGB, GLenum modeAlpha);
+        bool BlendFuncSeparatei(GLuint buf,
+                                GLenum srcRGB,
+                                GLenum dstRGB,
+                                GLenum srcAlpha,
+                                GLenum dstAlpha);
+        bool ColorMaski(GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a);
+        bool DepthFunc(GLenum func);
+        bool DepthMask(GLboolean flag);
+        bool Disable(GLenum cap);
+        bool Disablei(GLenum target, GLuint index);
+        bool Enable(GLenum cap);
+        bool Enablei(GLenum target, GLuint index);
+        bool UseProgram(GLuint program);
+
+        bool DeleteBuffers(GLsizei n, const GLuint* buffers);
+        bool DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+        bool DeleteSamplers(GLsizei count, const GLuint* samplers);
+        bool DeleteTextures(GLsizei n, const GLuint* textures);
+        bool DeleteVertexArrays(GLsizei n, const GLuint* arrays);
+
+        static constexpr uint32_t kNumBufferTargets = 14;
+        // GL_UNIFORM_BUFFER and GL_SHADER_STORAGE_BUFFER.
+        static constexpr uint32_t kNumIndexedBufferTargets = 2;
+        static constexpr uint32_t kMaxIndexedBufferBindings = kMaxBindGroups * kMaxBindingsPerGroup;
+        static constexpr uint32_t kNumTextureTargets = 8;
+        static constexpr uint32_t kMaxTextureUnits = kMaxBindGroups * kMaxBindingsPerGroup;
+        static constexpr uint32_t kNumCaps = 10;
+
+      private:
+        // A piece of state that is either unknown or has the value of the last call setting it.
+        template <typename T>
+        class ShadowValue {
+          public:
+            // Returns whether the value changed, in which case the call must be issued.
+            bool Set(const T& value) {
+                if (mKnown && mValue == value) {
+                    return false;
+                }
+                mKnown = true;
+                mValue = value;
+                return true;
+            }
+            bool Is(const T& value) const {
+                return mKnown && mValue == value;
+            }
+            bool IsKnown() const {
+                return mKnown;
+            }
+            const T& Get() const {
+                ASSERT(mKnown);
+                return mValue;
+            }
+            void Forget() {
+                mKnown = false;
+            }
+
+          private:
+            bool mKnown = false;
+            T mValue = {};
+        };
+
+        bool IsTracking() const;
+        // Counts the call as issued if it changed the state, filtered otherwise.
+        bool Filter(bool changed);
+        bool SetCap(GLenum cap, bool enabled);
+        bool SetIndexedCap(GLenum target, GLuint index, bool enabled);
+        void ForgetAllState();
+
+        DeviceCounters* mCounters = nullptr;
+        uint32_t mDeviceCount = 0;
+
+        ShadowValue<GLenum> mActiveTexture;
+        std::array<ShadowValue<GLuint>, kNumBufferTargets> mBuffers;
+        // The indexed buffer bindings as buffer, offset and size.
+        std::array<std::array<ShadowValue<std::array<uint64_t, 3>>, kMaxIndexedBufferBindings>,
+                   kNumIndexedBufferTargets>
+            mIndexedBuffers;
+        ShadowValue<GLuint> mDrawFramebuffer;
+        ShadowValue<GLuint> mReadFramebuffer;
+        std::array<ShadowValue<GLuint>, kMaxTextureUnits> mSamplers;
+        std::array<std::array<ShadowValue<GLuint>, kNumTextureTargets>, kMaxTextureUnits>
+            mTextures;
+        ShadowValue<GLuint> mVertexArray;
+        ShadowValue<GLuint> mProgram;
+
+        std::array<ShadowValue<bool>, kNumCaps> mCaps;
+        // GL_BLEND is the only cap the backend sets per color attachment.
+        std::array<ShadowValue<bool>, kMaxColorAttachments> mBlendCaps;
+
+        // Only the indexed blend state is tracked because the backend doesn't use the versions of
+        // the procs that set it for all the color attachments.
+        ShadowValue<std::array<GLfloat, 4>> mBlendColor;
+        std::array<ShadowValue<std::array<GLenum, 2>>, kMaxColorAttachments> mBlendEquations;
+        std::array<ShadowValue<std::array<GLenum, 4>>, kMaxColorAttachments> mBlendFuncs;
+        std::array<ShadowValue<std::array<GLboolean, 4>>, kMaxColorAttachments> mColorMasks;
+        ShadowValue<GLenum> mDepthFunc;
+        ShadowValue<GLboolean> mDepthMask;
+    };
+
+}}  // namespace dawn_native::opengl
+
+#endif  // DAWNNATIVE_OPENGL_OPENGLSTATETRACKER_H_
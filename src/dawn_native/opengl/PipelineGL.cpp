@@ -16,10 +16,12 @@
 
 #include "common/BitSetIterator.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/opengl/DeviceGL.h"
 #include "dawn_native/opengl/Forward.h"
 #include "dawn_native/opengl/OpenGLFunctions.h"
 #include "dawn_native/opengl/PipelineLayoutGL.h"
 #include "dawn_native/opengl/ShaderModuleGL.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <iostream>
 #include <set>
@@ -46,31 +48,19 @@ namespace dawn_native { namespace opengl {
     PipelineGL::PipelineGL() {
     }
 
+    PipelineGL::~PipelineGL() {
+        if (mDevice != nullptr && !mIsLinkFinished) {
+            mDevice->RemovePendingLink(this);
+        }
+    }
+
     void PipelineGL::Initialize(const OpenGLFunctions& gl,
                                 const PipelineLayout* layout,
                                 const PerStage<const ShaderModule*>& modules) {
-        auto CreateShader = [](const OpenGLFunctions& gl, GLenum type,
-                               const char* source) -> GLuint {
-            GLuint shader = gl.CreateShader(type);
-            gl.ShaderSource(shader, 1, &source, nullptr);
-            gl.CompileShader(shader);
-
-            GLint compileStatus = GL_FALSE;
-            gl.GetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
-            if (compileStatus == GL_FALSE) {
-                GLint infoLogLength = 0;
-                gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-                if (infoLogLength > 1) {
-                    std::vector<char> buffer(infoLogLength);
-                    gl.GetShaderInfoLog(shader, infoLogLength, nullptr, &buffer[0]);
-                    std::cout << source << std::endl;
-                    std::cout << "Program compilation failed:\n";
-                    std::cout << buffer.data() << std::endl;
-                }
-            }
-            return shader;
-        };
+        TRACE_EVENT0(layout->GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "PipelineGL::Initialize");
+        mDevice = ToBackend(layout->GetDevice());
+        mLayout = layout;
 
         mProgram = gl.CreateProgram();
 
@@ -81,16 +71,78 @@ namespace dawn_native { namespace opengl {
             }
         }
 
+        // The compile status isn't queried here as it would wait for the compilation.
         for (SingleShaderStage stage : IterateStages(activeStages)) {
-            GLuint shader = CreateShader(gl, GLShaderType(stage), modules[stage]->GetSource());
+            const char* source = modules[stage]->GetSource();
+            GLuint shader = gl.CreateShader(GLShaderType(stage));
+            gl.ShaderSource(shader, 1, &source, nullptr);
+            gl.CompileShader(shader);
             gl.AttachShader(mProgram, shader);
+            mShaders.emplace_back(shader, source);
         }
 
         gl.LinkProgram(mProgram);
 
+        // Compute links between stages for combined samplers, they are bound to texture units
+        // once the program is linked.
+        for (SingleShaderStage stage : IterateStages(activeStages)) {
+            for (const auto& combined : modules[stage]->GetCombinedSamplerInfo()) {
+                mCombinedSamplers.insert(combined);
+            }
+        }
+
+        if (mDevice->IsToggleEnabled(Toggle::AsyncGLShaderCompilation)) {
+            mDevice->AddPendingLink(this);
+        } else {
+            FinishLink(gl);
+        }
+    }
+
+    bool PipelineGL::IsLinkCompleted(const OpenGLFunctions& gl) const {
+        if (mIsLinkFinished) {
+            return true;
+        }
+
+        // Without KHR_parallel_shader_compile or ARB_parallel_shader_compile, the driver may only
+        // link when the program is queried, so the link is considered complete but waiting on it
+        // will be slow.
+        if (!mDevice->UsesParallelShaderCompile()) {
+            return true;
+        }
+
+        // GL_COMPLETION_STATUS_ARB has the same value.
+        GLint completionStatus = GL_FALSE;
+        gl.GetProgramiv(mProgram, GL_COMPLETION_STATUS_KHR, &completionStatus);
+        return completionStatus == GL_TRUE;
+    }
+
+    void PipelineGL::FinishLink(const OpenGLFunctions& gl) {
+        ASSERT(!mIsLinkFinished);
+        TRACE_EVENT0(mDevice->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "PipelineGL::FinishLink");
+        mIsLinkFinished = true;
+
         GLint linkStatus = GL_FALSE;
         gl.GetProgramiv(mProgram, GL_LINK_STATUS, &linkStatus);
         if (linkStatus == GL_FALSE) {
+            for (const auto& shader : mShaders) {
+                GLint compileStatus = GL_FALSE;
+                gl.GetShaderiv(shader.first, GL_COMPILE_STATUS, &compileStatus);
+                if (compileStatus == GL_TRUE) {
+                    continue;
+                }
+
+                GLint infoLogLength = 0;
+                gl.GetShaderiv(shader.first, GL_INFO_LOG_LENGTH, &infoLogLength);
+                if (infoLogLength > 1) {
+                    std::vector<char> buffer(infoLogLength);
+                    gl.GetShaderInfoLog(shader.first, infoLogLength, nullptr, &buffer[0]);
+                    std::cout << shader.second << std::endl;
+                    std::cout << "Program compilation failed:\n";
+                    std::cout << buffer.data() << std::endl;
+                }
+            }
+
             GLint infoLogLength = 0;
             gl.GetProgramiv(mProgram, GL_INFO_LOG_LENGTH, &infoLogLength);
 
@@ -101,15 +153,16 @@ namespace dawn_native { namespace opengl {
                 std::cout << buffer.data() << std::endl;
             }
         }
+        mShaders.clear();
 
         gl.UseProgram(mProgram);
 
         // The uniforms are part of the program state so we can pre-bind buffer units, texture units
         // etc.
-        const auto& indices = layout->GetBindingIndexInfo();
+        const auto& indices = mLayout->GetBindingIndexInfo();
 
-        for (uint32_t group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
-            const auto& groupInfo = layout->GetBindGroupLayout(group)->GetBindingInfo();
+        for (uint32_t group : IterateBitSet(mLayout->GetBindGroupLayoutsMask())) {
+            const auto& groupInfo = mLayout->GetBindGroupLayout(group)->GetBindingInfo();
 
             for (uint32_t binding = 0; binding < kMaxBindingsPerGroup; ++binding) {
                 if (!groupInfo.mask[binding]) {
@@ -150,20 +203,13 @@ namespace dawn_native { namespace opengl {
             }
         }
 
-        // Compute links between stages for combined samplers, then bind them to texture units
+        // Bind the combined samplers to texture units
         {
-            std::set<CombinedSampler> combinedSamplersSet;
-            for (SingleShaderStage stage : IterateStages(activeStages)) {
-                for (const auto& combined : modules[stage]->GetCombinedSamplerInfo()) {
-                    combinedSamplersSet.insert(combined);
-                }
-            }
+            mUnitsForSamplers.resize(mLayout->GetNumSamplers());
+            mUnitsForTextures.resize(mLayout->GetNumSampledTextures());
 
-            mUnitsForSamplers.resize(layout->GetNumSamplers());
-            mUnitsForTextures.resize(layout->GetNumSampledTextures());
-
-            GLuint textureUnit = layout->GetTextureUnitsUsed();
-            for (const auto& combined : combinedSamplersSet) {
+            GLuint textureUnit = mLayout->GetTextureUnitsUsed();
+            for (const auto& combined : mCombinedSamplers) {
                 std::string name = combined.GetName();
                 GLint location = gl.GetUniformLocation(mProgram, name.c_str());
 
@@ -178,7 +224,7 @@ namespace dawn_native { namespace opengl {
                 mUnitsForTextures[textureIndex].push_back(textureUnit);
 
                 dawn::TextureComponentType componentType =
-                    layout->GetBindGroupLayout(combined.textureLocation.group)
+                    mLayout->GetBindGroupLayout(combined.textureLocation.group)
                         ->GetBindingInfo()
                         .textureComponentTypes[combined.textureLocation.binding];
                 bool shouldUseFiltering = componentType == dawn::TextureComponentType::Float;
@@ -189,16 +235,19 @@ namespace dawn_native { namespace opengl {
 
                 textureUnit++;
             }
+            mCombinedSamplers.clear();
         }
     }
 
     const std::vector<PipelineGL::SamplerUnit>& PipelineGL::GetTextureUnitsForSampler(
         GLuint index) const {
+        ASSERT(mIsLinkFinished);
         ASSERT(index < mUnitsForSamplers.size());
         return mUnitsForSamplers[index];
     }
 
     const std::vector<GLuint>& PipelineGL::GetTextureUnitsForTextureView(GLuint index) const {
+        ASSERT(mIsLinkFinished);
         ASSERT(index < mUnitsForSamplers.size());
         return mUnitsForTextures[index];
     }
@@ -208,6 +257,10 @@ namespace dawn_native { namespace opengl {
     }
 
     void PipelineGL::ApplyNow(const OpenGLFunctions& gl) {
+        if (!mIsLinkFinished) {
+            mDevice->RemovePendingLink(this);
+            FinishLink(gl);
+        }
         gl.UseProgram(mProgram);
     }
 
@@ -17,25 +17,37 @@
 
 #include "dawn_native/Pipeline.h"
 
+#include "dawn_native/opengl/ShaderModuleGL.h"
 #include "dawn_native/opengl/opengl_platform.h"
 
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace dawn_native { namespace opengl {
 
+    class Device;
     struct OpenGLFunctions;
     class PersistentPipelineState;
     class PipelineLayout;
-    class ShaderModule;
 
     class PipelineGL {
       public:
         PipelineGL();
+        ~PipelineGL();
 
+        // Compiles the shaders and starts linking the program. The rest of the initialization
+        // needs the link to be complete, which FinishLink waits for. With the
+        // async_gl_shader_compilation toggle, FinishLink is called by the device when it sees the
+        // link completed or at the first use of the pipeline, otherwise it is called right away.
         void Initialize(const OpenGLFunctions& gl,
                         const PipelineLayout* layout,
                         const PerStage<const ShaderModule*>& modules);
 
+        // Whether FinishLink can be called without waiting for the driver.
+        bool IsLinkCompleted(const OpenGLFunctions& gl) const;
+        void FinishLink(const OpenGLFunctions& gl);
+
         using BindingLocations =
             std::array<std::array<GLint, kMaxBindingsPerGroup>, kMaxBindGroups>;
 
@@ -52,9 +64,17 @@ namespace dawn_native { namespace opengl {
         void ApplyNow(const OpenGLFunctions& gl);
 
       private:
+        Device* mDevice = nullptr;
         GLuint mProgram;
         std::vector<std::vector<SamplerUnit>> mUnitsForSamplers;
         std::vector<std::vector<GLuint>> mUnitsForTextures;
+
+        // The state needed by FinishLink. The sources are owned by the shader modules, which the
+        // pipeline references.
+        bool mIsLinkFinished = false;
+        const PipelineLayout* mLayout = nullptr;
+        std::vector<std::pair<GLuint, const char*>> mShaders;
+        std::set<CombinedSampler> mCombinedSamplers;
     };
 
 }}  // namespace dawn_native::opengl
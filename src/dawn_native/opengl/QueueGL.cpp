@@ -16,6 +16,7 @@
 
 #include "dawn_native/opengl/CommandBufferGL.h"
 #include "dawn_native/opengl/DeviceGL.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace opengl {
 
@@ -25,9 +26,13 @@ namespace dawn_native { namespace opengl {
     MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
         Device* device = ToBackend(GetDevice());
 
+        TRACE_EVENT_BEGIN0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                           "CommandBufferGL::Execute");
         for (uint32_t i = 0; i < commandCount; ++i) {
             ToBackend(commands[i])->Execute();
         }
+        TRACE_EVENT_END0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                         "CommandBufferGL::Execute");
 
         device->SubmitFenceSync();
         return {};
@@ -216,11 +216,17 @@ namespace dawn_native { namespace opengl {
     }
 
     void RenderPipeline::CreateVAOForVertexInput(const VertexInputDescriptor* vertexInput) {
-        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Device* device = ToBackend(GetDevice());
+        const OpenGLFunctions& gl = device->gl;
 
         gl.GenVertexArrays(1, &mVertexArrayObject);
         gl.BindVertexArray(mVertexArrayObject);
 
+        if (device->UsesVertexAttribBinding()) {
+            SpecifyVertexAttribBindings(gl);
+            return;
+        }
+
         for (uint32_t location : IterateBitSet(GetAttributesSetMask())) {
             const auto& attribute = GetAttribute(location);
             gl.EnableVertexAttribArray(location);
@@ -246,6 +252,43 @@ namespace dawn_native { namespace opengl {
         }
     }
 
+    void RenderPipeline::SpecifyVertexAttribBindings(const OpenGLFunctions& gl) {
+        // The binding index of an attribute is its input slot, so that binding a vertex buffer
+        // to a slot with glBindVertexBuffer is all that's needed to apply it.
+        for (uint32_t location : IterateBitSet(GetAttributesSetMask())) {
+            const auto& attribute = GetAttribute(location);
+            gl.EnableVertexAttribArray(location);
+
+            attributesUsingInput[attribute.inputSlot][location] = true;
+
+            GLint components = VertexFormatNumComponents(attribute.format);
+            GLenum formatType = VertexFormatType(attribute.format);
+            GLuint offset = static_cast<GLuint>(attribute.offset);
+            if (VertexFormatIsInt(attribute.format)) {
+                gl.VertexAttribIFormat(location, components, formatType, offset);
+            } else {
+                gl.VertexAttribFormat(location, components, formatType,
+                                      VertexFormatIsNormalized(attribute.format), offset);
+            }
+            gl.VertexAttribBinding(location, attribute.inputSlot);
+        }
+
+        // The stride is given when binding the vertex buffer, and unlike with
+        // glVertexAttribPointer a stride of zero is a constant attribute, so only the step mode
+        // is set here.
+        for (uint32_t slot : IterateBitSet(GetInputsSetMask())) {
+            switch (GetInput(slot).stepMode) {
+                case dawn::InputStepMode::Vertex:
+                    break;
+                case dawn::InputStepMode::Instance:
+                    gl.VertexBindingDivisor(slot, 1);
+                    break;
+                default:
+                    UNREACHABLE();
+            }
+        }
+    }
+
     void RenderPipeline::ApplyNow(PersistentPipelineState& persistentPipelineState) {
         const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
         PipelineGL::ApplyNow(gl);
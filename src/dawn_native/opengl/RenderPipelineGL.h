@@ -38,6 +38,7 @@ namespace dawn_native { namespace opengl {
 
       private:
         void CreateVAOForVertexInput(const VertexInputDescriptor* vertexInput);
+        void SpecifyVertexAttribBindings(const OpenGLFunctions& gl);
 
         // TODO(yunchao.he@intel.com): vao need to be deduplicated between pipelines.
         GLuint mVertexArrayObject;
@@ -16,10 +16,13 @@
 
 #include "common/Assert.h"
 #include "common/Platform.h"
+#include "dawn_native/WorkerPool.h"
 #include "dawn_native/opengl/DeviceGL.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <spirv_glsl.hpp>
 
+#include <memory>
 #include <sstream>
 
 namespace dawn_native { namespace opengl {
@@ -49,7 +52,32 @@ namespace dawn_native { namespace opengl {
 
     ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor)
         : ShaderModuleBase(device, descriptor) {
-        spirv_cross::CompilerGLSL compiler(descriptor->code, descriptor->codeSize);
+        // The compiler is shared with the translation task, which needs a copyable function.
+        std::shared_ptr<spirv_cross::CompilerGLSL> compiler =
+            std::make_shared<spirv_cross::CompilerGLSL>(descriptor->code, descriptor->codeSize);
+
+        // The frontend validates pipelines against the reflection data, so it is extracted right
+        // away and only the translation can be deferred.
+        ExtractSpirvInfo(*compiler);
+
+        WorkerPool* workerPool = device->GetWorkerPool();
+        if (workerPool == nullptr) {
+            TranslateToGLSL(compiler.get());
+            return;
+        }
+        mTranslation =
+            workerPool->PostTask([this, compiler]() { TranslateToGLSL(compiler.get()); });
+    }
+
+    ShaderModule::~ShaderModule() {
+        // The translation task references the module.
+        WaitForTranslation();
+    }
+
+    void ShaderModule::TranslateToGLSL(spirv_cross::CompilerGLSL* compiler) {
+        TRACE_EVENT0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "ShaderModuleGL::TranslateToGLSL");
+
         // If these options are changed, the values in DawnSPIRVCrossGLSLFastFuzzer.cpp need to be
         // updated.
         spirv_cross::CompilerGLSL::Options options;
@@ -67,30 +95,28 @@ namespace dawn_native { namespace opengl {
 #else
         options.version = 440;
 #endif
-        compiler.set_common_options(options);
-
-        ExtractSpirvInfo(compiler);
+        compiler->set_common_options(options);
 
         const auto& bindingInfo = GetBindingInfo();
 
         // Extract bindings names so that it can be used to get its location in program.
         // Now translate the separate sampler / textures into combined ones and store their info.
         // We need to do this before removing the set and binding decorations.
-        compiler.build_combined_image_samplers();
+        compiler->build_combined_image_samplers();
 
-        for (const auto& combined : compiler.get_combined_image_samplers()) {
+        for (const auto& combined : compiler->get_combined_image_samplers()) {
             mCombinedInfo.emplace_back();
 
             auto& info = mCombinedInfo.back();
             info.samplerLocation.group =
-                compiler.get_decoration(combined.sampler_id, spv::DecorationDescriptorSet);
+                compiler->get_decoration(combined.sampler_id, spv::DecorationDescriptorSet);
             info.samplerLocation.binding =
-                compiler.get_decoration(combined.sampler_id, spv::DecorationBinding);
+                compiler->get_decoration(combined.sampler_id, spv::DecorationBinding);
             info.textureLocation.group =
-                compiler.get_decoration(combined.image_id, spv::DecorationDescriptorSet);
+                compiler->get_decoration(combined.image_id, spv::DecorationDescriptorSet);
             info.textureLocation.binding =
-                compiler.get_decoration(combined.image_id, spv::DecorationBinding);
-            compiler.set_name(combined.combined_id, info.GetName());
+                compiler->get_decoration(combined.image_id, spv::DecorationBinding);
+            compiler->set_name(combined.combined_id, info.GetName());
         }
 
         // Change binding names to be "dawn_binding_<group>_<binding>".
@@ -100,21 +126,29 @@ namespace dawn_native { namespace opengl {
             for (uint32_t binding = 0; binding < kMaxBindingsPerGroup; ++binding) {
                 const auto& info = bindingInfo[group][binding];
                 if (info.used) {
-                    compiler.set_name(info.base_type_id, GetBindingName(group, binding));
-                    compiler.unset_decoration(info.id, spv::DecorationBinding);
-                    compiler.unset_decoration(info.id, spv::DecorationDescriptorSet);
+                    compiler->set_name(info.base_type_id, GetBindingName(group, binding));
+                    compiler->unset_decoration(info.id, spv::DecorationBinding);
+                    compiler->unset_decoration(info.id, spv::DecorationDescriptorSet);
                 }
             }
         }
 
-        mGlslSource = compiler.compile();
+        mGlslSource = compiler->compile();
+    }
+
+    void ShaderModule::WaitForTranslation() const {
+        if (mTranslation.valid()) {
+            mTranslation.wait();
+        }
     }
 
     const char* ShaderModule::GetSource() const {
+        WaitForTranslation();
         return mGlslSource.c_str();
     }
 
     const ShaderModule::CombinedSamplerInfo& ShaderModule::GetCombinedSamplerInfo() const {
+        WaitForTranslation();
         return mCombinedInfo;
     }
 
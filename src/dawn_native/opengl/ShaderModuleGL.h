@@ -19,6 +19,12 @@
 
 #include "dawn_native/opengl/opengl_platform.h"
 
+#include <future>
+
+namespace spirv_cross {
+    class CompilerGLSL;
+}  // namespace spirv_cross
+
 namespace dawn_native { namespace opengl {
 
     class Device;
@@ -41,15 +47,23 @@ namespace dawn_native { namespace opengl {
     class ShaderModule : public ShaderModuleBase {
       public:
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
+        ~ShaderModule();
 
         using CombinedSamplerInfo = std::vector<CombinedSampler>;
 
+        // These wait for the translation to GLSL if it runs on the device's worker pool.
         const char* GetSource() const;
         const CombinedSamplerInfo& GetCombinedSamplerInfo() const;
 
       private:
+        void TranslateToGLSL(spirv_cross::CompilerGLSL* compiler);
+        void WaitForTranslation() const;
+
         CombinedSamplerInfo mCombinedInfo;
         std::string mGlslSource;
+
+        // Only valid while the translation is posted to the worker pool.
+        std::future<void> mTranslation;
     };
 
 }}  // namespace dawn_native::opengl
@@ -0,0 +1,51 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_OPENGL_STAGINGBUFFERGL_H_
+#define DAWNNATIVE_OPENGL_STAGINGBUFFERGL_H_
+
+#include "dawn_native/StagingBuffer.h"
+
+#include "dawn_native/opengl/opengl_platform.h"
+
+#include <memory>
+
+namespace dawn_native { namespace opengl {
+
+    class Device;
+
+    // A staging buffer is a GL buffer that stays mapped for its whole lifetime, which requires
+    // glBufferStorage to map it persistently and coherently. Without it, the staging buffer is
+    // in CPU memory and the data is given directly to the GL calls that upload it, which lets the
+    // driver stage it as it sees fit.
+    class StagingBuffer : public StagingBufferBase {
+      public:
+        StagingBuffer(size_t size, Device* device);
+        ~StagingBuffer();
+
+        MaybeError Initialize() override;
+
+        // The GL buffer to copy from, or 0 if the staging buffer is in CPU memory.
+        GLuint GetHandle() const;
+
+      private:
+        Device* mDevice;
+        GLuint mBuffer = 0;
+        std::unique_ptr<uint8_t[]> mCPUStorage;
+    };
+
+}}  // namespace dawn_native::opengl
+
+#endif  // DAWNNATIVE_OPENGL_STAGINGBUFFERGL_H_
@@ -17,8 +17,11 @@
 #include "common/Assert.h"
 #include "common/Constants.h"
 #include "common/Math.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/opengl/BufferGL.h"
 #include "dawn_native/opengl/DeviceGL.h"
+#include "dawn_native/opengl/FramebufferCache.h"
+#include "dawn_native/opengl/StagingBufferGL.h"
 #include "dawn_native/opengl/UtilsGL.h"
 
 namespace dawn_native { namespace opengl {
@@ -159,14 +162,24 @@ namespace dawn_native { namespace opengl {
     }
 
     Texture::~Texture() {
+        // Textures that aren't owned by Dawn don't call DestroyImpl but can still have cached
+        // framebuffers.
+        RemoveCachedFramebuffers();
         DestroyInternal();
     }
 
     void Texture::DestroyImpl() {
+        RemoveCachedFramebuffers();
         ToBackend(GetDevice())->gl.DeleteTextures(1, &mHandle);
         mHandle = 0;
     }
 
+    void Texture::RemoveCachedFramebuffers() {
+        if (GetUsage() & dawn::TextureUsage::OutputAttachment) {
+            ToBackend(GetDevice())->GetFramebufferCache()->OnTextureDestroyed(this);
+        }
+    }
+
     GLuint Texture::GetHandle() const {
         return mHandle;
     }
@@ -246,33 +259,33 @@ namespace dawn_native { namespace opengl {
             ASSERT(rowPitch % GetFormat().blockByteSize == 0);
             ASSERT(GetSize().height % GetFormat().blockHeight == 0);
 
-            dawn_native::BufferDescriptor descriptor;
-            descriptor.size = rowPitch * (GetSize().height / GetFormat().blockHeight);
-            if (descriptor.size > std::numeric_limits<uint32_t>::max()) {
+            uint64_t bufferSize64 = rowPitch * (GetSize().height / GetFormat().blockHeight);
+            if (bufferSize64 > std::numeric_limits<uint32_t>::max()) {
                 return DAWN_OUT_OF_MEMORY_ERROR("Unable to allocate buffer.");
             }
-            descriptor.nextInChain = nullptr;
-            descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::MapWrite;
-            // TODO(natlee@microsoft.com): use Dynamic Uplaoder here for temp buffer
-            Ref<Buffer> srcBuffer = ToBackend(device->CreateBuffer(&descriptor));
-            // Call release here to prevent memory leak since CreateBuffer will up the ref count to
-            // 1, then assigning to Ref<Buffer> ups the ref count to 2. Release will reduce the ref
-            // count and ensure it to reach 0 when out of use.
-            srcBuffer->Release();
-
-            // Fill the buffer with clear color
-            uint8_t* clearBuffer = nullptr;
-            DAWN_TRY(srcBuffer->MapAtCreation(&clearBuffer));
-            std::fill(reinterpret_cast<uint32_t*>(clearBuffer),
-                      reinterpret_cast<uint32_t*>(clearBuffer + descriptor.size), clearColor);
-            srcBuffer->Unmap();
+            uint32_t bufferSize = static_cast<uint32_t>(bufferSize64);
+            DynamicUploader* uploader = device->GetDynamicUploader();
+            UploadHandle uploadHandle;
+            DAWN_TRY_ASSIGN(uploadHandle,
+                            uploader->Allocate(bufferSize, device->GetPendingCommandSerial()));
+            std::fill(reinterpret_cast<uint32_t*>(uploadHandle.mappedBuffer),
+                      reinterpret_cast<uint32_t*>(uploadHandle.mappedBuffer + bufferSize),
+                      clearColor);
+
+            // With a GL staging buffer, the pixels argument of glTexSubImage2D is the offset in
+            // the buffer bound to GL_PIXEL_UNPACK_BUFFER. Otherwise it points to CPU memory.
+            GLuint stagingHandle = ToBackend(uploadHandle.stagingBuffer)->GetHandle();
+            const void* pixels = uploadHandle.mappedBuffer;
+            if (stagingHandle != 0) {
+                pixels = reinterpret_cast<const void*>(uploadHandle.startOffset);
+            }
 
             // Bind buffer and texture, and make the buffer to texture copy
             gl.PixelStorei(GL_UNPACK_ROW_LENGTH,
                            (rowPitch / GetFormat().blockByteSize) * GetFormat().blockWidth);
             gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
             for (GLint level = baseMipLevel; level < baseMipLevel + levelCount; ++level) {
-                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, srcBuffer->GetHandle());
+                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingHandle);
                 gl.ActiveTexture(GL_TEXTURE0);
                 gl.BindTexture(GetGLTarget(), GetHandle());
 
@@ -283,7 +296,7 @@ namespace dawn_native { namespace opengl {
                         // than 1, because the buffer is only sized for one layer.
                         ASSERT(layerCount == 1);
                         gl.TexSubImage2D(GetGLTarget(), level, 0, 0, size.width, size.height,
-                                         GetGLFormat().format, GetGLFormat().type, 0);
+                                         GetGLFormat().format, GetGLFormat().type, pixels);
                         break;
 
                     default:
@@ -294,6 +307,7 @@ namespace dawn_native { namespace opengl {
 
                 gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
             }
+            device->TrackPendingUploads();
         }
         return {};
     }
@@ -45,6 +45,7 @@ namespace dawn_native { namespace opengl {
 
       private:
         void DestroyImpl() override;
+        void RemoveCachedFramebuffers();
         MaybeError ClearTexture(GLint baseMipLevel,
                                 GLint levelCount,
                                 GLint baseArrayLayer,
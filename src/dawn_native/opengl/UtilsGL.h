@@ -22,6 +22,10 @@ namespace dawn_native { namespace opengl {
 
     GLuint ToOpenGLCompareFunction(dawn::CompareFunction compareFunction);
     GLint GetStencilMaskFromStencilFormat(dawn::TextureFormat depthStencilFormat);
+
+    GLenum VertexFormatType(dawn::VertexFormat format);
+    GLboolean VertexFormatIsNormalized(dawn::VertexFormat format);
+    bool VertexFormatIsInt(dawn::VertexFormat format);
 }}  // namespace dawn_native::opengl
 
 #endif  // DAWNNATIVE_OPENGL_UTILSGL_H_
@@ -63,7 +63,8 @@ namespace dawn_native { namespace vulkan {
 
     MaybeError Backend::Initialize() {
         if (!mVulkanLib.Open(kVulkanLibName)) {
-            return DAWN_DEVICE_LOST_ERROR(std::string("Couldn't open ") + kVulkanLibName);
+            return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::DeviceLost,
+                                                std::string("Couldn't open ") + kVulkanLibName);
         }
 
         DAWN_TRY(mFunctions.LoadGlobalProcs(mVulkanLib));
@@ -22,9 +22,18 @@
 #include "dawn_native/vulkan/SamplerVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
+    namespace {
+
+        // Vulkan doesn't report the memory used by descriptor pools so it is estimated from the
+        // number of descriptors, using the size of the largest descriptors of common drivers.
+        constexpr uint64_t kEstimatedDescriptorSize = 64;
+
+    }  // anonymous namespace
+
     // static
     ResultOrError<BindGroup*> BindGroup::Create(Device* device,
                                                 const BindGroupDescriptor* descriptor) {
@@ -34,6 +43,8 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError BindGroup::Initialize() {
+        TRACE_EVENT0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "BindGroupVk::Initialize");
         Device* device = ToBackend(GetDevice());
 
         // Create a pool to hold our descriptor set.
@@ -54,6 +65,11 @@ namespace dawn_native { namespace vulkan {
             device->fn.CreateDescriptorPool(device->GetVkDevice(), &createInfo, nullptr, &mPool),
             "CreateDescriptorPool"));
 
+        for (uint32_t i = 0; i < numPoolSizes; ++i) {
+            mPoolMemorySize += poolSizes[i].descriptorCount * kEstimatedDescriptorSize;
+        }
+        device->GetMemoryTracker()->Allocate(MemoryCategory::DescriptorPool, mPoolMemorySize);
+
         // Now do the allocation of one descriptor set, this is very suboptimal too.
         VkDescriptorSetLayout vkLayout = ToBackend(GetLayout())->GetHandle();
 
@@ -136,6 +152,8 @@ namespace dawn_native { namespace vulkan {
 
         if (mPool != VK_NULL_HANDLE) {
             ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mPool);
+            GetDevice()->GetMemoryTracker()->Free(MemoryCategory::DescriptorPool,
+                                                  mPoolMemorySize);
             mPool = VK_NULL_HANDLE;
         }
     }
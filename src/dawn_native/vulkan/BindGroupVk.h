@@ -37,6 +37,7 @@ namespace dawn_native { namespace vulkan {
 
         VkDescriptorPool mPool = VK_NULL_HANDLE;
         VkDescriptorSet mHandle = VK_NULL_HANDLE;
+        uint64_t mPoolMemorySize = 0;
     };
 
 }}  // namespace dawn_native::vulkan
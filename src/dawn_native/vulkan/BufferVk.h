@@ -37,9 +37,8 @@ namespace dawn_native { namespace vulkan {
 
         VkBuffer GetHandle() const;
 
-        // Transitions the buffer to be used as `usage`, recording any necessary barrier in
-        // `commands`.
-        // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
+        // Transitions the buffer to be used as `usage`, adding any necessary barrier to the
+        // barriers of `recordingContext` that are recorded by its FlushBarriers.
         void TransitionUsageNow(CommandRecordingContext* recordingContext, dawn::BufferUsage usage);
 
       private:
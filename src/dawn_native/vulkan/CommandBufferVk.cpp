@@ -23,8 +23,9 @@
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
-#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
+#include "dawn_native/vulkan/RenderBundleVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
@@ -106,9 +107,316 @@ namespace dawn_native { namespace vulkan {
             }
         };
 
+        // The state of the recording of render commands. Secondary command buffers start without
+        // state so render bundles recorded in them use their own.
+        struct RenderCommandState {
+            DescriptorSetTracker descriptorSets = {};
+            RenderPipeline* lastPipeline = nullptr;
+        };
+
+        // Records the commands that can be both in render passes and render bundles.
+        void EncodeRenderBundleCommand(Device* device,
+                                       VkCommandBuffer commands,
+                                       RenderCommandState* state,
+                                       CommandIterator* iter,
+                                       Command type) {
+            switch (type) {
+                case Command::Draw: {
+                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+
+                    state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
+                                       draw->firstVertex, draw->firstInstance);
+                } break;
+
+                case Command::DrawIndexed: {
+                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+
+                    state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
+                                              draw->firstIndex, draw->baseVertex,
+                                              draw->firstInstance);
+                } break;
+
+                case Command::DrawIndirect: {
+                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+
+                    state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndirect(commands, indirectBuffer,
+                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
+                                               0);
+                } break;
+
+                case Command::DrawIndexedIndirect: {
+                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
+                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+
+                    state->descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                    device->fn.CmdDrawIndexedIndirect(
+                        commands, indirectBuffer, static_cast<VkDeviceSize>(draw->indirectOffset),
+                        1, 0);
+                } break;
+
+                case Command::InsertDebugMarker: {
+                    if (device->GetDeviceInfo().debugMarker) {
+                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
+                        VkDebugMarkerMarkerInfoEXT markerInfo;
+                        markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
+                        markerInfo.pNext = nullptr;
+                        markerInfo.pMarkerName = label;
+                        // Default color to black
+                        markerInfo.color[0] = 0.0;
+                        markerInfo.color[1] = 0.0;
+                        markerInfo.color[2] = 0.0;
+                        markerInfo.color[3] = 1.0;
+                        device->fn.CmdDebugMarkerInsertEXT(commands, &markerInfo);
+                    } else {
+                        SkipCommand(iter, Command::InsertDebugMarker);
+                    }
+                } break;
+
+                case Command::PopDebugGroup: {
+                    if (device->GetDeviceInfo().debugMarker) {
+                        iter->NextCommand<PopDebugGroupCmd>();
+                        device->fn.CmdDebugMarkerEndEXT(commands);
+                    } else {
+                        SkipCommand(iter, Command::PopDebugGroup);
+                    }
+                } break;
+
+                case Command::PushDebugGroup: {
+                    if (device->GetDeviceInfo().debugMarker) {
+                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
+                        const char* label = iter->NextData<char>(cmd->length + 1);
+                        VkDebugMarkerMarkerInfoEXT markerInfo;
+                        markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
+                        markerInfo.pNext = nullptr;
+                        markerInfo.pMarkerName = label;
+                        // Default color to black
+                        markerInfo.color[0] = 0.0;
+                        markerInfo.color[1] = 0.0;
+                        markerInfo.color[2] = 0.0;
+                        markerInfo.color[3] = 1.0;
+                        device->fn.CmdDebugMarkerBeginEXT(commands, &markerInfo);
+                    } else {
+                        SkipCommand(iter, Command::PushDebugGroup);
+                    }
+                } break;
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
+                    VkDescriptorSet set = ToBackend(cmd->group.Get())->GetHandle();
+                    uint64_t* dynamicOffsets = nullptr;
+                    if (cmd->dynamicOffsetCount > 0) {
+                        dynamicOffsets = iter->NextData<uint64_t>(cmd->dynamicOffsetCount);
+                    }
+
+                    state->descriptorSets.OnSetBindGroup(cmd->index, set,
+                                                         cmd->dynamicOffsetCount, dynamicOffsets);
+                } break;
+
+                case Command::SetIndexBuffer: {
+                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
+                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+                    // TODO(cwallez@chromium.org): get the index type from the last render pipeline
+                    // and rebind if needed on pipeline change
+                    ASSERT(state->lastPipeline != nullptr);
+                    VkIndexType indexType = VulkanIndexType(
+                        state->lastPipeline->GetVertexInputDescriptor()->indexFormat);
+                    device->fn.CmdBindIndexBuffer(
+                        commands, indexBuffer, static_cast<VkDeviceSize>(cmd->offset), indexType);
+                } break;
+
+                case Command::SetRenderPipeline: {
+                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
+                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+
+                    device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                               pipeline->GetHandle());
+                    state->lastPipeline = pipeline;
+
+                    state->descriptorSets.OnSetPipeline(pipeline);
+                } break;
+
+                case Command::SetVertexBuffer: {
+                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
+                    VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+                    device->fn.CmdBindVertexBuffers(commands, cmd->slot, 1, &buffer, &offset);
+                } break;
+
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+        }
+
+        // Records the commands of render passes other than EndRenderPass and ExecuteBundles,
+        // including the ones that can also be in render bundles.
+        void EncodeRenderPassCommand(Device* device,
+                                     VkCommandBuffer commands,
+                                     RenderCommandState* state,
+                                     CommandIterator* iter,
+                                     Command type) {
+            switch (type) {
+                case Command::SetBlendColor: {
+                    SetBlendColorCmd* cmd = iter->NextCommand<SetBlendColorCmd>();
+                    float blendConstants[4] = {
+                        cmd->color.r,
+                        cmd->color.g,
+                        cmd->color.b,
+                        cmd->color.a,
+                    };
+                    device->fn.CmdSetBlendConstants(commands, blendConstants);
+                } break;
+
+                case Command::SetStencilReference: {
+                    SetStencilReferenceCmd* cmd = iter->NextCommand<SetStencilReferenceCmd>();
+                    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
+                                                      cmd->reference);
+                } break;
+
+                case Command::SetViewport: {
+                    SetViewportCmd* cmd = iter->NextCommand<SetViewportCmd>();
+                    VkViewport viewport;
+                    viewport.x = cmd->x;
+                    viewport.y = cmd->y + cmd->height;
+                    viewport.width = cmd->width;
+                    viewport.height = -cmd->height;
+                    viewport.minDepth = cmd->minDepth;
+                    viewport.maxDepth = cmd->maxDepth;
+
+                    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+                } break;
+
+                case Command::SetScissorRect: {
+                    SetScissorRectCmd* cmd = iter->NextCommand<SetScissorRectCmd>();
+                    VkRect2D rect;
+                    rect.offset.x = cmd->x;
+                    rect.offset.y = cmd->y;
+                    rect.extent.width = cmd->width;
+                    rect.extent.height = cmd->height;
+
+                    device->fn.CmdSetScissor(commands, 0, 1, &rect);
+                } break;
+
+                default: {
+                    EncodeRenderBundleCommand(device, commands, state, iter, type);
+                } break;
+            }
+        }
+
+        // Records the default value of the dynamic state of a render pass of the given size.
+        void RecordDefaultDynamicState(Device* device,
+                                       VkCommandBuffer commands,
+                                       uint32_t width,
+                                       uint32_t height) {
+            device->fn.CmdSetLineWidth(commands, 1.0f);
+            device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+
+            device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+
+            float blendConstants[4] = {
+                0.0f,
+                0.0f,
+                0.0f,
+                0.0f,
+            };
+            device->fn.CmdSetBlendConstants(commands, blendConstants);
+
+            // The viewport and scissor default to cover all of the attachments
+            VkViewport viewport;
+            viewport.x = 0.0f;
+            viewport.y = static_cast<float>(height);
+            viewport.width = static_cast<float>(width);
+            viewport.height = -static_cast<float>(height);
+            viewport.minDepth = 0.0f;
+            viewport.maxDepth = 1.0f;
+            device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+
+            VkRect2D scissorRect;
+            scissorRect.offset.x = 0;
+            scissorRect.offset.y = 0;
+            scissorRect.extent.width = width;
+            scissorRect.extent.height = height;
+            device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+        }
+
+        // Returns, for each pass of the commands, whether it is a render pass that only executes
+        // render bundles. The commands of these render passes can all be in secondary command
+        // buffers, which Vulkan requires to execute any of them.
+        std::vector<bool> FindRenderPassesWithOnlyBundles(CommandIterator* commands) {
+            std::vector<bool> passesWithOnlyBundles;
+            bool inRenderPass = false;
+            bool hasBundles = false;
+            bool hasOtherCommands = false;
+
+            Command type;
+            while (commands->NextCommandId(&type)) {
+                switch (type) {
+                    case Command::BeginComputePass: {
+                        passesWithOnlyBundles.push_back(false);
+                    } break;
+
+                    case Command::BeginRenderPass: {
+                        inRenderPass = true;
+                        hasBundles = false;
+                        hasOtherCommands = false;
+                    } break;
+
+                    case Command::EndRenderPass: {
+                        passesWithOnlyBundles.push_back(hasBundles && !hasOtherCommands);
+                        inRenderPass = false;
+                    } break;
+
+                    case Command::ExecuteBundles: {
+                        hasBundles = true;
+                    } break;
+
+                    default: {
+                        hasOtherCommands = hasOtherCommands || inRenderPass;
+                    } break;
+                }
+                SkipCommand(commands, type);
+            }
+
+            commands->Reset();
+            return passesWithOnlyBundles;
+        }
+
+        // Returns the VkRenderPass for the attachments of `renderPass` with Load operations.
+        // Load and store operations don't matter for render pass compatibility, so it is the same
+        // for all the render passes compatible with `renderPass`.
+        ResultOrError<VkRenderPass> GetCompatibleRenderPass(Device* device,
+                                                            BeginRenderPassCmd* renderPass) {
+            RenderPassCacheQuery query;
+
+            for (uint32_t i :
+                 IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
+                const auto& attachmentInfo = renderPass->colorAttachments[i];
+                query.SetColor(i, attachmentInfo.view->GetFormat().format, dawn::LoadOp::Load,
+                               attachmentInfo.resolveTarget.Get() != nullptr);
+            }
+
+            if (renderPass->attachmentState->HasDepthStencilAttachment()) {
+                const auto& attachmentInfo = renderPass->depthStencilAttachment;
+                query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
+                                      dawn::LoadOp::Load, dawn::LoadOp::Load);
+            }
+
+            query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
+
+            return device->GetRenderPassCache()->GetRenderPass(query);
+        }
+
         MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                          Device* device,
-                                         BeginRenderPassCmd* renderPass) {
+                                         BeginRenderPassCmd* renderPass,
+                                         VkSubpassContents contents) {
             VkCommandBuffer commands = recordingContext->commandBuffer;
 
             // Query a VkRenderPass from the cache
@@ -201,21 +509,23 @@ namespace dawn_native { namespace vulkan {
                 DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
             }
 
-            // Create a framebuffer that will be used once for the render pass and gather the clear
+            // Get the framebuffer for the attachments of the render pass and gather the clear
             // values for the attachments at the same time.
             std::array<VkClearValue, kMaxColorAttachments + 1> clearValues;
             VkFramebuffer framebuffer = VK_NULL_HANDLE;
             uint32_t attachmentCount = 0;
             {
-                // Fill in the attachment info that will be chained in the framebuffer create info.
-                std::array<VkImageView, kMaxColorAttachments * 2 + 1> attachments;
+                // Fill in the attachments in "color-depthstencil-resolve" order, which is the one
+                // of the render pass.
+                FramebufferCacheQuery query;
+                query.SetRenderPass(renderPassVK, renderPass->width, renderPass->height);
 
                 for (uint32_t i :
                      IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
                     auto& attachmentInfo = renderPass->colorAttachments[i];
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view->GetHandle());
 
                     clearValues[attachmentCount].color.float32[0] = attachmentInfo.clearColor.r;
                     clearValues[attachmentCount].color.float32[1] = attachmentInfo.clearColor.g;
@@ -229,7 +539,7 @@ namespace dawn_native { namespace vulkan {
                     auto& attachmentInfo = renderPass->depthStencilAttachment;
                     TextureView* view = ToBackend(attachmentInfo.view.Get());
 
-                    attachments[attachmentCount] = view->GetHandle();
+                    query.AddAttachment(view->GetHandle());
 
                     clearValues[attachmentCount].depthStencil.depth = attachmentInfo.clearDepth;
                     clearValues[attachmentCount].depthStencil.stencil = attachmentInfo.clearStencil;
@@ -243,32 +553,14 @@ namespace dawn_native { namespace vulkan {
                         TextureView* view =
                             ToBackend(renderPass->colorAttachments[i].resolveTarget.Get());
 
-                        attachments[attachmentCount] = view->GetHandle();
+                        query.AddAttachment(view->GetHandle());
 
                         attachmentCount++;
                     }
                 }
 
-                // Chain attachments and create the framebuffer
-                VkFramebufferCreateInfo createInfo;
-                createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-                createInfo.pNext = nullptr;
-                createInfo.flags = 0;
-                createInfo.renderPass = renderPassVK;
-                createInfo.attachmentCount = attachmentCount;
-                createInfo.pAttachments = attachments.data();
-                createInfo.width = renderPass->width;
-                createInfo.height = renderPass->height;
-                createInfo.layers = 1;
-
-                DAWN_TRY(
-                    CheckVkSuccess(device->fn.CreateFramebuffer(device->GetVkDevice(), &createInfo,
-                                                                nullptr, &framebuffer),
-                                   "CreateFramebuffer"));
-
-                // We don't reuse VkFramebuffers so mark the framebuffer for deletion as soon as the
-                // commands currently being recorded are finished.
-                device->GetFencedDeleter()->DeleteWhenUnused(framebuffer);
+                ASSERT(query.attachmentCount == attachmentCount);
+                DAWN_TRY_ASSIGN(framebuffer, device->GetFramebufferCache()->GetFramebuffer(query));
             }
 
             VkRenderPassBeginInfo beginInfo;
@@ -283,12 +575,29 @@ namespace dawn_native { namespace vulkan {
             beginInfo.clearValueCount = attachmentCount;
             beginInfo.pClearValues = clearValues.data();
 
-            device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            device->fn.CmdBeginRenderPass(commands, &beginInfo, contents);
 
             return {};
         }
     }  // anonymous namespace
 
+    void RecordRenderBundleCommands(Device* device,
+                                    VkCommandBuffer commands,
+                                    RenderBundleBase* bundle,
+                                    uint32_t width,
+                                    uint32_t height) {
+        RecordDefaultDynamicState(device, commands, width, height);
+
+        RenderCommandState state;
+        CommandIterator* iter = bundle->GetCommands();
+        iter->Reset();
+
+        Command type;
+        while (iter->NextCommandId(&type)) {
+            EncodeRenderBundleCommand(device, commands, &state, iter, type);
+        }
+    }
+
     // static
     CommandBuffer* CommandBuffer::Create(CommandEncoderBase* encoder,
                                          const CommandBufferDescriptor* descriptor) {
@@ -337,6 +646,7 @@ namespace dawn_native { namespace vulkan {
         VkImage dstImage = ToBackend(dstCopy.texture)->GetHandle();
 
         tempBuffer->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopyDst);
+        recordingContext->FlushBarriers(device);
         VkBufferImageCopy srcToTempBufferRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, srcCopy, copySize);
 
@@ -345,6 +655,7 @@ namespace dawn_native { namespace vulkan {
                                         tempBuffer->GetHandle(), 1, &srcToTempBufferRegion);
 
         tempBuffer->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopySrc);
+        recordingContext->FlushBarriers(device);
         VkBufferImageCopy tempBufferToDstRegion =
             ComputeBufferImageCopyRegion(tempBufferCopy, dstCopy, copySize);
 
@@ -361,29 +672,45 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        // Records the necessary barriers for the resource usage pre-computed by the frontend
-        auto TransitionForPass = [](CommandRecordingContext* recordingContext,
+        // Records the necessary barriers for the resource usage pre-computed by the frontend, as
+        // a single vkCmdPipelineBarrier.
+        auto TransitionForPass = [](Device* device, CommandRecordingContext* recordingContext,
                                     const PassResourceUsage& usages) {
-            for (size_t i = 0; i < usages.buffers.size(); ++i) {
-                Buffer* buffer = ToBackend(usages.buffers[i]);
-                buffer->TransitionUsageNow(recordingContext, usages.bufferUsages[i]);
-            }
+            // Clear textures that are not output attachments. Output attachments will be
+            // cleared in RecordBeginRenderPass by setting the loadop to clear when the
+            // texture subresource has not been initialized before the render pass. The clears
+            // are done first because they record their own barriers.
             for (size_t i = 0; i < usages.textures.size(); ++i) {
                 Texture* texture = ToBackend(usages.textures[i]);
-                // Clear textures that are not output attachments. Output attachments will be
-                // cleared in RecordBeginRenderPass by setting the loadop to clear when the
-                // texture subresource has not been initialized before the render pass.
                 if (!(usages.textureUsages[i] & dawn::TextureUsage::OutputAttachment)) {
                     texture->EnsureSubresourceContentInitialized(recordingContext, 0,
                                                                  texture->GetNumMipLevels(), 0,
                                                                  texture->GetArrayLayers());
                 }
+            }
+
+            for (size_t i = 0; i < usages.buffers.size(); ++i) {
+                Buffer* buffer = ToBackend(usages.buffers[i]);
+                buffer->TransitionUsageNow(recordingContext, usages.bufferUsages[i]);
+            }
+            for (size_t i = 0; i < usages.textures.size(); ++i) {
+                Texture* texture = ToBackend(usages.textures[i]);
                 texture->TransitionUsageNow(recordingContext, usages.textureUsages[i]);
             }
+            recordingContext->FlushBarriers(device);
         };
         const std::vector<PassResourceUsage>& passResourceUsages = GetResourceUsages().perPass;
         size_t nextPassNumber = 0;
 
+        std::vector<bool> passesWithOnlyBundles = FindRenderPassesWithOnlyBundles(&mCommands);
+        ASSERT(passesWithOnlyBundles.size() == passResourceUsages.size());
+
+        // The secondary command buffers are only executed once, even if the command buffer is
+        // submitted again.
+        std::vector<SecondaryRenderPass> secondaryRenderPasses;
+        std::swap(secondaryRenderPasses, mSecondaryRenderPasses);
+        secondaryRenderPasses.resize(passResourceUsages.size());
+
         Command type;
         while (mCommands.NextCommandId(&type)) {
             switch (type) {
@@ -394,6 +721,7 @@ namespace dawn_native { namespace vulkan {
 
                     srcBuffer->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopySrc);
                     dstBuffer->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopyDst);
+                    recordingContext->FlushBarriers(device);
 
                     VkBufferCopy region;
                     region.srcOffset = copy->sourceOffset;
@@ -429,6 +757,7 @@ namespace dawn_native { namespace vulkan {
                         ->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopySrc);
                     ToBackend(dst.texture)
                         ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+                    recordingContext->FlushBarriers(device);
                     VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
                     VkImage dstImage = ToBackend(dst.texture)->GetHandle();
 
@@ -457,6 +786,7 @@ namespace dawn_native { namespace vulkan {
                         ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopySrc);
                     ToBackend(dst.buffer)
                         ->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopyDst);
+                    recordingContext->FlushBarriers(device);
 
                     VkImage srcImage = ToBackend(src.texture)->GetHandle();
                     VkBuffer dstBuffer = ToBackend(dst.buffer)->GetHandle();
@@ -489,6 +819,7 @@ namespace dawn_native { namespace vulkan {
                         ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopySrc);
                     ToBackend(dst.texture)
                         ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+                    recordingContext->FlushBarriers(device);
 
                     // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                     // because as Vulkan SPEC always validates image copies with the virtual size of
@@ -527,8 +858,18 @@ namespace dawn_native { namespace vulkan {
                 case Command::BeginRenderPass: {
                     BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
 
-                    TransitionForPass(recordingContext, passResourceUsages[nextPassNumber]);
-                    DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    TransitionForPass(device, recordingContext,
+                                      passResourceUsages[nextPassNumber]);
+                    VkCommandBuffer secondaryCommands =
+                        secondaryRenderPasses[nextPassNumber].commandBuffer;
+                    if (passesWithOnlyBundles[nextPassNumber]) {
+                        DAWN_TRY(RecordRenderPassWithOnlyBundles(recordingContext, cmd));
+                    } else if (secondaryCommands != VK_NULL_HANDLE) {
+                        DAWN_TRY(
+                            RecordSecondaryRenderPass(recordingContext, cmd, secondaryCommands));
+                    } else {
+                        DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    }
 
                     nextPassNumber++;
                 } break;
@@ -536,7 +877,8 @@ namespace dawn_native { namespace vulkan {
                 case Command::BeginComputePass: {
                     mCommands.NextCommand<BeginComputePassCmd>();
 
-                    TransitionForPass(recordingContext, passResourceUsages[nextPassNumber]);
+                    TransitionForPass(device, recordingContext,
+                                      passResourceUsages[nextPassNumber]);
                     RecordComputePass(recordingContext);
 
                     nextPassNumber++;
@@ -655,249 +997,287 @@ namespace dawn_native { namespace vulkan {
         UNREACHABLE();
     }
 
-    MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingContext,
-                                               BeginRenderPassCmd* renderPassCmd) {
+    MaybeError CommandBuffer::RecordRenderPassWithOnlyBundles(
+        CommandRecordingContext* recordingContext,
+        BeginRenderPassCmd* renderPassCmd) {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
+        // The bundles are recorded in secondary command buffers for the render passes compatible
+        // with this one, and are only recorded the first time they are executed in one.
+        VkRenderPass compatibleRenderPass = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(compatibleRenderPass, GetCompatibleRenderPass(device, renderPassCmd));
 
-        // Set the default value for the dynamic state
-        {
-            device->fn.CmdSetLineWidth(commands, 1.0f);
-            device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
 
-            device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+        std::vector<VkCommandBuffer> secondaryCommandBuffers;
 
-            float blendConstants[4] = {
-                0.0f,
-                0.0f,
-                0.0f,
-                0.0f,
-            };
-            device->fn.CmdSetBlendConstants(commands, blendConstants);
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    device->fn.CmdEndRenderPass(commands);
+                    return {};
+                } break;
 
-            // The viewport and scissor default to cover all of the attachments
-            VkViewport viewport;
-            viewport.x = 0.0f;
-            viewport.y = static_cast<float>(renderPassCmd->height);
-            viewport.width = static_cast<float>(renderPassCmd->width);
-            viewport.height = -static_cast<float>(renderPassCmd->height);
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-            device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
+                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
 
-            VkRect2D scissorRect;
-            scissorRect.offset.x = 0;
-            scissorRect.offset.y = 0;
-            scissorRect.extent.width = renderPassCmd->width;
-            scissorRect.extent.height = renderPassCmd->height;
-            device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+                    if (cmd->count == 0) {
+                        break;
+                    }
+
+                    secondaryCommandBuffers.resize(cmd->count);
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        DAWN_TRY_ASSIGN(secondaryCommandBuffers[i],
+                                        ToBackend(bundles[i].Get())
+                                            ->GetSecondaryCommandBuffer(compatibleRenderPass,
+                                                                        renderPassCmd->width,
+                                                                        renderPassCmd->height));
+                    }
+                    device->fn.CmdExecuteCommands(commands, cmd->count,
+                                                  secondaryCommandBuffers.data());
+                } break;
+
+                default: { UNREACHABLE(); } break;
+            }
         }
 
-        DescriptorSetTracker descriptorSets = {};
-        RenderPipeline* lastPipeline = nullptr;
+        // EndRenderPass should have been called
+        UNREACHABLE();
+    }
 
-        auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-            switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+    MaybeError CommandBuffer::RecordSecondaryRenderPass(CommandRecordingContext* recordingContext,
+                                                        BeginRenderPassCmd* renderPassCmd,
+                                                        VkCommandBuffer secondaryCommands) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
 
-                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                       draw->firstVertex, draw->firstInstance);
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
+        device->fn.CmdExecuteCommands(commands, 1, &secondaryCommands);
+
+        // The commands of the pass are already recorded in the secondary command buffer.
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    device->fn.CmdEndRenderPass(commands);
+                    return {};
                 } break;
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                default: { SkipCommand(&mCommands, type); } break;
+            }
+        }
 
-                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                              draw->firstIndex, draw->baseVertex,
-                                              draw->firstInstance);
-                } break;
+        // EndRenderPass should have been called
+        UNREACHABLE();
+    }
 
-                case Command::DrawIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+    MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingContext,
+                                               BeginRenderPassCmd* renderPassCmd) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
 
-                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndirect(commands, indirectBuffer,
-                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
-                                               0);
-                } break;
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_INLINE));
 
-                case Command::DrawIndexedIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+        RecordDefaultDynamicState(device, commands, renderPassCmd->width, renderPassCmd->height);
 
-                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, indirectBuffer, static_cast<VkDeviceSize>(draw->indirectOffset),
-                        1, 0);
-                } break;
+        RenderCommandState state;
 
-                case Command::InsertDebugMarker: {
-                    if (device->GetDeviceInfo().debugMarker) {
-                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugMarkerMarkerInfoEXT markerInfo;
-                        markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
-                        markerInfo.pNext = nullptr;
-                        markerInfo.pMarkerName = label;
-                        // Default color to black
-                        markerInfo.color[0] = 0.0;
-                        markerInfo.color[1] = 0.0;
-                        markerInfo.color[2] = 0.0;
-                        markerInfo.color[3] = 1.0;
-                        device->fn.CmdDebugMarkerInsertEXT(commands, &markerInfo);
-                    } else {
-                        SkipCommand(iter, Command::InsertDebugMarker);
-                    }
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    device->fn.CmdEndRenderPass(commands);
+                    return {};
                 } break;
 
-                case Command::PopDebugGroup: {
-                    if (device->GetDeviceInfo().debugMarker) {
-                        iter->NextCommand<PopDebugGroupCmd>();
-                        device->fn.CmdDebugMarkerEndEXT(commands);
-                    } else {
-                        SkipCommand(iter, Command::PopDebugGroup);
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
+                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
+
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        CommandIterator* iter = bundles[i]->GetCommands();
+                        iter->Reset();
+                        while (iter->NextCommandId(&type)) {
+                            EncodeRenderBundleCommand(device, commands, &state, iter, type);
+                        }
                     }
                 } break;
 
-                case Command::PushDebugGroup: {
-                    if (device->GetDeviceInfo().debugMarker) {
-                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugMarkerMarkerInfoEXT markerInfo;
-                        markerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_MARKER_MARKER_INFO_EXT;
-                        markerInfo.pNext = nullptr;
-                        markerInfo.pMarkerName = label;
-                        // Default color to black
-                        markerInfo.color[0] = 0.0;
-                        markerInfo.color[1] = 0.0;
-                        markerInfo.color[2] = 0.0;
-                        markerInfo.color[3] = 1.0;
-                        device->fn.CmdDebugMarkerBeginEXT(commands, &markerInfo);
-                    } else {
-                        SkipCommand(iter, Command::PushDebugGroup);
-                    }
+                default: {
+                    EncodeRenderPassCommand(device, commands, &state, &mCommands, type);
                 } break;
+            }
+        }
 
-                case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    VkDescriptorSet set = ToBackend(cmd->group.Get())->GetHandle();
-                    uint64_t* dynamicOffsets = nullptr;
-                    if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = iter->NextData<uint64_t>(cmd->dynamicOffsetCount);
-                    }
+        // EndRenderPass should have been called
+        UNREACHABLE();
+    }
 
-                    descriptorSets.OnSetBindGroup(cmd->index, set, cmd->dynamicOffsetCount,
-                                                  dynamicOffsets);
-                } break;
+    MaybeError CommandBuffer::PrepareSecondaryRenderPasses() {
+        Device* device = ToBackend(GetDevice());
+        mSecondaryRenderPasses.clear();
 
-                case Command::SetIndexBuffer: {
-                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+        // The render passes that execute render bundles are left to RecordCommands because the
+        // commands of a bundle can't be iterated by several threads at once, and the empty ones
+        // because they have nothing to record.
+        bool hasCommands = false;
+        bool hasBundles = false;
+        uint32_t secondaryRenderPassCount = 0;
 
-                    // TODO(cwallez@chromium.org): get the index type from the last render pipeline
-                    // and rebind if needed on pipeline change
-                    ASSERT(lastPipeline != nullptr);
-                    VkIndexType indexType =
-                        VulkanIndexType(lastPipeline->GetVertexInputDescriptor()->indexFormat);
-                    device->fn.CmdBindIndexBuffer(
-                        commands, indexBuffer, static_cast<VkDeviceSize>(cmd->offset), indexType);
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::BeginComputePass: {
+                    mSecondaryRenderPasses.push_back({});
+                    SkipCommand(&mCommands, type);
                 } break;
 
-                case Command::SetRenderPipeline: {
-                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                case Command::BeginRenderPass: {
+                    BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
 
-                    device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                               pipeline->GetHandle());
-                    lastPipeline = pipeline;
+                    SecondaryRenderPass renderPass;
+                    DAWN_TRY_ASSIGN(renderPass.compatibleRenderPass,
+                                    GetCompatibleRenderPass(device, cmd));
+                    renderPass.width = cmd->width;
+                    renderPass.height = cmd->height;
+                    mSecondaryRenderPasses.push_back(renderPass);
 
-                    descriptorSets.OnSetPipeline(pipeline);
+                    hasCommands = false;
+                    hasBundles = false;
                 } break;
 
-                case Command::SetVertexBuffer: {
-                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                    VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    if (hasCommands && !hasBundles) {
+                        secondaryRenderPassCount++;
+                    } else {
+                        mSecondaryRenderPasses.back().compatibleRenderPass = VK_NULL_HANDLE;
+                    }
+                } break;
 
-                    device->fn.CmdBindVertexBuffers(commands, cmd->slot, 1, &buffer, &offset);
+                case Command::ExecuteBundles: {
+                    hasBundles = true;
+                    SkipCommand(&mCommands, type);
                 } break;
 
-                default:
-                    UNREACHABLE();
-                    break;
+                default: {
+                    hasCommands = true;
+                    SkipCommand(&mCommands, type);
+                } break;
             }
-        };
+        }
+        mCommands.Reset();
+
+        if (secondaryRenderPassCount == 0) {
+            return {};
+        }
+
+        std::vector<VkCommandBuffer> commandBuffers;
+        DAWN_TRY_ASSIGN(commandBuffers,
+                        device->GetSecondaryCommandBuffers(secondaryRenderPassCount));
+
+        uint32_t nextCommandBuffer = 0;
+        for (SecondaryRenderPass& renderPass : mSecondaryRenderPasses) {
+            if (renderPass.compatibleRenderPass != VK_NULL_HANDLE) {
+                renderPass.commandBuffer = commandBuffers[nextCommandBuffer++];
+            }
+        }
+        ASSERT(nextCommandBuffer == secondaryRenderPassCount);
+
+        return {};
+    }
+
+    bool CommandBuffer::HasSecondaryRenderPasses() const {
+        for (const SecondaryRenderPass& renderPass : mSecondaryRenderPasses) {
+            if (renderPass.commandBuffer != VK_NULL_HANDLE) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void CommandBuffer::DiscardSecondaryRenderPasses() {
+        mSecondaryRenderPasses.clear();
+    }
+
+    MaybeError CommandBuffer::RecordSecondaryRenderPasses() {
+        size_t nextPassNumber = 0;
 
         Command type;
         while (mCommands.NextCommandId(&type)) {
             switch (type) {
-                case Command::EndRenderPass: {
-                    mCommands.NextCommand<EndRenderPassCmd>();
-                    device->fn.CmdEndRenderPass(commands);
-                    return {};
+                case Command::BeginComputePass: {
+                    SkipCommand(&mCommands, type);
+                    nextPassNumber++;
                 } break;
 
-                case Command::SetBlendColor: {
-                    SetBlendColorCmd* cmd = mCommands.NextCommand<SetBlendColorCmd>();
-                    float blendConstants[4] = {
-                        cmd->color.r,
-                        cmd->color.g,
-                        cmd->color.b,
-                        cmd->color.a,
-                    };
-                    device->fn.CmdSetBlendConstants(commands, blendConstants);
-                } break;
+                case Command::BeginRenderPass: {
+                    mCommands.NextCommand<BeginRenderPassCmd>();
 
-                case Command::SetStencilReference: {
-                    SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
-                                                      cmd->reference);
+                    const SecondaryRenderPass& renderPass = mSecondaryRenderPasses[nextPassNumber];
+                    if (renderPass.commandBuffer != VK_NULL_HANDLE) {
+                        DAWN_TRY(RecordRenderPassContents(renderPass));
+                    }
+                    nextPassNumber++;
                 } break;
 
-                case Command::SetViewport: {
-                    SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                    VkViewport viewport;
-                    viewport.x = cmd->x;
-                    viewport.y = cmd->y + cmd->height;
-                    viewport.width = cmd->width;
-                    viewport.height = -cmd->height;
-                    viewport.minDepth = cmd->minDepth;
-                    viewport.maxDepth = cmd->maxDepth;
+                default: { SkipCommand(&mCommands, type); } break;
+            }
+        }
+        mCommands.Reset();
 
-                    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-                } break;
+        return {};
+    }
 
-                case Command::SetScissorRect: {
-                    SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                    VkRect2D rect;
-                    rect.offset.x = cmd->x;
-                    rect.offset.y = cmd->y;
-                    rect.extent.width = cmd->width;
-                    rect.extent.height = cmd->height;
+    MaybeError CommandBuffer::RecordRenderPassContents(const SecondaryRenderPass& renderPass) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = renderPass.commandBuffer;
 
-                    device->fn.CmdSetScissor(commands, 0, 1, &rect);
-                } break;
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = renderPass.compatibleRenderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
 
-                case Command::ExecuteBundles: {
-                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
-                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                          VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
 
-                    for (uint32_t i = 0; i < cmd->count; ++i) {
-                        CommandIterator* iter = bundles[i]->GetCommands();
-                        iter->Reset();
-                        while (iter->NextCommandId(&type)) {
-                            EncodeRenderBundleCommand(iter, type);
-                        }
-                    }
+        DAWN_TRY(CheckVkSuccess(device->fn.BeginCommandBuffer(commands, &beginInfo),
+                                "vkBeginCommandBuffer"));
+
+        RecordDefaultDynamicState(device, commands, renderPass.width, renderPass.height);
+
+        RenderCommandState state;
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndRenderPass: {
+                    mCommands.NextCommand<EndRenderPassCmd>();
+                    return CheckVkSuccess(device->fn.EndCommandBuffer(commands),
+                                          "vkEndCommandBuffer");
                 } break;
 
-                default: { EncodeRenderBundleCommand(&mCommands, type); } break;
+                default: {
+                    EncodeRenderPassCommand(device, commands, &state, &mCommands, type);
+                } break;
             }
         }
 
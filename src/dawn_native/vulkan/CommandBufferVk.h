@@ -21,6 +21,8 @@
 
 #include "common/vulkan_platform.h"
 
+#include <vector>
+
 namespace dawn_native {
     struct BeginRenderPassCmd;
     struct TextureCopy;
@@ -31,6 +33,14 @@ namespace dawn_native { namespace vulkan {
     struct CommandRecordingContext;
     class Device;
 
+    // Records the commands of `bundle` in `commands`, a secondary command buffer that starts
+    // without any state, for a render pass of the given size.
+    void RecordRenderBundleCommands(Device* device,
+                                    VkCommandBuffer commands,
+                                    RenderBundleBase* bundle,
+                                    uint32_t width,
+                                    uint32_t height);
+
     class CommandBuffer : public CommandBufferBase {
       public:
         static CommandBuffer* Create(CommandEncoderBase* encoder,
@@ -39,18 +49,43 @@ namespace dawn_native { namespace vulkan {
 
         MaybeError RecordCommands(CommandRecordingContext* recordingContext);
 
+        // The render passes without render bundles can be recorded in secondary command buffers
+        // on another thread before RecordCommands, which then only executes them. They are found
+        // by PrepareSecondaryRenderPasses on the thread using the device, and recorded by
+        // RecordSecondaryRenderPasses on any thread. If the submit fails before RecordCommands,
+        // they must be discarded so that a later submit doesn't execute them.
+        MaybeError PrepareSecondaryRenderPasses();
+        bool HasSecondaryRenderPasses() const;
+        MaybeError RecordSecondaryRenderPasses();
+        void DiscardSecondaryRenderPasses();
+
       private:
         CommandBuffer(CommandEncoderBase* encoder, const CommandBufferDescriptor* descriptor);
 
         void RecordComputePass(CommandRecordingContext* recordingContext);
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
                                     BeginRenderPassCmd* renderPass);
+        MaybeError RecordRenderPassWithOnlyBundles(CommandRecordingContext* recordingContext,
+                                                   BeginRenderPassCmd* renderPass);
+        MaybeError RecordSecondaryRenderPass(CommandRecordingContext* recordingContext,
+                                             BeginRenderPassCmd* renderPass,
+                                             VkCommandBuffer secondaryCommands);
         void RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                 const TextureCopy& srcCopy,
                                                 const TextureCopy& dstCopy,
                                                 const Extent3D& copySize);
 
+        struct SecondaryRenderPass {
+            VkRenderPass compatibleRenderPass = VK_NULL_HANDLE;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        };
+        MaybeError RecordRenderPassContents(const SecondaryRenderPass& renderPass);
+
         CommandIterator mCommands;
+        // One per pass, with a null command buffer for the passes recorded by RecordCommands.
+        std::vector<SecondaryRenderPass> mSecondaryRenderPasses;
     };
 
 }}  // namespace dawn_native::vulkan
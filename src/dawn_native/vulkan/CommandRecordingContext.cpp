@@ -0,0 +1,77 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/CommandRecordingContext.h"
+
+#include "dawn_native/DeviceStatistics.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+
+namespace dawn_native { namespace vulkan {
+
+    void CommandRecordingContext::AddBufferBarrier(Device* device,
+                                                   VkPipelineStageFlags srcStages,
+                                                   VkPipelineStageFlags dstStages,
+                                                   const VkBufferMemoryBarrier& barrier) {
+        // The barriers of a vkCmdPipelineBarrier aren't ordered with each other so a second
+        // transition of the same buffer has to go in the next one.
+        for (VkBufferMemoryBarrier& pending : bufferBarriers) {
+            if (pending.buffer == barrier.buffer) {
+                FlushBarriers(device);
+                break;
+            }
+        }
+
+        barrierSrcStages |= srcStages;
+        barrierDstStages |= dstStages;
+        bufferBarriers.push_back(barrier);
+    }
+
+    void CommandRecordingContext::AddImageBarrier(Device* device,
+                                                  VkPipelineStageFlags srcStages,
+                                                  VkPipelineStageFlags dstStages,
+                                                  const VkImageMemoryBarrier& barrier) {
+        for (VkImageMemoryBarrier& pending : imageBarriers) {
+            if (pending.image == barrier.image) {
+                FlushBarriers(device);
+                break;
+            }
+        }
+
+        barrierSrcStages |= srcStages;
+        barrierDstStages |= dstStages;
+        imageBarriers.push_back(barrier);
+    }
+
+    void CommandRecordingContext::FlushBarriers(Device* device) {
+        size_t barrierCount = bufferBarriers.size() + imageBarriers.size();
+        if (barrierCount == 0) {
+            return;
+        }
+
+        device->fn.CmdPipelineBarrier(
+            commandBuffer, barrierSrcStages, barrierDstStages, 0, 0, nullptr,
+            static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+            static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+        DeviceCounters* counters = device->GetCounters();
+        counters->vulkanBarriersIssued.Increment();
+        counters->vulkanBarriersMerged.Increment(barrierCount - 1);
+
+        barrierSrcStages = 0;
+        barrierDstStages = 0;
+        bufferBarriers.clear();
+        imageBarriers.clear();
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -22,9 +22,10 @@
 
 namespace dawn_native { namespace vulkan {
     class Buffer;
+    class Device;
 
-    // Used to track operations that are handled after recording.
-    // Currently only tracks semaphores, but may be used to do barrier coalescing in the future.
+    // Used to track operations that are handled after recording: the semaphores of the submit
+    // and the pipeline barriers that are coalesced until the next command that depends on them.
     struct CommandRecordingContext {
         VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
         std::vector<VkSemaphore> waitSemaphores = {};
@@ -34,6 +35,24 @@ namespace dawn_native { namespace vulkan {
         // formats.
         std::vector<Ref<Buffer>> tempBuffers;
 
+        // The barriers added by the resource transitions are only recorded by FlushBarriers, as a
+        // single vkCmdPipelineBarrier with the union of their stages. It must be called before
+        // recording any command that uses the transitioned resources.
+        void AddBufferBarrier(Device* device,
+                              VkPipelineStageFlags srcStages,
+                              VkPipelineStageFlags dstStages,
+                              const VkBufferMemoryBarrier& barrier);
+        void AddImageBarrier(Device* device,
+                             VkPipelineStageFlags srcStages,
+                             VkPipelineStageFlags dstStages,
+                             const VkImageMemoryBarrier& barrier);
+        void FlushBarriers(Device* device);
+
+        VkPipelineStageFlags barrierSrcStages = 0;
+        VkPipelineStageFlags barrierDstStages = 0;
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+
         // For Device state tracking only.
         VkCommandPool commandPool = VK_NULL_HANDLE;
         bool used = false;
@@ -29,8 +29,10 @@
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QueueVk.h"
+#include "dawn_native/vulkan/RenderBundleVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/SamplerVk.h"
@@ -39,6 +41,7 @@
 #include "dawn_native/vulkan/SwapChainVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -70,11 +73,16 @@ namespace dawn_native { namespace vulkan {
         mMapRequestTracker = std::make_unique<MapRequestTracker>(this);
         mMemoryAllocator = std::make_unique<MemoryAllocator>(this);
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
+        mFramebufferCache = std::make_unique<FramebufferCache>(this);
         mResourceAllocator = std::make_unique<MemoryResourceAllocator>(this);
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
         mExternalSemaphoreService = std::make_unique<external_semaphore::Service>(this);
 
+        if (IsToggleEnabled(Toggle::RecordVulkanCommandsInParallel)) {
+            mWorkerPool = std::make_unique<WorkerPool>(WorkerPool::GetDefaultThreadCount());
+        }
+
         DAWN_TRY(PrepareRecordingContext());
 
         return {};
@@ -118,6 +126,13 @@ namespace dawn_native { namespace vulkan {
         }
         mUnusedCommands.clear();
 
+        ASSERT(mSecondaryCommandsInFlight.Empty());
+        for (const CommandPoolAndSecondaryBuffers& commands : mUnusedSecondaryCommands) {
+            fn.DestroyCommandPool(mVkDevice, commands.pool, nullptr);
+        }
+        mUnusedSecondaryCommands.clear();
+        mWorkerPool = nullptr;
+
         ASSERT(mRecordingContext.waitSemaphores.empty());
         ASSERT(mRecordingContext.signalSemaphores.empty());
 
@@ -129,6 +144,10 @@ namespace dawn_native { namespace vulkan {
         // Free services explicitly so that they can free Vulkan objects before vkDestroyDevice
         mDynamicUploader = nullptr;
 
+        // The VkFramebuffers in the cache can be destroyed immediately since all commands
+        // referring to them are guaranteed to be finished executing.
+        mFramebufferCache = nullptr;
+
         // Releasing the uploader enqueues buffers to be released.
         // Call Tick() again to clear them before releasing the deleter.
         mDeleter->Tick(mCompletedSerial);
@@ -163,6 +182,12 @@ namespace dawn_native { namespace vulkan {
                                                    const CommandBufferDescriptor* descriptor) {
         return CommandBuffer::Create(encoder, descriptor);
     }
+    RenderBundleBase* Device::CreateRenderBundle(RenderBundleEncoderBase* encoder,
+                                                 const RenderBundleDescriptor* descriptor,
+                                                 AttachmentState* attachmentState,
+                                                 PassResourceUsage resourceUsage) {
+        return new RenderBundle(encoder, descriptor, attachmentState, std::move(resourceUsage));
+    }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
         return ComputePipeline::Create(this, descriptor);
@@ -271,6 +296,10 @@ namespace dawn_native { namespace vulkan {
         return mRenderPassCache.get();
     }
 
+    FramebufferCache* Device::GetFramebufferCache() const {
+        return mFramebufferCache.get();
+    }
+
     CommandRecordingContext* Device::GetPendingRecordingContext() {
         ASSERT(mRecordingContext.commandBuffer != VK_NULL_HANDLE);
         mRecordingContext.used = true;
@@ -281,7 +310,12 @@ namespace dawn_native { namespace vulkan {
         if (!mRecordingContext.used) {
             return {};
         }
+        TRACE_EVENT0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                     "DeviceVk::SubmitPendingCommands");
 
+        // Transitions done outside of commands, like the ones for mapping or presenting, are
+        // only recorded at the end of the command buffer.
+        mRecordingContext.FlushBarriers(this);
         DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
                                 "vkEndCommandBuffer"));
 
@@ -308,6 +342,10 @@ namespace dawn_native { namespace vulkan {
         mLastSubmittedSerial++;
         mFencesInFlight.emplace(fence, mLastSubmittedSerial);
 
+        // The end is recorded when the fence is seen as signaled by CheckPassedFences.
+        TRACE_EVENT_ASYNC_BEGIN0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                 "DeviceVk::SubmitPendingCommands", mLastSubmittedSerial);
+
         CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                                   mRecordingContext.commandBuffer};
         mCommandsInFlight.Enqueue(submittedCommands, mLastSubmittedSerial);
@@ -485,6 +523,9 @@ namespace dawn_native { namespace vulkan {
             mUnusedFences.push_back(fence);
             mFencesInFlight.pop();
 
+            TRACE_EVENT_ASYNC_END0(GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                                   "DeviceVk::SubmitPendingCommands", fenceSerial);
+
             ASSERT(fenceSerial > mCompletedSerial);
             mCompletedSerial = fenceSerial;
         }
@@ -544,6 +585,63 @@ namespace dawn_native { namespace vulkan {
             mUnusedCommands.push_back(commands);
         }
         mCommandsInFlight.ClearUpTo(mCompletedSerial);
+
+        for (auto& commands : mSecondaryCommandsInFlight.IterateUpTo(mCompletedSerial)) {
+            mUnusedSecondaryCommands.push_back(std::move(commands));
+        }
+        mSecondaryCommandsInFlight.ClearUpTo(mCompletedSerial);
+    }
+
+    WorkerPool* Device::GetWorkerPool() const {
+        return mWorkerPool.get();
+    }
+
+    ResultOrError<std::vector<VkCommandBuffer>> Device::GetSecondaryCommandBuffers(
+        uint32_t count) {
+        CommandPoolAndSecondaryBuffers commands;
+
+        // First try to recycle unused command pools, which resets their command buffers too.
+        if (!mUnusedSecondaryCommands.empty()) {
+            commands = std::move(mUnusedSecondaryCommands.back());
+            mUnusedSecondaryCommands.pop_back();
+            DAWN_TRY(CheckVkSuccess(fn.ResetCommandPool(mVkDevice, commands.pool, 0),
+                                    "vkResetCommandPool"));
+        } else {
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            createInfo.queueFamilyIndex = mQueueFamily;
+
+            DAWN_TRY(CheckVkSuccess(
+                fn.CreateCommandPool(mVkDevice, &createInfo, nullptr, &commands.pool),
+                "vkCreateCommandPool"));
+        }
+
+        size_t allocatedCount = commands.commandBuffers.size();
+        if (allocatedCount < count) {
+            commands.commandBuffers.resize(count);
+
+            VkCommandBufferAllocateInfo allocateInfo;
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.pNext = nullptr;
+            allocateInfo.commandPool = commands.pool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocateInfo.commandBufferCount = static_cast<uint32_t>(count - allocatedCount);
+
+            VkResult result = fn.AllocateCommandBuffers(mVkDevice, &allocateInfo,
+                                                        &commands.commandBuffers[allocatedCount]);
+            if (result != VK_SUCCESS) {
+                // Destroying the pool frees the command buffers allocated from it.
+                fn.DestroyCommandPool(mVkDevice, commands.pool, nullptr);
+            }
+            DAWN_TRY(CheckVkSuccess(result, "vkAllocateCommandBuffers"));
+        }
+
+        std::vector<VkCommandBuffer> commandBuffers(commands.commandBuffers.begin(),
+                                                    commands.commandBuffers.begin() + count);
+        mSecondaryCommandsInFlight.Enqueue(std::move(commands), GetPendingCommandSerial());
+        return std::move(commandBuffers);
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
@@ -570,6 +668,7 @@ namespace dawn_native { namespace vulkan {
         // Insert pipeline barrier to ensure correct ordering with previous memory operations on the
         // buffer.
         ToBackend(destination)->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopyDst);
+        recordingContext->FlushBarriers(this);
 
         VkBufferCopy copy;
         copy.srcOffset = sourceOffset;
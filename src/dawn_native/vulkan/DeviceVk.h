@@ -20,6 +20,7 @@
 #include "common/Serial.h"
 #include "common/SerialQueue.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/WorkerPool.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/Forward.h"
 #include "dawn_native/vulkan/MemoryResourceAllocatorVk.h"
@@ -38,6 +39,7 @@ namespace dawn_native { namespace vulkan {
     class BufferUploader;
     struct ExternalImageDescriptor;
     class FencedDeleter;
+    class FramebufferCache;
     class MapRequestTracker;
     class MemoryAllocator;
     class RenderPassCache;
@@ -63,11 +65,20 @@ namespace dawn_native { namespace vulkan {
         MapRequestTracker* GetMapRequestTracker() const;
         MemoryAllocator* GetMemoryAllocator() const;
         RenderPassCache* GetRenderPassCache() const;
+        FramebufferCache* GetFramebufferCache() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         Serial GetPendingCommandSerial() const override;
         MaybeError SubmitPendingCommands();
 
+        // The pool recording command buffers on other threads, nullptr unless
+        // record_vulkan_commands_in_parallel is enabled.
+        WorkerPool* GetWorkerPool() const;
+        // Returns `count` secondary command buffers allocated from the same command pool, so that
+        // another thread can record them while this one records other commands. They must be
+        // executed by the pending commands, after which their pool is reset and they are reused.
+        ResultOrError<std::vector<VkCommandBuffer>> GetSecondaryCommandBuffers(uint32_t count);
+
         TextureBase* CreateTextureWrappingVulkanImage(
             const ExternalImageDescriptor* descriptor,
             ExternalMemoryHandle memoryHandle,
@@ -79,6 +90,10 @@ namespace dawn_native { namespace vulkan {
         // Dawn API
         CommandBufferBase* CreateCommandBuffer(CommandEncoderBase* encoder,
                                                const CommandBufferDescriptor* descriptor) override;
+        RenderBundleBase* CreateRenderBundle(RenderBundleEncoderBase* encoder,
+                                             const RenderBundleDescriptor* descriptor,
+                                             AttachmentState* attachmentState,
+                                             PassResourceUsage resourceUsage) override;
 
         Serial GetCompletedCommandSerial() const final override;
         Serial GetLastSubmittedCommandSerial() const final override;
@@ -139,6 +154,7 @@ namespace dawn_native { namespace vulkan {
         std::unique_ptr<MapRequestTracker> mMapRequestTracker;
         std::unique_ptr<MemoryAllocator> mMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<FramebufferCache> mFramebufferCache;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
@@ -166,6 +182,16 @@ namespace dawn_native { namespace vulkan {
         SerialQueue<CommandPoolAndBuffer> mCommandsInFlight;
         // Command pools in the unused list haven't been reset yet.
         std::vector<CommandPoolAndBuffer> mUnusedCommands;
+
+        struct CommandPoolAndSecondaryBuffers {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> commandBuffers;
+        };
+        SerialQueue<CommandPoolAndSecondaryBuffers> mSecondaryCommandsInFlight;
+        // Like mUnusedCommands, the pools in the unused list haven't been reset yet.
+        std::vector<CommandPoolAndSecondaryBuffers> mUnusedSecondaryCommands;
+        std::unique_ptr<WorkerPool> mWorkerPool;
+
         // There is always a valid recording context stored in mRecordingContext
         CommandRecordingContext mRecordingContext;
 
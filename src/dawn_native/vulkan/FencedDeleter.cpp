@@ -23,6 +23,7 @@ namespace dawn_native { namespace vulkan {
 
     FencedDeleter::~FencedDeleter() {
         ASSERT(mBuffersToDelete.Empty());
+        ASSERT(mCommandPoolsToDelete.Empty());
         ASSERT(mDescriptorPoolsToDelete.Empty());
         ASSERT(mFramebuffersToDelete.Empty());
         ASSERT(mImagesToDelete.Empty());
@@ -42,6 +43,10 @@ namespace dawn_native { namespace vulkan {
         mBuffersToDelete.Enqueue(buffer, mDevice->GetPendingCommandSerial());
     }
 
+    void FencedDeleter::DeleteWhenUnused(VkCommandPool pool) {
+        mCommandPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
+    }
+
     void FencedDeleter::DeleteWhenUnused(VkDescriptorPool pool) {
         mDescriptorPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
     }
@@ -129,6 +134,12 @@ namespace dawn_native { namespace vulkan {
         }
         mFramebuffersToDelete.ClearUpTo(completedSerial);
 
+        // Destroying the command pools frees the command buffers allocated from them.
+        for (VkCommandPool pool : mCommandPoolsToDelete.IterateUpTo(completedSerial)) {
+            mDevice->fn.DestroyCommandPool(vkDevice, pool, nullptr);
+        }
+        mCommandPoolsToDelete.ClearUpTo(completedSerial);
+
         for (VkImageView view : mImageViewsToDelete.IterateUpTo(completedSerial)) {
             mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
         }
@@ -28,6 +28,7 @@ namespace dawn_native { namespace vulkan {
         ~FencedDeleter();
 
         void DeleteWhenUnused(VkBuffer buffer);
+        void DeleteWhenUnused(VkCommandPool pool);
         void DeleteWhenUnused(VkDescriptorPool pool);
         void DeleteWhenUnused(VkDeviceMemory memory);
         void DeleteWhenUnused(VkFramebuffer framebuffer);
@@ -47,6 +48,7 @@ namespace dawn_native { namespace vulkan {
       private:
         Device* mDevice = nullptr;
         SerialQueue<VkBuffer> mBuffersToDelete;
+        SerialQueue<VkCommandPool> mCommandPoolsToDelete;
         SerialQueue<VkDescriptorPool> mDescriptorPoolsToDelete;
         SerialQueue<VkDeviceMemory> mMemoriesToDelete;
         SerialQueue<VkFramebuffer> mFramebuffersToDelete;
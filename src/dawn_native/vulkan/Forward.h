@@ -28,6 +28,7 @@ namespace dawn_native { namespace vulkan {
     class Device;
     class PipelineLayout;
     class Queue;
+    class RenderBundle;
     class RenderPipeline;
     class ResourceMemory;
     class Sampler;
@@ -47,6 +48,7 @@ namespace dawn_native { namespace vulkan {
         using DeviceType = Device;
         using PipelineLayoutType = PipelineLayout;
         using QueueType = Queue;
+        using RenderBundleType = RenderBundle;
         using RenderPipelineType = RenderPipeline;
         using ResourceHeapType = ResourceMemory;
         using SamplerType = Sampler;
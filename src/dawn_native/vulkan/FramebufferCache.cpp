@@ -0,0 +1,143 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dawn_native/vulkan/FramebufferCache.h"
+
+#include "common/HashUtils.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+namespace dawn_native { namespace vulkan {
+
+    // FramebufferCacheQuery
+
+    void FramebufferCacheQuery::SetRenderPass(VkRenderPass renderPass,
+                                              uint32_t width,
+                                              uint32_t height) {
+        this->renderPass = renderPass;
+        this->width = width;
+        this->height = height;
+    }
+
+    void FramebufferCacheQuery::AddAttachment(VkImageView view) {
+        ASSERT(attachmentCount < kMaxFramebufferAttachments);
+        attachments[attachmentCount++] = view;
+    }
+
+    // FramebufferCache
+
+    FramebufferCache::FramebufferCache(Device* device) : mDevice(device) {
+    }
+
+    FramebufferCache::~FramebufferCache() {
+        for (auto& entry : mLRUList) {
+            mDevice->fn.DestroyFramebuffer(mDevice->GetVkDevice(), entry.second, nullptr);
+        }
+        mLRUList.clear();
+        mCache.clear();
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::GetFramebuffer(
+        const FramebufferCacheQuery& query) {
+        auto it = mCache.find(query);
+        if (it != mCache.end()) {
+            mLRUList.splice(mLRUList.begin(), mLRUList, it->second);
+            return VkFramebuffer(it->second->second);
+        }
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY_ASSIGN(framebuffer, CreateFramebufferForQuery(query));
+
+        if (mCache.size() >= kMaxCachedFramebuffers) {
+            Remove(mCache.find(mLRUList.back().first));
+        }
+        mLRUList.emplace_front(query, framebuffer);
+        mCache.emplace(query, mLRUList.begin());
+        return framebuffer;
+    }
+
+    void FramebufferCache::OnImageViewDestroyed(VkImageView view) {
+        for (auto it = mCache.begin(); it != mCache.end();) {
+            const FramebufferCacheQuery& query = it->first;
+
+            bool usesView = false;
+            for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+                usesView = usesView || query.attachments[i].GetU64() == view.GetU64();
+            }
+
+            auto next = std::next(it);
+            if (usesView) {
+                Remove(it);
+            }
+            it = next;
+        }
+    }
+
+    void FramebufferCache::Remove(Cache::iterator it) {
+        // The framebuffer may be used by commands that are being recorded or in flight.
+        mDevice->GetFencedDeleter()->DeleteWhenUnused(it->second->second);
+        mLRUList.erase(it->second);
+        mCache.erase(it);
+    }
+
+    ResultOrError<VkFramebuffer> FramebufferCache::CreateFramebufferForQuery(
+        const FramebufferCacheQuery& query) const {
+        VkFramebufferCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.renderPass = query.renderPass;
+        createInfo.attachmentCount = query.attachmentCount;
+        createInfo.pAttachments = query.attachments.data();
+        createInfo.width = query.width;
+        createInfo.height = query.height;
+        createInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateFramebuffer(mDevice->GetVkDevice(), &createInfo,
+                                                              nullptr, &framebuffer),
+                                "CreateFramebuffer"));
+        return framebuffer;
+    }
+
+    size_t FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& query) const {
+        size_t hash = Hash(query.renderPass.GetU64());
+
+        HashCombine(&hash, query.width, query.height, query.attachmentCount);
+        for (uint32_t i = 0; i < query.attachmentCount; ++i) {
+            HashCombine(&hash, query.attachments[i].GetU64());
+        }
+
+        return hash;
+    }
+
+    bool FramebufferCache::CacheFuncs::operator()(const FramebufferCacheQuery& a,
+                                                  const FramebufferCacheQuery& b) const {
+        if (a.renderPass.GetU64() != b.renderPass.GetU64() || a.width != b.width ||
+            a.height != b.height || a.attachmentCount != b.attachmentCount) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < a.attachmentCount; ++i) {
+            if (a.attachments[i].GetU64() != b.attachments[i].GetU64()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,92 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+#define DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
+
+#include "common/Constants.h"
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // Render passes have a color, a depth-stencil and a resolve attachment per color attachment.
+    static constexpr uint32_t kMaxFramebufferAttachments = kMaxColorAttachments * 2 + 1;
+
+    // This is a key to query the FramebufferCache. Only the first attachmentCount attachments
+    // need to be initialized.
+    struct FramebufferCacheQuery {
+        void SetRenderPass(VkRenderPass renderPass, uint32_t width, uint32_t height);
+        void AddAttachment(VkImageView view);
+
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        uint32_t attachmentCount = 0;
+        std::array<VkImageView, kMaxFramebufferAttachments> attachments;
+    };
+
+    // Caches VkFramebuffers so that render passes to the same attachments don't create a new
+    // one each time. A framebuffer is removed from the cache when one of its image views is
+    // destroyed, so that a view created with the same handle can't be attached through a stale
+    // framebuffer. The cache keeps at most kMaxCachedFramebuffers framebuffers and evicts the
+    // least recently used ones first. Framebuffers removed from the cache are deleted once the
+    // commands that may use them are finished.
+    class FramebufferCache {
+      public:
+        static constexpr size_t kMaxCachedFramebuffers = 256;
+
+        FramebufferCache(Device* device);
+        ~FramebufferCache();
+
+        ResultOrError<VkFramebuffer> GetFramebuffer(const FramebufferCacheQuery& query);
+
+        void OnImageViewDestroyed(VkImageView view);
+
+      private:
+        // Does the actual VkFramebuffer creation on a cache miss.
+        ResultOrError<VkFramebuffer> CreateFramebufferForQuery(
+            const FramebufferCacheQuery& query) const;
+
+        // Implements the functors necessary for to use FramebufferCacheQueries as unordered_map
+        // keys.
+        struct CacheFuncs {
+            size_t operator()(const FramebufferCacheQuery& query) const;
+            bool operator()(const FramebufferCacheQuery& a, const FramebufferCacheQuery& b) const;
+        };
+
+        // The cached framebuffers, from the most recently used to the least recently used.
+        using LRUList = std::list<std::pair<FramebufferCacheQuery, VkFramebuffer>>;
+        using Cache =
+            std::unordered_map<FramebufferCacheQuery, LRUList::iterator, CacheFuncs, CacheFuncs>;
+
+        void Remove(Cache::iterator it);
+
+        Device* mDevice = nullptr;
+        LRUList mLRUList;
+        Cache mCache;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_FRAMEBUFFERCACHE_H_
@@ -14,12 +14,98 @@
 
 #include "dawn_native/vulkan/QueueVk.h"
 
+#include "dawn_native/ErrorData.h"
+#include "dawn_native/WorkerPool.h"
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
 
 namespace dawn_native { namespace vulkan {
 
+    namespace {
+
+        // The secondary command buffers that RecordCommands didn't execute must not be executed
+        // by a later submit, since their pool is reset once the commands of this one complete.
+        void DiscardSecondaryRenderPasses(uint32_t commandCount,
+                                          CommandBufferBase* const* commands) {
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                ToBackend(commands[i])->DiscardSecondaryRenderPasses();
+            }
+        }
+
+        // Records the render passes of the command buffers in secondary command buffers, with one
+        // task per command buffer because the commands of a command buffer can only be iterated
+        // by one thread. This thread runs the first task while the worker pool runs the others,
+        // and the secondary command buffers are all recorded when this returns.
+        MaybeError RecordSecondaryRenderPassesInParallel(Device* device,
+                                                         uint32_t commandCount,
+                                                         CommandBufferBase* const* commands) {
+            std::vector<CommandBuffer*> commandBuffers;
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                // The same command buffer can be submitted several times.
+                CommandBuffer* commandBuffer = ToBackend(commands[i]);
+                if (std::find(commandBuffers.begin(), commandBuffers.end(), commandBuffer) !=
+                    commandBuffers.end()) {
+                    continue;
+                }
+
+                MaybeError result = commandBuffer->PrepareSecondaryRenderPasses();
+                if (result.IsError()) {
+                    DiscardSecondaryRenderPasses(commandCount, commands);
+                    return result;
+                }
+                if (commandBuffer->HasSecondaryRenderPasses()) {
+                    commandBuffers.push_back(commandBuffer);
+                }
+            }
+
+            std::vector<ErrorData*> errors(commandBuffers.size(), nullptr);
+            auto RecordTask = [&commandBuffers, &errors](size_t index) {
+                MaybeError result = commandBuffers[index]->RecordSecondaryRenderPasses();
+                if (result.IsError()) {
+                    errors[index] = result.AcquireError();
+                }
+            };
+
+            std::vector<std::future<void>> tasks;
+            for (size_t i = 1; i < commandBuffers.size(); ++i) {
+                tasks.push_back(device->GetWorkerPool()->PostTask([&RecordTask, i]() {
+                    RecordTask(i);
+                }));
+            }
+            if (!commandBuffers.empty()) {
+                RecordTask(0);
+            }
+            for (std::future<void>& task : tasks) {
+                task.wait();
+            }
+
+            // The first error is returned and the others are only reported to the device. None of
+            // the secondary command buffers are executed then, since the submit fails.
+            ErrorData* firstError = nullptr;
+            for (ErrorData* error : errors) {
+                if (error == nullptr) {
+                    continue;
+                }
+                if (firstError == nullptr) {
+                    firstError = error;
+                } else {
+                    device->ConsumedError(MaybeError(error));
+                }
+            }
+            if (firstError != nullptr) {
+                DiscardSecondaryRenderPasses(commandCount, commands);
+            }
+            return MaybeError(firstError);
+        }
+
+    }  // anonymous namespace
+
     // static
     Queue* Queue::Create(Device* device) {
         return new Queue(device);
@@ -34,8 +120,21 @@ namespace dawn_native { namespace vulkan {
         device->Tick();
 
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
-        for (uint32_t i = 0; i < commandCount; ++i) {
-            DAWN_TRY(ToBackend(commands[i])->RecordCommands(recordingContext));
+        if (device->GetWorkerPool() != nullptr && commandCount > 1) {
+            TRACE_EVENT0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                         "CommandBufferVk::RecordSecondaryRenderPasses");
+            DAWN_TRY(RecordSecondaryRenderPassesInParallel(device, commandCount, commands));
+        }
+        {
+            TRACE_EVENT0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
+                         "CommandBufferVk::RecordCommands");
+            for (uint32_t i = 0; i < commandCount; ++i) {
+                MaybeError result = ToBackend(commands[i])->RecordCommands(recordingContext);
+                if (result.IsError()) {
+                    DiscardSecondaryRenderPasses(commandCount, commands);
+                    return result;
+                }
+            }
         }
 
         DAWN_TRY(device->SubmitPendingCommands());
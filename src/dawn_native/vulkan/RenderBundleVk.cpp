@@ -0,0 +1,114 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/RenderBundleVk.h"
+
+#include "dawn_native/vulkan/CommandBufferVk.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+namespace dawn_native { namespace vulkan {
+
+    RenderBundle::RenderBundle(RenderBundleEncoderBase* encoder,
+                               const RenderBundleDescriptor* descriptor,
+                               AttachmentState* attachmentState,
+                               PassResourceUsage resourceUsage)
+        : RenderBundleBase(encoder, descriptor, attachmentState, std::move(resourceUsage)) {
+    }
+
+    RenderBundle::~RenderBundle() {
+        if (mCommandPool != VK_NULL_HANDLE) {
+            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mCommandPool);
+            mCommandPool = VK_NULL_HANDLE;
+        }
+    }
+
+    ResultOrError<VkCommandBuffer> RenderBundle::GetSecondaryCommandBuffer(
+        VkRenderPass compatibleRenderPass,
+        uint32_t width,
+        uint32_t height) {
+        for (SecondaryCommandBuffer& secondary : mSecondaryCommandBuffers) {
+            if (secondary.renderPass == compatibleRenderPass && secondary.width == width &&
+                secondary.height == height) {
+                return secondary.commandBuffer;
+            }
+        }
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(commandBuffer,
+                        RecordSecondaryCommandBuffer(compatibleRenderPass, width, height));
+        mSecondaryCommandBuffers.push_back({compatibleRenderPass, width, height, commandBuffer});
+        return commandBuffer;
+    }
+
+    ResultOrError<VkCommandBuffer> RenderBundle::RecordSecondaryCommandBuffer(
+        VkRenderPass compatibleRenderPass,
+        uint32_t width,
+        uint32_t height) {
+        Device* device = ToBackend(GetDevice());
+
+        if (mCommandPool == VK_NULL_HANDLE) {
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.queueFamilyIndex = device->GetGraphicsQueueFamily();
+
+            DAWN_TRY(CheckVkSuccess(device->fn.CreateCommandPool(device->GetVkDevice(),
+                                                                 &createInfo, nullptr,
+                                                                 &mCommandPool),
+                                    "vkCreateCommandPool"));
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = mCommandPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.AllocateCommandBuffers(device->GetVkDevice(), &allocateInfo, &commandBuffer),
+            "vkAllocateCommandBuffers"));
+
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = compatibleRenderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        // The same command buffer is executed in every frame that executes the bundle, so it can
+        // be pending in several submits at once.
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                          VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        DAWN_TRY(CheckVkSuccess(device->fn.BeginCommandBuffer(commandBuffer, &beginInfo),
+                                "vkBeginCommandBuffer"));
+        RecordRenderBundleCommands(device, commandBuffer, this, width, height);
+        DAWN_TRY(CheckVkSuccess(device->fn.EndCommandBuffer(commandBuffer), "vkEndCommandBuffer"));
+
+        return commandBuffer;
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,70 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
+#define DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
+
+#include "dawn_native/RenderBundle.h"
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // Render bundles record their commands in secondary command buffers the first time they are
+    // executed in a render pass, so that later executions only need a vkCmdExecuteCommands. A
+    // secondary command buffer can only be executed in render passes compatible with the one it
+    // was recorded for, and it doesn't inherit the dynamic state of the render pass, so there is
+    // one for each compatible render pass and size of render pass the bundle is executed in.
+    class RenderBundle : public RenderBundleBase {
+      public:
+        RenderBundle(RenderBundleEncoderBase* encoder,
+                     const RenderBundleDescriptor* descriptor,
+                     AttachmentState* attachmentState,
+                     PassResourceUsage resourceUsage);
+        ~RenderBundle();
+
+        // Returns the secondary command buffer for render passes compatible with
+        // `compatibleRenderPass` that are of the given size, recording it if needed.
+        ResultOrError<VkCommandBuffer> GetSecondaryCommandBuffer(VkRenderPass compatibleRenderPass,
+                                                                 uint32_t width,
+                                                                 uint32_t height);
+
+      private:
+        ResultOrError<VkCommandBuffer> RecordSecondaryCommandBuffer(
+            VkRenderPass compatibleRenderPass,
+            uint32_t width,
+            uint32_t height);
+
+        struct SecondaryCommandBuffer {
+            VkRenderPass renderPass;
+            uint32_t width;
+            uint32_t height;
+            VkCommandBuffer commandBuffer;
+        };
+        // Bundles are executed in a handful of render passes at most so a vector is enough.
+        std::vector<SecondaryCommandBuffer> mSecondaryCommandBuffers;
+
+        // The command buffers are allocated from a pool owned by the bundle so that they are
+        // all freed with it once the GPU no longer uses them.
+        VkCommandPool mCommandPool = VK_NULL_HANDLE;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_RENDERBUNDLEVK_H_
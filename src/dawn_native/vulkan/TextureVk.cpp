@@ -24,6 +24,7 @@
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/FramebufferCache.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
@@ -663,9 +664,7 @@ namespace dawn_native { namespace vulkan {
                                                 mWaitRequirements.begin(), mWaitRequirements.end());
         mWaitRequirements.clear();
 
-        ToBackend(GetDevice())
-            ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, 1, &barrier);
+        recordingContext->AddImageBarrier(ToBackend(GetDevice()), srcStages, dstStages, barrier);
 
         mLastUsage = usage;
         mLastExternalState = mExternalState;
@@ -687,6 +686,7 @@ namespace dawn_native { namespace vulkan {
         uint8_t clearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0 : 1;
 
         TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+        recordingContext->FlushBarriers(device);
         if (GetFormat().isRenderable) {
             if (GetFormat().HasDepthOrStencil()) {
                 VkClearDepthStencilValue clearDepthStencilValue[1];
@@ -817,6 +817,9 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetTexture()->GetDevice());
 
         if (mHandle != VK_NULL_HANDLE) {
+            if (GetTexture()->GetUsage() & dawn::TextureUsage::OutputAttachment) {
+                device->GetFramebufferCache()->OnImageViewDestroyed(mHandle);
+            }
             device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
@@ -55,9 +55,8 @@ namespace dawn_native { namespace vulkan {
         VkImage GetHandle() const;
         VkImageAspectFlags GetVkAspectMask() const;
 
-        // Transitions the texture to be used as `usage`, recording any necessary barrier in
-        // `commands`.
-        // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
+        // Transitions the texture to be used as `usage`, adding any necessary barrier to the
+        // barriers of `recordingContext` that are recorded by its FlushBarriers.
         void TransitionUsageNow(CommandRecordingContext* recordingContext,
                                 dawn::TextureUsage usage);
         void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
@@ -22,7 +22,7 @@ namespace dawn_native { namespace vulkan {
 #define GET_GLOBAL_PROC(name)                                                          \
     name = reinterpret_cast<decltype(name)>(GetInstanceProcAddr(nullptr, "vk" #name)); \
     if (name == nullptr) {                                                             \
-        return DAWN_DEVICE_LOST_ERROR(std::string("Couldn't get proc vk") + #name);    \
+        return DAWN_DEVICE_LOST_ERROR("Couldn't get proc vk" #name);                   \
     }
 
     MaybeError VulkanFunctions::LoadGlobalProcs(const DynamicLib& vulkanLib) {
@@ -44,7 +44,7 @@ namespace dawn_native { namespace vulkan {
 #define GET_INSTANCE_PROC(name)                                                         \
     name = reinterpret_cast<decltype(name)>(GetInstanceProcAddr(instance, "vk" #name)); \
     if (name == nullptr) {                                                              \
-        return DAWN_DEVICE_LOST_ERROR(std::string("Couldn't get proc vk") + #name);     \
+        return DAWN_DEVICE_LOST_ERROR("Couldn't get proc vk" #name);                    \
     }
 
     MaybeError VulkanFunctions::LoadInstanceProcs(VkInstance instance,
@@ -115,7 +115,7 @@ namespace dawn_native { namespace vulkan {
 #define GET_DEVICE_PROC(name)                                                       \
     name = reinterpret_cast<decltype(name)>(GetDeviceProcAddr(device, "vk" #name)); \
     if (name == nullptr) {                                                          \
-        return DAWN_DEVICE_LOST_ERROR(std::string("Couldn't get proc vk") + #name); \
+        return DAWN_DEVICE_LOST_ERROR("Couldn't get proc vk" #name);                \
     }
 
     MaybeError VulkanFunctions::LoadDeviceProcs(VkDevice device,
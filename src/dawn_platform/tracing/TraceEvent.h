@@ -842,7 +842,7 @@ namespace dawn_platform { namespace TraceEvent {
 // structures so that it is portable to third_party libraries.
 #define INTERNAL_DECLARE_SET_TRACE_VALUE(actual_type, union_member, value_type_id) \
     static inline void setTraceValue(actual_type arg, unsigned char* type,         \
-                                     unsigned long long* value) {                  \
+                                     uint64_t* value) {                            \
         TraceValueUnion typeValue;                                                 \
         typeValue.union_member = arg;                                              \
         *type = value_type_id;                                                     \
@@ -851,16 +851,18 @@ namespace dawn_platform { namespace TraceEvent {
 // Simpler form for int types that can be safely casted.
 #define INTERNAL_DECLARE_SET_TRACE_VALUE_INT(actual_type, value_type_id)   \
     static inline void setTraceValue(actual_type arg, unsigned char* type, \
-                                     unsigned long long* value) {          \
+                                     uint64_t* value) {                    \
         *type = value_type_id;                                             \
         *value = static_cast<unsigned long long>(arg);                     \
     }
 
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(unsigned long long, TRACE_VALUE_TYPE_UINT)
+        INTERNAL_DECLARE_SET_TRACE_VALUE_INT(unsigned long, TRACE_VALUE_TYPE_UINT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(unsigned int, TRACE_VALUE_TYPE_UINT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(unsigned short, TRACE_VALUE_TYPE_UINT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(unsigned char, TRACE_VALUE_TYPE_UINT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(long long, TRACE_VALUE_TYPE_INT)
+        INTERNAL_DECLARE_SET_TRACE_VALUE_INT(long, TRACE_VALUE_TYPE_INT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(int, TRACE_VALUE_TYPE_INT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(short, TRACE_VALUE_TYPE_INT)
         INTERNAL_DECLARE_SET_TRACE_VALUE_INT(signed char, TRACE_VALUE_TYPE_INT)
@@ -877,7 +879,7 @@ namespace dawn_platform { namespace TraceEvent {
 
         static inline void setTraceValue(const std::string& arg,
                                          unsigned char* type,
-                                         unsigned long long* value) {
+                                         uint64_t* value) {
             TraceValueUnion typeValue;
             typeValue.m_string = arg.data();
             *type = TRACE_VALUE_TYPE_COPY_STRING;
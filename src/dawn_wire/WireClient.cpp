@@ -13,12 +13,17 @@
 // limitations under the License.
 
 #include "dawn_wire/WireClient.h"
+#include "common/Assert.h"
 #include "dawn_wire/client/Client.h"
 
+#include <cstring>
+
 namespace dawn_wire {
 
     WireClient::WireClient(const WireClientDescriptor& descriptor)
-        : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {
+        : mImpl(new client::Client(descriptor.serializer,
+                                   descriptor.memoryTransferService,
+                                   descriptor.coalesceReleases)) {
     }
 
     WireClient::~WireClient() {
@@ -41,6 +46,14 @@ namespace dawn_wire {
         return mImpl->ReserveTexture(device);
     }
 
+    WireStatistics WireClient::GetStatistics() const {
+        return mImpl->GetStatistics();
+    }
+
+    bool WireClient::Flush() {
+        return mImpl->Flush();
+    }
+
     namespace client {
         MemoryTransferService::~MemoryTransferService() = default;
 
@@ -57,6 +70,26 @@ namespace dawn_wire {
         MemoryTransferService::ReadHandle::~ReadHandle() = default;
 
         MemoryTransferService::WriteHandle::~WriteHandle() = default;
+
+        void MemoryTransferService::WriteHandle::SerializeFlushChunk(void* serializePointer,
+                                                                     size_t offset,
+                                                                     size_t size) {
+            size_t flushSize = SerializeFlushSize();
+            ASSERT(offset <= flushSize && size <= flushSize - offset);
+
+            if (offset == 0) {
+                mFlushChunkStorage = std::unique_ptr<uint8_t[]>(new uint8_t[flushSize]);
+                SerializeFlush(mFlushChunkStorage.get());
+            }
+            ASSERT(mFlushChunkStorage != nullptr);
+
+            memcpy(serializePointer, mFlushChunkStorage.get() + offset, size);
+
+            // Release the storage once the last chunk has been serialized.
+            if (offset + size == flushSize) {
+                mFlushChunkStorage = nullptr;
+            }
+        }
     }  // namespace client
 
 }  // namespace dawn_wire
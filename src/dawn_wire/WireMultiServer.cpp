@@ -0,0 +1,59 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireMultiServer.h"
+#include "dawn_wire/server/MultiServer.h"
+
+namespace dawn_wire {
+
+    WireMultiServer::WireMultiServer(const WireMultiServerDescriptor& descriptor)
+        : mImpl(new server::MultiServer(descriptor)) {
+    }
+
+    WireMultiServer::~WireMultiServer() {
+        mImpl.reset();
+    }
+
+    uint32_t WireMultiServer::AddClient(CommandSerializer* serializer) {
+        return mImpl->AddClient(serializer);
+    }
+
+    void WireMultiServer::RemoveClient(uint32_t clientId) {
+        mImpl->RemoveClient(clientId);
+    }
+
+    CommandHandler* WireMultiServer::GetCommandHandler(uint32_t clientId) {
+        return mImpl->GetCommandHandler(clientId);
+    }
+
+    bool WireMultiServer::InjectTexture(uint32_t clientId,
+                                        DawnTexture texture,
+                                        uint32_t id,
+                                        uint32_t generation) {
+        return mImpl->InjectTexture(clientId, texture, id, generation);
+    }
+
+    bool WireMultiServer::HandleQueuedCommands() {
+        return mImpl->HandleQueuedCommands();
+    }
+
+    bool WireMultiServer::HasQueuedCommands(uint32_t clientId) const {
+        return mImpl->HasQueuedCommands(clientId);
+    }
+
+    bool WireMultiServer::IsClientLost(uint32_t clientId) const {
+        return mImpl->IsClientLost(clientId);
+    }
+
+}  // namespace dawn_wire
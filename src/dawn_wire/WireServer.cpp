@@ -15,13 +15,17 @@
 #include "dawn_wire/WireServer.h"
 #include "dawn_wire/server/Server.h"
 
+#include <cstring>
+#include <new>
+
 namespace dawn_wire {
 
     WireServer::WireServer(const WireServerDescriptor& descriptor)
         : mImpl(new server::Server(descriptor.device,
                                    *descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {
+                                   descriptor.memoryTransferService,
+                                   descriptor.platform)) {
     }
 
     WireServer::~WireServer() {
@@ -32,6 +36,10 @@ namespace dawn_wire {
         return mImpl->HandleCommands(commands, size);
     }
 
+    WireStatistics WireServer::GetStatistics() const {
+        return mImpl->GetStatistics();
+    }
+
     bool WireServer::InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation) {
         return mImpl->InjectTexture(texture, id, generation);
     }
@@ -47,6 +55,50 @@ namespace dawn_wire {
             mTargetData = data;
             mDataLength = dataLength;
         }
+
+        size_t MemoryTransferService::WriteHandle::GetMaxFlushInfoSize() const {
+            return mDataLength;
+        }
+
+        bool MemoryTransferService::WriteHandle::DeserializeFlushChunk(
+            const void* deserializePointer,
+            size_t deserializeSize,
+            size_t offset,
+            size_t totalSize) {
+            if (deserializePointer == nullptr && deserializeSize != 0) {
+                return false;
+            }
+
+            // The total size comes from the client so it is bounded by the limit declared by the
+            // handle before anything is allocated for it.
+            if (totalSize > GetMaxFlushInfoSize()) {
+                mFlushChunkStorage = nullptr;
+                return false;
+            }
+
+            // The first chunk starts a new flush. Subsequent chunks must continue it in order.
+            if (offset == 0) {
+                // An allocation failure is caught by the null storage check below.
+                mFlushChunkStorage.reset(new (std::nothrow) uint8_t[totalSize]);
+                mFlushChunkOffset = 0;
+                mFlushChunkTotalSize = totalSize;
+            }
+            if (mFlushChunkStorage == nullptr || offset != mFlushChunkOffset ||
+                totalSize != mFlushChunkTotalSize || deserializeSize > totalSize - offset) {
+                mFlushChunkStorage = nullptr;
+                return false;
+            }
+
+            memcpy(mFlushChunkStorage.get() + offset, deserializePointer, deserializeSize);
+            mFlushChunkOffset += deserializeSize;
+
+            if (mFlushChunkOffset < mFlushChunkTotalSize) {
+                return true;
+            }
+
+            std::unique_ptr<uint8_t[]> flushInfo = std::move(mFlushChunkStorage);
+            return DeserializeFlush(flushInfo.get(), mFlushChunkTotalSize);
+        }
     }  // namespace server
 
 }  // namespace dawn_wire
@@ -0,0 +1,198 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/WireTrace.h"
+
+#include "common/Assert.h"
+
+#include <cstring>
+#include <limits>
+
+namespace dawn_wire {
+
+    namespace {
+
+        constexpr char kMagic[8] = {'D', 'A', 'W', 'N', 'W', 'I', 'R', 'E'};
+        constexpr uint32_t kVersion = 1;
+
+        // Bounds what a malformed trace can make the reader allocate.
+        constexpr uint64_t kMaxBatchSize = 1ull << 32;
+
+    }  // anonymous namespace
+
+    // WireTraceWriter
+
+    // static
+    std::unique_ptr<WireTraceWriter> WireTraceWriter::Create(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) {
+            return nullptr;
+        }
+
+        WireTraceFileHeader header = {};
+        memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        if (fwrite(&header, sizeof(header), 1, file) != 1) {
+            fclose(file);
+            return nullptr;
+        }
+
+        return std::unique_ptr<WireTraceWriter>(new WireTraceWriter(file));
+    }
+
+    WireTraceWriter::WireTraceWriter(FILE* file)
+        : mFile(file), mStartTime(std::chrono::steady_clock::now()) {
+    }
+
+    WireTraceWriter::~WireTraceWriter() {
+        fclose(mFile);
+    }
+
+    bool WireTraceWriter::WriteBatch(WireTraceDirection direction,
+                                     const uint32_t* commandSizes,
+                                     uint32_t commandCount,
+                                     const char* commands,
+                                     size_t size) {
+        WireTraceBatchHeader header;
+        header.direction = direction;
+        header.commandCount = commandCount;
+        header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - mStartTime)
+                               .count();
+        header.size = size;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        return fwrite(&header, sizeof(header), 1, mFile) == 1 &&
+               fwrite(commandSizes, sizeof(uint32_t), commandCount, mFile) == commandCount &&
+               fwrite(commands, 1, size, mFile) == size;
+    }
+
+    // WireTraceReader
+
+    // static
+    std::unique_ptr<WireTraceReader> WireTraceReader::Create(const char* path) {
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            return nullptr;
+        }
+
+        WireTraceFileHeader header;
+        if (fread(&header, sizeof(header), 1, file) != 1 ||
+            memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+            fclose(file);
+            return nullptr;
+        }
+
+        return std::unique_ptr<WireTraceReader>(new WireTraceReader(file));
+    }
+
+    WireTraceReader::WireTraceReader(FILE* file) : mFile(file) {
+    }
+
+    WireTraceReader::~WireTraceReader() {
+        fclose(mFile);
+    }
+
+    bool WireTraceReader::ReadBatch(WireTraceBatch* batch) {
+        WireTraceBatchHeader header;
+        size_t headerSize = fread(&header, 1, sizeof(header), mFile);
+        if (headerSize != sizeof(header)) {
+            // A header cut short is a truncated batch, not the end of the trace.
+            mIsAtEnd = headerSize == 0 && feof(mFile) != 0;
+            return false;
+        }
+        if (header.direction != WireTraceDirection::ClientToServer &&
+            header.direction != WireTraceDirection::ServerToClient) {
+            return false;
+        }
+        if (header.size > kMaxBatchSize || header.commandCount > header.size) {
+            return false;
+        }
+
+        batch->direction = header.direction;
+        batch->timestamp = header.timestamp;
+        batch->commandSizes.resize(header.commandCount);
+        batch->commands.resize(static_cast<size_t>(header.size));
+
+        if (fread(batch->commandSizes.data(), sizeof(uint32_t), header.commandCount, mFile) !=
+                header.commandCount ||
+            fread(batch->commands.data(), 1, batch->commands.size(), mFile) !=
+                batch->commands.size()) {
+            return false;
+        }
+
+        uint64_t totalCommandSize = 0;
+        for (uint32_t commandSize : batch->commandSizes) {
+            totalCommandSize += commandSize;
+        }
+        return totalCommandSize == header.size;
+    }
+
+    bool WireTraceReader::IsAtEnd() const {
+        return mIsAtEnd;
+    }
+
+    // RecordingCommandSerializer
+
+    RecordingCommandSerializer::RecordingCommandSerializer(CommandSerializer* serializer,
+                                                           WireTraceWriter* writer,
+                                                           WireTraceDirection direction)
+        : mSerializer(serializer), mWriter(writer), mDirection(direction) {
+    }
+
+    RecordingCommandSerializer::~RecordingCommandSerializer() = default;
+
+    void* RecordingCommandSerializer::GetCmdSpace(size_t size) {
+        RecordLastAllocation();
+
+        char* allocation = static_cast<char*>(mSerializer->GetCmdSpace(size));
+        if (allocation != nullptr) {
+            mLastAllocation = allocation;
+            mLastAllocationSize = size;
+        }
+        return allocation;
+    }
+
+    bool RecordingCommandSerializer::Flush() {
+        RecordLastAllocation();
+
+        if (!mCommandSizes.empty()) {
+            // Failing to record doesn't prevent the commands from being sent.
+            mWriter->WriteBatch(mDirection, mCommandSizes.data(),
+                                static_cast<uint32_t>(mCommandSizes.size()), mCommands.data(),
+                                mCommands.size());
+            mCommandSizes.clear();
+            mCommands.clear();
+        }
+
+        return mSerializer->Flush();
+    }
+
+    size_t RecordingCommandSerializer::GetMaximumAllocationSize() const {
+        return mSerializer->GetMaximumAllocationSize();
+    }
+
+    void RecordingCommandSerializer::RecordLastAllocation() {
+        if (mLastAllocation == nullptr) {
+            return;
+        }
+
+        ASSERT(mLastAllocationSize <= std::numeric_limits<uint32_t>::max());
+        mCommandSizes.push_back(static_cast<uint32_t>(mLastAllocationSize));
+        mCommands.insert(mCommands.end(), mLastAllocation, mLastAllocation + mLastAllocationSize);
+        mLastAllocation = nullptr;
+        mLastAllocationSize = 0;
+    }
+
+}  // namespace dawn_wire
@@ -16,6 +16,8 @@
 #include "dawn_wire/client/ApiProcs_autogen.h"
 #include "dawn_wire/client/Client.h"
 
+#include <algorithm>
+
 namespace dawn_wire { namespace client {
 
     namespace {
@@ -44,6 +46,44 @@ namespace dawn_wire { namespace client {
             // Serialize the handle into the space after the command.
             handle->SerializeCreate(allocatedBuffer + commandSize);
         }
+
+        // Returns how many bytes of payload can follow a command of |commandSize| bytes in a
+        // single allocation from the client's serializer.
+        size_t GetMaximumChunkSize(Client* wireClient, size_t commandSize) {
+            size_t maxAllocationSize = wireClient->GetMaximumAllocationSize();
+            ASSERT(maxAllocationSize > commandSize);
+            return maxAllocationSize - commandSize;
+        }
+
+        // Serialize the flush of the buffer's WriteHandle as a sequence of bounded
+        // BufferUpdateMappedDataChunk commands when it doesn't fit in a single allocation.
+        void SerializeBufferUpdateMappedDataChunks(const Buffer* buffer,
+                                                   size_t writeFlushInfoLength) {
+            Client* wireClient = buffer->device->GetClient();
+
+            BufferUpdateMappedDataChunkCmd cmd;
+            cmd.bufferId = buffer->id;
+            cmd.writeFlushInfoLength = writeFlushInfoLength;
+            cmd.chunk = nullptr;
+
+            size_t commandSize = cmd.GetRequiredSize();
+            size_t maxChunkSize = GetMaximumChunkSize(wireClient, commandSize);
+
+            size_t offset = 0;
+            do {
+                size_t chunkSize = std::min(maxChunkSize, writeFlushInfoLength - offset);
+                cmd.offset = offset;
+                cmd.chunkLength = chunkSize;
+
+                char* allocatedBuffer =
+                    static_cast<char*>(wireClient->GetCmdSpace(commandSize + chunkSize));
+                cmd.Serialize(allocatedBuffer);
+                // Serialize this range of the flush info into the space after the command.
+                buffer->writeHandle->SerializeFlushChunk(allocatedBuffer + commandSize, offset,
+                                                         chunkSize);
+                offset += chunkSize;
+            } while (offset < writeFlushInfoLength);
+        }
     }  // namespace
 
     void ClientBufferMapReadAsync(DawnBuffer cBuffer,
@@ -308,6 +348,7 @@ namespace dawn_wire { namespace client {
                                 uint64_t count,
                                 const void* data) {
         Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        Client* wireClient = buffer->device->GetClient();
 
         BufferSetSubDataInternalCmd cmd;
         cmd.bufferId = buffer->id;
@@ -315,10 +356,34 @@ namespace dawn_wire { namespace client {
         cmd.count = count;
         cmd.data = static_cast<const uint8_t*>(data);
 
-        Client* wireClient = buffer->device->GetClient();
         size_t requiredSize = cmd.GetRequiredSize();
-        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
-        cmd.Serialize(allocatedBuffer);
+        if (requiredSize <= wireClient->GetMaximumAllocationSize()) {
+            char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+            cmd.Serialize(allocatedBuffer);
+            return;
+        }
+
+        // The data doesn't fit in a single command, split it into bounded chunks that the server
+        // reassembles before applying the SetSubData.
+        BufferSetSubDataChunkCmd chunkCmd;
+        chunkCmd.bufferId = buffer->id;
+        chunkCmd.start = start;
+        chunkCmd.count = count;
+        chunkCmd.chunkLength = 0;
+        size_t maxChunkSize = GetMaximumChunkSize(wireClient, chunkCmd.GetRequiredSize());
+
+        uint64_t offset = 0;
+        while (offset < count) {
+            uint64_t chunkSize = std::min(static_cast<uint64_t>(maxChunkSize), count - offset);
+            chunkCmd.offset = offset;
+            chunkCmd.chunkLength = chunkSize;
+            chunkCmd.chunk = static_cast<const uint8_t*>(data) + offset;
+
+            char* allocatedBuffer =
+                static_cast<char*>(wireClient->GetCmdSpace(chunkCmd.GetRequiredSize()));
+            chunkCmd.Serialize(allocatedBuffer);
+            offset += chunkSize;
+        }
     }
 
     void ClientBufferUnmap(DawnBuffer cBuffer) {
@@ -345,14 +410,18 @@ namespace dawn_wire { namespace client {
             cmd.writeFlushInfoLength = writeFlushInfoLength;
             cmd.writeFlushInfo = nullptr;
 
+            Client* wireClient = buffer->device->GetClient();
             size_t commandSize = cmd.GetRequiredSize();
-            size_t requiredSize = commandSize + writeFlushInfoLength;
-            char* allocatedBuffer =
-                static_cast<char*>(buffer->device->GetClient()->GetCmdSpace(requiredSize));
-            cmd.Serialize(allocatedBuffer);
-            // Serialize flush metadata into the space after the command.
-            // This closes the handle for writing.
-            buffer->writeHandle->SerializeFlush(allocatedBuffer + commandSize);
+            if (writeFlushInfoLength <= GetMaximumChunkSize(wireClient, commandSize)) {
+                size_t requiredSize = commandSize + writeFlushInfoLength;
+                char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+                cmd.Serialize(allocatedBuffer);
+                // Serialize flush metadata into the space after the command.
+                // This closes the handle for writing.
+                buffer->writeHandle->SerializeFlush(allocatedBuffer + commandSize);
+            } else {
+                SerializeBufferUpdateMappedDataChunks(buffer, writeFlushInfoLength);
+            }
             buffer->writeHandle = nullptr;
 
         } else if (buffer->readHandle) {
@@ -15,13 +15,26 @@
 #include "dawn_wire/client/Client.h"
 #include "dawn_wire/client/Device.h"
 
+#include <algorithm>
+
 namespace dawn_wire { namespace client {
 
-    Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
+    namespace {
+
+        // Bounds the number of destroys held back so that releasing a lot of objects without
+        // sending other commands doesn't accumulate IDs indefinitely.
+        constexpr size_t kMaxPendingDestroys = 4096;
+
+    }  // anonymous namespace
+
+    Client::Client(CommandSerializer* serializer,
+                   MemoryTransferService* memoryTransferService,
+                   bool coalesceReleases)
         : ClientBase(),
           mDevice(DeviceAllocator().New(this)->object.get()),
           mSerializer(serializer),
-          mMemoryTransferService(memoryTransferService) {
+          mMemoryTransferService(memoryTransferService),
+          mCoalesceReleases(coalesceReleases) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fall back to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -33,6 +46,54 @@ namespace dawn_wire { namespace client {
         DeviceAllocator().Free(mDevice);
     }
 
+    bool Client::Flush() {
+        if (mPendingDestroyCount > 0) {
+            SerializePendingDestroys();
+        }
+        return mSerializer->Flush();
+    }
+
+    void Client::OnObjectFreed() {
+        mPendingDestroyCount++;
+        if (!mCoalesceReleases || mPendingDestroyCount >= kMaxPendingDestroys) {
+            SerializePendingDestroys();
+        }
+    }
+
+    void Client::SerializePendingDestroys() {
+        TakePendingDestroys([this](ObjectType objectType, const std::vector<ObjectId>& ids) {
+            DestroyObjectsCmd cmd;
+            cmd.objectType = objectType;
+            cmd.objectCount = 0;
+            cmd.objectIds = nullptr;
+
+            // Split the IDs in as many commands as needed to stay within allocation limits.
+            size_t maxAllocationSize = mSerializer->GetMaximumAllocationSize();
+            size_t commandSize = cmd.GetRequiredSize();
+            ASSERT(maxAllocationSize >= commandSize + sizeof(ObjectId));
+            size_t maxIdsPerCommand = (maxAllocationSize - commandSize) / sizeof(ObjectId);
+
+            for (size_t offset = 0; offset < ids.size(); offset += maxIdsPerCommand) {
+                size_t count = std::min(maxIdsPerCommand, ids.size() - offset);
+                cmd.objectCount = static_cast<uint32_t>(count);
+                cmd.objectIds = ids.data() + offset;
+
+                size_t requiredSize = cmd.GetRequiredSize();
+                mBytesOut.fetch_add(requiredSize, std::memory_order_relaxed);
+                char* allocatedBuffer = static_cast<char*>(mSerializer->GetCmdSpace(requiredSize));
+                cmd.Serialize(allocatedBuffer);
+            }
+        });
+        mPendingDestroyCount = 0;
+    }
+
+    WireStatistics Client::GetStatistics() const {
+        WireStatistics statistics;
+        statistics.bytesIn = mBytesIn.load(std::memory_order_relaxed);
+        statistics.bytesOut = mBytesOut.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
     ReservedTexture Client::ReserveTexture(DawnDevice cDevice) {
         Device* device = reinterpret_cast<Device*>(cDevice);
         ObjectAllocator<Texture>::ObjectAndSerial* allocation = TextureAllocator().New(device);
@@ -18,11 +18,14 @@
 #include <dawn/dawn.h>
 #include <dawn_wire/Wire.h>
 
+#include "common/Compiler.h"
 #include "dawn_wire/WireClient.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/WireDeserializeAllocator.h"
 #include "dawn_wire/client/ClientBase_autogen.h"
 
+#include <atomic>
+
 namespace dawn_wire { namespace client {
 
     class Device;
@@ -30,16 +33,37 @@ namespace dawn_wire { namespace client {
 
     class Client : public ClientBase {
       public:
-        Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+        Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               bool coalesceReleases);
         ~Client();
 
         const volatile char* HandleCommands(const volatile char* commands, size_t size);
         ReservedTexture ReserveTexture(DawnDevice device);
 
         void* GetCmdSpace(size_t size) {
+            // Destroys must reach the server before any command that comes after the releases.
+            if (DAWN_UNLIKELY(mPendingDestroyCount > 0)) {
+                SerializePendingDestroys();
+            }
+            mBytesOut.fetch_add(size, std::memory_order_relaxed);
             return mSerializer->GetCmdSpace(size);
         }
 
+        bool Flush();
+
+        WireStatistics GetStatistics() const;
+
+        // Called after an object is freed in its allocator. The destruction of the object is
+        // serialized immediately, unless releases are coalesced: then it is batched with the
+        // other pending destroys in DestroyObjects commands serialized before the next command,
+        // on Flush, or when too many destroys are pending.
+        void OnObjectFreed();
+
+        size_t GetMaximumAllocationSize() const {
+            return mSerializer->GetMaximumAllocationSize();
+        }
+
         DawnDevice GetDevice() const {
             return reinterpret_cast<DawnDeviceImpl*>(mDevice);
         }
@@ -51,11 +75,19 @@ namespace dawn_wire { namespace client {
       private:
 #include "dawn_wire/client/ClientPrototypes_autogen.inc"
 
+        void SerializePendingDestroys();
+
         Device* mDevice = nullptr;
         CommandSerializer* mSerializer = nullptr;
         WireDeserializeAllocator mAllocator;
         MemoryTransferService* mMemoryTransferService = nullptr;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
+        size_t mPendingDestroyCount = 0;
+        bool mCoalesceReleases = false;
+
+        // Relaxed atomics so that the statistics can be queried from another thread.
+        std::atomic<uint64_t> mBytesIn = {0};
+        std::atomic<uint64_t> mBytesOut = {0};
     };
 
     DawnProcTable GetProcs();
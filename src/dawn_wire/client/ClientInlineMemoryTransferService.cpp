@@ -89,6 +89,13 @@ namespace dawn_wire { namespace client {
                 memcpy(serializePointer, mStagingData.get(), mSize);
             }
 
+            void SerializeFlushChunk(void* serializePointer, size_t offset, size_t size) override {
+                ASSERT(mStagingData != nullptr);
+                ASSERT(serializePointer != nullptr);
+                ASSERT(offset <= mSize && size <= mSize - offset);
+                memcpy(serializePointer, mStagingData.get() + offset, size);
+            }
+
           private:
             size_t mSize;
             std::unique_ptr<uint8_t[]> mStagingData;
@@ -62,11 +62,24 @@ namespace dawn_wire { namespace client {
 
             return &mObjects[id];
         }
+        // Frees the object. Its ID is only reused after ClearPendingDestroys is called, once the
+        // destruction of the object has been serialized.
         void Free(T* obj) {
-            FreeId(obj->id);
+            mPendingDestroys.push_back(obj->id);
             mObjects[obj->id].object = nullptr;
         }
 
+        // The IDs of the objects freed since the last call to ClearPendingDestroys.
+        const std::vector<uint32_t>& GetPendingDestroys() const {
+            return mPendingDestroys;
+        }
+
+        // Makes the IDs of the pending destroys available for reuse.
+        void ClearPendingDestroys() {
+            mFreeIds.insert(mFreeIds.end(), mPendingDestroys.begin(), mPendingDestroys.end());
+            mPendingDestroys.clear();
+        }
+
         T* GetObject(uint32_t id) {
             if (id >= mObjects.size()) {
                 return nullptr;
@@ -90,13 +103,11 @@ namespace dawn_wire { namespace client {
             mFreeIds.pop_back();
             return id;
         }
-        void FreeId(uint32_t id) {
-            mFreeIds.push_back(id);
-        }
 
         // 0 is an ID reserved to represent nullptr
         uint32_t mCurrentId = 1;
         std::vector<uint32_t> mFreeIds;
+        std::vector<uint32_t> mPendingDestroys;
         std::vector<ObjectAndSerial> mObjects;
         Device* mDevice;
     };
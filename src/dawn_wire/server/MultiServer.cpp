@@ -0,0 +1,251 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/server/MultiServer.h"
+
+#include "common/Assert.h"
+#include "dawn_wire/server/Server.h"
+
+#include <algorithm>
+
+namespace dawn_wire { namespace server {
+
+    // ClientEndpoint
+
+    MultiServer::ClientEndpoint::ClientEndpoint(std::unique_ptr<Server> server)
+        : mServer(std::move(server)), mLost(false) {
+    }
+
+    MultiServer::ClientEndpoint::~ClientEndpoint() = default;
+
+    const volatile char* MultiServer::ClientEndpoint::HandleCommands(
+        const volatile char* commands,
+        size_t size) {
+        if (mLost) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        std::vector<char> batch;
+        if (!mFreeBatches.empty()) {
+            batch = std::move(mFreeBatches.back());
+            mFreeBatches.pop_back();
+        }
+        // The commands are volatile because they may be in memory shared with the client. They
+        // are copied once here and deserialized from the copy later.
+        batch.resize(size);
+        std::copy(commands, commands + size, batch.begin());
+        mBatches.push_back(std::move(batch));
+
+        return commands + size;
+    }
+
+    Server* MultiServer::ClientEndpoint::GetServer() {
+        return mServer.get();
+    }
+
+    bool MultiServer::ClientEndpoint::HasQueuedCommands() const {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return !mBatches.empty();
+    }
+
+    bool MultiServer::ClientEndpoint::IsLost() const {
+        return mLost;
+    }
+
+    void MultiServer::ClientEndpoint::Lose() {
+        mLost = true;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mBatches.clear();
+    }
+
+    bool MultiServer::ClientEndpoint::PopBatch(size_t maxSize, std::vector<char>* batch) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mBatches.empty() || mBatches.front().size() > maxSize) {
+            return false;
+        }
+
+        *batch = std::move(mBatches.front());
+        mBatches.pop_front();
+        return true;
+    }
+
+    void MultiServer::ClientEndpoint::RecycleBatch(std::vector<char> batch) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFreeBatches.push_back(std::move(batch));
+    }
+
+    // MultiServer
+
+    MultiServer::MultiServer(const WireMultiServerDescriptor& descriptor)
+        : mDevice(descriptor.device),
+          mProcs(*descriptor.procs),
+          mMemoryTransferService(descriptor.memoryTransferService),
+          mPlatform(descriptor.platform),
+          mClientQuotaPerRound(descriptor.clientQuotaPerRound) {
+        ASSERT(mClientQuotaPerRound > 0);
+        mProcs.deviceSetUncapturedErrorCallback(mDevice, ForwardUncapturedError, this);
+    }
+
+    MultiServer::~MultiServer() {
+        mClients.clear();
+        mProcs.deviceSetUncapturedErrorCallback(mDevice, nullptr, nullptr);
+    }
+
+    uint32_t MultiServer::AddClient(CommandSerializer* serializer) {
+        // The device callback is shared by all the clients so the servers don't set it.
+        std::unique_ptr<Server> server(
+            new Server(mDevice, mProcs, serializer, mMemoryTransferService, mPlatform, false));
+        std::unique_ptr<ClientEndpoint> client(new ClientEndpoint(std::move(server)));
+
+        for (uint32_t clientId = 0; clientId < mClients.size(); ++clientId) {
+            if (mClients[clientId] == nullptr) {
+                mClients[clientId] = std::move(client);
+                return clientId;
+            }
+        }
+
+        mClients.push_back(std::move(client));
+        return static_cast<uint32_t>(mClients.size() - 1);
+    }
+
+    void MultiServer::RemoveClient(uint32_t clientId) {
+        ASSERT(GetClient(clientId) != nullptr);
+        ASSERT(mCurrentClient == nullptr);
+        if (mScopedClient == mClients[clientId].get()) {
+            mScopedClient = nullptr;
+        }
+        // The server pops the error scopes the client left open, and detaches the userdata of
+        // its pending callbacks so they can be called safely after it is destroyed.
+        mClients[clientId] = nullptr;
+    }
+
+    CommandHandler* MultiServer::GetCommandHandler(uint32_t clientId) {
+        return GetClient(clientId);
+    }
+
+    bool MultiServer::InjectTexture(uint32_t clientId,
+                                    DawnTexture texture,
+                                    uint32_t id,
+                                    uint32_t generation) {
+        return GetClient(clientId)->GetServer()->InjectTexture(texture, id, generation);
+    }
+
+    bool MultiServer::HandleQueuedCommands() {
+        if (mScopedClient != nullptr) {
+            mScopedClient->deficit += mClientQuotaPerRound;
+            HandleClientBatches(mScopedClient);
+            if (mScopedClient->GetServer()->HasOpenErrorScopes()) {
+                return mScopedClient->HasQueuedCommands();
+            }
+
+            // The client closed its scopes, the round it interrupted resumes after it.
+            if (!mScopedClient->HasQueuedCommands()) {
+                mScopedClient->deficit = 0;
+            }
+            mScopedClient = nullptr;
+        }
+
+        for (; mRoundPosition < mClients.size(); ++mRoundPosition) {
+            ClientEndpoint* client = mClients[mRoundPosition].get();
+            if (client == nullptr) {
+                continue;
+            }
+
+            // Idle clients don't accumulate quota, otherwise they could monopolize the device
+            // when they become busy.
+            if (client->IsLost() || !client->HasQueuedCommands()) {
+                client->deficit = 0;
+                continue;
+            }
+
+            client->deficit += mClientQuotaPerRound;
+            HandleClientBatches(client);
+
+            if (client->GetServer()->HasOpenErrorScopes()) {
+                mScopedClient = client;
+                ++mRoundPosition;
+                return client->HasQueuedCommands();
+            }
+
+            if (!client->HasQueuedCommands()) {
+                client->deficit = 0;
+            }
+        }
+        mRoundPosition = 0;
+
+        for (const std::unique_ptr<ClientEndpoint>& client : mClients) {
+            if (client != nullptr && client->HasQueuedCommands()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void MultiServer::HandleClientBatches(ClientEndpoint* client) {
+        std::vector<char> batch;
+        mCurrentClient = client;
+        while (client->PopBatch(client->deficit, &batch)) {
+            client->deficit -= batch.size();
+            if (client->GetServer()->HandleCommands(batch.data(), batch.size()) == nullptr) {
+                // The scopes of a lost client would never be closed.
+                client->GetServer()->PopOpenErrorScopes();
+                client->Lose();
+                break;
+            }
+            client->RecycleBatch(std::move(batch));
+        }
+        mCurrentClient = nullptr;
+    }
+
+    bool MultiServer::HasQueuedCommands(uint32_t clientId) const {
+        return GetClient(clientId)->HasQueuedCommands();
+    }
+
+    bool MultiServer::IsClientLost(uint32_t clientId) const {
+        return GetClient(clientId)->IsLost();
+    }
+
+    MultiServer::ClientEndpoint* MultiServer::GetClient(uint32_t clientId) const {
+        ASSERT(clientId < mClients.size());
+        return mClients[clientId].get();
+    }
+
+    // static
+    void MultiServer::ForwardUncapturedError(DawnErrorType type,
+                                             const char* message,
+                                             void* userdata) {
+        auto multiServer = static_cast<MultiServer*>(userdata);
+        multiServer->OnUncapturedError(type, message);
+    }
+
+    void MultiServer::OnUncapturedError(DawnErrorType type, const char* message) {
+        // Between batches, the errors that happen while a client has error scopes open are
+        // attributed to that client, like the errors its scopes capture.
+        ClientEndpoint* owner = mCurrentClient != nullptr ? mCurrentClient : mScopedClient;
+        if (owner != nullptr) {
+            owner->GetServer()->OnUncapturedError(type, message);
+            return;
+        }
+
+        for (const std::unique_ptr<ClientEndpoint>& client : mClients) {
+            if (client != nullptr && !client->IsLost()) {
+                client->GetServer()->OnUncapturedError(type, message);
+            }
+        }
+    }
+
+}}  // namespace dawn_wire::server
@@ -0,0 +1,109 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_SERVER_MULTISERVER_H_
+#define DAWNWIRE_SERVER_MULTISERVER_H_
+
+#include "dawn_wire/WireMultiServer.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dawn_wire { namespace server {
+
+    class Server;
+
+    class MultiServer {
+      public:
+        MultiServer(const WireMultiServerDescriptor& descriptor);
+        ~MultiServer();
+
+        uint32_t AddClient(CommandSerializer* serializer);
+        void RemoveClient(uint32_t clientId);
+        CommandHandler* GetCommandHandler(uint32_t clientId);
+
+        bool InjectTexture(uint32_t clientId,
+                           DawnTexture texture,
+                           uint32_t id,
+                           uint32_t generation);
+
+        bool HandleQueuedCommands();
+
+        bool HasQueuedCommands(uint32_t clientId) const;
+        bool IsClientLost(uint32_t clientId) const;
+
+      private:
+        // The server-side state of a client: its object namespace and the queue of batches it
+        // sent that haven't been handled yet.
+        class ClientEndpoint : public CommandHandler {
+          public:
+            explicit ClientEndpoint(std::unique_ptr<Server> server);
+            ~ClientEndpoint() override;
+
+            const volatile char* HandleCommands(const volatile char* commands,
+                                                size_t size) override;
+
+            Server* GetServer();
+            bool HasQueuedCommands() const;
+            bool IsLost() const;
+            void Lose();
+
+            // Pops the next batch if it fits in |maxSize|. The storage of the batch should be
+            // given back with RecycleBatch.
+            bool PopBatch(size_t maxSize, std::vector<char>* batch);
+            void RecycleBatch(std::vector<char> batch);
+
+            // The number of bytes the client can still have handled in the current round.
+            size_t deficit = 0;
+
+          private:
+            std::unique_ptr<Server> mServer;
+            std::atomic<bool> mLost;
+
+            mutable std::mutex mMutex;
+            std::deque<std::vector<char>> mBatches;
+            std::vector<std::vector<char>> mFreeBatches;
+        };
+
+        ClientEndpoint* GetClient(uint32_t clientId) const;
+        // Handles the batches of |client| that fit in its quota.
+        void HandleClientBatches(ClientEndpoint* client);
+
+        static void ForwardUncapturedError(DawnErrorType type, const char* message, void* userdata);
+        void OnUncapturedError(DawnErrorType type, const char* message);
+
+        DawnDevice mDevice;
+        DawnProcTable mProcs;
+        MemoryTransferService* mMemoryTransferService;
+        dawn_platform::Platform* mPlatform;
+        size_t mClientQuotaPerRound;
+
+        // Indexed by client ID. Removed clients leave a nullptr that AddClient reuses.
+        std::vector<std::unique_ptr<ClientEndpoint>> mClients;
+        // The client whose commands are being handled, if any.
+        ClientEndpoint* mCurrentClient = nullptr;
+        // The client with error scopes open on the device, if any. The error scopes of the device
+        // are shared by the clients, so only the commands of this client are handled until it
+        // closes them.
+        ClientEndpoint* mScopedClient = nullptr;
+        // The index of the next client to handle in the current round.
+        size_t mRoundPosition = 0;
+    };
+
+}}  // namespace dawn_wire::server
+
+#endif  // DAWNWIRE_SERVER_MULTISERVER_H_
@@ -15,11 +15,15 @@
 #ifndef DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 #define DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 
+#include "common/Assert.h"
+#include "common/Math.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/WireServer.h"
 
 #include <algorithm>
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace dawn_wire { namespace server {
 
@@ -28,10 +32,6 @@ namespace dawn_wire { namespace server {
         // The backend-provided handle and serial to this object.
         T handle;
         uint32_t serial = 0;
-
-        // Whether this object has been allocated, used by the KnownObjects queries
-        // TODO(cwallez@chromium.org): make this an internal bit vector in KnownObjects.
-        bool allocated;
     };
 
     // Stores what the backend knows about the type.
@@ -40,15 +40,81 @@ namespace dawn_wire { namespace server {
 
     enum class BufferMapWriteState { Unmapped, Mapped, MapError };
 
+    // Owns the ReadHandle or WriteHandle of a mapped buffer. A buffer can only have one mapping
+    // at a time so the kind of handle is tagged in the low bit of a single pointer.
+    class BufferMapHandle {
+      public:
+        BufferMapHandle() = default;
+        ~BufferMapHandle() {
+            Reset();
+        }
+
+        BufferMapHandle(BufferMapHandle&& other) : mTaggedHandle(other.mTaggedHandle) {
+            other.mTaggedHandle = 0;
+        }
+        BufferMapHandle& operator=(BufferMapHandle&& other) {
+            if (this != &other) {
+                Reset();
+                mTaggedHandle = other.mTaggedHandle;
+                other.mTaggedHandle = 0;
+            }
+            return *this;
+        }
+
+        MemoryTransferService::ReadHandle* GetReadHandle() const {
+            if ((mTaggedHandle & kWriteTag) != 0) {
+                return nullptr;
+            }
+            return reinterpret_cast<MemoryTransferService::ReadHandle*>(mTaggedHandle);
+        }
+
+        MemoryTransferService::WriteHandle* GetWriteHandle() const {
+            if ((mTaggedHandle & kWriteTag) == 0) {
+                return nullptr;
+            }
+            return reinterpret_cast<MemoryTransferService::WriteHandle*>(mTaggedHandle &
+                                                                         ~kWriteTag);
+        }
+
+        void SetReadHandle(std::unique_ptr<MemoryTransferService::ReadHandle> readHandle) {
+            Reset();
+            mTaggedHandle = reinterpret_cast<uintptr_t>(readHandle.release());
+            ASSERT((mTaggedHandle & kWriteTag) == 0);
+        }
+
+        void SetWriteHandle(std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle) {
+            Reset();
+            uintptr_t handle = reinterpret_cast<uintptr_t>(writeHandle.release());
+            ASSERT((handle & kWriteTag) == 0);
+            if (handle != 0) {
+                mTaggedHandle = handle | kWriteTag;
+            }
+        }
+
+        void Reset() {
+            if ((mTaggedHandle & kWriteTag) != 0) {
+                delete GetWriteHandle();
+            } else {
+                delete GetReadHandle();
+            }
+            mTaggedHandle = 0;
+        }
+
+      private:
+        static constexpr uintptr_t kWriteTag = 1;
+
+        uintptr_t mTaggedHandle = 0;
+    };
+
     template <>
     struct ObjectData<DawnBuffer> : public ObjectDataBase<DawnBuffer> {
-        // TODO(enga): Use a tagged pointer to save space.
-        std::unique_ptr<MemoryTransferService::ReadHandle> readHandle;
-        std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle;
+        BufferMapHandle mapHandle;
         BufferMapWriteState mapWriteState = BufferMapWriteState::Unmapped;
     };
 
-    // Keeps track of the mapping between client IDs and backend objects.
+    // Keeps track of the mapping between client IDs and backend objects. The data is stored in a
+    // dense array indexed by ID, and which IDs are allocated is tracked in a separate bit vector so
+    // that validating an ID doesn't touch the data.
     template <typename T>
     class KnownObjects {
       public:
@@ -60,36 +126,40 @@ namespace dawn_wire { namespace server {
             // KnownObjects for ID 0.
             Data reservation;
             reservation.handle = nullptr;
-            reservation.allocated = false;
             mKnown.push_back(std::move(reservation));
+            mAllocated.push_back(false);
         }
 
         // Get a backend objects for a given client ID.
         // Returns nullptr if the ID hasn't previously been allocated.
         const Data* Get(uint32_t id) const {
-            if (id >= mKnown.size()) {
-                return nullptr;
-            }
-
-            const Data* data = &mKnown[id];
-
-            if (!data->allocated) {
+            if (!IsAllocated(id)) {
                 return nullptr;
             }
-
-            return data;
+            return &mKnown[id];
         }
         Data* Get(uint32_t id) {
-            if (id >= mKnown.size()) {
+            if (!IsAllocated(id)) {
                 return nullptr;
             }
+            return &mKnown[id];
+        }
 
-            Data* data = &mKnown[id];
-
-            if (!data->allocated) {
+        // Get a backend object for a given client ID and serial.
+        // Returns nullptr if the ID isn't allocated or if it has been reused for another object
+        // since the serial was recorded.
+        const Data* Get(uint32_t id, uint32_t serial) const {
+            const Data* data = Get(id);
+            if (data == nullptr || data->serial != serial) {
+                return nullptr;
+            }
+            return data;
+        }
+        Data* Get(uint32_t id, uint32_t serial) {
+            Data* data = Get(id);
+            if (data == nullptr || data->serial != serial) {
                 return nullptr;
             }
-
             return data;
         }
 
@@ -102,35 +172,42 @@ namespace dawn_wire { namespace server {
             }
 
             Data data;
-            data.allocated = true;
             data.handle = nullptr;
 
             if (id >= mKnown.size()) {
                 mKnown.push_back(std::move(data));
+                mAllocated.push_back(true);
                 return &mKnown.back();
             }
 
-            if (mKnown[id].allocated) {
+            if (mAllocated[id]) {
                 return nullptr;
             }
 
             mKnown[id] = std::move(data);
+            mAllocated[id] = true;
             return &mKnown[id];
         }
 
         // Marks an ID as deallocated
         void Free(uint32_t id) {
             ASSERT(id < mKnown.size());
-            mKnown[id].allocated = false;
+            mAllocated[id] = false;
+        }
+
+        // Marks an ID freed with Free as allocated again, with its data unchanged.
+        void Unfree(uint32_t id) {
+            ASSERT(id < mKnown.size() && !mAllocated[id]);
+            mAllocated[id] = true;
         }
 
         std::vector<T> AcquireAllHandles() {
             std::vector<T> objects;
-            for (Data& data : mKnown) {
-                if (data.allocated && data.handle != nullptr) {
-                    objects.push_back(data.handle);
-                    data.allocated = false;
-                    data.handle = nullptr;
+            for (size_t id = 0; id < mKnown.size(); ++id) {
+                if (mAllocated[id] && mKnown[id].handle != nullptr) {
+                    objects.push_back(mKnown[id].handle);
+                    mAllocated[id] = false;
+                    mKnown[id].handle = nullptr;
                 }
             }
 
@@ -138,37 +215,119 @@ namespace dawn_wire { namespace server {
         }
 
       private:
+        bool IsAllocated(uint32_t id) const {
+            return id < mAllocated.size() && mAllocated[id];
+        }
+
         std::vector<Data> mKnown;
+        std::vector<bool> mAllocated;
     };
 
     // ObjectIds are lost in deserialization. Store the ids of deserialized
     // objects here so they can be used in command handlers. This is useful
     // for creating ReturnWireCmds which contain client ids
+    // The table is an open-addressing hash table with linear probing where nullptr marks empty
+    // slots, so lookups are a few loads in a flat array.
     template <typename T>
     class ObjectIdLookupTable {
       public:
         void Store(T key, ObjectId id) {
-            mTable[key] = id;
+            // nullptr is the empty slot marker, looking it up always returns the 0 ID anyway.
+            if (key == nullptr) {
+                return;
+            }
+
+            if ((mCount + 1) * 4 > mSlots.size() * 3) {
+                size_t capacity = mSlots.size() * 2;
+                if (capacity < kMinCapacity) {
+                    capacity = kMinCapacity;
+                }
+                Rehash(capacity);
+            }
+
+            Slot* slot = &mSlots[FindSlot(key)];
+            if (slot->key == nullptr) {
+                slot->key = key;
+                mCount++;
+            }
+            slot->id = id;
         }
 
         // Return the cached ObjectId, or 0 (null handle)
         ObjectId Get(T key) const {
-            const auto it = mTable.find(key);
-            if (it != mTable.end()) {
-                return it->second;
+            if (key == nullptr || mSlots.empty()) {
+                return 0;
             }
-            return 0;
+            // Empty slots have a 0 ID.
+            return mSlots[FindSlot(key)].id;
         }
 
         void Remove(T key) {
-            auto it = mTable.find(key);
-            if (it != mTable.end()) {
-                mTable.erase(it);
+            if (key == nullptr || mSlots.empty()) {
+                return;
             }
+
+            size_t hole = FindSlot(key);
+            if (mSlots[hole].key == nullptr) {
+                return;
+            }
+
+            // Shift back the following entries of the probe sequence into the hole when the hole
+            // is on their probe path so that no tombstones are needed.
+            const size_t mask = mSlots.size() - 1;
+            for (size_t i = (hole + 1) & mask; mSlots[i].key != nullptr; i = (i + 1) & mask) {
+                size_t ideal = Hash(mSlots[i].key) & mask;
+                if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                    mSlots[hole] = mSlots[i];
+                    hole = i;
+                }
+            }
+
+            mSlots[hole] = Slot();
+            mCount--;
         }
 
       private:
-        std::map<T, ObjectId> mTable;
+        struct Slot {
+            T key = nullptr;
+            ObjectId id = 0;
+        };
+
+        static constexpr size_t kMinCapacity = 16;
+
+        static size_t Hash(T key) {
+            // Handles are pointers with zero low bits, mix them so that all bits are used.
+            uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            return static_cast<size_t>(hash);
+        }
+
+        // Returns the index of the slot containing |key|, or of the empty slot where it would be
+        // inserted.
+        size_t FindSlot(T key) const {
+            const size_t mask = mSlots.size() - 1;
+            size_t i = Hash(key) & mask;
+            while (mSlots[i].key != nullptr && mSlots[i].key != key) {
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        void Rehash(size_t capacity) {
+            ASSERT(IsPowerOfTwo(capacity));
+            std::vector<Slot> oldSlots(capacity);
+            std::swap(oldSlots, mSlots);
+            for (const Slot& slot : oldSlots) {
+                if (slot.key != nullptr) {
+                    mSlots[FindSlot(slot.key)] = slot;
+                }
+            }
+        }
+
+        std::vector<Slot> mSlots;
+        size_t mCount = 0;
     };
 
 }}  // namespace dawn_wire::server
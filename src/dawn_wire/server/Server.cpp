@@ -20,8 +20,13 @@ namespace dawn_wire { namespace server {
     Server::Server(DawnDevice device,
                    const DawnProcTable& procs,
                    CommandSerializer* serializer,
-                   MemoryTransferService* memoryTransferService)
-        : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
+                   MemoryTransferService* memoryTransferService,
+                   dawn_platform::Platform* platform,
+                   bool setUncapturedErrorCallback)
+        : mSerializer(serializer),
+          mProcs(procs),
+          mMemoryTransferService(memoryTransferService),
+          mPlatform(platform) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fallback to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -31,17 +36,42 @@ namespace dawn_wire { namespace server {
         auto* deviceData = DeviceObjects().Allocate(1);
         deviceData->handle = device;
 
-        mProcs.deviceSetUncapturedErrorCallback(device, ForwardUncapturedError, this);
+        if (setUncapturedErrorCallback) {
+            mProcs.deviceSetUncapturedErrorCallback(device, ForwardUncapturedError, this);
+        }
     }
 
     Server::~Server() {
+        // The device may outlive the server, so the scopes of the client mustn't capture the
+        // errors of whoever uses it next.
+        PopOpenErrorScopes();
         DestroyAllObjects(mProcs);
+
+        for (DetachableUserdata* userdata : mPendingUserdata) {
+            userdata->server = nullptr;
+        }
+    }
+
+    void Server::TrackUserdata(DetachableUserdata* userdata) {
+        mPendingUserdata.insert(userdata);
+    }
+
+    void Server::UntrackUserdata(DetachableUserdata* userdata) {
+        mPendingUserdata.erase(userdata);
     }
 
     void* Server::GetCmdSpace(size_t size) {
+        mBytesOut.fetch_add(size, std::memory_order_relaxed);
         return mSerializer->GetCmdSpace(size);
     }
 
+    WireStatistics Server::GetStatistics() const {
+        WireStatistics statistics;
+        statistics.bytesIn = mBytesIn.load(std::memory_order_relaxed);
+        statistics.bytesOut = mBytesOut.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
     bool Server::InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation) {
         ObjectData<DawnTexture>* data = TextureObjects().Allocate(id);
         if (data == nullptr) {
@@ -50,7 +80,6 @@ namespace dawn_wire { namespace server {
 
         data->handle = texture;
         data->serial = generation;
-        data->allocated = true;
 
         // The texture is externally owned so it shouldn't be destroyed when we receive a destroy
         // message from the client. Add a reference to counterbalance the eventual release.
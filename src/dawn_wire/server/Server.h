@@ -17,13 +17,28 @@
 
 #include "dawn_wire/server/ServerBase_autogen.h"
 
+#include <atomic>
+#include <unordered_set>
+
+namespace dawn_platform {
+    class Platform;
+}  // namespace dawn_platform
+
 namespace dawn_wire { namespace server {
 
     class Server;
     class MemoryTransferService;
 
-    struct MapUserdata {
+    // The userdata of the callbacks that the device can call after the server is destroyed: the
+    // device keeps fences with pending completions and buffers with pending maps alive, and calls
+    // the callbacks of popped error scopes when the scopes are destroyed. When the server is
+    // destroyed it sets |server| to nullptr in the userdata still pending, and the callbacks then
+    // only free them.
+    struct DetachableUserdata {
         Server* server;
+    };
+
+    struct MapUserdata : DetachableUserdata {
         ObjectHandle buffer;
         uint32_t requestSerial;
         uint64_t size;
@@ -32,15 +47,13 @@ namespace dawn_wire { namespace server {
         std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle = nullptr;
     };
 
-    struct ErrorScopeUserdata {
-        Server* server;
+    struct ErrorScopeUserdata : DetachableUserdata {
         // TODO(enga): ObjectHandle device;
         // when the wire supports multiple devices.
         uint64_t requestSerial;
     };
 
-    struct FenceCompletionUserdata {
-        Server* server;
+    struct FenceCompletionUserdata : DetachableUserdata {
         ObjectHandle fence;
         uint64_t value;
     };
@@ -50,15 +63,33 @@ namespace dawn_wire { namespace server {
         Server(DawnDevice device,
                const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService);
+               MemoryTransferService* memoryTransferService,
+               dawn_platform::Platform* platform,
+               bool setUncapturedErrorCallback = true);
         ~Server();
 
         const volatile char* HandleCommands(const volatile char* commands, size_t size);
 
         bool InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation);
 
+        WireStatistics GetStatistics() const;
+
+        // Whether the client has error scopes open on the device.
+        bool HasOpenErrorScopes() const;
+        // Pops the error scopes the client left open on the device, ignoring their errors.
+        void PopOpenErrorScopes();
+
+        // Sends an uncaptured error to the client. Called by the device callback, unless the
+        // server was created without setting it, in which case the owner forwards the errors.
+        void OnUncapturedError(DawnErrorType type, const char* message);
+
       private:
         void* GetCmdSpace(size_t size);
+        const volatile char* HandleCommandsImpl(const volatile char* commands, size_t size);
+
+        // Register and unregister the userdata of a pending callback that may outlive the server.
+        void TrackUserdata(DetachableUserdata* userdata);
+        void UntrackUserdata(DetachableUserdata* userdata);
 
         // Forwarding callbacks
         static void ForwardUncapturedError(DawnErrorType type, const char* message, void* userdata);
@@ -74,7 +105,6 @@ namespace dawn_wire { namespace server {
         static void ForwardFenceCompletedValue(DawnFenceCompletionStatus status, void* userdata);
 
         // Error callbacks
-        void OnUncapturedError(DawnErrorType type, const char* message);
         void OnDevicePopErrorScope(DawnErrorType type,
                                    const char* message,
                                    ErrorScopeUserdata* userdata);
@@ -96,6 +126,23 @@ namespace dawn_wire { namespace server {
         DawnProcTable mProcs;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
         MemoryTransferService* mMemoryTransferService = nullptr;
+        dawn_platform::Platform* mPlatform = nullptr;
+        std::unordered_set<DetachableUserdata*> mPendingUserdata;
+        uint64_t mOpenErrorScopeCount = 0;
+
+        // The SetSubData the client is sending in chunks, if any.
+        struct ChunkedSetSubData {
+            ObjectId bufferId = 0;
+            uint64_t start = 0;
+            uint64_t count = 0;
+            uint64_t offset = 0;
+            std::unique_ptr<uint8_t[]> data;
+        };
+        ChunkedSetSubData mChunkedSetSubData;
+
+        // Relaxed atomics so that the statistics can be queried from another thread.
+        std::atomic<uint64_t> mBytesIn = {0};
+        std::atomic<uint64_t> mBytesOut = {0};
     };
 
     std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
@@ -15,7 +15,10 @@
 #include "common/Assert.h"
 #include "dawn_wire/server/Server.h"
 
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <new>
 
 namespace dawn_wire { namespace server {
 
@@ -24,8 +27,7 @@ namespace dawn_wire { namespace server {
         DAWN_ASSERT(buffer != nullptr);
 
         // The buffer was unmapped. Clear the Read/WriteHandle.
-        buffer->readHandle = nullptr;
-        buffer->writeHandle = nullptr;
+        buffer->mapHandle.Reset();
         buffer->mapWriteState = BufferMapWriteState::Unmapped;
 
         return true;
@@ -73,6 +75,7 @@ namespace dawn_wire { namespace server {
 
             userdata->writeHandle =
                 std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle);
+            TrackUserdata(userdata.get());
             mProcs.bufferMapWriteAsync(buffer->handle, ForwardBufferMapWriteAsync,
                                        userdata.release());
         } else {
@@ -85,6 +88,7 @@ namespace dawn_wire { namespace server {
             ASSERT(readHandle != nullptr);
 
             userdata->readHandle = std::unique_ptr<MemoryTransferService::ReadHandle>(readHandle);
+            TrackUserdata(userdata.get());
             mProcs.bufferMapReadAsync(buffer->handle, ForwardBufferMapReadAsync,
                                       userdata.release());
         }
@@ -132,8 +136,8 @@ namespace dawn_wire { namespace server {
             // The buffer is mapped and has a valid mappedData pointer.
             // The buffer may still be an error with fake staging data.
             resultData->mapWriteState = BufferMapWriteState::Mapped;
-            resultData->writeHandle =
-                std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle);
+            resultData->mapHandle.SetWriteHandle(
+                std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle));
         }
         resultData->handle = result.buffer;
 
@@ -170,7 +174,7 @@ namespace dawn_wire { namespace server {
 
     bool Server::DoBufferSetSubDataInternal(ObjectId bufferId,
                                             uint64_t start,
-                                            uint64_t offset,
+                                            uint64_t count,
                                             const uint8_t* data) {
         // The null object isn't valid as `self`
         if (bufferId == 0) {
@@ -182,7 +186,67 @@ namespace dawn_wire { namespace server {
             return false;
         }
 
-        mProcs.bufferSetSubData(buffer->handle, start, offset, data);
+        mProcs.bufferSetSubData(buffer->handle, start, count, data);
+        return true;
+    }
+
+    bool Server::DoBufferSetSubDataChunk(ObjectId bufferId,
+                                         uint64_t start,
+                                         uint64_t count,
+                                         uint64_t offset,
+                                         uint64_t chunkLength,
+                                         const uint8_t* chunk) {
+        // The null object isn't valid as `self`
+        if (bufferId == 0) {
+            return false;
+        }
+
+        if (count > std::numeric_limits<size_t>::max()) {
+            return false;
+        }
+
+        auto* buffer = BufferObjects().Get(bufferId);
+        if (buffer == nullptr) {
+            return false;
+        }
+
+        // The chunks are reassembled so that the SetSubData is validated and applied once, like
+        // when it isn't split. The first chunk starts a new SetSubData and the following ones
+        // must continue it in order.
+        ChunkedSetSubData& pending = mChunkedSetSubData;
+        if (offset == 0) {
+            pending.bufferId = bufferId;
+            pending.start = start;
+            pending.count = count;
+            pending.offset = 0;
+            // An allocation failure is reported once all the chunks are received.
+            pending.data.reset(new (std::nothrow) uint8_t[static_cast<size_t>(count)]);
+        }
+        if (bufferId != pending.bufferId || start != pending.start || count != pending.count ||
+            offset != pending.offset || chunkLength > count - offset) {
+            pending = {};
+            return false;
+        }
+
+        if (pending.data != nullptr) {
+            memcpy(pending.data.get() + offset, chunk, static_cast<size_t>(chunkLength));
+        }
+        pending.offset += chunkLength;
+
+        if (pending.offset < pending.count) {
+            return true;
+        }
+
+        std::unique_ptr<uint8_t[]> data = std::move(pending.data);
+        pending = {};
+        if (data == nullptr) {
+            DawnDevice device = DeviceObjects().Get(1)->handle;
+            mProcs.deviceInjectError(device, DAWN_ERROR_TYPE_OUT_OF_MEMORY,
+                                     "Failed to allocate the data of a chunked SetSubData");
+            return true;
+        }
+
+        mProcs.bufferSetSubData(buffer->handle, start, count, data.get());
         return true;
     }
 
@@ -212,15 +276,59 @@ namespace dawn_wire { namespace server {
             case BufferMapWriteState::Mapped:
                 break;
         }
-        if (!buffer->writeHandle) {
+        MemoryTransferService::WriteHandle* writeHandle = buffer->mapHandle.GetWriteHandle();
+        if (writeHandle == nullptr) {
             // This check is performed after the check for the MapError state. It is permissible
             // to Unmap and attempt to update mapped data of an error buffer.
             return false;
         }
         // Deserialize the flush info and flush updated data from the handle into the target
         // of the handle. The target is set via WriteHandle::SetTarget.
-        return buffer->writeHandle->DeserializeFlush(writeFlushInfo,
-                                                     static_cast<size_t>(writeFlushInfoLength));
+        return writeHandle->DeserializeFlush(writeFlushInfo,
+                                             static_cast<size_t>(writeFlushInfoLength));
+    }
+
+    bool Server::DoBufferUpdateMappedDataChunk(ObjectId bufferId,
+                                               uint64_t offset,
+                                               uint64_t writeFlushInfoLength,
+                                               uint64_t chunkLength,
+                                               const uint8_t* chunk) {
+        // The null object isn't valid as `self`
+        if (bufferId == 0) {
+            return false;
+        }
+
+        if (writeFlushInfoLength > std::numeric_limits<size_t>::max()) {
+            return false;
+        }
+        if (offset > writeFlushInfoLength || chunkLength > writeFlushInfoLength - offset) {
+            return false;
+        }
+
+        auto* buffer = BufferObjects().Get(bufferId);
+        if (buffer == nullptr) {
+            return false;
+        }
+        switch (buffer->mapWriteState) {
+            case BufferMapWriteState::Unmapped:
+                return false;
+            case BufferMapWriteState::MapError:
+                // The buffer is mapped but there was an error allocating mapped data.
+                // Do not perform the memcpy.
+                return true;
+            case BufferMapWriteState::Mapped:
+                break;
+        }
+        MemoryTransferService::WriteHandle* writeHandle = buffer->mapHandle.GetWriteHandle();
+        if (writeHandle == nullptr) {
+            return false;
+        }
+        // Deserialize the chunk of flush info. Depending on the handle, the chunk is either
+        // copied directly into the target of the handle, or reassembled and flushed once the
+        // last chunk is received.
+        return writeHandle->DeserializeFlushChunk(chunk, static_cast<size_t>(chunkLength),
+                                                  static_cast<size_t>(offset),
+                                                  static_cast<size_t>(writeFlushInfoLength));
     }
 
     void Server::ForwardBufferMapReadAsync(DawnBufferMapAsyncStatus status,
@@ -228,6 +336,10 @@ namespace dawn_wire { namespace server {
                                            uint64_t dataLength,
                                            void* userdata) {
         auto data = static_cast<MapUserdata*>(userdata);
+        if (data->server == nullptr) {
+            delete data;
+            return;
+        }
         data->server->OnBufferMapReadAsyncCallback(status, ptr, dataLength, data);
     }
 
@@ -236,6 +348,10 @@ namespace dawn_wire { namespace server {
                                             uint64_t dataLength,
                                             void* userdata) {
         auto data = static_cast<MapUserdata*>(userdata);
+        if (data->server == nullptr) {
+            delete data;
+            return;
+        }
         data->server->OnBufferMapWriteAsyncCallback(status, ptr, dataLength, data);
     }
 
@@ -244,10 +360,11 @@ namespace dawn_wire { namespace server {
                                               uint64_t dataLength,
                                               MapUserdata* userdata) {
         std::unique_ptr<MapUserdata> data(userdata);
+        UntrackUserdata(userdata);
 
         // Skip sending the callback if the buffer has already been destroyed.
-        auto* bufferData = BufferObjects().Get(data->buffer.id);
-        if (bufferData == nullptr || bufferData->serial != data->buffer.serial) {
+        auto* bufferData = BufferObjects().Get(data->buffer.id, data->buffer.serial);
+        if (bufferData == nullptr) {
             return;
         }
 
@@ -277,7 +394,7 @@ namespace dawn_wire { namespace server {
 
             // The in-flight map request returned successfully.
             // Move the ReadHandle so it is owned by the buffer.
-            bufferData->readHandle = std::move(data->readHandle);
+            bufferData->mapHandle.SetReadHandle(std::move(data->readHandle));
         }
     }
 
@@ -286,10 +403,12 @@ namespace dawn_wire { namespace server {
                                                uint64_t dataLength,
                                                MapUserdata* userdata) {
         std::unique_ptr<MapUserdata> data(userdata);
+        UntrackUserdata(userdata);
+        UntrackUserdata(userdata);
 
         // Skip sending the callback if the buffer has already been destroyed.
-        auto* bufferData = BufferObjects().Get(data->buffer.id);
-        if (bufferData == nullptr || bufferData->serial != data->buffer.serial) {
+        auto* bufferData = BufferObjects().Get(data->buffer.id, data->buffer.serial);
+        if (bufferData == nullptr) {
             return;
         }
 
@@ -305,10 +424,10 @@ namespace dawn_wire { namespace server {
         if (status == DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS) {
             // The in-flight map request returned successfully.
             // Move the WriteHandle so it is owned by the buffer.
-            bufferData->writeHandle = std::move(data->writeHandle);
-            bufferData->mapWriteState = BufferMapWriteState::Mapped;
             // Set the target of the WriteHandle to the mapped buffer data.
-            bufferData->writeHandle->SetTarget(ptr, dataLength);
+            data->writeHandle->SetTarget(ptr, dataLength);
+            bufferData->mapHandle.SetWriteHandle(std::move(data->writeHandle));
+            bufferData->mapWriteState = BufferMapWriteState::Mapped;
         }
     }
 
@@ -31,21 +31,53 @@ namespace dawn_wire { namespace server {
         cmd.Serialize(allocatedBuffer);
     }
 
+    bool Server::HasOpenErrorScopes() const {
+        return mOpenErrorScopeCount > 0;
+    }
+
+    void Server::PopOpenErrorScopes() {
+        DawnDevice device = DeviceObjects().Get(1)->handle;
+        for (; mOpenErrorScopeCount > 0; --mOpenErrorScopeCount) {
+            // Without a callback the error of the scope is dropped without being formatted.
+            mProcs.devicePopErrorScope(device, nullptr, nullptr);
+        }
+    }
+
+    bool Server::PreHandleDevicePushErrorScope(const DevicePushErrorScopeCmd& cmd) {
+        mOpenErrorScopeCount++;
+        return true;
+    }
+
     bool Server::DoDevicePopErrorScope(DawnDevice cDevice, uint64_t requestSerial) {
+        // The error scopes are shared with the other users of the device, so the client can't be
+        // allowed to pop one it didn't push.
+        if (mOpenErrorScopeCount == 0) {
+            return false;
+        }
+
         ErrorScopeUserdata* userdata = new ErrorScopeUserdata;
         userdata->server = this;
         userdata->requestSerial = requestSerial;
+        TrackUserdata(userdata);
 
         bool success = mProcs.devicePopErrorScope(cDevice, ForwardPopErrorScope, userdata);
         if (!success) {
+            UntrackUserdata(userdata);
             delete userdata;
+            return false;
         }
-        return success;
+
+        mOpenErrorScopeCount--;
+        return true;
     }
 
     // static
     void Server::ForwardPopErrorScope(DawnErrorType type, const char* message, void* userdata) {
         auto* data = reinterpret_cast<ErrorScopeUserdata*>(userdata);
+        if (data->server == nullptr) {
+            delete data;
+            return;
+        }
         data->server->OnDevicePopErrorScope(type, message, data);
     }
 
@@ -53,6 +85,7 @@ namespace dawn_wire { namespace server {
                                        const char* message,
                                        ErrorScopeUserdata* userdata) {
         std::unique_ptr<ErrorScopeUserdata> data{userdata};
+        UntrackUserdata(userdata);
 
         ReturnDevicePopErrorScopeCallbackCmd cmd;
         cmd.requestSerial = data->requestSerial;
@@ -20,12 +20,17 @@ namespace dawn_wire { namespace server {
 
     void Server::ForwardFenceCompletedValue(DawnFenceCompletionStatus status, void* userdata) {
         auto data = static_cast<FenceCompletionUserdata*>(userdata);
+        if (data->server == nullptr) {
+            delete data;
+            return;
+        }
         data->server->OnFenceCompletedValueUpdated(status, data);
     }
 
     void Server::OnFenceCompletedValueUpdated(DawnFenceCompletionStatus status,
                                               FenceCompletionUserdata* userdata) {
         std::unique_ptr<FenceCompletionUserdata> data(userdata);
+        UntrackUserdata(userdata);
 
         if (status != DAWN_FENCE_COMPLETION_STATUS_SUCCESS) {
             return;
@@ -57,6 +57,21 @@ namespace dawn_wire { namespace server {
                 memcpy(mTargetData, deserializePointer, mDataLength);
                 return true;
             }
+
+            bool DeserializeFlushChunk(const void* deserializePointer,
+                                       size_t deserializeSize,
+                                       size_t offset,
+                                       size_t totalSize) override {
+                // The flush info is the raw data so chunks are copied directly into the target.
+                if (totalSize != mDataLength || mTargetData == nullptr ||
+                    deserializePointer == nullptr || offset > mDataLength ||
+                    deserializeSize > mDataLength - offset) {
+                    return false;
+                }
+                memcpy(static_cast<uint8_t*>(mTargetData) + offset, deserializePointer,
+                       deserializeSize);
+                return true;
+            }
         };
 
         InlineMemoryTransferService() {
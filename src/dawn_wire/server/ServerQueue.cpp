@@ -33,6 +33,7 @@ namespace dawn_wire { namespace server {
         userdata->server = this;
         userdata->fence = ObjectHandle{fenceId, fence->serial};
         userdata->value = signalValue;
+        TrackUserdata(userdata);
 
         mProcs.fenceOnCompletion(cFence, signalValue, ForwardFenceCompletedValue, userdata);
         return true;
@@ -159,6 +159,109 @@ namespace dawn_native {
 
     // Backdoor to get the number of lazy clears for testing
     DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(DawnDevice device);
+
+    // The GPU memory used by a device, in bytes. The memory of the buffers and textures is computed
+    // from their descriptors and doesn't include the padding added by the driver, and the memory
+    // of the descriptor pools is estimated.
+    struct MemoryUsage {
+        uint64_t buffers = 0;
+        uint64_t textures = 0;
+        // The staging memory of the buffers mapped at creation.
+        uint64_t staging = 0;
+        // The staging memory used to upload data to the GPU.
+        uint64_t uploadRingBuffers = 0;
+        uint64_t descriptorPools = 0;
+        uint64_t total = 0;
+    };
+
+    struct ObjectCacheStatistics {
+        uint64_t size = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // Counters of the internal state of a device, returned by GetDeviceStatistics.
+    struct DeviceStatistics {
+        // The number of objects created by the application that are still alive, either because
+        // the application holds a reference to them or because Dawn still uses them.
+        struct LiveObjectCounts {
+            uint64_t bindGroups = 0;
+            uint64_t bindGroupLayouts = 0;
+            uint64_t buffers = 0;
+            uint64_t commandBuffers = 0;
+            uint64_t commandEncoders = 0;
+            uint64_t computePipelines = 0;
+            uint64_t fences = 0;
+            uint64_t pipelineLayouts = 0;
+            uint64_t queues = 0;
+            uint64_t renderBundles = 0;
+            uint64_t renderBundleEncoders = 0;
+            uint64_t renderPipelines = 0;
+            uint64_t samplers = 0;
+            uint64_t shaderModules = 0;
+            uint64_t swapChains = 0;
+            uint64_t textures = 0;
+            uint64_t textureViews = 0;
+        } liveObjects;
+
+        // The caches that deduplicate the objects created with the same descriptor.
+        ObjectCacheStatistics attachmentStateCache;
+        ObjectCacheStatistics bindGroupLayoutCache;
+        ObjectCacheStatistics computePipelineCache;
+        ObjectCacheStatistics pipelineLayoutCache;
+        ObjectCacheStatistics renderPipelineCache;
+        ObjectCacheStatistics samplerCache;
+        ObjectCacheStatistics shaderModuleCache;
+
+        // The bytes of the blocks used to record commands that aren't freed yet. These are shared
+        // by all the devices of the process.
+        uint64_t commandAllocatorBytes = 0;
+
+        // The ring buffers of the staging memory used to upload data to the GPU.
+        uint64_t uploadRingBufferCount = 0;
+        uint64_t uploadRingBufferBytes = 0;
+        uint64_t uploadRingBufferUsedBytes = 0;
+        uint64_t uploadRingBufferGrowths = 0;
+        uint64_t stagingBytesUploaded = 0;
+
+        uint64_t lazyClearCount = 0;
+
+        // The OpenGL calls setting state that were issued, and the ones that were skipped because
+        // they would have set the state to the value it already had. Only counted when the
+        // filter_redundant_gl_state_calls toggle is enabled.
+        uint64_t glStateCallsIssued = 0;
+        uint64_t glStateCallsFiltered = 0;
+
+        // The vkCmdPipelineBarrier calls recorded by the Vulkan backend, and the resource barriers
+        // that were merged in a call with other barriers instead of getting their own.
+        uint64_t vulkanBarriersIssued = 0;
+        uint64_t vulkanBarriersMerged = 0;
+
+        uint64_t lastSubmittedSerial = 0;
+        uint64_t completedSerial = 0;
+
+        MemoryUsage memoryUsage;
+    };
+
+    // Returns the counters of the device. It must be called on the thread that uses the device,
+    // but the counters themselves are cheap to update and don't slow the device down.
+    DAWN_NATIVE_EXPORT DeviceStatistics GetDeviceStatistics(DawnDevice device);
+
+    DAWN_NATIVE_EXPORT MemoryUsage GetMemoryUsage(DawnDevice device);
+
+    // Called when the memory usage of the device goes over its budget, so that the application can
+    // release the objects it doesn't need before running out of memory.
+    using MemoryPressureCallback = void (*)(uint64_t usage, uint64_t budget, void* userdata);
+
+    constexpr uint64_t kNoMemoryBudget = UINT64_MAX;
+
+    // Sets the memory budget of the device. The callback is called during the device tick that
+    // follows the usage going over the budget, and isn't called again until the usage has gone
+    // back under the budget. The budget doesn't prevent allocations from succeeding.
+    DAWN_NATIVE_EXPORT void SetMemoryBudget(DawnDevice device,
+                                            uint64_t budget,
+                                            MemoryPressureCallback callback,
+                                            void* userdata);
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_DAWNNATIVE_H_
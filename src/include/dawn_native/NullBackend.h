@@ -20,6 +20,26 @@
 
 namespace dawn_native { namespace null {
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+    // The cost model of the simulated GPU timeline of a null device, in nanoseconds.
+    struct SimulatedGPUTimelineDescriptor {
+        uint64_t submitCost = 10000;
+        // Every command recorded in the submitted command buffers, draws and dispatches as well
+        // as state changes.
+        uint64_t commandCost = 500;
+        // Added for each kilobyte copied between buffers, and from staging memory for
+        // SetSubData and mappable buffers.
+        uint64_t copyCostPerKilobyte = 100;
+    };
+
+    // By default the work submitted to a null device completes at the next submit or tick.
+    // With a simulated GPU timeline, a worker thread retires the serials instead, once the work
+    // submitted for them has been executed according to the cost model. Map callbacks, fences
+    // and deferred frees then behave as they would on a GPU, which is what perf tests need.
+    // Returns false and does nothing if |device| isn't a null device or already has a timeline.
+    DAWN_NATIVE_EXPORT bool EnableSimulatedGPUTimeline(
+        DawnDevice device,
+        const SimulatedGPUTimelineDescriptor* descriptor);
 }}  // namespace dawn_native::null
 
 #endif  // DAWNNATIVE_NULLBACKEND_H_
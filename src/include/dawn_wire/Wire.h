@@ -16,6 +16,7 @@
 #define DAWNWIRE_WIRE_H_
 
 #include <cstdint>
+#include <limits>
 
 #include "dawn/dawn.h"
 #include "dawn_wire/dawn_wire_export.h"
@@ -27,6 +28,19 @@ namespace dawn_wire {
         virtual ~CommandSerializer() = default;
         virtual void* GetCmdSpace(size_t size) = 0;
         virtual bool Flush() = 0;
+
+        // The largest |size| that GetCmdSpace is guaranteed to succeed for. Uploads whose
+        // payload doesn't fit in a single allocation are split into multiple bounded commands.
+        virtual size_t GetMaximumAllocationSize() const {
+            return std::numeric_limits<size_t>::max();
+        }
+    };
+
+    // The bytes of the commands that went through a WireClient or a WireServer. The bytes in are
+    // the ones given to HandleCommands and the bytes out the ones serialized for the other side.
+    struct DAWN_WIRE_EXPORT WireStatistics {
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
     };
 
     class DAWN_WIRE_EXPORT CommandHandler {
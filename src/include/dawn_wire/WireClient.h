@@ -35,6 +35,12 @@ namespace dawn_wire {
     struct DAWN_WIRE_EXPORT WireClientDescriptor {
         CommandSerializer* serializer;
         client::MemoryTransferService* memoryTransferService = nullptr;
+        // Whether the destruction of released objects is held back and coalesced in batches
+        // serialized before the next command or on WireClient::Flush. Only embedders that always
+        // flush through WireClient::Flush can set it: flushing the serializer directly would
+        // leave the destruction of the objects released last unsent, and leak them on the server.
+        // Otherwise each release is serialized immediately.
+        bool coalesceReleases = false;
     };
 
     class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -49,6 +55,14 @@ namespace dawn_wire {
 
         ReservedTexture ReserveTexture(DawnDevice device);
 
+        WireStatistics GetStatistics() const;
+
+        // Serializes the commands held back by the client, like the destruction of released
+        // objects when they are coalesced, then flushes the serializer. Embedders that set
+        // WireClientDescriptor::coalesceReleases must call this instead of flushing the
+        // serializer directly.
+        bool Flush();
+
       private:
         std::unique_ptr<client::Client> mImpl;
     };
@@ -116,7 +130,19 @@ namespace dawn_wire {
                 // server.
                 virtual void SerializeFlush(void* serializePointer) = 0;
 
+                // Serialize |size| bytes of the flush info, starting at |offset|, into
+                // |serializePointer|. This is used when the flush info is too large to fit in a
+                // single command. Chunks are requested in increasing order of |offset| and cover
+                // the whole SerializeFlushSize() range. The default implementation serializes the
+                // whole flush info to temporary storage on the first chunk and copies from it.
+                virtual void SerializeFlushChunk(void* serializePointer,
+                                                 size_t offset,
+                                                 size_t size);
+
                 virtual ~WriteHandle();
+
+              private:
+                std::unique_ptr<uint8_t[]> mFlushChunkStorage;
             };
         };
     }  // namespace client
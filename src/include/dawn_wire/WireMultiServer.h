@@ -0,0 +1,102 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_WIREMULTISERVER_H_
+#define DAWNWIRE_WIREMULTISERVER_H_
+
+#include <memory>
+
+#include "dawn_wire/Wire.h"
+
+namespace dawn_platform {
+    class Platform;
+}  // namespace dawn_platform
+
+namespace dawn_wire {
+
+    namespace server {
+        class MultiServer;
+        class MemoryTransferService;
+    }
+
+    struct DAWN_WIRE_EXPORT WireMultiServerDescriptor {
+        DawnDevice device;
+        const DawnProcTable* procs;
+        server::MemoryTransferService* memoryTransferService = nullptr;
+        // Records the trace events of the servers if not null.
+        dawn_platform::Platform* platform = nullptr;
+        // The number of bytes of commands that each client gets to have handled per scheduling
+        // round. Batches are never split, so a batch bigger than the quota waits for the quota
+        // of several rounds.
+        size_t clientQuotaPerRound = 64 * 1024;
+    };
+
+    // A server front-end that hosts several wire clients on a single device. Each client has its
+    // own object ID namespace and its own serializer for the commands sent back to it, like it
+    // would with its own WireServer.
+    //
+    // The commands of each client are queued when they are received, and handled when the
+    // embedder calls HandleQueuedCommands, which interleaves the batches of the clients in a
+    // deficit round-robin: a client that sends a lot of commands can't delay the other clients
+    // by more than a quota per round.
+    //
+    // Error scopes are per-device, so while a client has error scopes open only its commands are
+    // handled: the scopes then only capture its errors, and it can only pop the scopes it pushed.
+    // Clients should close their scopes quickly since they hold the device until they do.
+    //
+    // Uncaptured errors that happen while a client's commands are handled, or while it has error
+    // scopes open, are sent to that client. The other ones, for example errors of the device
+    // when it is ticked by the embedder, can't be attributed to a client and are sent to all
+    // clients.
+    class DAWN_WIRE_EXPORT WireMultiServer {
+      public:
+        WireMultiServer(const WireMultiServerDescriptor& descriptor);
+        ~WireMultiServer();
+
+        // Adds a client and returns its ID. The commands sent back to the client are written to
+        // |serializer| which must outlive the client.
+        uint32_t AddClient(CommandSerializer* serializer);
+
+        // Destroys the objects of the client and its command handler. The transport of the client
+        // must be disconnected from the handler first: RemoveClient must not run concurrently
+        // with, or be followed by, calls to the handler. The error scopes the client left open are
+        // popped, and the callbacks still pending on the device for the client, like fence
+        // completions, are dropped.
+        void RemoveClient(uint32_t clientId);
+
+        // The handler the client->server transport of a client should be connected to. It only
+        // copies the commands in the queue of the client and can be called from any thread.
+        // It returns nullptr once the client sent invalid commands.
+        CommandHandler* GetCommandHandler(uint32_t clientId);
+
+        bool InjectTexture(uint32_t clientId,
+                           DawnTexture texture,
+                           uint32_t id,
+                           uint32_t generation);
+
+        // Runs one scheduling round over the clients, or only handles the commands of the client
+        // with error scopes open. Returns true if commands that can be handled are still queued
+        // afterwards.
+        bool HandleQueuedCommands();
+
+        bool HasQueuedCommands(uint32_t clientId) const;
+        bool IsClientLost(uint32_t clientId) const;
+
+      private:
+        std::unique_ptr<server::MultiServer> mImpl;
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_WIREMULTISERVER_H_
@@ -19,6 +19,10 @@
 
 #include "dawn_wire/Wire.h"
 
+namespace dawn_platform {
+    class Platform;
+}  // namespace dawn_platform
+
 namespace dawn_wire {
 
     namespace server {
@@ -31,6 +35,8 @@ namespace dawn_wire {
         const DawnProcTable* procs;
         CommandSerializer* serializer;
         server::MemoryTransferService* memoryTransferService = nullptr;
+        // Records the trace events of the server if not null.
+        dawn_platform::Platform* platform = nullptr;
     };
 
     class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -43,6 +49,8 @@ namespace dawn_wire {
 
         bool InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation);
 
+        WireStatistics GetStatistics() const;
+
       private:
         std::unique_ptr<server::Server> mImpl;
     };
@@ -87,11 +95,34 @@ namespace dawn_wire {
                 // client::MemoryTransferService::WriteHandle::SerializeFlush.
                 virtual bool DeserializeFlush(const void* deserializePointer,
                                               size_t deserializeSize) = 0;
+
+                // This function takes in a chunk of the serialized result of
+                // client::MemoryTransferService::WriteHandle::SerializeFlushChunk, located at
+                // |offset| in a flush info of |totalSize| bytes. The default implementation
+                // reassembles the chunks, which must arrive in order and total no more than
+                // GetMaxFlushInfoSize(), and calls DeserializeFlush once the last one is received.
+                // Implementations where the flush info is the raw data can override this to copy
+                // each chunk directly into the target.
+                virtual bool DeserializeFlushChunk(const void* deserializePointer,
+                                                   size_t deserializeSize,
+                                                   size_t offset,
+                                                   size_t totalSize);
+
+                // The largest flush info accepted by the default DeserializeFlushChunk. It
+                // defaults to the size of the target and must be overridden by implementations
+                // whose serialized flush info can be larger than the data, for example because
+                // it contains a header.
+                virtual size_t GetMaxFlushInfoSize() const;
                 virtual ~WriteHandle();
 
               protected:
                 void* mTargetData = nullptr;
                 size_t mDataLength = 0;
+
+              private:
+                std::unique_ptr<uint8_t[]> mFlushChunkStorage;
+                size_t mFlushChunkOffset = 0;
+                size_t mFlushChunkTotalSize = 0;
             };
         };
     }  // namespace server
@@ -0,0 +1,134 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_WIRETRACE_H_
+#define DAWNWIRE_WIRETRACE_H_
+
+#include "dawn_wire/Wire.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dawn_wire {
+
+    // Wire traces contain the commands flushed on a wire so that they can be replayed later, for
+    // example by dawn_wire_replay to benchmark the server on the exact streams of a client.
+    //
+    // A trace file starts with a WireTraceFileHeader followed by a sequence of batches. Each batch
+    // is a WireTraceBatchHeader, then the size of each of its commands as uint32_t, then the bytes
+    // of the commands.
+
+    enum class WireTraceDirection : uint32_t {
+        ClientToServer = 0,
+        ServerToClient = 1,
+    };
+
+    struct WireTraceFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    struct WireTraceBatchHeader {
+        WireTraceDirection direction;
+        uint32_t commandCount;
+        // Nanoseconds between the creation of the writer and the flush of the batch.
+        uint64_t timestamp;
+        uint64_t size;
+    };
+
+    struct WireTraceBatch {
+        WireTraceDirection direction;
+        uint64_t timestamp;
+        std::vector<uint32_t> commandSizes;
+        std::vector<char> commands;
+    };
+
+    // Writes batches to a trace file. A single writer can be shared by the recording serializers
+    // of both directions of a wire.
+    class DAWN_WIRE_EXPORT WireTraceWriter {
+      public:
+        // Returns nullptr if the file can't be created.
+        static std::unique_ptr<WireTraceWriter> Create(const char* path);
+        ~WireTraceWriter();
+
+        bool WriteBatch(WireTraceDirection direction,
+                        const uint32_t* commandSizes,
+                        uint32_t commandCount,
+                        const char* commands,
+                        size_t size);
+
+      private:
+        explicit WireTraceWriter(FILE* file);
+
+        FILE* mFile;
+        std::mutex mMutex;
+        std::chrono::steady_clock::time_point mStartTime;
+    };
+
+    // Reads the batches of a trace file in order.
+    class DAWN_WIRE_EXPORT WireTraceReader {
+      public:
+        // Returns nullptr if the file can't be opened or isn't a wire trace.
+        static std::unique_ptr<WireTraceReader> Create(const char* path);
+        ~WireTraceReader();
+
+        // Returns false at the end of the trace or if the next batch is malformed.
+        bool ReadBatch(WireTraceBatch* batch);
+        // Whether the last ReadBatch failed because the trace ended cleanly after a batch, rather
+        // than because of a malformed or truncated batch.
+        bool IsAtEnd() const;
+
+      private:
+        explicit WireTraceReader(FILE* file);
+
+        FILE* mFile;
+        bool mIsAtEnd = false;
+    };
+
+    // A CommandSerializer that forwards to another serializer and records every flushed batch in
+    // a trace. Each GetCmdSpace allocation is recorded as one command.
+    class DAWN_WIRE_EXPORT RecordingCommandSerializer : public CommandSerializer {
+      public:
+        RecordingCommandSerializer(CommandSerializer* serializer,
+                                   WireTraceWriter* writer,
+                                   WireTraceDirection direction);
+        ~RecordingCommandSerializer() override;
+
+        void* GetCmdSpace(size_t size) override;
+        bool Flush() override;
+        size_t GetMaximumAllocationSize() const override;
+
+      private:
+        // Copies the last allocation into the batch. It is only complete once the next
+        // allocation is requested, and must be copied before the wrapped serializer gets a chance
+        // to flush and reuse its memory.
+        void RecordLastAllocation();
+
+        CommandSerializer* mSerializer;
+        WireTraceWriter* mWriter;
+        WireTraceDirection mDirection;
+
+        char* mLastAllocation = nullptr;
+        size_t mLastAllocationSize = 0;
+        std::vector<uint32_t> mCommandSizes;
+        std::vector<char> mCommands;
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_WIRETRACE_H_
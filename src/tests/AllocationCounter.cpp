@@ -0,0 +1,117 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/AllocationCounter.h"
+
+#include "common/Assert.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+    // These are plain thread_local integers so that they are zero-initialized without any
+    // allocation, as operator new can be called before anything else on a thread.
+    thread_local uint32_t tCounterDepth = 0;
+    thread_local uint64_t tAllocationCount = 0;
+    thread_local uint64_t tAllocatedBytes = 0;
+
+}  // anonymous namespace
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+    : mStartAllocationCount(tAllocationCount), mStartAllocatedBytes(tAllocatedBytes) {
+    tCounterDepth++;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+    ASSERT(tCounterDepth > 0);
+    tCounterDepth--;
+}
+
+// static
+bool ScopedAllocationCounter::IsSupported() {
+#if defined(DAWN_DISABLE_ALLOCATION_COUNTER)
+    return false;
+#else
+    return true;
+#endif
+}
+
+uint64_t ScopedAllocationCounter::GetAllocationCount() const {
+    return tAllocationCount - mStartAllocationCount;
+}
+
+uint64_t ScopedAllocationCounter::GetAllocatedBytes() const {
+    return tAllocatedBytes - mStartAllocatedBytes;
+}
+
+#if !defined(DAWN_DISABLE_ALLOCATION_COUNTER)
+
+namespace {
+
+    void* CountedAllocate(size_t size) {
+        if (tCounterDepth > 0) {
+            tAllocationCount++;
+            tAllocatedBytes += size;
+        }
+        return malloc(size == 0 ? 1 : size);
+    }
+
+}  // anonymous namespace
+
+void* operator new(size_t size) {
+    void* ptr = CountedAllocate(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    free(ptr);
+}
+
+#endif  // !defined(DAWN_DISABLE_ALLOCATION_COUNTER)
@@ -0,0 +1,47 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_ALLOCATIONCOUNTER_H_
+#define TESTS_ALLOCATIONCOUNTER_H_
+
+#include <cstdint>
+
+// Counts the heap allocations made with operator new on the current thread while it is alive.
+// The test binaries replace the global operator new and delete to do the counting, so
+// allocations made directly with malloc aren't seen.
+//
+//   ScopedAllocationCounter counter;
+//   DoSteadyStateWork();
+//   EXPECT_EQ(0u, counter.GetAllocationCount());
+class ScopedAllocationCounter {
+  public:
+    ScopedAllocationCounter();
+    ~ScopedAllocationCounter();
+
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    // The counting isn't available when the test binary is built with an allocator that
+    // already replaces operator new, in which case the counts are always 0.
+    static bool IsSupported();
+
+    uint64_t GetAllocationCount() const;
+    uint64_t GetAllocatedBytes() const;
+
+  private:
+    uint64_t mStartAllocationCount;
+    uint64_t mStartAllocatedBytes;
+};
+
+#endif  // TESTS_ALLOCATIONCOUNTER_H_
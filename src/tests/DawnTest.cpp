@@ -81,6 +81,7 @@ namespace {
 
 const DawnTestParam D3D12Backend(dawn_native::BackendType::D3D12);
 const DawnTestParam MetalBackend(dawn_native::BackendType::Metal);
+const DawnTestParam NullBackend(dawn_native::BackendType::Null);
 const DawnTestParam OpenGLBackend(dawn_native::BackendType::OpenGL);
 const DawnTestParam VulkanBackend(dawn_native::BackendType::Vulkan);
 
@@ -273,6 +274,10 @@ bool DawnTestBase::IsMetal() const {
     return mParam.backendType == dawn_native::BackendType::Metal;
 }
 
+bool DawnTestBase::IsNull() const {
+    return mParam.backendType == dawn_native::BackendType::Null;
+}
+
 bool DawnTestBase::IsOpenGL() const {
     return mParam.backendType == dawn_native::BackendType::OpenGL;
 }
@@ -431,12 +436,14 @@ void DawnTestBase::SetUp() {
         serverDesc.device = backendDevice;
         serverDesc.procs = &backendProcs;
         serverDesc.serializer = mS2cBuf.get();
+        serverDesc.platform = gTestEnv->GetInstance()->GetPlatform();
 
         mWireServer.reset(new dawn_wire::WireServer(serverDesc));
         mC2sBuf->SetHandler(mWireServer.get());
 
         dawn_wire::WireClientDescriptor clientDesc = {};
         clientDesc.serializer = mC2sBuf.get();
+        clientDesc.coalesceReleases = true;
 
         mWireClient.reset(new dawn_wire::WireClient(clientDesc));
         DawnDevice clientDevice = mWireClient->GetDevice();
@@ -578,7 +585,7 @@ void DawnTestBase::WaitABit() {
 
 void DawnTestBase::FlushWire() {
     if (gTestEnv->UsesWire()) {
-        bool C2SFlushed = mC2sBuf->Flush();
+        bool C2SFlushed = mWireClient->Flush();
         bool S2CFlushed = mS2cBuf->Flush();
         ASSERT(C2SFlushed);
         ASSERT(S2CFlushed);
@@ -700,6 +707,9 @@ namespace detail {
 #if defined(DAWN_ENABLE_BACKEND_METAL)
             case dawn_native::BackendType::Metal:
 #endif
+#if defined(DAWN_ENABLE_BACKEND_NULL)
+            case dawn_native::BackendType::Null:
+#endif
 #if defined(DAWN_ENABLE_BACKEND_OPENGL)
             case dawn_native::BackendType::OpenGL:
 #endif
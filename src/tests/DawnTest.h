@@ -91,6 +91,7 @@ std::ostream& operator<<(std::ostream& os, const DawnTestParam& param);
 // Shorthands for backend types used in the DAWN_INSTANTIATE_TEST
 extern const DawnTestParam D3D12Backend;
 extern const DawnTestParam MetalBackend;
+extern const DawnTestParam NullBackend;
 extern const DawnTestParam OpenGLBackend;
 extern const DawnTestParam VulkanBackend;
 
@@ -151,6 +152,7 @@ class DawnTestBase {
 
     bool IsD3D12() const;
     bool IsMetal() const;
+    bool IsNull() const;
     bool IsOpenGL() const;
     bool IsVulkan() const;
 
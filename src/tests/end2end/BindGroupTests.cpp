@@ -807,4 +807,9 @@ TEST_P(BindGroupTests, BindGroupLayoutVisibilityCanBeNone) {
     queue.Submit(1, &commands);
 }
 
-DAWN_INSTANTIATE_TEST(BindGroupTests, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(BindGroupTests,
+                      D3D12Backend,
+                      MetalBackend,
+                      OpenGLBackend,
+                      ForceWorkarounds(OpenGLBackend, {"async_gl_shader_compilation"}),
+                      VulkanBackend);
@@ -79,6 +79,36 @@ TEST_P(BufferMapReadTests, LargeRead) {
     buffer.Unmap();
 }
 
+// Test that unmapping a buffer before its map request completes cancels the request, and that
+// the buffer can be mapped again afterwards.
+TEST_P(BufferMapReadTests, UnmapBeforeMapCompletes) {
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+    dawn::Buffer buffer = device.CreateBuffer(&descriptor);
+
+    uint32_t myData = 0x01020304;
+    buffer.SetSubData(0, sizeof(myData), &myData);
+
+    bool cancelled = false;
+    buffer.MapReadAsync(
+        [](DawnBufferMapAsyncStatus status, const void*, uint64_t, void* userdata) {
+            EXPECT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_UNKNOWN, status);
+            *static_cast<bool*>(userdata) = true;
+        },
+        &cancelled);
+    buffer.Unmap();
+
+    while (!cancelled) {
+        WaitABit();
+    }
+
+    const void* mappedData = MapReadAsyncAndWait(buffer);
+    ASSERT_EQ(myData, *reinterpret_cast<const uint32_t*>(mappedData));
+
+    buffer.Unmap();
+}
+
 DAWN_INSTANTIATE_TEST(BufferMapReadTests, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
 
 class BufferMapWriteTests : public DawnTest {
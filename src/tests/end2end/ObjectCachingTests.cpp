@@ -394,4 +394,9 @@ TEST_P(ObjectCachingTest, SamplerDeduplication) {
     EXPECT_EQ(sampler.Get() == sameSampler.Get(), !UsesWire());
 }
 
-DAWN_INSTANTIATE_TEST(ObjectCachingTest, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(ObjectCachingTest,
+                      D3D12Backend,
+                      MetalBackend,
+                      OpenGLBackend,
+                      ForceWorkarounds(OpenGLBackend, {"async_gl_shader_compilation"}),
+                      VulkanBackend);
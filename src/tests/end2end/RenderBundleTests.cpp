@@ -204,4 +204,46 @@ TEST_P(RenderBundleTest, BundleAndRenderPassCommands) {
     EXPECT_PIXEL_RGBA8_EQ(kColors[1], renderPass.color, 3, 1);
 }
 
+// Test executing the same bundle in several submits and in render passes of different sizes,
+// which the Vulkan backend records in different secondary command buffers.
+TEST_P(RenderBundleTest, ReusedInRenderPassesOfDifferentSizes) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatsCount = 1;
+    desc.cColorFormats[0] = renderPass.colorFormat;
+
+    dawn::RenderBundleEncoder renderBundleEncoder = device.CreateRenderBundleEncoder(&desc);
+
+    renderBundleEncoder.SetPipeline(pipeline);
+    renderBundleEncoder.SetVertexBuffer(0, vertexBuffer);
+    renderBundleEncoder.SetBindGroup(0, bindGroups[0]);
+    renderBundleEncoder.Draw(6, 1, 0, 0);
+
+    dawn::RenderBundle renderBundle = renderBundleEncoder.Finish();
+
+    utils::BasicRenderPass largeRenderPass =
+        utils::CreateBasicRenderPass(device, 2 * kRTSize, 2 * kRTSize);
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        {
+            dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+            pass.ExecuteBundles(1, &renderBundle);
+            pass.EndPass();
+        }
+        {
+            dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&largeRenderPass.renderPassInfo);
+            pass.ExecuteBundles(1, &renderBundle);
+            pass.EndPass();
+        }
+
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], renderPass.color, 3, 1);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], largeRenderPass.color, 1, 7);
+    EXPECT_PIXEL_RGBA8_EQ(kColors[0], largeRenderPass.color, 7, 1);
+}
+
 DAWN_INSTANTIATE_TEST(RenderBundleTest, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
@@ -171,4 +171,76 @@ TEST_P(RenderPassTest, NoCorrespondingFragmentShaderOutputs) {
     EXPECT_PIXEL_RGBA8_EQ(kRed, renderTarget, kRTSize - 1, 1);
 }
 
-DAWN_INSTANTIATE_TEST(RenderPassTest, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+// Test render passes to the same render target in different submits, and to a render target
+// created after another one was destroyed, work correctly. Backends may cache the objects of
+// render passes by render target.
+TEST_P(RenderPassTest, RenderPassesToReusedAndRecreatedRenderTargets) {
+    constexpr RGBA8 kRed(255, 0, 0, 255);
+    constexpr RGBA8 kGreen(0, 255, 0, 255);
+
+    auto ClearRenderTarget = [this](const dawn::Texture& renderTarget, dawn::Color clearColor) {
+        utils::ComboRenderPassDescriptor renderPass({renderTarget.CreateView()});
+        renderPass.cColorAttachments[0].clearColor = clearColor;
+
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.EndPass();
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    };
+
+    dawn::Texture renderTarget = CreateDefault2DTexture();
+    ClearRenderTarget(renderTarget, {1.0f, 0.0f, 0.0f, 1.0f});
+    EXPECT_PIXEL_RGBA8_EQ(kRed, renderTarget, 0, 0);
+    ClearRenderTarget(renderTarget, {0.0f, 1.0f, 0.0f, 1.0f});
+    EXPECT_PIXEL_RGBA8_EQ(kGreen, renderTarget, 0, 0);
+
+    renderTarget.Destroy();
+    renderTarget = CreateDefault2DTexture();
+    ClearRenderTarget(renderTarget, {1.0f, 0.0f, 0.0f, 1.0f});
+    EXPECT_PIXEL_RGBA8_EQ(kRed, renderTarget, 0, 0);
+}
+
+// Test render passes in several command buffers of the same submit, one of them submitted twice,
+// work correctly. Backends may record the command buffers of a submit in parallel.
+TEST_P(RenderPassTest, RenderPassesInSeveralCommandBuffersOfOneSubmit) {
+    constexpr RGBA8 kRed(255, 0, 0, 255);
+    constexpr RGBA8 kBlue(0, 0, 255, 255);
+    constexpr uint32_t kNumCommandBuffers = 4;
+
+    // Each command buffer clears its render target to red and draws a blue triangle in the
+    // bottom left of it, except the last one that only clears it.
+    std::array<dawn::Texture, kNumCommandBuffers> renderTargets;
+    std::vector<dawn::CommandBuffer> commandBuffers;
+    for (uint32_t i = 0; i < kNumCommandBuffers; ++i) {
+        renderTargets[i] = CreateDefault2DTexture();
+
+        utils::ComboRenderPassDescriptor renderPass({renderTargets[i].CreateView()});
+        renderPass.cColorAttachments[0].clearColor = {1.0f, 0.0f, 0.0f, 1.0f};
+
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        if (i != kNumCommandBuffers - 1) {
+            pass.SetPipeline(pipeline);
+            pass.Draw(3, 1, 0, 0);
+        }
+        pass.EndPass();
+        commandBuffers.push_back(encoder.Finish());
+    }
+    commandBuffers.push_back(commandBuffers[0]);
+
+    queue.Submit(static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+
+    for (uint32_t i = 0; i < kNumCommandBuffers - 1; ++i) {
+        EXPECT_PIXEL_RGBA8_EQ(kBlue, renderTargets[i], 1, kRTSize - 1);
+        EXPECT_PIXEL_RGBA8_EQ(kRed, renderTargets[i], kRTSize - 1, 1);
+    }
+    EXPECT_PIXEL_RGBA8_EQ(kRed, renderTargets[kNumCommandBuffers - 1], 1, kRTSize - 1);
+}
+
+DAWN_INSTANTIATE_TEST(RenderPassTest,
+                      D3D12Backend,
+                      MetalBackend,
+                      OpenGLBackend,
+                      VulkanBackend,
+                      ForceWorkarounds(VulkanBackend, {"record_vulkan_commands_in_parallel"}));
@@ -184,4 +184,9 @@ TEST_P(SamplerTest, AddressMode) {
     }
 }
 
-DAWN_INSTANTIATE_TEST(SamplerTest, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(SamplerTest,
+                      D3D12Backend,
+                      MetalBackend,
+                      OpenGLBackend,
+                      ForceWorkarounds(OpenGLBackend, {"async_gl_shader_compilation"}),
+                      VulkanBackend);
@@ -0,0 +1,206 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Assert.h"
+#include "tests/ParamGenerator.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+#include <cstring>
+
+namespace {
+
+    constexpr unsigned int kNumReadbacks = 16;
+
+    enum class ReadbackSize {
+        BufferSize_1KB = 1 * 1024,
+        BufferSize_64KB = 64 * 1024,
+        BufferSize_1MB = 1 * 1024 * 1024,
+        BufferSize_16MB = 16 * 1024 * 1024,
+    };
+
+    struct BufferReadbackParams : DawnTestParam {
+        BufferReadbackParams(const DawnTestParam& param,
+                             ReadbackSize readbackSize,
+                             uint32_t readbacksInFlight)
+            : DawnTestParam(param),
+              readbackSize(readbackSize),
+              readbacksInFlight(readbacksInFlight) {
+        }
+
+        ReadbackSize readbackSize;
+        uint32_t readbacksInFlight;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BufferReadbackParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.readbackSize) {
+            case ReadbackSize::BufferSize_1KB:
+                ostream << "_BufferSize_1KB";
+                break;
+            case ReadbackSize::BufferSize_64KB:
+                ostream << "_BufferSize_64KB";
+                break;
+            case ReadbackSize::BufferSize_1MB:
+                ostream << "_BufferSize_1MB";
+                break;
+            case ReadbackSize::BufferSize_16MB:
+                ostream << "_BufferSize_16MB";
+                break;
+        }
+
+        ostream << "_" << param.readbacksInFlight << "_InFlight";
+        return ostream;
+    }
+
+}  // namespace
+
+// Test reading back data written by the GPU |kNumReadbacks| times. Each readback copies a buffer
+// into a MapRead buffer, submits the copy and maps the MapRead buffer. With several readbacks in
+// flight, the MapRead buffers are used in turn and a readback only waits for the one that used
+// the same buffer before it, which shows whether mapping stalls the CPU. The reported time is per
+// readback, and the latency from the map request to the map callback is also reported.
+class BufferReadbackPerf : public DawnPerfTestWithParams<BufferReadbackParams> {
+  public:
+    BufferReadbackPerf()
+        : DawnPerfTestWithParams(kNumReadbacks),
+          mData(static_cast<size_t>(GetParam().readbackSize)),
+          mTimer(utils::CreateTimer()) {
+    }
+    ~BufferReadbackPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintLatencyResults();
+
+  private:
+    struct Readback {
+        BufferReadbackPerf* test = nullptr;
+        dawn::Buffer buffer;
+        bool pending = false;
+        bool done = false;
+        double startTime = 0.0;
+    };
+
+    static void OnMapRead(DawnBufferMapAsyncStatus status,
+                          const void* data,
+                          uint64_t dataLength,
+                          void* userdata);
+
+    void Step() override;
+    void WaitForReadback(Readback* readback);
+
+    dawn::Buffer mSource;
+    std::vector<Readback> mReadbacks;
+    std::vector<uint8_t> mData;
+
+    std::unique_ptr<utils::Timer> mTimer;
+    unsigned int mNumReadbacksPerformed = 0;
+    double mLatency = 0.0;
+};
+
+void BufferReadbackPerf::TestSetUp() {
+    DawnPerfTestWithParams<BufferReadbackParams>::TestSetUp();
+
+    dawn::BufferDescriptor descriptor = {};
+    descriptor.size = mData.size();
+    descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+    mSource = device.CreateBuffer(&descriptor);
+    mSource.SetSubData(0, mData.size(), mData.data());
+
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+    mReadbacks.resize(GetParam().readbacksInFlight);
+    for (Readback& readback : mReadbacks) {
+        readback.test = this;
+        readback.buffer = device.CreateBuffer(&descriptor);
+    }
+}
+
+// static
+void BufferReadbackPerf::OnMapRead(DawnBufferMapAsyncStatus status,
+                                   const void* data,
+                                   uint64_t dataLength,
+                                   void* userdata) {
+    ASSERT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, status);
+
+    Readback* readback = static_cast<Readback*>(userdata);
+    BufferReadbackPerf* test = readback->test;
+    ASSERT_EQ(test->mData.size(), dataLength);
+
+    test->mLatency += test->mTimer->GetAbsoluteTime() - readback->startTime;
+    test->mNumReadbacksPerformed++;
+
+    // Read the data like an application would, which is slow if it isn't in cached memory.
+    memcpy(test->mData.data(), data, dataLength);
+    readback->done = true;
+}
+
+void BufferReadbackPerf::WaitForReadback(Readback* readback) {
+    ASSERT(readback->pending);
+    while (!readback->done) {
+        device.Tick();
+        FlushWire();
+    }
+    readback->buffer.Unmap();
+    readback->pending = false;
+    readback->done = false;
+}
+
+void BufferReadbackPerf::Step() {
+    for (unsigned int i = 0; i < kNumReadbacks; ++i) {
+        Readback* readback = &mReadbacks[i % mReadbacks.size()];
+        if (readback->pending) {
+            WaitForReadback(readback);
+        }
+
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(mSource, 0, readback->buffer, 0, mData.size());
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        readback->pending = true;
+        readback->startTime = mTimer->GetAbsoluteTime();
+        readback->buffer.MapReadAsync(OnMapRead, readback);
+    }
+
+    for (Readback& readback : mReadbacks) {
+        if (readback.pending) {
+            WaitForReadback(&readback);
+        }
+    }
+}
+
+void BufferReadbackPerf::PrintLatencyResults() {
+    if (mNumReadbacksPerformed == 0) {
+        return;
+    }
+    PrintResult("readback_latency", mLatency * 1e6 / mNumReadbacksPerformed, "us", false);
+}
+
+TEST_P(BufferReadbackPerf, Run) {
+    RunTest();
+    PrintLatencyResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(BufferReadbackPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {ReadbackSize::BufferSize_1KB, ReadbackSize::BufferSize_64KB,
+                                    ReadbackSize::BufferSize_1MB, ReadbackSize::BufferSize_16MB},
+                                   {1, 4});
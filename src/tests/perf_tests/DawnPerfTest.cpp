@@ -14,7 +14,15 @@
 
 #include "tests/perf_tests/DawnPerfTest.h"
 
+#include "common/Assert.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+#include "tests/AllocationCounter.h"
 #include "utils/Timer.h"
+#include "utils/TracingPlatform.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
 
 namespace {
 
@@ -23,6 +31,16 @@ namespace {
     constexpr double kMicroSecondsPerSecond = 1e6;
     constexpr double kNanoSecondsPerSecond = 1e9;
 
+    // The trace events are only collected between the runs of a test, so the buffers of the
+    // threads have to hold all the events of a run.
+    constexpr size_t kTraceEventsPerThread = 1 << 18;
+
+    std::string FormatResult(double value) {
+        char formattedValue[64];
+        snprintf(formattedValue, sizeof(formattedValue), "%f", value);
+        return formattedValue;
+    }
+
 }  // namespace
 
 void InitDawnPerfTestEnvironment(int argc, char** argv) {
@@ -47,12 +65,72 @@ DawnPerfTestEnvironment::DawnPerfTestEnvironment(int argc, char** argv)
             continue;
         }
 
+        if (strstr(argv[i], "--null-gpu-cost=") == argv[i]) {
+            const char* value = strchr(argv[i], '=') + 1;
+            if (strcmp(value, "none") == 0) {
+                mUseNullGPUTimeline = false;
+            } else if (sscanf(value, "%" SCNu64 ",%" SCNu64 ",%" SCNu64,
+                              &mNullGPUCost.submitCost, &mNullGPUCost.commandCost,
+                              &mNullGPUCost.copyCostPerKilobyte) != 3) {
+                std::cerr << "Invalid value for --null-gpu-cost: " << value << std::endl;
+                UNREACHABLE();
+            }
+            continue;
+        }
+
+        if (strstr(argv[i], "--results-file=") == argv[i]) {
+            mResultsFile = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strstr(argv[i], "--baseline-file=") == argv[i]) {
+            mBaselineFile = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strstr(argv[i], "--regression-threshold=") == argv[i]) {
+            mRegressionThreshold = strtod(strchr(argv[i], '=') + 1, nullptr);
+            continue;
+        }
+
+        if (strstr(argv[i], "--trace-file=") == argv[i]) {
+            mTraceFile = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strstr(argv[i], "--trace-categories=") == argv[i]) {
+            mTraceCategories = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strcmp("--count-allocations", argv[i]) == 0) {
+            mIsCountingAllocations = true;
+            continue;
+        }
+
         if (strcmp("-h", argv[i]) == 0 || strcmp("--help", argv[i]) == 0) {
             std::cout << "Additional flags:"
-                      << " [--calibration] [--override-steps=x]\n"
+                      << " [--calibration] [--override-steps=x] [--null-gpu-cost=s,c,k|none]"
+                         " [--results-file=x] [--baseline-file=x] [--regression-threshold=x]"
+                         " [--count-allocations] [--trace-file=x] [--trace-categories=x]\n"
                       << "  --calibration: Only run calibration. Calibration allows the perf test"
                          " runner script to save some time.\n"
                       << " --override-steps: Set a fixed number of steps to run for each test\n"
+                      << " --null-gpu-cost: Set the cost in nanoseconds of a submit, of a command"
+                         " and of copying a kilobyte on the simulated GPU of the Null backend,"
+                         " or disable the simulated GPU with 'none'\n"
+                      << " --results-file: Write the results and their statistics as JSON to"
+                         " this file\n"
+                      << " --baseline-file: Compare the results to the ones in this JSON file"
+                         " and fail the tests that regressed significantly\n"
+                      << " --regression-threshold: The relative increase of the median time"
+                         " above which a significant change is a regression (defaults to 0.05)\n"
+                      << " --count-allocations: Count the heap allocations made by the steps of"
+                         " the tests and report them per iteration\n"
+                      << " --trace-file: Record the trace events of Dawn and write them to this"
+                         " file in the JSON format of chrome://tracing\n"
+                      << " --trace-categories: The comma-separated trace categories to record"
+                         " (defaults to all of them)\n"
                       << std::endl;
             continue;
         }
@@ -63,6 +141,34 @@ DawnPerfTestEnvironment::~DawnPerfTestEnvironment() = default;
 
 void DawnPerfTestEnvironment::SetUp() {
     DawnTestEnvironment::SetUp();
+
+    if (!mTraceFile.empty()) {
+        mTracingPlatform =
+            std::make_unique<utils::TracingPlatform>(mTraceCategories, kTraceEventsPerThread);
+        GetInstance()->SetPlatform(mTracingPlatform.get());
+    }
+
+    if (!mBaselineFile.empty()) {
+        ASSERT_TRUE(ReadPerfResultsJSON(mBaselineFile, &mBaselineResults))
+            << "Failed to read the baseline file " << mBaselineFile;
+    }
+}
+
+void DawnPerfTestEnvironment::TearDown() {
+    if (!mResultsFile.empty() && !WritePerfResultsJSON(mResultsFile, mResults)) {
+        ADD_FAILURE() << "Failed to write the results file " << mResultsFile;
+    }
+
+    if (mTracingPlatform != nullptr) {
+        if (!mTracingPlatform->WriteTraceFile(mTraceFile)) {
+            ADD_FAILURE() << "Failed to write the trace file " << mTraceFile;
+        }
+        if (mTracingPlatform->GetDroppedEventCount() > 0) {
+            std::cerr << mTracingPlatform->GetDroppedEventCount()
+                      << " trace events were dropped because a thread recorded too many"
+                      << std::endl;
+        }
+    }
 }
 
 bool DawnPerfTestEnvironment::IsCalibrating() const {
@@ -73,6 +179,33 @@ unsigned int DawnPerfTestEnvironment::OverrideStepsToRun() const {
     return mOverrideStepsToRun;
 }
 
+const dawn_native::null::SimulatedGPUTimelineDescriptor* DawnPerfTestEnvironment::GetNullGPUCost()
+    const {
+    return mUseNullGPUTimeline ? &mNullGPUCost : nullptr;
+}
+
+PerfTestResult* DawnPerfTestEnvironment::GetTestResult(const std::string& testName) {
+    return &mResults[testName];
+}
+
+const PerfTestResult* DawnPerfTestEnvironment::GetBaselineResult(
+    const std::string& testName) const {
+    auto it = mBaselineResults.find(testName);
+    return it != mBaselineResults.end() ? &it->second : nullptr;
+}
+
+double DawnPerfTestEnvironment::GetRegressionThreshold() const {
+    return mRegressionThreshold;
+}
+
+bool DawnPerfTestEnvironment::IsCountingAllocations() const {
+    return mIsCountingAllocations;
+}
+
+utils::TracingPlatform* DawnPerfTestEnvironment::GetTracingPlatform() const {
+    return mTracingPlatform.get();
+}
+
 DawnPerfTestBase::DawnPerfTestBase(DawnTestBase* test, unsigned int iterationsPerStep)
     : mTest(test), mIterationsPerStep(iterationsPerStep), mTimer(utils::CreateTimer()) {
 }
@@ -104,6 +237,15 @@ void DawnPerfTestBase::WaitForGPU() {
 }
 
 void DawnPerfTestBase::RunTest() {
+    // Without a simulated GPU, the Null backend completes work as soon as it is submitted, which
+    // hides the cost of waiting for the GPU and of keeping resources alive in the meantime.
+#if defined(DAWN_ENABLE_BACKEND_NULL)
+    if (mTest->IsNull() && gTestEnv->GetNullGPUCost() != nullptr) {
+        ASSERT_TRUE(dawn_native::null::EnableSimulatedGPUTimeline(mTest->backendDevice,
+                                                                  gTestEnv->GetNullGPUCost()));
+    }
+#endif  // defined(DAWN_ENABLE_BACKEND_NULL)
+
     if (gTestEnv->OverrideStepsToRun() == 0) {
         // Run to compute the approximate number of steps to perform.
         mStepsToRun = std::numeric_limits<unsigned int>::max();
@@ -128,23 +270,88 @@ void DawnPerfTestBase::RunTest() {
     // Do another warmup run. Seems to consistently improve results.
     DoRunLoop(kMaximumRunTimeSeconds);
 
+    PerfTestResult* result = gTestEnv->GetTestResult(GetCurrentTestName());
+    result->iterationsPerStep = mIterationsPerStep;
+    result->trials.clear();
+    mTrialSamples.clear();
+
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+    double totalIterations = 0.0;
+
     for (unsigned int trial = 0; trial < kNumTrials; ++trial) {
         DoRunLoop(kMaximumRunTimeSeconds);
+        if (mNumStepsPerformed == 0) {
+            return;
+        }
         PrintResults();
+
+        double iterations = static_cast<double>(mNumStepsPerformed) * mIterationsPerStep;
+        PerfTrial perfTrial;
+        perfTrial.steps = mNumStepsPerformed;
+        perfTrial.wallTime = mTimer->GetElapsedTime() / iterations * kMicroSecondsPerSecond;
+        perfTrial.cpuTime = mCPUTime / iterations * kMicroSecondsPerSecond;
+        result->trials.push_back(perfTrial);
+
+        allocationCount += mAllocationCount;
+        allocatedBytes += mAllocatedBytes;
+        totalIterations += iterations;
+
+        for (double stepTime : mStepTimes) {
+            mTrialSamples.push_back(stepTime / mIterationsPerStep * kMicroSecondsPerSecond);
+        }
+    }
+
+    result->wallTime = ComputePerfStatistics(mTrialSamples);
+    PrintStatistics();
+    CompareToBaseline();
+
+    if (gTestEnv->IsCountingAllocations()) {
+        if (!ScopedAllocationCounter::IsSupported()) {
+            std::cerr << "Allocations aren't counted in this build" << std::endl;
+            return;
+        }
+        PrintResult("allocations", static_cast<double>(allocationCount) / totalIterations,
+                    "count", false);
+        PrintResult("allocated_bytes", static_cast<double>(allocatedBytes) / totalIterations,
+                    "bytes", false);
     }
 }
 
 void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
     mNumStepsPerformed = 0;
+    mStepTimes.clear();
+    mAllocationCount = 0;
+    mAllocatedBytes = 0;
     mRunning = true;
+    std::clock_t cpuStartTime = std::clock();
     mTimer->Start();
 
     // This loop can be canceled by calling AbortTest().
+    double previousElapsedTime = 0.0;
+    utils::TracingPlatform* tracingPlatform = gTestEnv->GetTracingPlatform();
     while (mRunning) {
-        Step();
+        {
+            TRACE_EVENT0(tracingPlatform, "dawn.perf_tests", "Step");
+            if (gTestEnv->IsCountingAllocations()) {
+                // Only the allocations of the step itself are counted, not the ones of the
+                // harness.
+                ScopedAllocationCounter counter;
+                Step();
+                mAllocationCount += counter.GetAllocationCount();
+                mAllocatedBytes += counter.GetAllocatedBytes();
+            } else {
+                Step();
+            }
+        }
         if (mRunning) {
             ++mNumStepsPerformed;
-            if (mTimer->GetElapsedTime() > maxRunTime) {
+
+            double elapsedTime = mTimer->GetElapsedTime();
+            mStepTimes.push_back(elapsedTime - previousElapsedTime);
+            previousElapsedTime = elapsedTime;
+
+            if (elapsedTime > maxRunTime) {
                 mRunning = false;
             } else if (mNumStepsPerformed >= mStepsToRun) {
                 mRunning = false;
@@ -153,6 +360,14 @@ void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
     }
 
     mTimer->Stop();
+    // This is the CPU time of all the threads of the process, including the driver's.
+    mCPUTime = static_cast<double>(std::clock() - cpuStartTime) / CLOCKS_PER_SEC;
+
+    // Empty the buffers of the threads between runs so that it isn't timed. The events that
+    // don't fit in the buffer of a thread during a run are dropped and reported.
+    if (tracingPlatform != nullptr) {
+        tracingPlatform->CollectTraceEvents();
+    }
 }
 
 void DawnPerfTestBase::PrintResults() {
@@ -176,36 +391,78 @@ void DawnPerfTestBase::PrintResults() {
         // Give the result a different name to ensure separate graphs if we transition.
         if (secondsPerIteration > 1e-3) {
             double microSecondsPerIteration = secondsPerIteration * kMicroSecondsPerSecond;
-            PrintResult(clockNames[i], microSecondsPerIteration, "us", true);
+            PrintResultLine(clockNames[i], FormatResult(microSecondsPerIteration), "us", true);
         } else {
             double nanoSecPerIteration = secondsPerIteration * kNanoSecondsPerSecond;
-            PrintResult(clockNames[i], nanoSecPerIteration, "ns", true);
+            PrintResultLine(clockNames[i], FormatResult(nanoSecPerIteration), "ns", true);
         }
     }
 }
 
+void DawnPerfTestBase::PrintStatistics() {
+    const PerfTestResult* result = gTestEnv->GetTestResult(GetCurrentTestName());
+    const PerfStatistics& wallTime = result->wallTime;
+
+    double cpuTime = 0.0;
+    for (const PerfTrial& trial : result->trials) {
+        cpuTime += trial.cpuTime / static_cast<double>(result->trials.size());
+    }
+
+    PrintResultLine("wall_time_median", FormatResult(wallTime.median), "us", false);
+    PrintResultLine("wall_time_p90", FormatResult(wallTime.p90), "us", false);
+    PrintResultLine("wall_time_p99", FormatResult(wallTime.p99), "us", false);
+    PrintResultLine("wall_time_stddev", FormatResult(wallTime.stddev), "us", false);
+    PrintResultLine("wall_time_outliers", std::to_string(wallTime.outlierCount), "count", false);
+    PrintResultLine("cpu_time", FormatResult(cpuTime), "us", false);
+}
+
+void DawnPerfTestBase::CompareToBaseline() {
+    std::string testName = GetCurrentTestName();
+    const PerfTestResult* baseline = gTestEnv->GetBaselineResult(testName);
+    if (baseline == nullptr) {
+        return;
+    }
+
+    const PerfTestResult* result = gTestEnv->GetTestResult(testName);
+    PerfComparison comparison = ComparePerfStatistics(
+        baseline->wallTime, result->wallTime, gTestEnv->GetRegressionThreshold());
+
+    PrintResultLine("wall_time_change", FormatResult(comparison.relativeChange * 100.0), "%",
+                    false);
+
+    EXPECT_FALSE(comparison.isRegression)
+        << "The median wall time regressed by " << comparison.relativeChange * 100.0
+        << "% from " << baseline->wallTime.median << "us to " << result->wallTime.median
+        << "us (t = " << comparison.tStatistic << ")";
+}
+
+// static
+std::string DawnPerfTestBase::GetCurrentTestName() {
+    const ::testing::TestInfo* const testInfo =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+    return std::string(testInfo->test_suite_name()) + "." + testInfo->name();
+}
+
 void DawnPerfTestBase::PrintResult(const std::string& trace,
                                    double value,
                                    const std::string& units,
                                    bool important) const {
-    const ::testing::TestInfo* const testInfo =
-        ::testing::UnitTest::GetInstance()->current_test_info();
-
-    const char* testName = testInfo->name();
-    const char* testSuite = testInfo->test_suite_name();
-
-    // The results are printed according to the format specified at
-    // [chromium]//build/scripts/slave/performance_log_processor.py
-    fflush(stdout);
-    printf("%sRESULT %s%s: %s= %s%f%s %s\n", important ? "*" : "", testSuite, testName,
-           trace.c_str(), "", value, "", units.c_str());
-    fflush(stdout);
+    gTestEnv->GetTestResult(GetCurrentTestName())->metrics[trace] = value;
+    PrintResultLine(trace, FormatResult(value), units, important);
 }
 
 void DawnPerfTestBase::PrintResult(const std::string& trace,
                                    unsigned int value,
                                    const std::string& units,
                                    bool important) const {
+    gTestEnv->GetTestResult(GetCurrentTestName())->metrics[trace] = value;
+    PrintResultLine(trace, std::to_string(value), units, important);
+}
+
+void DawnPerfTestBase::PrintResultLine(const std::string& trace,
+                                       const std::string& value,
+                                       const std::string& units,
+                                       bool important) const {
     const ::testing::TestInfo* const testInfo =
         ::testing::UnitTest::GetInstance()->current_test_info();
 
@@ -215,7 +472,7 @@ void DawnPerfTestBase::PrintResult(const std::string& trace,
     // The results are printed according to the format specified at
     // [chromium]//build/scripts/slave/performance_log_processor.py
     fflush(stdout);
-    printf("%sRESULT %s%s: %s= %s%u%s %s\n", important ? "*" : "", testName, testSuite,
-           trace.c_str(), "", value, "", units.c_str());
+    printf("%sRESULT %s%s: %s= %s%s%s %s\n", important ? "*" : "", testSuite, testName,
+           trace.c_str(), "", value.c_str(), "", units.c_str());
     fflush(stdout);
 }
@@ -15,11 +15,14 @@
 #ifndef TESTS_PERFTESTS_DAWNPERFTEST_H_
 #define TESTS_PERFTESTS_DAWNPERFTEST_H_
 
+#include "dawn_native/NullBackend.h"
 #include "tests/DawnTest.h"
+#include "tests/perf_tests/PerfResults.h"
 
 namespace utils {
     class Timer;
-}
+    class TracingPlatform;
+}  // namespace utils
 
 void InitDawnPerfTestEnvironment(int argc, char** argv);
 
@@ -29,16 +32,53 @@ class DawnPerfTestEnvironment : public DawnTestEnvironment {
     ~DawnPerfTestEnvironment();
 
     void SetUp() override;
+    void TearDown() override;
 
     bool IsCalibrating() const;
     unsigned int OverrideStepsToRun() const;
 
+    // Returns the cost model of the simulated GPU used for the Null backend, or nullptr if the
+    // Null backend should complete work immediately.
+    const dawn_native::null::SimulatedGPUTimelineDescriptor* GetNullGPUCost() const;
+
+    // The results of the test named |testName|, written to the results file at the end.
+    PerfTestResult* GetTestResult(const std::string& testName);
+    // Returns the results of |testName| in the baseline file, or nullptr if there are none.
+    const PerfTestResult* GetBaselineResult(const std::string& testName) const;
+    double GetRegressionThreshold() const;
+
+    bool IsCountingAllocations() const;
+
+    // Returns the platform recording the trace events, or nullptr if they aren't recorded.
+    utils::TracingPlatform* GetTracingPlatform() const;
+
   private:
     // Only run calibration which allows the perf test runner to save time.
     bool mIsCalibrating = false;
 
     // If non-zero, overrides the number of steps.
     unsigned int mOverrideStepsToRun = 0;
+
+    bool mUseNullGPUTimeline = true;
+    dawn_native::null::SimulatedGPUTimelineDescriptor mNullGPUCost;
+
+    std::string mResultsFile;
+    PerfResults mResults;
+
+    // If set, each test is compared to its results in the baseline file and fails if it
+    // regressed by more than the threshold.
+    std::string mBaselineFile;
+    PerfResults mBaselineResults;
+    double mRegressionThreshold = 0.05;
+
+    // Count the heap allocations made by the steps of the tests.
+    bool mIsCountingAllocations = false;
+
+    // If set, the trace events of the tests are written to this file in the JSON format of
+    // chrome://tracing.
+    std::string mTraceFile;
+    std::string mTraceCategories = "*";
+    std::unique_ptr<utils::TracingPlatform> mTracingPlatform;
 };
 
 class DawnPerfTestBase {
@@ -69,6 +109,14 @@ class DawnPerfTestBase {
   private:
     void DoRunLoop(double maxRunTime);
     void PrintResults();
+    void PrintStatistics();
+    void CompareToBaseline();
+
+    static std::string GetCurrentTestName();
+    void PrintResultLine(const std::string& trace,
+                         const std::string& value,
+                         const std::string& units,
+                         bool important) const;
 
     virtual void Step() = 0;
 
@@ -79,6 +127,18 @@ class DawnPerfTestBase {
     unsigned int mNumStepsPerformed = 0;
     uint64_t mGPUTimeNs = 0;  // TODO(enga): Measure GPU time with timing queries.
     std::unique_ptr<utils::Timer> mTimer;
+
+    // The wall time of each step of the last run loop, and the CPU time of the whole process
+    // during it, in seconds.
+    std::vector<double> mStepTimes;
+    double mCPUTime = 0.0;
+
+    // The heap allocations made by the steps of the last run loop, if they are counted.
+    uint64_t mAllocationCount = 0;
+    uint64_t mAllocatedBytes = 0;
+
+    // The time of each step of all the trials, in microseconds per iteration.
+    std::vector<double> mTrialSamples;
 };
 
 template <typename Params = DawnTestParam>
@@ -0,0 +1,332 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Constants.h"
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+namespace {
+
+    constexpr uint32_t kTextureSize = 64;
+    constexpr uint64_t kUniformSize = 4 * sizeof(float);
+    constexpr uint64_t kVertexStride = 9 * sizeof(float);
+
+    // The state that is changed between consecutive draws.
+    enum class StateChange {
+        None,
+        Pipeline,
+        BindGroup,
+        DynamicOffset,
+        VertexBuffer,
+    };
+
+    enum class EncodeMethod {
+        Direct,
+        RenderBundle,
+    };
+
+    struct DrawCallParams : DawnTestParam {
+        DrawCallParams(const DawnTestParam& param,
+                       uint32_t numDraws,
+                       StateChange stateChange,
+                       EncodeMethod encodeMethod)
+            : DawnTestParam(param),
+              numDraws(numDraws),
+              stateChange(stateChange),
+              encodeMethod(encodeMethod) {
+        }
+
+        uint32_t numDraws;
+        StateChange stateChange;
+        EncodeMethod encodeMethod;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const DrawCallParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param) << "_" << param.numDraws << "_Draws";
+
+        switch (param.stateChange) {
+            case StateChange::None:
+                ostream << "_NoChange";
+                break;
+            case StateChange::Pipeline:
+                ostream << "_PipelineChange";
+                break;
+            case StateChange::BindGroup:
+                ostream << "_BindGroupChange";
+                break;
+            case StateChange::DynamicOffset:
+                ostream << "_DynamicOffsetChange";
+                break;
+            case StateChange::VertexBuffer:
+                ostream << "_VertexBufferChange";
+                break;
+        }
+
+        switch (param.encodeMethod) {
+            case EncodeMethod::Direct:
+                ostream << "_Direct";
+                break;
+            case EncodeMethod::RenderBundle:
+                ostream << "_RenderBundle";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the CPU cost of draws. Each step encodes a render pass with |numDraws| draws, finishes
+// the command encoder, and submits the command buffer, changing the state between the draws
+// as requested. With render bundles, the draws are recorded once in a bundle that each step
+// executes. Along with the total time per draw, the time spent in each of the phases is
+// reported per draw. When the OpenGL backend filters the redundant state calls, the number of
+// state calls issued and filtered per draw is reported too.
+class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParams> {
+  public:
+    DrawCallPerf()
+        : DawnPerfTestWithParams(GetParam().numDraws), mPhaseTimer(utils::CreateTimer()) {
+    }
+    ~DrawCallPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintPhaseResults();
+
+  private:
+    void Step() override;
+
+    template <typename Encoder>
+    void RecordDraws(Encoder encoder);
+
+    utils::BasicRenderPass mRenderPass;
+    dawn::RenderPipeline mPipelines[2];
+    dawn::BindGroup mBindGroups[2];
+    dawn::Buffer mVertexBuffers[2];
+    dawn::RenderBundle mRenderBundle;
+
+    std::unique_ptr<utils::Timer> mPhaseTimer;
+    unsigned int mNumStepsPerformed = 0;
+    double mEncodeTime = 0.0;
+    double mFinishTime = 0.0;
+    double mSubmitTime = 0.0;
+    dawn_native::DeviceStatistics mStatisticsBefore;
+};
+
+void DrawCallPerf::TestSetUp() {
+    DawnPerfTestWithParams<DrawCallParams>::TestSetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+
+    dawn::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout(location = 0) in vec4 pos;
+            layout(location = 1) in vec3 normal;
+            layout(location = 2) in vec2 texCoord;
+            layout(location = 0) out vec4 shading;
+            void main() {
+                shading = vec4(normal, texCoord.x);
+                gl_Position = pos;
+            })");
+
+    // Two fragment shaders so that the pipelines are distinct objects, otherwise the device
+    // would deduplicate them.
+    dawn::ShaderModule fsModules[2] = {
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            layout(set = 0, binding = 0) uniform Uniforms {
+                vec4 color;
+            };
+            void main() {
+                fragColor = color;
+            })"),
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            layout(set = 0, binding = 0) uniform Uniforms {
+                vec4 color;
+            };
+            void main() {
+                fragColor = color.bgra;
+            })"),
+    };
+
+    bool hasDynamicOffset = GetParam().stateChange == StateChange::DynamicOffset;
+    dawn::BindGroupLayoutBinding binding = {0, dawn::ShaderStage::Fragment,
+                                            dawn::BindingType::UniformBuffer, hasDynamicOffset};
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(device, {binding});
+
+    // Large enough for two dynamic offsets.
+    std::vector<float> uniformData(2 * kMinDynamicBufferOffsetAlignment / sizeof(float), 1.0f);
+    for (dawn::BindGroup& bindGroup : mBindGroups) {
+        dawn::Buffer uniformBuffer = utils::CreateBufferFromData(
+            device, uniformData.data(), uniformData.size() * sizeof(float),
+            dawn::BufferUsage::Uniform);
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, uniformBuffer, 0, kUniformSize}});
+    }
+
+    dawn::PipelineLayout pipelineLayout = utils::MakeBasicPipelineLayout(device, &bgl);
+    for (uint32_t i = 0; i < 2; ++i) {
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.layout = pipelineLayout;
+        descriptor.vertexStage.module = vsModule;
+        descriptor.cFragmentStage.module = fsModules[i];
+        descriptor.cVertexInput.bufferCount = 1;
+        descriptor.cVertexInput.cBuffers[0].stride = kVertexStride;
+        descriptor.cVertexInput.cBuffers[0].attributeCount = 3;
+        descriptor.cVertexInput.cAttributes[0].format = dawn::VertexFormat::Float4;
+        descriptor.cVertexInput.cAttributes[1].shaderLocation = 1;
+        descriptor.cVertexInput.cAttributes[1].offset = 4 * sizeof(float);
+        descriptor.cVertexInput.cAttributes[1].format = dawn::VertexFormat::Float3;
+        descriptor.cVertexInput.cAttributes[2].shaderLocation = 2;
+        descriptor.cVertexInput.cAttributes[2].offset = 7 * sizeof(float);
+        descriptor.cVertexInput.cAttributes[2].format = dawn::VertexFormat::Float2;
+        descriptor.cColorStates[0].format = mRenderPass.colorFormat;
+
+        mPipelines[i] = device.CreateRenderPipeline(&descriptor);
+    }
+
+    // Each vertex has a position, a normal and texture coordinates like the vertices of a mesh,
+    // so that changing the vertex buffer is like switching between meshes.
+    for (dawn::Buffer& vertexBuffer : mVertexBuffers) {
+        vertexBuffer = utils::CreateBufferFromData<float>(
+            device, dawn::BufferUsage::Vertex,
+            {-1.0f, 1.0f,  0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,  //
+             1.0f,  -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,  //
+             -1.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f});
+    }
+
+    if (GetParam().encodeMethod == EncodeMethod::RenderBundle) {
+        utils::ComboRenderBundleEncoderDescriptor desc = {};
+        desc.colorFormatsCount = 1;
+        desc.cColorFormats[0] = mRenderPass.colorFormat;
+
+        dawn::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&desc);
+        RecordDraws(encoder);
+        mRenderBundle = encoder.Finish();
+    }
+
+    mStatisticsBefore = dawn_native::GetDeviceStatistics(backendDevice);
+}
+
+template <typename Encoder>
+void DrawCallPerf::RecordDraws(Encoder encoder) {
+    StateChange stateChange = GetParam().stateChange;
+    uint64_t dynamicOffsets[2] = {0, kMinDynamicBufferOffsetAlignment};
+
+    encoder.SetPipeline(mPipelines[0]);
+    encoder.SetVertexBuffer(0, mVertexBuffers[0]);
+    if (stateChange == StateChange::DynamicOffset) {
+        encoder.SetBindGroup(0, mBindGroups[0], 1, &dynamicOffsets[0]);
+    } else {
+        encoder.SetBindGroup(0, mBindGroups[0], 0, nullptr);
+    }
+
+    for (uint32_t i = 0; i < GetParam().numDraws; ++i) {
+        uint32_t index = i % 2;
+        switch (stateChange) {
+            case StateChange::None:
+                break;
+            case StateChange::Pipeline:
+                encoder.SetPipeline(mPipelines[index]);
+                break;
+            case StateChange::BindGroup:
+                encoder.SetBindGroup(0, mBindGroups[index], 0, nullptr);
+                break;
+            case StateChange::DynamicOffset:
+                encoder.SetBindGroup(0, mBindGroups[0], 1, &dynamicOffsets[index]);
+                break;
+            case StateChange::VertexBuffer:
+                encoder.SetVertexBuffer(0, mVertexBuffers[index]);
+                break;
+        }
+        encoder.Draw(3, 1, 0, 0);
+    }
+}
+
+void DrawCallPerf::Step() {
+    double startTime = mPhaseTimer->GetAbsoluteTime();
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+    switch (GetParam().encodeMethod) {
+        case EncodeMethod::Direct:
+            RecordDraws(pass);
+            break;
+        case EncodeMethod::RenderBundle:
+            pass.ExecuteBundles(1, &mRenderBundle);
+            break;
+    }
+    pass.EndPass();
+    double encodeEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    dawn::CommandBuffer commands = encoder.Finish();
+    double finishEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    queue.Submit(1, &commands);
+    double submitEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    mEncodeTime += encodeEndTime - startTime;
+    mFinishTime += finishEndTime - encodeEndTime;
+    mSubmitTime += submitEndTime - finishEndTime;
+    mNumStepsPerformed++;
+
+    // Wait for the GPU so that the work doesn't pile up. The wait time gets amortized over the
+    // draws of the step.
+    WaitForGPU();
+}
+
+void DrawCallPerf::PrintPhaseResults() {
+    if (mNumStepsPerformed == 0) {
+        return;
+    }
+
+    double usPerDraw = 1e6 / (static_cast<double>(mNumStepsPerformed) * GetParam().numDraws);
+    PrintResult("encode_time", mEncodeTime * usPerDraw, "us", false);
+    PrintResult("finish_time", mFinishTime * usPerDraw, "us", false);
+    PrintResult("submit_time", mSubmitTime * usPerDraw, "us", false);
+
+    dawn_native::DeviceStatistics statistics = dawn_native::GetDeviceStatistics(backendDevice);
+    uint64_t issued = statistics.glStateCallsIssued - mStatisticsBefore.glStateCallsIssued;
+    uint64_t filtered = statistics.glStateCallsFiltered - mStatisticsBefore.glStateCallsFiltered;
+    if (issued + filtered > 0) {
+        double perDraw = 1.0 / (static_cast<double>(mNumStepsPerformed) * GetParam().numDraws);
+        PrintResult("gl_state_calls_issued", issued * perDraw, "calls", false);
+        PrintResult("gl_state_calls_filtered", filtered * perDraw, "calls", false);
+    }
+}
+
+TEST_P(DrawCallPerf, Run) {
+    RunTest();
+    PrintPhaseResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(DrawCallPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    ForceWorkarounds(OpenGLBackend,
+                                                     {"filter_redundant_gl_state_calls"}),
+                                    VulkanBackend},
+                                   {10, 100, 1000},
+                                   {StateChange::None, StateChange::Pipeline,
+                                    StateChange::BindGroup, StateChange::DynamicOffset,
+                                    StateChange::VertexBuffer},
+                                   {EncodeMethod::Direct, EncodeMethod::RenderBundle});
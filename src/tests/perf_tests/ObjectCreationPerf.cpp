@@ -0,0 +1,466 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Constants.h"
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+#include <sstream>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 100;
+
+    // Unique bind group layouts are made of a single binding with a different binding number or
+    // visibility.
+    constexpr uint32_t kNumVisibilities = 7;
+    static_assert(kNumObjects <= kMaxBindingsPerGroup * kNumVisibilities,
+                  "Not enough unique bind group layouts");
+
+    enum class ObjectType {
+        ShaderModule,
+        BindGroupLayout,
+        PipelineLayout,
+        RenderPipeline,
+        Sampler,
+        BindGroup,
+        TextureView,
+    };
+
+    // Whether each object is created with a different descriptor, or with the descriptor of an
+    // object that is alive and can be reused by the device. Bind groups and texture views are
+    // never deduplicated so they are only tested with unique descriptors.
+    enum class DescriptorMode {
+        Unique,
+        Cached,
+    };
+
+    struct ObjectCreationParams : DawnTestParam {
+        ObjectCreationParams(const DawnTestParam& param,
+                             ObjectType objectType,
+                             DescriptorMode descriptorMode)
+            : DawnTestParam(param), objectType(objectType), descriptorMode(descriptorMode) {
+        }
+
+        ObjectType objectType;
+        DescriptorMode descriptorMode;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ObjectCreationParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.objectType) {
+            case ObjectType::ShaderModule:
+                ostream << "_ShaderModule";
+                break;
+            case ObjectType::BindGroupLayout:
+                ostream << "_BindGroupLayout";
+                break;
+            case ObjectType::PipelineLayout:
+                ostream << "_PipelineLayout";
+                break;
+            case ObjectType::RenderPipeline:
+                ostream << "_RenderPipeline";
+                break;
+            case ObjectType::Sampler:
+                ostream << "_Sampler";
+                break;
+            case ObjectType::BindGroup:
+                ostream << "_BindGroup";
+                break;
+            case ObjectType::TextureView:
+                ostream << "_TextureView";
+                break;
+        }
+
+        switch (param.descriptorMode) {
+            case DescriptorMode::Unique:
+                ostream << "_Unique";
+                break;
+            case DescriptorMode::Cached:
+                ostream << "_Cached";
+                break;
+        }
+
+        return ostream;
+    }
+
+    // Returns a fragment shader whose SPIR-V is different for each |index|.
+    std::string MakeFragmentShader(uint32_t index, uint32_t numStatements) {
+        std::ostringstream fs;
+        fs << "#version 450\n"
+              "layout(location = 0) out vec4 fragColor;\n"
+              "void main() {\n"
+              "    vec4 color = vec4("
+           << index << ".0);\n";
+        for (uint32_t i = 0; i < numStatements; ++i) {
+            fs << "    color = sin(color * " << i + 1 << ".0);\n";
+        }
+        fs << "    fragColor = color;\n"
+              "}\n";
+        return fs.str();
+    }
+
+    // Creates |kNumObjects| objects then releases them, and accumulates the time spent in each
+    // of the two phases.
+    template <typename Object, typename CreateFn>
+    void CreateAndReleaseObjects(utils::Timer* timer,
+                                 CreateFn createObject,
+                                 double* creationTime,
+                                 double* destructionTime) {
+        std::vector<Object> objects;
+        objects.reserve(kNumObjects);
+
+        double startTime = timer->GetAbsoluteTime();
+        for (unsigned int i = 0; i < kNumObjects; ++i) {
+            objects.push_back(createObject(i));
+        }
+        double creationEndTime = timer->GetAbsoluteTime();
+
+        objects.clear();
+        double destructionEndTime = timer->GetAbsoluteTime();
+
+        *creationTime += creationEndTime - startTime;
+        *destructionTime += destructionEndTime - creationEndTime;
+    }
+
+}  // namespace
+
+// Test the cost of creating and destroying objects. Each step creates |kNumObjects| objects of
+// one type and releases them. With unique descriptors, every creation misses the device's
+// cache and every release removes the object from it. With cached descriptors, every creation
+// hits the cache and returns an object kept alive by the test. Along with the total time per
+// object, the creation and destruction times are reported per object.
+class ObjectCreationPerf : public DawnPerfTestWithParams<ObjectCreationParams> {
+  public:
+    ObjectCreationPerf()
+        : DawnPerfTestWithParams(kNumObjects), mPhaseTimer(utils::CreateTimer()) {
+    }
+    ~ObjectCreationPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintPhaseResults();
+
+  private:
+    void Step() override;
+
+    // Returns the index of the descriptor to use for the |i|-th object of the step.
+    uint32_t DescriptorIndex(uint32_t i) const;
+
+    dawn::BindGroupLayout MakeUniqueBindGroupLayout(uint32_t index);
+    dawn::SamplerDescriptor MakeUniqueSamplerDescriptor(uint32_t index);
+
+    // The objects at index 0 are the ones returned by the cache with cached descriptors.
+    // Unique shader modules and bind group layouts are only kept when testing the objects
+    // created from them.
+    std::vector<std::vector<uint32_t>> mFragmentShaderCodes;
+    std::vector<dawn::ShaderModule> mFragmentShaderModules;
+    std::vector<dawn::BindGroupLayout> mBindGroupLayouts;
+    dawn::PipelineLayout mCachedPipelineLayout;
+    dawn::RenderPipeline mCachedRenderPipeline;
+    dawn::Sampler mCachedSampler;
+
+    dawn::PipelineLayout mEmptyPipelineLayout;
+    std::unique_ptr<utils::ComboRenderPipelineDescriptor> mRenderPipelineDescriptor;
+    dawn::BindGroupLayout mUniformBindGroupLayout;
+    dawn::Buffer mUniformBuffer;
+    dawn::Texture mTexture;
+
+    std::unique_ptr<utils::Timer> mPhaseTimer;
+    unsigned int mNumStepsPerformed = 0;
+    double mCreationTime = 0.0;
+    double mDestructionTime = 0.0;
+};
+
+void ObjectCreationPerf::TestSetUp() {
+    DawnPerfTestWithParams<ObjectCreationParams>::TestSetUp();
+
+    // Only the objects used to create the tested ones are all kept alive, otherwise the tested
+    // objects would be found in the cache even with unique descriptors.
+    ObjectType objectType = GetParam().objectType;
+    uint32_t numShaderModules = objectType == ObjectType::RenderPipeline ? kNumObjects : 1;
+    uint32_t numBindGroupLayouts = objectType == ObjectType::PipelineLayout ? kNumObjects : 1;
+
+    for (uint32_t i = 0; i < kNumObjects; ++i) {
+        mFragmentShaderCodes.push_back(utils::CompileGLSLToSpirv(
+            utils::SingleShaderStage::Fragment, MakeFragmentShader(i, 1).c_str()));
+    }
+    for (uint32_t i = 0; i < numShaderModules; ++i) {
+        dawn::ShaderModuleDescriptor descriptor;
+        descriptor.codeSize = static_cast<uint32_t>(mFragmentShaderCodes[i].size());
+        descriptor.code = mFragmentShaderCodes[i].data();
+        mFragmentShaderModules.push_back(device.CreateShaderModule(&descriptor));
+    }
+    for (uint32_t i = 0; i < numBindGroupLayouts; ++i) {
+        mBindGroupLayouts.push_back(MakeUniqueBindGroupLayout(i));
+    }
+
+    mCachedPipelineLayout = utils::MakeBasicPipelineLayout(device, &mBindGroupLayouts[0]);
+    mEmptyPipelineLayout = utils::MakeBasicPipelineLayout(device, nullptr);
+
+    mRenderPipelineDescriptor = std::make_unique<utils::ComboRenderPipelineDescriptor>(device);
+    mRenderPipelineDescriptor->layout = mEmptyPipelineLayout;
+    mRenderPipelineDescriptor->vertexStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            void main() {
+                gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+            })");
+    mRenderPipelineDescriptor->cFragmentStage.module = mFragmentShaderModules[0];
+    mCachedRenderPipeline = device.CreateRenderPipeline(mRenderPipelineDescriptor.get());
+
+    dawn::SamplerDescriptor samplerDescriptor = MakeUniqueSamplerDescriptor(0);
+    mCachedSampler = device.CreateSampler(&samplerDescriptor);
+
+    mUniformBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::UniformBuffer}});
+
+    dawn::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = 16;
+    bufferDescriptor.usage = dawn::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDescriptor);
+
+    dawn::TextureDescriptor textureDescriptor;
+    textureDescriptor.dimension = dawn::TextureDimension::e2D;
+    textureDescriptor.size = {16, 16, 1};
+    textureDescriptor.arrayLayerCount = 1;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDescriptor.mipLevelCount = 1;
+    textureDescriptor.usage = dawn::TextureUsage::Sampled;
+    mTexture = device.CreateTexture(&textureDescriptor);
+}
+
+uint32_t ObjectCreationPerf::DescriptorIndex(uint32_t i) const {
+    return GetParam().descriptorMode == DescriptorMode::Unique ? i : 0;
+}
+
+dawn::BindGroupLayout ObjectCreationPerf::MakeUniqueBindGroupLayout(uint32_t index) {
+    uint32_t binding = index % kMaxBindingsPerGroup;
+    auto visibility = static_cast<dawn::ShaderStage>(1 + index / kMaxBindingsPerGroup);
+    return utils::MakeBindGroupLayout(
+        device, {{binding, visibility, dawn::BindingType::UniformBuffer}});
+}
+
+dawn::SamplerDescriptor ObjectCreationPerf::MakeUniqueSamplerDescriptor(uint32_t index) {
+    dawn::SamplerDescriptor descriptor = utils::GetDefaultSamplerDescriptor();
+    descriptor.lodMinClamp = static_cast<float>(index);
+    return descriptor;
+}
+
+void ObjectCreationPerf::Step() {
+    switch (GetParam().objectType) {
+        case ObjectType::ShaderModule:
+            CreateAndReleaseObjects<dawn::ShaderModule>(
+                mPhaseTimer.get(),
+                [this](uint32_t i) {
+                    const std::vector<uint32_t>& code = mFragmentShaderCodes[DescriptorIndex(i)];
+                    dawn::ShaderModuleDescriptor descriptor;
+                    descriptor.codeSize = static_cast<uint32_t>(code.size());
+                    descriptor.code = code.data();
+                    return device.CreateShaderModule(&descriptor);
+                },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::BindGroupLayout:
+            CreateAndReleaseObjects<dawn::BindGroupLayout>(
+                mPhaseTimer.get(),
+                [this](uint32_t i) { return MakeUniqueBindGroupLayout(DescriptorIndex(i)); },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::PipelineLayout:
+            CreateAndReleaseObjects<dawn::PipelineLayout>(
+                mPhaseTimer.get(),
+                [this](uint32_t i) {
+                    return utils::MakeBasicPipelineLayout(device,
+                                                          &mBindGroupLayouts[DescriptorIndex(i)]);
+                },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::RenderPipeline:
+            CreateAndReleaseObjects<dawn::RenderPipeline>(
+                mPhaseTimer.get(),
+                [this](uint32_t i) {
+                    mRenderPipelineDescriptor->cFragmentStage.module =
+                        mFragmentShaderModules[DescriptorIndex(i)];
+                    return device.CreateRenderPipeline(mRenderPipelineDescriptor.get());
+                },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::Sampler:
+            CreateAndReleaseObjects<dawn::Sampler>(
+                mPhaseTimer.get(),
+                [this](uint32_t i) {
+                    dawn::SamplerDescriptor descriptor =
+                        MakeUniqueSamplerDescriptor(DescriptorIndex(i));
+                    return device.CreateSampler(&descriptor);
+                },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::BindGroup:
+            CreateAndReleaseObjects<dawn::BindGroup>(
+                mPhaseTimer.get(),
+                [this](uint32_t) {
+                    return utils::MakeBindGroup(device, mUniformBindGroupLayout,
+                                                {{0, mUniformBuffer, 0, 16}});
+                },
+                &mCreationTime, &mDestructionTime);
+            break;
+
+        case ObjectType::TextureView:
+            CreateAndReleaseObjects<dawn::TextureView>(
+                mPhaseTimer.get(), [this](uint32_t) { return mTexture.CreateView(); },
+                &mCreationTime, &mDestructionTime);
+            break;
+    }
+    mNumStepsPerformed++;
+
+    // Backends may defer the destruction of objects until the GPU is done with them.
+    WaitForGPU();
+}
+
+void ObjectCreationPerf::PrintPhaseResults() {
+    if (mNumStepsPerformed == 0) {
+        return;
+    }
+
+    double usPerObject = 1e6 / (static_cast<double>(mNumStepsPerformed) * kNumObjects);
+    PrintResult("creation_time", mCreationTime * usPerObject, "us", true);
+    PrintResult("destruction_time", mDestructionTime * usPerObject, "us", false);
+}
+
+TEST_P(ObjectCreationPerf, Run) {
+    DAWN_SKIP_TEST_IF(GetParam().descriptorMode == DescriptorMode::Cached &&
+                      (GetParam().objectType == ObjectType::BindGroup ||
+                       GetParam().objectType == ObjectType::TextureView));
+
+    RunTest();
+    PrintPhaseResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(ObjectCreationPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {ObjectType::ShaderModule, ObjectType::BindGroupLayout,
+                                    ObjectType::PipelineLayout, ObjectType::RenderPipeline,
+                                    ObjectType::Sampler, ObjectType::BindGroup,
+                                    ObjectType::TextureView},
+                                   {DescriptorMode::Unique, DescriptorMode::Cached});
+
+namespace {
+
+    constexpr unsigned int kNumShaderModules = 16;
+
+    // The number of statements in the generated fragment shaders.
+    enum class ShaderSize {
+        Small = 1,
+        Medium = 100,
+        Large = 1000,
+    };
+
+    struct ShaderModuleCreationParams : DawnTestParam {
+        ShaderModuleCreationParams(const DawnTestParam& param, ShaderSize shaderSize)
+            : DawnTestParam(param), shaderSize(shaderSize) {
+        }
+
+        ShaderSize shaderSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ShaderModuleCreationParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.shaderSize) {
+            case ShaderSize::Small:
+                ostream << "_Small";
+                break;
+            case ShaderSize::Medium:
+                ostream << "_Medium";
+                break;
+            case ShaderSize::Large:
+                ostream << "_Large";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the effect of the size of the SPIR-V on the creation of shader modules, which validates
+// the code and extracts the reflection information from it. Every shader module created is
+// unique so that it misses the device's cache. The size of the SPIR-V is also reported.
+class ShaderModuleCreationPerf : public DawnPerfTestWithParams<ShaderModuleCreationParams> {
+  public:
+    ShaderModuleCreationPerf() : DawnPerfTestWithParams(kNumShaderModules) {
+    }
+    ~ShaderModuleCreationPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintCodeSize();
+
+  private:
+    void Step() override;
+
+    std::vector<std::vector<uint32_t>> mCodes;
+};
+
+void ShaderModuleCreationPerf::TestSetUp() {
+    DawnPerfTestWithParams<ShaderModuleCreationParams>::TestSetUp();
+
+    uint32_t numStatements = static_cast<uint32_t>(GetParam().shaderSize);
+    for (uint32_t i = 0; i < kNumShaderModules; ++i) {
+        mCodes.push_back(utils::CompileGLSLToSpirv(
+            utils::SingleShaderStage::Fragment, MakeFragmentShader(i, numStatements).c_str()));
+    }
+}
+
+void ShaderModuleCreationPerf::Step() {
+    std::vector<dawn::ShaderModule> modules;
+    modules.reserve(kNumShaderModules);
+
+    for (const std::vector<uint32_t>& code : mCodes) {
+        dawn::ShaderModuleDescriptor descriptor;
+        descriptor.codeSize = static_cast<uint32_t>(code.size());
+        descriptor.code = code.data();
+        modules.push_back(device.CreateShaderModule(&descriptor));
+    }
+}
+
+void ShaderModuleCreationPerf::PrintCodeSize() {
+    PrintResult("code_size", static_cast<unsigned int>(mCodes[0].size() * sizeof(uint32_t)),
+                "bytes", false);
+}
+
+TEST_P(ShaderModuleCreationPerf, Run) {
+    RunTest();
+    PrintCodeSize();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(ShaderModuleCreationPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {ShaderSize::Small, ShaderSize::Medium, ShaderSize::Large});
@@ -0,0 +1,386 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/PerfResults.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+    // A difference of the means of more than 3 standard errors is very unlikely to be noise.
+    constexpr double kSignificantTStatistic = 3.0;
+
+    // Linear interpolation between the closest ranks of |sorted|.
+    double Percentile(const std::vector<double>& sorted, double fraction) {
+        double position = fraction * static_cast<double>(sorted.size() - 1);
+        size_t lower = static_cast<size_t>(position);
+        size_t upper = std::min(lower + 1, sorted.size() - 1);
+        double weight = position - static_cast<double>(lower);
+        return sorted[lower] * (1.0 - weight) + sorted[upper] * weight;
+    }
+
+    std::string EscapeJSONString(const std::string& string) {
+        std::ostringstream escaped;
+        for (char c : string) {
+            switch (c) {
+                case '"':
+                    escaped << "\\\"";
+                    break;
+                case '\\':
+                    escaped << "\\\\";
+                    break;
+                case '\n':
+                    escaped << "\\n";
+                    break;
+                default:
+                    escaped << c;
+                    break;
+            }
+        }
+        return escaped.str();
+    }
+
+    // JSON has no representation for NaN and the infinities, they are written as null and read
+    // back as NaN.
+    struct JSONNumber {
+        double value;
+    };
+
+    std::ostream& operator<<(std::ostream& out, JSONNumber number) {
+        if (!std::isfinite(number.value)) {
+            return out << "null";
+        }
+        return out << number.value;
+    }
+
+    void WriteStatistics(std::ostream& out, const PerfStatistics& statistics) {
+        out << "{\"samples\": " << statistics.sampleCount
+            << ", \"outliers\": " << statistics.outlierCount
+            << ", \"mean\": " << JSONNumber{statistics.mean}
+            << ", \"stddev\": " << JSONNumber{statistics.stddev}
+            << ", \"median\": " << JSONNumber{statistics.median}
+            << ", \"p90\": " << JSONNumber{statistics.p90}
+            << ", \"p99\": " << JSONNumber{statistics.p99}
+            << ", \"min\": " << JSONNumber{statistics.min}
+            << ", \"max\": " << JSONNumber{statistics.max} << "}";
+    }
+
+    // A minimal JSON parser that flattens the document into the paths of its leaves, for
+    // example "tests[2].wall_time_us.median". It is only meant to read back the files written
+    // by WritePerfResultsJSON.
+    class FlatJSONParser {
+      public:
+        FlatJSONParser(const std::string& text) : mText(text) {
+        }
+
+        bool Parse() {
+            if (!ParseValue("")) {
+                return false;
+            }
+            SkipWhitespace();
+            return mPosition == mText.size();
+        }
+
+        const std::map<std::string, double>& GetNumbers() const {
+            return mNumbers;
+        }
+        const std::map<std::string, std::string>& GetStrings() const {
+            return mStrings;
+        }
+
+      private:
+        void SkipWhitespace() {
+            while (mPosition < mText.size() && isspace(mText[mPosition])) {
+                mPosition++;
+            }
+        }
+
+        bool Consume(char c) {
+            SkipWhitespace();
+            if (mPosition < mText.size() && mText[mPosition] == c) {
+                mPosition++;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseString(std::string* string) {
+            if (!Consume('"')) {
+                return false;
+            }
+            while (mPosition < mText.size() && mText[mPosition] != '"') {
+                char c = mText[mPosition++];
+                if (c == '\\') {
+                    if (mPosition == mText.size()) {
+                        return false;
+                    }
+                    c = mText[mPosition++];
+                    if (c == 'n') {
+                        c = '\n';
+                    }
+                }
+                string->push_back(c);
+            }
+            return Consume('"');
+        }
+
+        bool ParseValue(const std::string& path) {
+            SkipWhitespace();
+            if (mPosition == mText.size()) {
+                return false;
+            }
+
+            char c = mText[mPosition];
+            if (c == '{') {
+                mPosition++;
+                if (Consume('}')) {
+                    return true;
+                }
+                do {
+                    std::string key;
+                    if (!ParseString(&key) || !Consume(':') ||
+                        !ParseValue(path.empty() ? key : path + "." + key)) {
+                        return false;
+                    }
+                } while (Consume(','));
+                return Consume('}');
+            }
+
+            if (c == '[') {
+                mPosition++;
+                if (Consume(']')) {
+                    return true;
+                }
+                size_t index = 0;
+                do {
+                    if (!ParseValue(path + "[" + std::to_string(index++) + "]")) {
+                        return false;
+                    }
+                } while (Consume(','));
+                return Consume(']');
+            }
+
+            if (c == '"') {
+                return ParseString(&mStrings[path]);
+            }
+
+            for (const char* literal : {"true", "false", "null"}) {
+                size_t length = strlen(literal);
+                if (mText.compare(mPosition, length, literal) == 0) {
+                    mPosition += length;
+                    if (strcmp(literal, "null") == 0) {
+                        mNumbers[path] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                    return true;
+                }
+            }
+
+            // strtod also parses non-JSON numbers like "nan" or "inf".
+            if (c != '-' && !isdigit(c)) {
+                return false;
+            }
+            const char* start = mText.c_str() + mPosition;
+            char* end = nullptr;
+            double number = strtod(start, &end);
+            if (end == start) {
+                return false;
+            }
+            mPosition += end - start;
+            mNumbers[path] = number;
+            return true;
+        }
+
+        const std::string& mText;
+        size_t mPosition = 0;
+        std::map<std::string, double> mNumbers;
+        std::map<std::string, std::string> mStrings;
+    };
+
+}  // anonymous namespace
+
+PerfStatistics ComputePerfStatistics(std::vector<double> samples) {
+    PerfStatistics statistics;
+    if (samples.empty()) {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    double q1 = Percentile(samples, 0.25);
+    double q3 = Percentile(samples, 0.75);
+    double lowerFence = q1 - 1.5 * (q3 - q1);
+    double upperFence = q3 + 1.5 * (q3 - q1);
+
+    std::vector<double> kept;
+    kept.reserve(samples.size());
+    for (double sample : samples) {
+        if (sample >= lowerFence && sample <= upperFence) {
+            kept.push_back(sample);
+        }
+    }
+
+    statistics.sampleCount = kept.size();
+    statistics.outlierCount = samples.size() - kept.size();
+
+    double sum = 0.0;
+    for (double sample : kept) {
+        sum += sample;
+    }
+    statistics.mean = sum / static_cast<double>(kept.size());
+
+    if (kept.size() > 1) {
+        double squaredDeviations = 0.0;
+        for (double sample : kept) {
+            squaredDeviations += (sample - statistics.mean) * (sample - statistics.mean);
+        }
+        statistics.stddev = std::sqrt(squaredDeviations / static_cast<double>(kept.size() - 1));
+    }
+
+    statistics.median = Percentile(kept, 0.5);
+    statistics.p90 = Percentile(kept, 0.9);
+    statistics.p99 = Percentile(kept, 0.99);
+    statistics.min = kept.front();
+    statistics.max = kept.back();
+    return statistics;
+}
+
+bool WritePerfResultsJSON(const std::string& path, const PerfResults& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    out << "{\n  \"version\": 1,\n  \"tests\": [";
+
+    bool firstTest = true;
+    for (const auto& it : results) {
+        const PerfTestResult& result = it.second;
+
+        out << (firstTest ? "\n" : ",\n");
+        firstTest = false;
+
+        out << "    {\n      \"name\": \"" << EscapeJSONString(it.first) << "\",\n";
+        out << "      \"iterations_per_step\": " << result.iterationsPerStep << ",\n";
+
+        out << "      \"trials\": [";
+        for (size_t i = 0; i < result.trials.size(); ++i) {
+            const PerfTrial& trial = result.trials[i];
+            out << (i == 0 ? "" : ", ") << "{\"steps\": " << trial.steps
+                << ", \"wall_time_us\": " << JSONNumber{trial.wallTime}
+                << ", \"cpu_time_us\": " << JSONNumber{trial.cpuTime} << "}";
+        }
+        out << "],\n";
+
+        out << "      \"wall_time_us\": ";
+        WriteStatistics(out, result.wallTime);
+        out << ",\n";
+
+        out << "      \"metrics\": {";
+        bool firstMetric = true;
+        for (const auto& metric : result.metrics) {
+            out << (firstMetric ? "" : ", ") << "\"" << EscapeJSONString(metric.first)
+                << "\": " << JSONNumber{metric.second};
+            firstMetric = false;
+        }
+        out << "}\n    }";
+    }
+
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool ReadPerfResultsJSON(const std::string& path, PerfResults* results) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+
+    std::string content = text.str();
+    FlatJSONParser parser(content);
+    if (!parser.Parse()) {
+        return false;
+    }
+    const std::map<std::string, double>& numbers = parser.GetNumbers();
+    const std::map<std::string, std::string>& strings = parser.GetStrings();
+
+    for (size_t i = 0;; ++i) {
+        std::string prefix = "tests[" + std::to_string(i) + "].";
+        auto name = strings.find(prefix + "name");
+        if (name == strings.end()) {
+            break;
+        }
+
+        PerfTestResult& result = (*results)[name->second];
+        auto GetNumber = [&](const std::string& key) {
+            auto number = numbers.find(prefix + key);
+            return number != numbers.end() ? number->second : 0.0;
+        };
+
+        result.iterationsPerStep = static_cast<unsigned int>(GetNumber("iterations_per_step"));
+        result.wallTime.sampleCount = static_cast<size_t>(GetNumber("wall_time_us.samples"));
+        result.wallTime.outlierCount = static_cast<size_t>(GetNumber("wall_time_us.outliers"));
+        result.wallTime.mean = GetNumber("wall_time_us.mean");
+        result.wallTime.stddev = GetNumber("wall_time_us.stddev");
+        result.wallTime.median = GetNumber("wall_time_us.median");
+        result.wallTime.p90 = GetNumber("wall_time_us.p90");
+        result.wallTime.p99 = GetNumber("wall_time_us.p99");
+        result.wallTime.min = GetNumber("wall_time_us.min");
+        result.wallTime.max = GetNumber("wall_time_us.max");
+
+        std::string metricsPrefix = prefix + "metrics.";
+        for (auto it = numbers.lower_bound(metricsPrefix);
+             it != numbers.end() && it->first.compare(0, metricsPrefix.size(), metricsPrefix) == 0;
+             ++it) {
+            result.metrics[it->first.substr(metricsPrefix.size())] = it->second;
+        }
+    }
+
+    return true;
+}
+
+PerfComparison ComparePerfStatistics(const PerfStatistics& baseline,
+                                     const PerfStatistics& current,
+                                     double threshold) {
+    PerfComparison comparison;
+    if (baseline.sampleCount == 0 || current.sampleCount == 0 || baseline.median <= 0.0) {
+        return comparison;
+    }
+
+    comparison.relativeChange = (current.median - baseline.median) / baseline.median;
+
+    double standardError =
+        std::sqrt(baseline.stddev * baseline.stddev / static_cast<double>(baseline.sampleCount) +
+                  current.stddev * current.stddev / static_cast<double>(current.sampleCount));
+    double meanDifference = current.mean - baseline.mean;
+    if (standardError > 0.0) {
+        comparison.tStatistic = meanDifference / standardError;
+    } else if (meanDifference != 0.0) {
+        comparison.tStatistic = std::copysign(std::numeric_limits<double>::infinity(),
+                                              meanDifference);
+    }
+
+    comparison.isRegression =
+        comparison.relativeChange > threshold && comparison.tStatistic > kSignificantTStatistic;
+    return comparison;
+}
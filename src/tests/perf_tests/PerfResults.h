@@ -0,0 +1,80 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESTS_PERFTESTS_PERFRESULTS_H_
+#define TESTS_PERFTESTS_PERFRESULTS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Statistics of the samples of a measurement, computed after the outliers are rejected.
+struct PerfStatistics {
+    size_t sampleCount = 0;
+    size_t outlierCount = 0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double median = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+// Rejects the samples outside of Tukey's fences, [Q1 - 1.5 * IQR, Q3 + 1.5 * IQR], then
+// computes the statistics of the remaining ones.
+PerfStatistics ComputePerfStatistics(std::vector<double> samples);
+
+struct PerfTrial {
+    unsigned int steps = 0;
+    // Per iteration, in microseconds.
+    double wallTime = 0.0;
+    double cpuTime = 0.0;
+};
+
+// All the results of a test, with the times in microseconds per iteration.
+struct PerfTestResult {
+    unsigned int iterationsPerStep = 0;
+    std::vector<PerfTrial> trials;
+    // Computed from the time of each step of all the trials.
+    PerfStatistics wallTime;
+    // Additional results reported by the test, by name.
+    std::map<std::string, double> metrics;
+};
+
+// The results of all the tests, by test name.
+using PerfResults = std::map<std::string, PerfTestResult>;
+
+bool WritePerfResultsJSON(const std::string& path, const PerfResults& results);
+
+// Reads the results written by WritePerfResultsJSON. Only the wall time statistics and the
+// metrics are read back.
+bool ReadPerfResultsJSON(const std::string& path, PerfResults* results);
+
+struct PerfComparison {
+    // The relative change of the median, positive when the current run is slower.
+    double relativeChange = 0.0;
+    // Welch's t statistic of the difference of the means, positive when the current run is
+    // slower.
+    double tStatistic = 0.0;
+    bool isRegression = false;
+};
+
+// A result is a regression when its median is more than |threshold| slower than the baseline's
+// and the difference of the means is statistically significant.
+PerfComparison ComparePerfStatistics(const PerfStatistics& baseline,
+                                     const PerfStatistics& current,
+                                     double threshold);
+
+#endif  // TESTS_PERFTESTS_PERFRESULTS_H_
@@ -0,0 +1,189 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+#include <sstream>
+
+namespace {
+
+    constexpr unsigned int kNumPipelines = 500;
+    constexpr uint32_t kTextureSize = 4;
+
+    enum class ShaderSharing {
+        // Each pipeline has its own fragment shader, so shaders are translated and compiled.
+        UniqueShaders,
+        // The pipelines share their shaders and only differ by their rasterization state.
+        SharedShaders,
+    };
+
+    struct PipelineCreationParams : DawnTestParam {
+        PipelineCreationParams(const DawnTestParam& param, ShaderSharing shaderSharing)
+            : DawnTestParam(param), shaderSharing(shaderSharing) {
+        }
+
+        ShaderSharing shaderSharing;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const PipelineCreationParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.shaderSharing) {
+            case ShaderSharing::UniqueShaders:
+                ostream << "_UniqueShaders";
+                break;
+            case ShaderSharing::SharedShaders:
+                ostream << "_SharedShaders";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the throughput of creating |kNumPipelines| render pipelines and using each of them for a
+// draw, like an application loading a scene. The first use is included because backends may
+// defer the compilation of the pipelines until then. The reported time is per pipeline, with the
+// shader module creation, pipeline creation and first use times also reported per pipeline.
+class PipelineCreationPerf : public DawnPerfTestWithParams<PipelineCreationParams> {
+  public:
+    PipelineCreationPerf()
+        : DawnPerfTestWithParams(kNumPipelines), mPhaseTimer(utils::CreateTimer()) {
+    }
+    ~PipelineCreationPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintPhaseResults();
+
+  private:
+    void Step() override;
+    dawn::ShaderModule CreateFragmentShaderModule();
+
+    utils::BasicRenderPass mRenderPass;
+    dawn::ShaderModule mVertexShaderModule;
+    dawn::ShaderModule mSharedFragmentShaderModule;
+
+    // Makes the shaders of every step unique, so that they don't hit driver shader caches.
+    uint32_t mNextShaderIndex = 0;
+
+    std::unique_ptr<utils::Timer> mPhaseTimer;
+    unsigned int mNumStepsPerformed = 0;
+    double mShaderModuleTime = 0.0;
+    double mPipelineTime = 0.0;
+    double mFirstUseTime = 0.0;
+};
+
+void PipelineCreationPerf::TestSetUp() {
+    DawnPerfTestWithParams<PipelineCreationParams>::TestSetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+
+    mVertexShaderModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+        #version 450
+        void main() {
+            const vec2 pos[3] = vec2[3](vec2(-1.0, 1.0), vec2(1.0, -1.0), vec2(-1.0, -1.0));
+            gl_Position = vec4(pos[gl_VertexIndex], 0.0, 1.0);
+        })");
+    mSharedFragmentShaderModule = CreateFragmentShaderModule();
+}
+
+dawn::ShaderModule PipelineCreationPerf::CreateFragmentShaderModule() {
+    std::ostringstream source;
+    source << R"(
+        #version 450
+        layout(location = 0) out vec4 fragColor;
+        void main() {
+            fragColor = vec4()"
+           << mNextShaderIndex++ << R"(.0, 0.0, 0.0, 1.0);
+        })";
+    return utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment,
+                                     source.str().c_str());
+}
+
+void PipelineCreationPerf::Step() {
+    double startTime = mPhaseTimer->GetAbsoluteTime();
+
+    std::vector<dawn::ShaderModule> fragmentShaderModules(kNumPipelines,
+                                                          mSharedFragmentShaderModule);
+    if (GetParam().shaderSharing == ShaderSharing::UniqueShaders) {
+        for (dawn::ShaderModule& module : fragmentShaderModules) {
+            module = CreateFragmentShaderModule();
+        }
+    }
+    double shaderModuleEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    std::vector<dawn::RenderPipeline> pipelines(kNumPipelines);
+    for (unsigned int i = 0; i < kNumPipelines; ++i) {
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.vertexStage.module = mVertexShaderModule;
+        descriptor.cFragmentStage.module = fragmentShaderModules[i];
+        descriptor.cColorStates[0].format = mRenderPass.colorFormat;
+        // Make the descriptors unique so that the device doesn't deduplicate the pipelines.
+        descriptor.cRasterizationState.depthBias = static_cast<int32_t>(i);
+        pipelines[i] = device.CreateRenderPipeline(&descriptor);
+    }
+    double pipelineEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+    for (const dawn::RenderPipeline& pipeline : pipelines) {
+        pass.SetPipeline(pipeline);
+        pass.Draw(3, 1, 0, 0);
+    }
+    pass.EndPass();
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+    WaitForGPU();
+    double firstUseEndTime = mPhaseTimer->GetAbsoluteTime();
+
+    mShaderModuleTime += shaderModuleEndTime - startTime;
+    mPipelineTime += pipelineEndTime - shaderModuleEndTime;
+    mFirstUseTime += firstUseEndTime - pipelineEndTime;
+    mNumStepsPerformed++;
+}
+
+void PipelineCreationPerf::PrintPhaseResults() {
+    if (mNumStepsPerformed == 0) {
+        return;
+    }
+
+    unsigned int numPipelines = mNumStepsPerformed * kNumPipelines;
+    double usPerPipeline = 1e6 / numPipelines;
+    PrintResult("shader_module_time", mShaderModuleTime * usPerPipeline, "us", false);
+    PrintResult("pipeline_time", mPipelineTime * usPerPipeline, "us", false);
+    PrintResult("first_use_time", mFirstUseTime * usPerPipeline, "us", false);
+
+    double totalTime = mShaderModuleTime + mPipelineTime + mFirstUseTime;
+    PrintResult("pipeline_throughput", numPipelines / totalTime, "pipelines/s", false);
+}
+
+TEST_P(PipelineCreationPerf, Run) {
+    RunTest();
+    PrintPhaseResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(PipelineCreationPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    ForceWorkarounds(OpenGLBackend,
+                                                     {"async_gl_shader_compilation"}),
+                                    VulkanBackend},
+                                   {ShaderSharing::UniqueShaders, ShaderSharing::SharedShaders});
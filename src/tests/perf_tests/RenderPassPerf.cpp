@@ -0,0 +1,175 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumPasses = 100;
+    constexpr unsigned int kNumRenderTargets = 4;
+    constexpr unsigned int kRenderTargetSize = 16;
+
+    enum class RenderTargets {
+        // The render targets are created once and reused by every step.
+        Reused,
+        // The render targets are created at the beginning of each step.
+        Recreated,
+    };
+
+    enum class Attachments {
+        Color,
+        ColorAndDepthStencil,
+    };
+
+    struct RenderPassParams : DawnTestParam {
+        RenderPassParams(const DawnTestParam& param,
+                         RenderTargets renderTargets,
+                         Attachments attachments)
+            : DawnTestParam(param), renderTargets(renderTargets), attachments(attachments) {
+        }
+
+        RenderTargets renderTargets;
+        Attachments attachments;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const RenderPassParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.renderTargets) {
+            case RenderTargets::Reused:
+                ostream << "_Reused";
+                break;
+            case RenderTargets::Recreated:
+                ostream << "_Recreated";
+                break;
+        }
+
+        switch (param.attachments) {
+            case Attachments::Color:
+                ostream << "_Color";
+                break;
+            case Attachments::ColorAndDepthStencil:
+                ostream << "_ColorAndDepthStencil";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the CPU cost of setting up render passes. Each step encodes |kNumPasses| small render
+// passes that only clear one of |kNumRenderTargets| render targets, and optionally a depth-stencil
+// attachment, and submits them. Reused render targets show the cost of render passes to targets
+// already used, and recreated render targets the cost of render passes to new targets.
+class RenderPassPerf : public DawnPerfTestWithParams<RenderPassParams> {
+  public:
+    RenderPassPerf() : DawnPerfTestWithParams(kNumPasses) {
+    }
+    ~RenderPassPerf() override = default;
+
+    void TestSetUp() override;
+
+    void PrintBarrierResults();
+
+  private:
+    void Step() override;
+
+    void CreateRenderTargets();
+
+    unsigned int mNumStepsPerformed = 0;
+    dawn_native::DeviceStatistics mStatisticsBefore;
+
+    std::array<dawn::TextureView, kNumRenderTargets> mRenderTargets;
+    std::array<dawn::TextureView, kNumRenderTargets> mDepthStencilTargets;
+};
+
+void RenderPassPerf::TestSetUp() {
+    DawnPerfTestWithParams<RenderPassParams>::TestSetUp();
+    CreateRenderTargets();
+
+    mStatisticsBefore = dawn_native::GetDeviceStatistics(backendDevice);
+}
+
+void RenderPassPerf::CreateRenderTargets() {
+    dawn::TextureDescriptor descriptor;
+    descriptor.dimension = dawn::TextureDimension::e2D;
+    descriptor.size = {kRenderTargetSize, kRenderTargetSize, 1};
+    descriptor.arrayLayerCount = 1;
+    descriptor.sampleCount = 1;
+    descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    descriptor.mipLevelCount = 1;
+    descriptor.usage = dawn::TextureUsage::OutputAttachment;
+
+    for (dawn::TextureView& renderTarget : mRenderTargets) {
+        renderTarget = device.CreateTexture(&descriptor).CreateView();
+    }
+
+    if (GetParam().attachments == Attachments::ColorAndDepthStencil) {
+        descriptor.format = dawn::TextureFormat::Depth24PlusStencil8;
+        for (dawn::TextureView& depthStencilTarget : mDepthStencilTargets) {
+            depthStencilTarget = device.CreateTexture(&descriptor).CreateView();
+        }
+    }
+}
+
+void RenderPassPerf::Step() {
+    if (GetParam().renderTargets == RenderTargets::Recreated) {
+        CreateRenderTargets();
+    }
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (unsigned int i = 0; i < kNumPasses; ++i) {
+        utils::ComboRenderPassDescriptor renderPass({mRenderTargets[i % kNumRenderTargets]},
+                                                    mDepthStencilTargets[i % kNumRenderTargets]);
+        renderPass.cColorAttachments[0].loadOp = dawn::LoadOp::Clear;
+
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.EndPass();
+    }
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    mNumStepsPerformed++;
+}
+
+// The Vulkan backend records the barriers of each pass as a single vkCmdPipelineBarrier, so the
+// barriers issued and merged per pass show how many calls the batching saves.
+void RenderPassPerf::PrintBarrierResults() {
+    dawn_native::DeviceStatistics statistics = dawn_native::GetDeviceStatistics(backendDevice);
+    uint64_t issued = statistics.vulkanBarriersIssued - mStatisticsBefore.vulkanBarriersIssued;
+    uint64_t merged = statistics.vulkanBarriersMerged - mStatisticsBefore.vulkanBarriersMerged;
+    if (mNumStepsPerformed == 0 || issued + merged == 0) {
+        return;
+    }
+
+    double perPass = 1.0 / (static_cast<double>(mNumStepsPerformed) * kNumPasses);
+    PrintResult("vulkan_barriers_issued", issued * perPass, "calls", false);
+    PrintResult("vulkan_barriers_merged", merged * perPass, "barriers", false);
+}
+
+TEST_P(RenderPassPerf, Run) {
+    RunTest();
+    PrintBarrierResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(RenderPassPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {RenderTargets::Reused, RenderTargets::Recreated},
+                                   {Attachments::Color, Attachments::ColorAndDepthStencil});
@@ -0,0 +1,181 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+namespace {
+
+    constexpr uint32_t kNumDrawsPerCommandBuffer = 1000;
+    constexpr uint32_t kTextureSize = 64;
+
+    struct SubmitParams : DawnTestParam {
+        SubmitParams(const DawnTestParam& param, uint32_t numCommandBuffers)
+            : DawnTestParam(param), numCommandBuffers(numCommandBuffers) {
+        }
+
+        uint32_t numCommandBuffers;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const SubmitParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param) << "_" << param.numCommandBuffers
+                << "_CommandBuffers";
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the CPU cost of submitting many draws split in several command buffers. Each step encodes
+// |numCommandBuffers| command buffers, each with a render pass of |kNumDrawsPerCommandBuffer|
+// draws that change pipelines and bind groups, and submits them all at once. The reported time
+// is per draw, with the latency of the submit also reported per step, which shows how the
+// backends that record the command buffers in parallel scale with their number.
+class SubmitPerf : public DawnPerfTestWithParams<SubmitParams> {
+  public:
+    SubmitPerf()
+        : DawnPerfTestWithParams(kNumDrawsPerCommandBuffer * GetParam().numCommandBuffers),
+          mSubmitTimer(utils::CreateTimer()) {
+    }
+    ~SubmitPerf() override = default;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintSubmitResults();
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass mRenderPass;
+    dawn::RenderPipeline mPipelines[2];
+    dawn::BindGroup mBindGroups[2];
+    dawn::Buffer mVertexBuffer;
+
+    std::unique_ptr<utils::Timer> mSubmitTimer;
+    unsigned int mNumStepsPerformed = 0;
+    double mSubmitTime = 0.0;
+};
+
+void SubmitPerf::TestSetUp() {
+    DawnPerfTestWithParams<SubmitParams>::TestSetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kTextureSize, kTextureSize);
+
+    dawn::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout(location = 0) in vec4 pos;
+            void main() {
+                gl_Position = pos;
+            })");
+
+    // Two fragment shaders so that the pipelines are distinct objects, otherwise the device
+    // would deduplicate them.
+    dawn::ShaderModule fsModules[2] = {
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            layout(set = 0, binding = 0) uniform Uniforms {
+                vec4 color;
+            };
+            void main() {
+                fragColor = color;
+            })"),
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            layout(set = 0, binding = 0) uniform Uniforms {
+                vec4 color;
+            };
+            void main() {
+                fragColor = color.bgra;
+            })"),
+    };
+
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::UniformBuffer}});
+
+    for (dawn::BindGroup& bindGroup : mBindGroups) {
+        dawn::Buffer uniformBuffer = utils::CreateBufferFromData<float>(
+            device, dawn::BufferUsage::Uniform, {1.0f, 0.0f, 0.0f, 1.0f});
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, uniformBuffer, 0, 4 * sizeof(float)}});
+    }
+
+    dawn::PipelineLayout pipelineLayout = utils::MakeBasicPipelineLayout(device, &bgl);
+    for (uint32_t i = 0; i < 2; ++i) {
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.layout = pipelineLayout;
+        descriptor.vertexStage.module = vsModule;
+        descriptor.cFragmentStage.module = fsModules[i];
+        descriptor.cVertexInput.bufferCount = 1;
+        descriptor.cVertexInput.cBuffers[0].stride = 4 * sizeof(float);
+        descriptor.cVertexInput.cBuffers[0].attributeCount = 1;
+        descriptor.cVertexInput.cAttributes[0].format = dawn::VertexFormat::Float4;
+        descriptor.cColorStates[0].format = mRenderPass.colorFormat;
+
+        mPipelines[i] = device.CreateRenderPipeline(&descriptor);
+    }
+
+    mVertexBuffer = utils::CreateBufferFromData<float>(
+        device, dawn::BufferUsage::Vertex,
+        {-1.0f, 1.0f, 0.0f, 1.0f, 1.0f, -1.0f, 0.0f, 1.0f, -1.0f, -1.0f, 0.0f, 1.0f});
+}
+
+void SubmitPerf::Step() {
+    std::vector<dawn::CommandBuffer> commandBuffers(GetParam().numCommandBuffers);
+    for (dawn::CommandBuffer& commandBuffer : commandBuffers) {
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+        pass.SetVertexBuffer(0, mVertexBuffer);
+        for (uint32_t i = 0; i < kNumDrawsPerCommandBuffer; ++i) {
+            pass.SetPipeline(mPipelines[i % 2]);
+            pass.SetBindGroup(0, mBindGroups[i % 2], 0, nullptr);
+            pass.Draw(3, 1, 0, 0);
+        }
+        pass.EndPass();
+        commandBuffer = encoder.Finish();
+    }
+
+    double startTime = mSubmitTimer->GetAbsoluteTime();
+    queue.Submit(static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+    mSubmitTime += mSubmitTimer->GetAbsoluteTime() - startTime;
+    mNumStepsPerformed++;
+
+    // Wait for the GPU so that the work doesn't pile up.
+    WaitForGPU();
+}
+
+void SubmitPerf::PrintSubmitResults() {
+    if (mNumStepsPerformed == 0) {
+        return;
+    }
+
+    PrintResult("submit_latency", mSubmitTime * 1e6 / mNumStepsPerformed, "us", false);
+}
+
+TEST_P(SubmitPerf, Run) {
+    RunTest();
+    PrintSubmitResults();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(SubmitPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend,
+                                    ForceWorkarounds(VulkanBackend,
+                                                     {"record_vulkan_commands_in_parallel"})},
+                                   {1, 2, 4, 8});
@@ -0,0 +1,119 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+namespace {
+
+    constexpr unsigned int kNumInvalidCalls = 100;
+
+    enum class InvalidCall {
+        // Creating a buffer with a descriptor that fails validation.
+        CreateBuffer,
+        // Encoding a command that fails validation, which is reported when finishing the encoder.
+        EncoderCommand,
+    };
+
+    struct ValidationErrorParams : DawnTestParam {
+        ValidationErrorParams(const DawnTestParam& param, InvalidCall invalidCall)
+            : DawnTestParam(param), invalidCall(invalidCall) {
+        }
+
+        InvalidCall invalidCall;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ValidationErrorParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.invalidCall) {
+            case InvalidCall::CreateBuffer:
+                ostream << "_CreateBuffer";
+                break;
+            case InvalidCall::EncoderCommand:
+                ostream << "_EncoderCommand";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the cost of validation errors caught by error scopes, like when an application probes the
+// validation. Each invalid call is wrapped in its own validation error scope that is popped with
+// a callback ignoring the error. The message is still formatted when the scope calls the
+// callback, so this measures the whole cost of generating, capturing and reporting the error.
+class ValidationErrorPerf : public DawnPerfTestWithParams<ValidationErrorParams> {
+  public:
+    ValidationErrorPerf() : DawnPerfTestWithParams(kNumInvalidCalls) {
+    }
+    ~ValidationErrorPerf() override = default;
+
+    void TestSetUp() override;
+
+  private:
+    void Step() override;
+
+    void MakeInvalidCall();
+
+    dawn::Buffer mBuffer;
+};
+
+void ValidationErrorPerf::TestSetUp() {
+    DawnPerfTestWithParams<ValidationErrorParams>::TestSetUp();
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+    mBuffer = device.CreateBuffer(&descriptor);
+}
+
+void ValidationErrorPerf::MakeInvalidCall() {
+    switch (GetParam().invalidCall) {
+        case InvalidCall::CreateBuffer: {
+            // MapRead buffers can only be used as CopyDst.
+            dawn::BufferDescriptor descriptor;
+            descriptor.size = 16;
+            descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::Uniform;
+            device.CreateBuffer(&descriptor);
+        } break;
+
+        case InvalidCall::EncoderCommand: {
+            // The copy is out of bounds of the buffer.
+            dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            encoder.CopyBufferToBuffer(mBuffer, 0, mBuffer, 8, 16);
+            encoder.Finish();
+        } break;
+    }
+}
+
+void ValidationErrorPerf::Step() {
+    for (unsigned int i = 0; i < kNumInvalidCalls; ++i) {
+        device.PushErrorScope(dawn::ErrorFilter::Validation);
+        MakeInvalidCall();
+        device.PopErrorScope([](DawnErrorType, const char*, void*) {}, nullptr);
+    }
+}
+
+TEST_P(ValidationErrorPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(ValidationErrorPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {InvalidCall::CreateBuffer, InvalidCall::EncoderCommand});
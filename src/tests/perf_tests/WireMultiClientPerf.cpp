@@ -0,0 +1,212 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireMultiServer.h"
+#include "tests/ParamGenerator.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace {
+
+    // The number of copies each client records per frame. The first client is busier than the
+    // others so that the latency shows whether it can starve them.
+    constexpr unsigned int kCopiesPerFrame = 16;
+    constexpr unsigned int kBusyClientCopiesPerFrame = 8 * kCopiesPerFrame;
+
+    struct WireMultiClientParams : DawnTestParam {
+        WireMultiClientParams(const DawnTestParam& param, uint32_t numClients)
+            : DawnTestParam(param), numClients(numClients) {
+        }
+
+        uint32_t numClients;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireMultiClientParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param) << "_" << param.numClients
+                << "_Clients";
+        return ostream;
+    }
+
+    struct SimulatedClient {
+        std::unique_ptr<utils::TerribleCommandBuffer> c2sBuf;
+        std::unique_ptr<utils::TerribleCommandBuffer> s2cBuf;
+        std::unique_ptr<dawn_wire::WireClient> wireClient;
+        uint32_t clientId;
+
+        DawnDevice device = nullptr;
+        DawnQueue queue = nullptr;
+        DawnBuffer src = nullptr;
+        DawnBuffer dst = nullptr;
+    };
+
+}  // namespace
+
+// Test many clients sharing the backend device through a WireMultiServer. Each step, every
+// client records a frame of small copies, then the server handles the queued frames. The time
+// reported is per client frame, and the latency of each frame is measured from when it is
+// queued until it has been handled by the server.
+class WireMultiClientPerf : public DawnPerfTestWithParams<WireMultiClientParams> {
+  public:
+    WireMultiClientPerf() : DawnPerfTestWithParams(GetParam().numClients) {
+    }
+    ~WireMultiClientPerf() override;
+
+    void TestSetUp() override;
+
+  protected:
+    void PrintLatencies();
+
+  private:
+    void Step() override;
+    void RecordFrame(SimulatedClient* client, unsigned int copies);
+
+    std::unique_ptr<dawn_wire::WireMultiServer> mWireServer;
+    std::vector<SimulatedClient> mClients;
+    DawnProcTable clientProcs;
+
+    std::vector<std::chrono::steady_clock::time_point> mQueueTimes;
+    std::vector<double> mLatenciesUs;
+};
+
+WireMultiClientPerf::~WireMultiClientPerf() {
+    for (SimulatedClient& client : mClients) {
+        clientProcs.bufferRelease(client.src);
+        clientProcs.bufferRelease(client.dst);
+        clientProcs.queueRelease(client.queue);
+        client.wireClient->Flush();
+    }
+    while (mWireServer != nullptr && mWireServer->HandleQueuedCommands()) {
+    }
+
+    // The server must be destroyed before the clients since it uses their serializers.
+    mWireServer = nullptr;
+    mClients.clear();
+}
+
+void WireMultiClientPerf::TestSetUp() {
+    DawnPerfTestWithParams<WireMultiClientParams>::TestSetUp();
+
+    dawn_wire::WireMultiServerDescriptor serverDesc = {};
+    serverDesc.device = backendDevice;
+    serverDesc.procs = &backendProcs;
+    mWireServer.reset(new dawn_wire::WireMultiServer(serverDesc));
+
+    mClients.resize(GetParam().numClients);
+    mQueueTimes.resize(mClients.size());
+    for (SimulatedClient& client : mClients) {
+        client.s2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        client.clientId = mWireServer->AddClient(client.s2cBuf.get());
+        client.c2sBuf = std::make_unique<utils::TerribleCommandBuffer>(
+            mWireServer->GetCommandHandler(client.clientId));
+
+        dawn_wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = client.c2sBuf.get();
+        client.wireClient.reset(new dawn_wire::WireClient(clientDesc));
+        client.s2cBuf->SetHandler(client.wireClient.get());
+
+        clientProcs = client.wireClient->GetProcs();
+        client.device = client.wireClient->GetDevice();
+        client.queue = clientProcs.deviceCreateQueue(client.device);
+
+        DawnBufferDescriptor desc = {};
+        desc.size = 4;
+        desc.usage = DAWN_BUFFER_USAGE_COPY_SRC;
+        client.src = clientProcs.deviceCreateBuffer(client.device, &desc);
+        desc.usage = DAWN_BUFFER_USAGE_COPY_DST;
+        client.dst = clientProcs.deviceCreateBuffer(client.device, &desc);
+
+        ASSERT_TRUE(client.wireClient->Flush());
+    }
+
+    while (mWireServer->HandleQueuedCommands()) {
+    }
+}
+
+void WireMultiClientPerf::RecordFrame(SimulatedClient* client, unsigned int copies) {
+    DawnCommandEncoder encoder = clientProcs.deviceCreateCommandEncoder(client->device, nullptr);
+    for (unsigned int i = 0; i < copies; ++i) {
+        clientProcs.commandEncoderCopyBufferToBuffer(encoder, client->src, 0, client->dst, 0, 4);
+    }
+    DawnCommandBuffer commands = clientProcs.commandEncoderFinish(encoder, nullptr);
+    clientProcs.queueSubmit(client->queue, 1, &commands);
+
+    clientProcs.commandBufferRelease(commands);
+    clientProcs.commandEncoderRelease(encoder);
+}
+
+void WireMultiClientPerf::Step() {
+    for (size_t i = 0; i < mClients.size(); ++i) {
+        RecordFrame(&mClients[i], i == 0 ? kBusyClientCopiesPerFrame : kCopiesPerFrame);
+        if (!mClients[i].wireClient->Flush()) {
+            AbortTest();
+            return;
+        }
+        mQueueTimes[i] = std::chrono::steady_clock::now();
+    }
+
+    bool hasQueuedCommands = true;
+    while (hasQueuedCommands) {
+        hasQueuedCommands = mWireServer->HandleQueuedCommands();
+
+        auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < mClients.size(); ++i) {
+            if (mQueueTimes[i] == std::chrono::steady_clock::time_point() ||
+                mWireServer->HasQueuedCommands(mClients[i].clientId)) {
+                continue;
+            }
+            mLatenciesUs.push_back(
+                std::chrono::duration<double, std::micro>(now - mQueueTimes[i]).count());
+            mQueueTimes[i] = std::chrono::steady_clock::time_point();
+        }
+    }
+
+    for (const SimulatedClient& client : mClients) {
+        if (mWireServer->IsClientLost(client.clientId)) {
+            AbortTest();
+            return;
+        }
+    }
+
+    WaitForGPU();
+}
+
+void WireMultiClientPerf::PrintLatencies() {
+    if (mLatenciesUs.empty()) {
+        return;
+    }
+
+    std::sort(mLatenciesUs.begin(), mLatenciesUs.end());
+    auto Percentile = [&](size_t percent) {
+        return mLatenciesUs[(mLatenciesUs.size() - 1) * percent / 100];
+    };
+    PrintResult("frame_latency_p50", Percentile(50), "us", false);
+    PrintResult("frame_latency_p99", Percentile(99), "us", true);
+    PrintResult("frame_latency_max", mLatenciesUs.back(), "us", false);
+}
+
+TEST_P(WireMultiClientPerf, Run) {
+    RunTest();
+    PrintLatencies();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireMultiClientPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {1, 8, 64});
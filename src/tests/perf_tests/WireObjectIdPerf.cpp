@@ -0,0 +1,128 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "tests/ParamGenerator.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <array>
+
+namespace {
+
+    // Spread the commands over many objects so that ID lookups don't all hit the same cache line.
+    constexpr uint32_t kNumBuffers = 4096;
+    constexpr uint32_t kBufferStride = 97;
+
+    // Each copy references the encoder, the source and the destination buffers.
+    constexpr uint32_t kNumCopies = 128 * 1024;
+    constexpr uint32_t kIdsPerCopy = 3;
+
+    // The iteration count is the number of object IDs resolved by the wire server in each step.
+    constexpr unsigned int kNumIterations = kNumCopies * kIdsPerCopy;
+
+}  // namespace
+
+// Test resolving object IDs on the wire server. Each step encodes a lot of buffer copies between
+// many different buffers on the client, and the server resolves the IDs of every command as it
+// deserializes it. The wire is set up on top of the backend device independently of the
+// --use-wire flag.
+class WireObjectIdPerf : public DawnPerfTest {
+  public:
+    WireObjectIdPerf() : DawnPerfTest(kNumIterations) {
+    }
+    ~WireObjectIdPerf() override;
+
+    void TestSetUp() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+
+    DawnProcTable clientProcs;
+    DawnDevice clientDevice = nullptr;
+    std::array<DawnBuffer, kNumBuffers> buffers;
+};
+
+WireObjectIdPerf::~WireObjectIdPerf() {
+    if (mWireClient == nullptr) {
+        return;
+    }
+    for (DawnBuffer buffer : buffers) {
+        clientProcs.bufferRelease(buffer);
+    }
+    mWireClient->Flush();
+}
+
+void WireObjectIdPerf::TestSetUp() {
+    DawnPerfTest::TestSetUp();
+
+    mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+    mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.device = backendDevice;
+    serverDesc.procs = &backendProcs;
+    serverDesc.serializer = mS2cBuf.get();
+
+    mWireServer.reset(new dawn_wire::WireServer(serverDesc));
+    mC2sBuf->SetHandler(mWireServer.get());
+
+    dawn_wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = mC2sBuf.get();
+
+    mWireClient.reset(new dawn_wire::WireClient(clientDesc));
+    mS2cBuf->SetHandler(mWireClient.get());
+
+    clientProcs = mWireClient->GetProcs();
+    clientDevice = mWireClient->GetDevice();
+
+    DawnBufferDescriptor desc = {};
+    desc.size = 4;
+    desc.usage =
+        static_cast<DawnBufferUsage>(DAWN_BUFFER_USAGE_COPY_SRC | DAWN_BUFFER_USAGE_COPY_DST);
+    for (DawnBuffer& buffer : buffers) {
+        buffer = clientProcs.deviceCreateBuffer(clientDevice, &desc);
+    }
+
+    ASSERT_TRUE(mWireClient->Flush());
+}
+
+void WireObjectIdPerf::Step() {
+    DawnCommandEncoder encoder = clientProcs.deviceCreateCommandEncoder(clientDevice, nullptr);
+    for (uint32_t i = 0; i < kNumCopies; ++i) {
+        uint32_t index = (i * kBufferStride) % kNumBuffers;
+        clientProcs.commandEncoderCopyBufferToBuffer(encoder, buffers[index], 0,
+                                                     buffers[(index + 1) % kNumBuffers], 0, 4);
+    }
+    clientProcs.commandEncoderRelease(encoder);
+
+    if (!mWireClient->Flush()) {
+        AbortTest();
+    }
+}
+
+TEST_P(WireObjectIdPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireObjectIdPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend});
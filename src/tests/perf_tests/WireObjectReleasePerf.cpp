@@ -0,0 +1,99 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "tests/ParamGenerator.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <vector>
+
+namespace {
+
+    // The number of objects created and released in each step, as in the teardown of a big scene.
+    constexpr unsigned int kNumObjects = 50000;
+
+}  // namespace
+
+// Test creating and releasing many objects through the wire. Releases are coalesced in batched
+// DestroyObjects commands by the client. The wire is set up on top of the backend device
+// independently of the --use-wire flag.
+class WireObjectReleasePerf : public DawnPerfTest {
+  public:
+    WireObjectReleasePerf() : DawnPerfTest(kNumObjects), encoders(kNumObjects) {
+    }
+    ~WireObjectReleasePerf() override = default;
+
+    void TestSetUp() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+
+    DawnProcTable clientProcs;
+    DawnDevice clientDevice = nullptr;
+    std::vector<DawnCommandEncoder> encoders;
+};
+
+void WireObjectReleasePerf::TestSetUp() {
+    DawnPerfTest::TestSetUp();
+
+    mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+    mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.device = backendDevice;
+    serverDesc.procs = &backendProcs;
+    serverDesc.serializer = mS2cBuf.get();
+
+    mWireServer.reset(new dawn_wire::WireServer(serverDesc));
+    mC2sBuf->SetHandler(mWireServer.get());
+
+    dawn_wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = mC2sBuf.get();
+    clientDesc.coalesceReleases = true;
+
+    mWireClient.reset(new dawn_wire::WireClient(clientDesc));
+    mS2cBuf->SetHandler(mWireClient.get());
+
+    clientProcs = mWireClient->GetProcs();
+    clientDevice = mWireClient->GetDevice();
+}
+
+void WireObjectReleasePerf::Step() {
+    for (DawnCommandEncoder& encoder : encoders) {
+        encoder = clientProcs.deviceCreateCommandEncoder(clientDevice, nullptr);
+    }
+    for (DawnCommandEncoder encoder : encoders) {
+        clientProcs.commandEncoderRelease(encoder);
+    }
+
+    if (!mWireClient->Flush()) {
+        AbortTest();
+    }
+}
+
+TEST_P(WireObjectReleasePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireObjectReleasePerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend});
@@ -0,0 +1,183 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "tests/ParamGenerator.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <cstring>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1;
+
+    // Upload much more data than fits in the client->server ring so that every upload is split
+    // in chunks by the wire.
+    constexpr uint64_t kUploadSize = 256 * 1024 * 1024;
+    // The Null backend has a 256MB memory limit that the destination and staging buffers must
+    // fit in together.
+    constexpr uint64_t kNullUploadSize = 64 * 1024 * 1024;
+    constexpr size_t kRingSize = 1 * 1024 * 1024;
+
+    enum class UploadMethod {
+        SetSubData,
+        CreateBufferMapped,
+    };
+
+    struct WireUploadParams : DawnTestParam {
+        WireUploadParams(const DawnTestParam& param, UploadMethod uploadMethod)
+            : DawnTestParam(param), uploadMethod(uploadMethod) {
+        }
+
+        UploadMethod uploadMethod;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireUploadParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.uploadMethod) {
+            case UploadMethod::SetSubData:
+                ostream << "_SetSubData";
+                break;
+            case UploadMethod::CreateBufferMapped:
+                ostream << "_CreateBufferMapped";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test uploading |kUploadSize| bytes of data through a wire whose client->server buffer is only
+// |kRingSize| bytes. The wire is set up on top of the backend device independently of the
+// --use-wire flag so the ring size is controlled.
+class WireUploadPerf : public DawnPerfTestWithParams<WireUploadParams> {
+  public:
+    WireUploadPerf()
+        : DawnPerfTestWithParams(kNumIterations), data(IsNull() ? kNullUploadSize : kUploadSize) {
+    }
+    ~WireUploadPerf() override;
+
+    void TestSetUp() override;
+
+  private:
+    void Step() override;
+
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBuf;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBuf;
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::unique_ptr<dawn_wire::WireClient> mWireClient;
+
+    DawnProcTable clientProcs;
+    DawnDevice clientDevice = nullptr;
+    DawnQueue clientQueue = nullptr;
+    DawnBuffer dst = nullptr;
+    std::vector<uint8_t> data;
+};
+
+WireUploadPerf::~WireUploadPerf() {
+    if (mWireClient == nullptr) {
+        return;
+    }
+    clientProcs.bufferRelease(dst);
+    clientProcs.queueRelease(clientQueue);
+    mWireClient->Flush();
+}
+
+void WireUploadPerf::TestSetUp() {
+    DawnPerfTestWithParams<WireUploadParams>::TestSetUp();
+
+    mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(kRingSize);
+    mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.device = backendDevice;
+    serverDesc.procs = &backendProcs;
+    serverDesc.serializer = mS2cBuf.get();
+
+    mWireServer.reset(new dawn_wire::WireServer(serverDesc));
+    mC2sBuf->SetHandler(mWireServer.get());
+
+    dawn_wire::WireClientDescriptor clientDesc = {};
+    clientDesc.serializer = mC2sBuf.get();
+
+    mWireClient.reset(new dawn_wire::WireClient(clientDesc));
+    mS2cBuf->SetHandler(mWireClient.get());
+
+    clientProcs = mWireClient->GetProcs();
+    clientDevice = mWireClient->GetDevice();
+    clientQueue = clientProcs.deviceCreateQueue(clientDevice);
+
+    DawnBufferDescriptor desc = {};
+    desc.size = data.size();
+    desc.usage = DAWN_BUFFER_USAGE_COPY_DST;
+    dst = clientProcs.deviceCreateBuffer(clientDevice, &desc);
+
+    ASSERT_TRUE(mWireClient->Flush());
+}
+
+void WireUploadPerf::Step() {
+    switch (GetParam().uploadMethod) {
+        case UploadMethod::SetSubData: {
+            clientProcs.bufferSetSubData(dst, 0, data.size(), data.data());
+            // Make sure the SetSubData is flushed.
+            clientProcs.queueSubmit(clientQueue, 0, nullptr);
+        } break;
+
+        case UploadMethod::CreateBufferMapped: {
+            DawnBufferDescriptor desc = {};
+            desc.size = data.size();
+            desc.usage = static_cast<DawnBufferUsage>(DAWN_BUFFER_USAGE_COPY_SRC |
+                                                      DAWN_BUFFER_USAGE_MAP_WRITE);
+
+            DawnCreateBufferMappedResult result =
+                clientProcs.deviceCreateBufferMapped(clientDevice, &desc);
+            memcpy(result.data, data.data(), data.size());
+            clientProcs.bufferUnmap(result.buffer);
+
+            DawnCommandEncoder encoder =
+                clientProcs.deviceCreateCommandEncoder(clientDevice, nullptr);
+            clientProcs.commandEncoderCopyBufferToBuffer(encoder, result.buffer, 0, dst, 0,
+                                                         data.size());
+            DawnCommandBuffer commands = clientProcs.commandEncoderFinish(encoder, nullptr);
+            clientProcs.queueSubmit(clientQueue, 1, &commands);
+
+            clientProcs.commandBufferRelease(commands);
+            clientProcs.commandEncoderRelease(encoder);
+            clientProcs.bufferRelease(result.buffer);
+        } break;
+    }
+
+    if (!mWireClient->Flush()) {
+        AbortTest();
+        return;
+    }
+
+    // Wait for the GPU so that the upload is complete. The wait time gets amortized over the
+    // size of the upload.
+    WaitForGPU();
+}
+
+TEST_P(WireUploadPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireUploadPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {UploadMethod::SetSubData, UploadMethod::CreateBufferMapped});
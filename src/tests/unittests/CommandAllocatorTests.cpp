@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include "dawn_native/CommandAllocator.h"
+#include "tests/AllocationCounter.h"
 
 #include <limits>
 
@@ -112,6 +113,50 @@ TEST(CommandAllocator, Basic) {
     }
 }
 
+// Test that allocating commands in the current block and iterating over them don't allocate
+// memory.
+TEST(CommandAllocator, SteadyStateIsAllocationFree) {
+    if (!ScopedAllocationCounter::IsSupported()) {
+        return;
+    }
+
+    CommandAllocator allocator;
+
+    // The first command allocates the first block.
+    CommandDraw* firstDraw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+    firstDraw->first = 0;
+    firstDraw->count = 1;
+
+    {
+        ScopedAllocationCounter counter;
+        for (uint32_t i = 1; i < 16; ++i) {
+            CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+            draw->first = i;
+            draw->count = 1;
+        }
+        EXPECT_EQ(0u, counter.GetAllocationCount());
+    }
+
+    CommandIterator iterator(std::move(allocator));
+    {
+        ScopedAllocationCounter counter;
+
+        // Iterate twice to check the implicit reset at the end of the commands too.
+        for (uint32_t pass = 0; pass < 2; ++pass) {
+            uint32_t i = 0;
+            CommandType type;
+            while (iterator.NextCommandId(&type)) {
+                ASSERT_EQ(type, CommandType::Draw);
+                ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, i++);
+            }
+            ASSERT_EQ(i, 16u);
+        }
+        EXPECT_EQ(0u, counter.GetAllocationCount());
+    }
+
+    iterator.DataWasDestroyed();
+}
+
 // Test basic usage of allocator + iterator with data
 TEST(CommandAllocator, BasicWithData) {
     CommandAllocator allocator;
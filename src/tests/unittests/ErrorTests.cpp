@@ -17,12 +17,15 @@
 #include "dawn_native/Error.h"
 #include "dawn_native/ErrorData.h"
 
+#include <cstring>
+
 using namespace dawn_native;
 
 namespace {
 
 int dummySuccess = 0xbeef;
-const char* dummyErrorMessage = "I am an error message :3";
+#define DUMMY_ERROR_MESSAGE "I am an error message :3"
+const char* dummyErrorMessage = DUMMY_ERROR_MESSAGE;
 
 // Check returning a success MaybeError with {};
 TEST(ErrorTests, Error_Success) {
@@ -37,7 +40,7 @@ TEST(ErrorTests, Error_Success) {
 // Check returning an error MaybeError with "return DAWN_VALIDATION_ERROR"
 TEST(ErrorTests, Error_Error) {
     auto ReturnError = []() -> MaybeError {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     MaybeError result = ReturnError();
@@ -62,7 +65,7 @@ TEST(ErrorTests, ResultOrError_Success) {
 // Check returning an error ResultOrError with "return DAWN_VALIDATION_ERROR"
 TEST(ErrorTests, ResultOrError_Error) {
     auto ReturnError = []() -> ResultOrError<int*> {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     ResultOrError<int*> result = ReturnError();
@@ -96,7 +99,7 @@ TEST(ErrorTests, TRY_Success) {
 // Check DAWN_TRY handles errors correctly.
 TEST(ErrorTests, TRY_Error) {
     auto ReturnError = []() -> MaybeError {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> MaybeError {
@@ -117,7 +120,7 @@ TEST(ErrorTests, TRY_Error) {
 // Check DAWN_TRY adds to the backtrace.
 TEST(ErrorTests, TRY_AddsToBacktrace) {
     auto ReturnError = []() -> MaybeError {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto SingleTry = [ReturnError]() -> MaybeError {
@@ -172,7 +175,7 @@ TEST(ErrorTests, TRY_RESULT_Success) {
 // Check DAWN_TRY_ASSIGN handles errors correctly.
 TEST(ErrorTests, TRY_RESULT_Error) {
     auto ReturnError = []() -> ResultOrError<int*> {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> ResultOrError<int*> {
@@ -196,7 +199,7 @@ TEST(ErrorTests, TRY_RESULT_Error) {
 // Check DAWN_TRY_ASSIGN adds to the backtrace.
 TEST(ErrorTests, TRY_RESULT_AddsToBacktrace) {
     auto ReturnError = []() -> ResultOrError<int*> {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto SingleTry = [ReturnError]() -> ResultOrError<int*> {
@@ -227,7 +230,7 @@ TEST(ErrorTests, TRY_RESULT_AddsToBacktrace) {
 // Check a ResultOrError can be DAWN_TRY_ASSIGNED in a function that returns an Error
 TEST(ErrorTests, TRY_RESULT_ConversionToError) {
     auto ReturnError = []() -> ResultOrError<int*> {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> MaybeError {
@@ -250,7 +253,7 @@ TEST(ErrorTests, TRY_RESULT_ConversionToError) {
 // Version without Result<E*, T*>
 TEST(ErrorTests, TRY_RESULT_ConversionToErrorNonPointer) {
     auto ReturnError = []() -> ResultOrError<int> {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> MaybeError {
@@ -273,7 +276,7 @@ TEST(ErrorTests, TRY_RESULT_ConversionToErrorNonPointer) {
 // Check DAWN_TRY handles errors correctly.
 TEST(ErrorTests, TRY_ConversionToErrorOrResult) {
     auto ReturnError = []() -> MaybeError {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> ResultOrError<int*>{
@@ -293,7 +296,7 @@ TEST(ErrorTests, TRY_ConversionToErrorOrResult) {
 // Check DAWN_TRY handles errors correctly. Version without Result<E*, T*>
 TEST(ErrorTests, TRY_ConversionToErrorOrResultNonPointer) {
     auto ReturnError = []() -> MaybeError {
-        return DAWN_VALIDATION_ERROR(dummyErrorMessage);
+        return DAWN_VALIDATION_ERROR(DUMMY_ERROR_MESSAGE);
     };
 
     auto Try = [ReturnError]() -> ResultOrError<int>{
@@ -309,4 +312,53 @@ TEST(ErrorTests, TRY_ConversionToErrorOrResultNonPointer) {
     delete errorData;
 }
 
+// Check the arguments of an error message are formatted in its format.
+TEST(ErrorTests, MessageWithArguments) {
+    auto ReturnError = []() -> MaybeError {
+        uint32_t binding = 3;
+        uint64_t offset = 1ull << 40;
+        return DAWN_VALIDATION_ERROR("Binding %u at offset %u is 100%% out of bounds", binding,
+                                     offset);
+    };
+
+    MaybeError result = ReturnError();
+    ASSERT_TRUE(result.IsError());
+
+    ErrorData* errorData = result.AcquireError();
+    ASSERT_EQ(errorData->GetMessage(), "Binding 3 at offset 1099511627776 is 100% out of bounds");
+    delete errorData;
+}
+
+// Check messages computed at runtime are copied in the error.
+TEST(ErrorTests, MessageComputedAtRuntime) {
+    auto ReturnError = []() -> MaybeError {
+        std::string message = "Computed ";
+        message += dummyErrorMessage;
+        return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::Validation, message);
+    };
+
+    MaybeError result = ReturnError();
+    ASSERT_TRUE(result.IsError());
+
+    ErrorData* errorData = result.AcquireError();
+    ASSERT_EQ(errorData->GetMessage(), std::string("Computed ") + dummyErrorMessage);
+    delete errorData;
+}
+
+// Check character arrays that aren't string literals are copied in the error.
+TEST(ErrorTests, MessageFromCharacterArray) {
+    auto ReturnError = []() -> MaybeError {
+        char message[32] = "Array ";
+        strncat(message, "message", sizeof(message) - strlen(message) - 1);
+        return DAWN_MAKE_ERROR_WITH_MESSAGE(InternalErrorType::Validation, message);
+    };
+
+    MaybeError result = ReturnError();
+    ASSERT_TRUE(result.IsError());
+
+    ErrorData* errorData = result.AcquireError();
+    ASSERT_EQ(errorData->GetMessage(), "Array message");
+    delete errorData;
+}
+
 }  // anonymous namespace
@@ -0,0 +1,212 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "tests/perf_tests/PerfResults.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+    PerfStatistics MakeStatistics(size_t sampleCount, double mean, double stddev) {
+        PerfStatistics statistics;
+        statistics.sampleCount = sampleCount;
+        statistics.mean = mean;
+        statistics.median = mean;
+        statistics.stddev = stddev;
+        return statistics;
+    }
+
+}  // anonymous namespace
+
+class PerfResultsTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+        mPath = testing::TempDir() + "dawn_perf_results_" + info->name() + ".json";
+    }
+
+    void TearDown() override {
+        remove(mPath.c_str());
+    }
+
+    std::string ReadFile() const {
+        std::ifstream in(mPath);
+        std::stringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    std::string mPath;
+};
+
+// Test the statistics of samples without outliers.
+TEST_F(PerfResultsTests, ComputeStatistics) {
+    PerfStatistics statistics = ComputePerfStatistics({5.0, 1.0, 4.0, 2.0, 3.0});
+
+    EXPECT_EQ(5u, statistics.sampleCount);
+    EXPECT_EQ(0u, statistics.outlierCount);
+    EXPECT_DOUBLE_EQ(3.0, statistics.mean);
+    EXPECT_DOUBLE_EQ(std::sqrt(2.5), statistics.stddev);
+    EXPECT_DOUBLE_EQ(3.0, statistics.median);
+    EXPECT_DOUBLE_EQ(4.6, statistics.p90);
+    EXPECT_DOUBLE_EQ(4.96, statistics.p99);
+    EXPECT_DOUBLE_EQ(1.0, statistics.min);
+    EXPECT_DOUBLE_EQ(5.0, statistics.max);
+}
+
+// Test that the samples outside of Tukey's fences are rejected before computing the statistics.
+TEST_F(PerfResultsTests, ComputeStatisticsRejectsOutliers) {
+    PerfStatistics statistics = ComputePerfStatistics({10.0, 11.0, 10.0, 11.0, 10.0, 100.0});
+
+    EXPECT_EQ(5u, statistics.sampleCount);
+    EXPECT_EQ(1u, statistics.outlierCount);
+    EXPECT_DOUBLE_EQ(10.4, statistics.mean);
+    EXPECT_DOUBLE_EQ(11.0, statistics.max);
+}
+
+// Test the statistics of degenerate sample sets.
+TEST_F(PerfResultsTests, ComputeStatisticsDegenerate) {
+    PerfStatistics empty = ComputePerfStatistics({});
+    EXPECT_EQ(0u, empty.sampleCount);
+    EXPECT_EQ(0.0, empty.mean);
+
+    PerfStatistics single = ComputePerfStatistics({7.0});
+    EXPECT_EQ(1u, single.sampleCount);
+    EXPECT_DOUBLE_EQ(7.0, single.mean);
+    EXPECT_EQ(0.0, single.stddev);
+    EXPECT_DOUBLE_EQ(7.0, single.median);
+    EXPECT_DOUBLE_EQ(7.0, single.p99);
+}
+
+// Test that the wall time statistics and the metrics are read back as written.
+TEST_F(PerfResultsTests, JSONRoundTrip) {
+    PerfResults results;
+    PerfTestResult& result = results["Suite.Test/Vulkan \"quoted\""];
+    result.iterationsPerStep = 50;
+    result.trials.push_back({10, 1.5, 1.25});
+    result.wallTime = ComputePerfStatistics({1.0, 2.0, 3.0, 4.0});
+    result.metrics["draws_per_second"] = 123456.789;
+    result.metrics["bytes"] = 1.0 / 3.0;
+    results["Other"].iterationsPerStep = 1;
+
+    ASSERT_TRUE(WritePerfResultsJSON(mPath, results));
+
+    PerfResults readResults;
+    ASSERT_TRUE(ReadPerfResultsJSON(mPath, &readResults));
+    ASSERT_EQ(2u, readResults.size());
+
+    const PerfTestResult& readResult = readResults["Suite.Test/Vulkan \"quoted\""];
+    EXPECT_EQ(50u, readResult.iterationsPerStep);
+    EXPECT_EQ(result.wallTime.sampleCount, readResult.wallTime.sampleCount);
+    EXPECT_EQ(result.wallTime.outlierCount, readResult.wallTime.outlierCount);
+    EXPECT_EQ(result.wallTime.mean, readResult.wallTime.mean);
+    EXPECT_EQ(result.wallTime.stddev, readResult.wallTime.stddev);
+    EXPECT_EQ(result.wallTime.median, readResult.wallTime.median);
+    EXPECT_EQ(result.wallTime.p90, readResult.wallTime.p90);
+    EXPECT_EQ(result.wallTime.p99, readResult.wallTime.p99);
+    EXPECT_EQ(result.wallTime.min, readResult.wallTime.min);
+    EXPECT_EQ(result.wallTime.max, readResult.wallTime.max);
+    EXPECT_EQ(result.metrics, readResult.metrics);
+
+    EXPECT_EQ(1u, readResults["Other"].iterationsPerStep);
+}
+
+// Test that NaN and infinite values are written as null so that the file stays valid JSON, and
+// are read back as NaN.
+TEST_F(PerfResultsTests, JSONNonFiniteValues) {
+    PerfResults results;
+    PerfTestResult& result = results["Test"];
+    result.trials.push_back({1, std::numeric_limits<double>::infinity(), 1.0});
+    result.wallTime.mean = std::numeric_limits<double>::quiet_NaN();
+    result.metrics["nan"] = std::numeric_limits<double>::quiet_NaN();
+    result.metrics["inf"] = -std::numeric_limits<double>::infinity();
+    result.metrics["finite"] = 2.0;
+
+    ASSERT_TRUE(WritePerfResultsJSON(mPath, results));
+
+    std::string text = ReadFile();
+    EXPECT_EQ(std::string::npos, text.find(": nan"));
+    EXPECT_EQ(std::string::npos, text.find(": inf"));
+    EXPECT_EQ(std::string::npos, text.find(": -inf"));
+    EXPECT_NE(std::string::npos, text.find("\"mean\": null"));
+    EXPECT_NE(std::string::npos, text.find("\"wall_time_us\": null"));
+
+    PerfResults readResults;
+    ASSERT_TRUE(ReadPerfResultsJSON(mPath, &readResults));
+    const PerfTestResult& readResult = readResults["Test"];
+    EXPECT_TRUE(std::isnan(readResult.wallTime.mean));
+    EXPECT_TRUE(std::isnan(readResult.metrics.at("nan")));
+    EXPECT_TRUE(std::isnan(readResult.metrics.at("inf")));
+    EXPECT_EQ(2.0, readResult.metrics.at("finite"));
+}
+
+// Test that reading a missing or malformed file fails.
+TEST_F(PerfResultsTests, JSONReadInvalid) {
+    PerfResults results;
+    EXPECT_FALSE(ReadPerfResultsJSON(mPath, &results));
+
+    std::ofstream(mPath) << "{\"version\": 1, \"tests\": [{\"name\": \"Test\", ";
+    EXPECT_FALSE(ReadPerfResultsJSON(mPath, &results));
+
+    std::ofstream(mPath) << "{\"mean\": nan}";
+    EXPECT_FALSE(ReadPerfResultsJSON(mPath, &results));
+}
+
+// Test that a slower median is a regression only when the difference is significant.
+TEST_F(PerfResultsTests, CompareStatistics) {
+    PerfStatistics baseline = MakeStatistics(100, 10.0, 0.5);
+
+    // 10% slower with little noise is a regression.
+    PerfComparison slower = ComparePerfStatistics(baseline, MakeStatistics(100, 11.0, 0.5), 0.05);
+    EXPECT_DOUBLE_EQ(0.1, slower.relativeChange);
+    EXPECT_GT(slower.tStatistic, 3.0);
+    EXPECT_TRUE(slower.isRegression);
+
+    // Faster isn't a regression.
+    PerfComparison faster = ComparePerfStatistics(baseline, MakeStatistics(100, 9.0, 0.5), 0.05);
+    EXPECT_LT(faster.relativeChange, 0.0);
+    EXPECT_LT(faster.tStatistic, 0.0);
+    EXPECT_FALSE(faster.isRegression);
+
+    // Under the threshold isn't a regression.
+    EXPECT_FALSE(
+        ComparePerfStatistics(baseline, MakeStatistics(100, 10.2, 0.01), 0.05).isRegression);
+
+    // Above the threshold but within the noise isn't a regression.
+    EXPECT_FALSE(
+        ComparePerfStatistics(baseline, MakeStatistics(4, 11.0, 10.0), 0.05).isRegression);
+}
+
+// Test the comparison of statistics without noise or samples.
+TEST_F(PerfResultsTests, CompareStatisticsDegenerate) {
+    PerfStatistics baseline = MakeStatistics(10, 10.0, 0.0);
+
+    PerfComparison noNoise = ComparePerfStatistics(baseline, MakeStatistics(10, 12.0, 0.0), 0.05);
+    EXPECT_TRUE(std::isinf(noNoise.tStatistic));
+    EXPECT_TRUE(noNoise.isRegression);
+
+    PerfComparison same = ComparePerfStatistics(baseline, baseline, 0.05);
+    EXPECT_EQ(0.0, same.tStatistic);
+    EXPECT_FALSE(same.isRegression);
+
+    PerfComparison empty = ComparePerfStatistics(PerfStatistics(), baseline, 0.05);
+    EXPECT_EQ(0.0, empty.relativeChange);
+    EXPECT_FALSE(empty.isRegression);
+}
@@ -0,0 +1,138 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_platform/tracing/TraceEvent.h"
+#include "utils/TracingPlatform.h"
+
+#include <sstream>
+#include <thread>
+
+namespace {
+
+    std::string WriteTraceEvents(utils::TracingPlatform* platform) {
+        std::ostringstream out;
+        platform->WriteTraceEvents(out);
+        return out.str();
+    }
+
+}  // anonymous namespace
+
+// Test that the begin and end events of a scoped trace event are recorded.
+TEST(TracingPlatform, ScopedEvent) {
+    utils::TracingPlatform platform;
+    { TRACE_EVENT1(&platform, "dawn.test", "Scoped", "value", 42u); }
+
+    std::string trace = WriteTraceEvents(&platform);
+    EXPECT_NE(trace.find("{\"name\": \"Scoped\", \"cat\": \"dawn.test\", \"ph\": \"B\""),
+              std::string::npos);
+    EXPECT_NE(trace.find("{\"name\": \"Scoped\", \"cat\": \"dawn.test\", \"ph\": \"E\""),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"args\": {\"value\": 42}"), std::string::npos);
+}
+
+// Test that only the events of the enabled categories are recorded.
+TEST(TracingPlatform, CategoryFiltering) {
+    utils::TracingPlatform platform("dawn.enabled,disabled-by-default-dawn.*");
+    TRACE_EVENT_INSTANT0(&platform, "dawn.enabled", "Enabled");
+    TRACE_EVENT_INSTANT0(&platform, "dawn.disabled", "Disabled");
+    TRACE_EVENT_INSTANT0(&platform, TRACE_DISABLED_BY_DEFAULT("dawn.prefixed"), "Prefixed");
+    TRACE_EVENT_INSTANT0(&platform, "dawn.disabled,dawn.enabled", "Group");
+
+    std::string trace = WriteTraceEvents(&platform);
+    EXPECT_NE(trace.find("\"Enabled\""), std::string::npos);
+    EXPECT_EQ(trace.find("\"Disabled\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Prefixed\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Group\""), std::string::npos);
+}
+
+// Test that the category flags are disabled when the platform is destroyed, as the tracing macros
+// keep using them.
+TEST(TracingPlatform, FlagsDisabledOnDestruction) {
+    const unsigned char* flag = nullptr;
+    {
+        utils::TracingPlatform platform;
+        flag = platform.GetTraceCategoryEnabledFlag("dawn.test");
+        EXPECT_NE(*flag, 0u);
+    }
+    EXPECT_EQ(*flag, 0u);
+
+    utils::TracingPlatform platform;
+    EXPECT_EQ(flag, platform.GetTraceCategoryEnabledFlag("dawn.test"));
+    EXPECT_NE(*flag, 0u);
+}
+
+// Test that destroying a platform keeps enabled the categories that another live platform
+// enables.
+TEST(TracingPlatform, FlagsKeptWhileAnotherPlatformEnablesThem) {
+    utils::TracingPlatform outer("dawn.shared");
+    const unsigned char* shared = outer.GetTraceCategoryEnabledFlag("dawn.shared");
+    const unsigned char* innerOnly = outer.GetTraceCategoryEnabledFlag("dawn.inner");
+    EXPECT_NE(*shared, 0u);
+    EXPECT_EQ(*innerOnly, 0u);
+
+    {
+        utils::TracingPlatform inner("dawn.shared,dawn.inner");
+        EXPECT_NE(*shared, 0u);
+        EXPECT_NE(*innerOnly, 0u);
+    }
+    EXPECT_NE(*shared, 0u);
+    EXPECT_EQ(*innerOnly, 0u);
+}
+
+// Test that control characters are escaped in the JSON strings.
+TEST(TracingPlatform, ControlCharactersEscaped) {
+    utils::TracingPlatform platform;
+    TRACE_EVENT_COPY_INSTANT1(&platform, "dawn.test", "Event", "string", "a\tb\nc\x01\"\\");
+
+    std::string trace = WriteTraceEvents(&platform);
+    EXPECT_NE(trace.find("{\"string\": \"a\\u0009b\\nc\\u0001\\\"\\\\\"}"),
+              std::string::npos);
+}
+
+// Test that the events of each thread are recorded with their own thread id.
+TEST(TracingPlatform, MultipleThreads) {
+    utils::TracingPlatform platform;
+    TRACE_EVENT_INSTANT0(&platform, "dawn.test", "MainThread");
+    std::thread thread([&platform]() {
+        TRACE_EVENT_COPY_INSTANT1(&platform, "dawn.test", "OtherThread", "string", "value");
+    });
+    thread.join();
+
+    std::string trace = WriteTraceEvents(&platform);
+    EXPECT_NE(trace.find("\"name\": \"MainThread\", \"cat\": \"dawn.test\", \"ph\": \"I\", "),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"pid\": 0, \"tid\": 0"), std::string::npos);
+    EXPECT_NE(trace.find("\"pid\": 0, \"tid\": 1"), std::string::npos);
+    EXPECT_NE(trace.find("\"args\": {\"string\": \"value\"}"), std::string::npos);
+}
+
+// Test that events are dropped when the buffer of a thread is full until it is collected.
+TEST(TracingPlatform, FullBuffer) {
+    utils::TracingPlatform platform("*", 4);
+    for (uint32_t i = 0; i < 6; ++i) {
+        TRACE_EVENT_INSTANT1(&platform, "dawn.test", "Event", "index", i);
+    }
+    EXPECT_EQ(platform.GetDroppedEventCount(), 2u);
+
+    platform.CollectTraceEvents();
+    TRACE_EVENT_INSTANT1(&platform, "dawn.test", "Event", "index", 6u);
+    EXPECT_EQ(platform.GetDroppedEventCount(), 2u);
+
+    std::string trace = WriteTraceEvents(&platform);
+    EXPECT_NE(trace.find("{\"index\": 3}"), std::string::npos);
+    EXPECT_EQ(trace.find("{\"index\": 4}"), std::string::npos);
+    EXPECT_NE(trace.find("{\"index\": 6}"), std::string::npos);
+}
@@ -0,0 +1,77 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/WorkerPool.h"
+
+#include <atomic>
+
+using namespace dawn_native;
+
+// Test that all the posted tasks run and that their futures become ready.
+TEST(WorkerPool, RunsAllTasks) {
+    WorkerPool pool(4);
+    EXPECT_EQ(4u, pool.GetThreadCount());
+
+    std::atomic<uint32_t> runCount(0);
+    std::vector<std::future<void>> futures;
+    for (uint32_t i = 0; i < 100; ++i) {
+        futures.push_back(pool.PostTask([&runCount]() { runCount++; }));
+    }
+
+    for (std::future<void>& future : futures) {
+        future.wait();
+    }
+    EXPECT_EQ(100u, runCount.load());
+}
+
+// Test that a single thread runs the tasks in the order they were posted.
+TEST(WorkerPool, SingleThreadRunsTasksInOrder) {
+    WorkerPool pool(1);
+
+    std::vector<uint32_t> order;
+    std::vector<std::future<void>> futures;
+    for (uint32_t i = 0; i < 10; ++i) {
+        futures.push_back(pool.PostTask([&order, i]() { order.push_back(i); }));
+    }
+    futures.back().wait();
+
+    std::vector<uint32_t> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(expected, order);
+}
+
+// Test that destroying the pool runs the tasks that are still pending.
+TEST(WorkerPool, DestructionRunsPendingTasks) {
+    std::atomic<uint32_t> runCount(0);
+    std::future<void> lastFuture;
+    {
+        WorkerPool pool(1);
+        for (uint32_t i = 0; i < 10; ++i) {
+            lastFuture = pool.PostTask([&runCount]() { runCount++; });
+        }
+    }
+    EXPECT_EQ(10u, runCount.load());
+    EXPECT_EQ(std::future_status::ready, lastFuture.wait_for(std::chrono::seconds(0)));
+}
+
+// Test that the default thread count leaves a core to the thread using the device.
+TEST(WorkerPool, DefaultThreadCount) {
+    uint32_t threadCount = WorkerPool::GetDefaultThreadCount();
+    EXPECT_GE(threadCount, 1u);
+    if (std::thread::hardware_concurrency() > 1) {
+        EXPECT_EQ(std::thread::hardware_concurrency() - 1, threadCount);
+    }
+}
@@ -0,0 +1,216 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/DeviceStatistics.h"
+#include "dawn_native/opengl/OpenGLStateTracker.h"
+
+using namespace dawn_native;
+using namespace dawn_native::opengl;
+
+class OpenGLStateTrackerTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mTracker.StartTracking(&mCounters);
+    }
+
+    uint64_t Issued() const {
+        return mCounters.glStateCallsIssued.Get();
+    }
+    uint64_t Filtered() const {
+        return mCounters.glStateCallsFiltered.Get();
+    }
+
+    DeviceCounters mCounters;
+    OpenGLStateTracker mTracker;
+};
+
+// Test that all the calls are issued and not counted when the tracking isn't started.
+TEST(OpenGLStateTrackerDisabledTests, AllCallsIssued) {
+    OpenGLStateTracker tracker;
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_TRUE(tracker.Enable(GL_DEPTH_TEST));
+    EXPECT_TRUE(tracker.Enable(GL_DEPTH_TEST));
+}
+
+// Test that setting a piece of state to the value it already has is filtered, and that the state
+// starts unknown.
+TEST_F(OpenGLStateTrackerTests, RedundantCallsFiltered) {
+    EXPECT_TRUE(mTracker.UseProgram(0));
+    EXPECT_FALSE(mTracker.UseProgram(0));
+    EXPECT_TRUE(mTracker.UseProgram(1));
+
+    EXPECT_TRUE(mTracker.DepthMask(GL_TRUE));
+    EXPECT_FALSE(mTracker.DepthMask(GL_TRUE));
+    EXPECT_TRUE(mTracker.DepthMask(GL_FALSE));
+
+    EXPECT_TRUE(mTracker.ColorMaski(0, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+    EXPECT_TRUE(mTracker.ColorMaski(1, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+    EXPECT_FALSE(mTracker.ColorMaski(0, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+    EXPECT_TRUE(mTracker.ColorMaski(0, GL_TRUE, GL_FALSE, GL_TRUE, GL_TRUE));
+
+    EXPECT_EQ(7u, Issued());
+    EXPECT_EQ(3u, Filtered());
+}
+
+// Test that buffer bindings are tracked per target, and that binding an indexed binding point
+// also binds the generic one.
+TEST_F(OpenGLStateTrackerTests, BufferBindings) {
+    EXPECT_TRUE(mTracker.BindBuffer(GL_ARRAY_BUFFER, 1));
+    EXPECT_TRUE(mTracker.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 1));
+    EXPECT_FALSE(mTracker.BindBuffer(GL_ARRAY_BUFFER, 1));
+
+    EXPECT_TRUE(mTracker.BindBufferRange(GL_UNIFORM_BUFFER, 0, 2, 0, 16));
+    EXPECT_FALSE(mTracker.BindBufferRange(GL_UNIFORM_BUFFER, 0, 2, 0, 16));
+    EXPECT_TRUE(mTracker.BindBufferRange(GL_UNIFORM_BUFFER, 0, 2, 256, 16));
+    EXPECT_FALSE(mTracker.BindBuffer(GL_UNIFORM_BUFFER, 2));
+
+    // The element array buffer binding is part of the vertex array.
+    EXPECT_TRUE(mTracker.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3));
+    EXPECT_TRUE(mTracker.BindVertexArray(1));
+    EXPECT_TRUE(mTracker.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3));
+}
+
+// Test that texture bindings are tracked per texture unit.
+TEST_F(OpenGLStateTrackerTests, TextureBindings) {
+    // The texture unit is unknown so the binding can't be filtered.
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+
+    EXPECT_TRUE(mTracker.ActiveTexture(GL_TEXTURE0));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+    EXPECT_FALSE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+
+    EXPECT_TRUE(mTracker.ActiveTexture(GL_TEXTURE1));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D_ARRAY, 1));
+
+    EXPECT_FALSE(mTracker.ActiveTexture(GL_TEXTURE1));
+    EXPECT_TRUE(mTracker.ActiveTexture(GL_TEXTURE0));
+    EXPECT_FALSE(mTracker.BindTexture(GL_TEXTURE_2D, 1));
+}
+
+// Test that binding GL_FRAMEBUFFER binds both the draw and the read framebuffers.
+TEST_F(OpenGLStateTrackerTests, FramebufferBindings) {
+    EXPECT_TRUE(mTracker.BindFramebuffer(GL_FRAMEBUFFER, 1));
+    EXPECT_FALSE(mTracker.BindFramebuffer(GL_DRAW_FRAMEBUFFER, 1));
+    EXPECT_FALSE(mTracker.BindFramebuffer(GL_READ_FRAMEBUFFER, 1));
+
+    EXPECT_TRUE(mTracker.BindFramebuffer(GL_READ_FRAMEBUFFER, 2));
+    EXPECT_TRUE(mTracker.BindFramebuffer(GL_FRAMEBUFFER, 1));
+    EXPECT_FALSE(mTracker.BindFramebuffer(GL_FRAMEBUFFER, 1));
+}
+
+// Test that deleting a bound object resets its bindings to 0, so that binding an object that
+// reuses its name isn't filtered.
+TEST_F(OpenGLStateTrackerTests, DeletingBoundObjects) {
+    GLuint name = 1;
+
+    EXPECT_TRUE(mTracker.BindBuffer(GL_ARRAY_BUFFER, name));
+    EXPECT_TRUE(mTracker.DeleteBuffers(1, &name));
+    EXPECT_FALSE(mTracker.BindBuffer(GL_ARRAY_BUFFER, 0));
+    EXPECT_TRUE(mTracker.BindBuffer(GL_ARRAY_BUFFER, name));
+
+    EXPECT_TRUE(mTracker.ActiveTexture(GL_TEXTURE0));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, name));
+    EXPECT_TRUE(mTracker.DeleteTextures(1, &name));
+    EXPECT_TRUE(mTracker.BindTexture(GL_TEXTURE_2D, name));
+
+    EXPECT_TRUE(mTracker.BindSampler(0, name));
+    EXPECT_TRUE(mTracker.DeleteSamplers(1, &name));
+    EXPECT_TRUE(mTracker.BindSampler(0, name));
+
+    EXPECT_TRUE(mTracker.BindFramebuffer(GL_FRAMEBUFFER, name));
+    EXPECT_TRUE(mTracker.DeleteFramebuffers(1, &name));
+    EXPECT_TRUE(mTracker.BindFramebuffer(GL_DRAW_FRAMEBUFFER, name));
+
+    EXPECT_TRUE(mTracker.BindVertexArray(name));
+    EXPECT_TRUE(mTracker.DeleteVertexArrays(1, &name));
+    EXPECT_TRUE(mTracker.BindVertexArray(name));
+}
+
+// Test that the caps set with and without an index are kept consistent.
+TEST_F(OpenGLStateTrackerTests, IndexedCaps) {
+    EXPECT_TRUE(mTracker.Enablei(GL_BLEND, 0));
+    EXPECT_TRUE(mTracker.Disablei(GL_BLEND, 1));
+    EXPECT_FALSE(mTracker.Enablei(GL_BLEND, 0));
+
+    // Disabling the cap disables it for all the indices.
+    EXPECT_TRUE(mTracker.Disable(GL_BLEND));
+    EXPECT_FALSE(mTracker.Disablei(GL_BLEND, 0));
+    EXPECT_FALSE(mTracker.Disable(GL_BLEND));
+
+    // Enabling one index makes the cap without an index unknown.
+    EXPECT_TRUE(mTracker.Enablei(GL_BLEND, 1));
+    EXPECT_TRUE(mTracker.Disable(GL_BLEND));
+
+    EXPECT_TRUE(mTracker.Enable(GL_DEPTH_TEST));
+    EXPECT_FALSE(mTracker.Enable(GL_DEPTH_TEST));
+    EXPECT_TRUE(mTracker.Disable(GL_DEPTH_TEST));
+}
+
+// Test that the calls for the targets, units and indices outside of the tracked ones are always
+// issued.
+TEST_F(OpenGLStateTrackerTests, UntrackedStateIsIssued) {
+    EXPECT_TRUE(mTracker.BindSampler(OpenGLStateTracker::kMaxTextureUnits, 1));
+    EXPECT_TRUE(mTracker.BindSampler(OpenGLStateTracker::kMaxTextureUnits, 1));
+
+    EXPECT_TRUE(mTracker.ColorMaski(kMaxColorAttachments, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+    EXPECT_TRUE(mTracker.ColorMaski(kMaxColorAttachments, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+
+    EXPECT_TRUE(mTracker.Enable(GL_DITHER));
+    EXPECT_TRUE(mTracker.Enable(GL_DITHER));
+
+    // Binding an untracked indexed binding point makes the generic binding point unknown.
+    EXPECT_TRUE(mTracker.BindBuffer(GL_UNIFORM_BUFFER, 1));
+    EXPECT_TRUE(mTracker.BindBufferRange(GL_UNIFORM_BUFFER,
+                                         OpenGLStateTracker::kMaxIndexedBufferBindings, 2, 0, 16));
+    EXPECT_TRUE(mTracker.BindBuffer(GL_UNIFORM_BUFFER, 1));
+}
+
+// Test that tracking is only enabled while a single device is alive on the context, and that
+// the state is forgotten when it stops.
+TEST(OpenGLStateTrackerDeviceTests, OnlyTrackedWithASingleDevice) {
+    DeviceCounters counters1;
+    DeviceCounters counters2;
+    OpenGLStateTracker tracker;
+
+    tracker.AddDevice(&counters1, true);
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_FALSE(tracker.UseProgram(1));
+
+    // The second device may change the state so nothing is filtered anymore.
+    tracker.AddDevice(&counters2, true);
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_TRUE(tracker.UseProgram(1));
+
+    tracker.RemoveDevice();
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_TRUE(tracker.UseProgram(1));
+    tracker.RemoveDevice();
+
+    EXPECT_EQ(1u, counters1.glStateCallsIssued.Get());
+    EXPECT_EQ(1u, counters1.glStateCallsFiltered.Get());
+    EXPECT_EQ(0u, counters2.glStateCallsIssued.Get());
+
+    // A device that doesn't filter the calls doesn't start the tracking.
+    tracker.AddDevice(&counters2, false);
+    EXPECT_TRUE(tracker.UseProgram(1));
+    EXPECT_TRUE(tracker.UseProgram(1));
+    tracker.RemoveDevice();
+    EXPECT_EQ(0u, counters2.glStateCallsIssued.Get());
+}
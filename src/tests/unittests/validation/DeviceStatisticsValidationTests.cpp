@@ -0,0 +1,176 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+class DeviceStatisticsValidationTest : public ValidationTest {
+  protected:
+    dawn_native::DeviceStatistics GetStatistics() {
+        return dawn_native::GetDeviceStatistics(device.Get());
+    }
+};
+
+// Test that the live objects are counted until they are destroyed.
+TEST_F(DeviceStatisticsValidationTest, LiveObjectCounts) {
+    uint64_t buffersBefore = GetStatistics().liveObjects.buffers;
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::Uniform;
+    {
+        dawn::Buffer buffer1 = device.CreateBuffer(&descriptor);
+        dawn::Buffer buffer2 = device.CreateBuffer(&descriptor);
+        EXPECT_EQ(buffersBefore + 2, GetStatistics().liveObjects.buffers);
+    }
+    EXPECT_EQ(buffersBefore, GetStatistics().liveObjects.buffers);
+
+    // Error objects aren't counted.
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::Uniform;
+    ASSERT_DEVICE_ERROR(device.CreateBuffer(&descriptor));
+    EXPECT_EQ(buffersBefore, GetStatistics().liveObjects.buffers);
+
+    {
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        EXPECT_EQ(1u, GetStatistics().liveObjects.commandEncoders);
+
+        dawn::CommandBuffer commands = encoder.Finish();
+        EXPECT_EQ(1u, GetStatistics().liveObjects.commandBuffers);
+    }
+    EXPECT_EQ(0u, GetStatistics().liveObjects.commandEncoders);
+    EXPECT_EQ(0u, GetStatistics().liveObjects.commandBuffers);
+}
+
+// Test that the cache statistics count the hits and misses of the object caches.
+TEST_F(DeviceStatisticsValidationTest, CacheHitsAndMisses) {
+    dawn_native::ObjectCacheStatistics before = GetStatistics().samplerCache;
+
+    dawn::SamplerDescriptor descriptor = utils::GetDefaultSamplerDescriptor();
+    dawn::Sampler sampler1 = device.CreateSampler(&descriptor);
+    dawn::Sampler sampler2 = device.CreateSampler(&descriptor);
+
+    dawn_native::DeviceStatistics statistics = GetStatistics();
+    EXPECT_EQ(before.size + 1, statistics.samplerCache.size);
+    EXPECT_EQ(before.hits + 1, statistics.samplerCache.hits);
+    EXPECT_EQ(before.misses + 1, statistics.samplerCache.misses);
+    EXPECT_EQ(1u, statistics.liveObjects.samplers);
+}
+
+// Test that the lazy clear count of the statistics is the one used by the tests.
+TEST_F(DeviceStatisticsValidationTest, LazyClearCount) {
+    EXPECT_EQ(dawn_native::GetLazyClearCountForTesting(device.Get()),
+              GetStatistics().lazyClearCount);
+}
+
+// Test that the memory of buffers and textures is accounted until they are destroyed.
+TEST_F(DeviceStatisticsValidationTest, MemoryUsage) {
+    dawn_native::MemoryUsage before = dawn_native::GetMemoryUsage(device.Get());
+
+    dawn::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = 256;
+    bufferDescriptor.usage = dawn::BufferUsage::Uniform;
+    dawn::Buffer buffer = device.CreateBuffer(&bufferDescriptor);
+
+    dawn::TextureDescriptor textureDescriptor;
+    textureDescriptor.size = {16, 16, 1};
+    textureDescriptor.arrayLayerCount = 2;
+    textureDescriptor.mipLevelCount = 2;
+    textureDescriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDescriptor.usage = dawn::TextureUsage::Sampled;
+    dawn::Texture texture = device.CreateTexture(&textureDescriptor);
+
+    dawn_native::MemoryUsage usage = dawn_native::GetMemoryUsage(device.Get());
+    EXPECT_EQ(before.buffers + 256, usage.buffers);
+    EXPECT_EQ(before.textures + (16 * 16 + 8 * 8) * 4 * 2, usage.textures);
+    EXPECT_EQ(before.total + 256 + (16 * 16 + 8 * 8) * 4 * 2, usage.total);
+
+    // Destroying the objects frees their memory even if they are still referenced.
+    buffer.Destroy();
+    texture.Destroy();
+    usage = dawn_native::GetMemoryUsage(device.Get());
+    EXPECT_EQ(before.buffers, usage.buffers);
+    EXPECT_EQ(before.textures, usage.textures);
+}
+
+// Test that the staging memory of a buffer mapped at creation is accounted until it is unmapped.
+TEST_F(DeviceStatisticsValidationTest, MemoryUsageOfBufferMappedAtCreation) {
+    dawn_native::MemoryUsage before = dawn_native::GetMemoryUsage(device.Get());
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 64;
+    descriptor.usage = dawn::BufferUsage::Uniform;
+    dawn::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+    EXPECT_EQ(before.staging + 64, dawn_native::GetMemoryUsage(device.Get()).staging);
+
+    // The staging buffer is released once the copy to the buffer is complete, which takes a tick
+    // to submit the copy and another one to see it completed.
+    result.buffer.Unmap();
+    device.Tick();
+    device.Tick();
+    EXPECT_EQ(before.staging, dawn_native::GetMemoryUsage(device.Get()).staging);
+}
+
+struct MemoryPressure {
+    uint32_t callCount = 0;
+    uint64_t usage = 0;
+    uint64_t budget = 0;
+};
+
+void OnMemoryPressure(uint64_t usage, uint64_t budget, void* userdata) {
+    MemoryPressure* pressure = static_cast<MemoryPressure*>(userdata);
+    pressure->callCount++;
+    pressure->usage = usage;
+    pressure->budget = budget;
+}
+
+// Test that the pressure callback is called on the tick that follows going over the budget, and
+// only once until the usage goes back under the budget.
+TEST_F(DeviceStatisticsValidationTest, MemoryBudget) {
+    uint64_t budget = dawn_native::GetMemoryUsage(device.Get()).total + 1024;
+
+    MemoryPressure pressure;
+    dawn_native::SetMemoryBudget(device.Get(), budget, OnMemoryPressure, &pressure);
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 1024;
+    descriptor.usage = dawn::BufferUsage::Uniform;
+    dawn::Buffer underBudget = device.CreateBuffer(&descriptor);
+    device.Tick();
+    EXPECT_EQ(0u, pressure.callCount);
+
+    dawn::Buffer overBudget1 = device.CreateBuffer(&descriptor);
+    EXPECT_EQ(0u, pressure.callCount);
+    device.Tick();
+    EXPECT_EQ(1u, pressure.callCount);
+    EXPECT_EQ(budget + 1024, pressure.usage);
+    EXPECT_EQ(budget, pressure.budget);
+
+    dawn::Buffer overBudget2 = device.CreateBuffer(&descriptor);
+    device.Tick();
+    EXPECT_EQ(1u, pressure.callCount);
+
+    // Going back under the budget rearms the callback.
+    overBudget1.Destroy();
+    overBudget2.Destroy();
+    overBudget1 = device.CreateBuffer(&descriptor);
+    device.Tick();
+    EXPECT_EQ(2u, pressure.callCount);
+
+    dawn_native::SetMemoryBudget(device.Get(), dawn_native::kNoMemoryBudget, nullptr, nullptr);
+}
+
+}  // anonymous namespace
@@ -48,10 +48,22 @@ class ErrorScopeValidationTest : public ValidationTest {
 TEST_F(ErrorScopeValidationTest, Success) {
     device.PushErrorScope(dawn::ErrorFilter::Validation);
 
-    EXPECT_CALL(*mockDevicePopErrorScopeCallback, Call(DAWN_ERROR_TYPE_NO_ERROR, _, this)).Times(1);
+    EXPECT_CALL(*mockDevicePopErrorScopeCallback, Call(DAWN_ERROR_TYPE_NO_ERROR, StrEq(""), this))
+        .Times(1);
     device.PopErrorScope(ToMockDevicePopErrorScopeCallback, this);
 }
 
+// Test that a scope popped without a callback drops the error it caught.
+TEST_F(ErrorScopeValidationTest, PopWithoutCallback) {
+    device.PushErrorScope(dawn::ErrorFilter::Validation);
+
+    dawn::BufferDescriptor desc = {};
+    desc.usage = static_cast<dawn::BufferUsage>(DAWN_BUFFER_USAGE_FORCE32);
+    device.CreateBuffer(&desc);
+
+    EXPECT_TRUE(device.PopErrorScope(nullptr, nullptr));
+}
+
 // Test the simple case where the error scope catches an error.
 TEST_F(ErrorScopeValidationTest, CatchesError) {
     device.PushErrorScope(dawn::ErrorFilter::Validation);
@@ -14,6 +14,10 @@
 
 #include "tests/unittests/wire/WireTest.h"
 
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "tests/AllocationCounter.h"
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -78,3 +82,56 @@ TEST_F(WireBasicTests, ReleaseCalledOnRefCount0) {
 
     FlushClient();
 }
+
+// Test that serializing commands on existing objects doesn't allocate memory in the client.
+TEST_F(WireBasicTests, ClientCommandsAreAllocationFree) {
+    if (!ScopedAllocationCounter::IsSupported()) {
+        return;
+    }
+
+    DawnCommandEncoder encoder;
+    {
+        // Check that the counter sees the allocation of the client object.
+        ScopedAllocationCounter counter;
+        encoder = dawnDeviceCreateCommandEncoder(device, nullptr);
+        EXPECT_GT(counter.GetAllocationCount(), 0u);
+    }
+
+    {
+        ScopedAllocationCounter counter;
+        for (uint32_t i = 0; i < 10; ++i) {
+            dawnCommandEncoderPushDebugGroup(encoder, "group");
+            dawnCommandEncoderInsertDebugMarker(encoder, "marker");
+            dawnCommandEncoderPopDebugGroup(encoder);
+        }
+        EXPECT_EQ(0u, counter.GetAllocationCount());
+    }
+
+    DawnCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderPushDebugGroup(apiEncoder, StrEq("group"))).Times(10);
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("marker"))).Times(10);
+    EXPECT_CALL(api, CommandEncoderPopDebugGroup(apiEncoder)).Times(10);
+
+    FlushClient();
+}
+
+// Test that the bytes serialized by the client are the ones handled by the server.
+TEST_F(WireBasicTests, Statistics) {
+    WireStatistics clientBefore = GetWireClient()->GetStatistics();
+    WireStatistics serverBefore = GetWireServer()->GetStatistics();
+
+    DawnCommandEncoder encoder = dawnDeviceCreateCommandEncoder(device, nullptr);
+    dawnCommandEncoderInsertDebugMarker(encoder, "marker");
+
+    DawnCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, StrEq("marker")));
+
+    FlushClient();
+
+    uint64_t clientBytesOut = GetWireClient()->GetStatistics().bytesOut - clientBefore.bytesOut;
+    uint64_t serverBytesIn = GetWireServer()->GetStatistics().bytesIn - serverBefore.bytesIn;
+    EXPECT_GT(clientBytesOut, 0u);
+    EXPECT_EQ(clientBytesOut, serverBytesIn);
+}
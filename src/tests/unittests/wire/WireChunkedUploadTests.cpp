@@ -0,0 +1,275 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireServer.h"
+
+#include <limits>
+#include <vector>
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    // A small client->server buffer so that uploads have to be split in multiple chunks.
+    constexpr size_t kC2sBufferSize = 256;
+    constexpr uint64_t kBufferSize = 4096;
+
+    // Fills |data| with a pattern that makes misplaced chunks detectable.
+    void FillPattern(std::vector<uint8_t>* data) {
+        for (size_t i = 0; i < data->size(); ++i) {
+            (*data)[i] = static_cast<uint8_t>(i * 7 + i / 256);
+        }
+    }
+
+}  // anonymous namespace
+
+class WireChunkedUploadTests : public WireTest {
+  public:
+    WireChunkedUploadTests() {
+    }
+    ~WireChunkedUploadTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        DawnBufferDescriptor descriptor;
+        descriptor.nextInChain = nullptr;
+        descriptor.label = nullptr;
+        descriptor.size = kBufferSize;
+
+        apiBuffer = api.GetNewBuffer();
+        buffer = dawnDeviceCreateBuffer(device, &descriptor);
+
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _))
+            .WillOnce(Return(apiBuffer))
+            .RetiresOnSaturation();
+        FlushClient();
+    }
+
+  protected:
+    DawnBuffer buffer;
+    DawnBuffer apiBuffer;
+
+  private:
+    size_t GetC2sBufferSize() override {
+        return kC2sBufferSize;
+    }
+};
+
+// Test that a SetSubData that fits in the client->server buffer is sent as a single command.
+TEST_F(WireChunkedUploadTests, SmallSetSubDataIsNotChunked) {
+    std::vector<uint8_t> data(64);
+    FillPattern(&data);
+
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, 16, 64, _))
+        .WillOnce(Invoke([&](DawnBuffer, uint64_t, uint64_t count, const void* apiData) {
+            ASSERT_EQ(0, memcmp(apiData, data.data(), count));
+        }));
+
+    dawnBufferSetSubData(buffer, 16, data.size(), data.data());
+    FlushClient();
+}
+
+// Test that a SetSubData larger than the client->server buffer is split in bounded chunks that
+// are reassembled by the server and applied to the destination buffer at once.
+TEST_F(WireChunkedUploadTests, LargeSetSubDataIsChunked) {
+    constexpr uint64_t kStart = 8;
+    std::vector<uint8_t> data(kBufferSize - kStart);
+    FillPattern(&data);
+    ASSERT_GT(data.size(), kC2sBufferSize);
+
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, kStart, data.size(), _))
+        .WillOnce(Invoke([&](DawnBuffer, uint64_t, uint64_t count, const void* apiData) {
+            ASSERT_EQ(0, memcmp(apiData, data.data(), count));
+        }));
+
+    // The client->server buffer is flushed while chunks are serialized so expectations must be
+    // set before the call.
+    dawnBufferSetSubData(buffer, kStart, data.size(), data.data());
+    FlushClient();
+}
+
+// Test that a large SetSubData is validated as a whole by the device, so that an invalid one
+// produces a single error and isn't partially applied.
+TEST_F(WireChunkedUploadTests, LargeSetSubDataIsValidatedOnce) {
+    std::vector<uint8_t> data(kBufferSize);
+
+    // Out of range: the error is generated by the device for the whole SetSubData.
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, 4, kBufferSize, _)).Times(1);
+
+    dawnBufferSetSubData(buffer, 4, data.size(), data.data());
+    FlushClient();
+}
+
+// Test that consecutive large SetSubData are reassembled separately.
+TEST_F(WireChunkedUploadTests, ConsecutiveLargeSetSubData) {
+    std::vector<uint8_t> first(kBufferSize / 2);
+    std::vector<uint8_t> second(kBufferSize / 2);
+    FillPattern(&first);
+    std::fill(second.begin(), second.end(), 42);
+
+    InSequence s;
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, 0, first.size(), _))
+        .WillOnce(Invoke([&](DawnBuffer, uint64_t, uint64_t count, const void* apiData) {
+            ASSERT_EQ(0, memcmp(apiData, first.data(), count));
+        }));
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, first.size(), second.size(), _))
+        .WillOnce(Invoke([&](DawnBuffer, uint64_t, uint64_t count, const void* apiData) {
+            ASSERT_EQ(0, memcmp(apiData, second.data(), count));
+        }));
+
+    dawnBufferSetSubData(buffer, 0, first.size(), first.data());
+    dawnBufferSetSubData(buffer, first.size(), second.size(), second.data());
+    FlushClient();
+}
+
+// Test that flushing the writes of a large CreateBufferMapped is chunked and reassembled directly
+// in the server-side mapping.
+TEST_F(WireChunkedUploadTests, LargeCreateBufferMappedFlushIsChunked) {
+    DawnBufferDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.label = nullptr;
+    descriptor.size = kBufferSize;
+
+    std::vector<uint8_t> apiMapping(kBufferSize, 0);
+    DawnBuffer apiMappedBuffer = api.GetNewBuffer();
+    DawnCreateBufferMappedResult apiResult;
+    apiResult.buffer = apiMappedBuffer;
+    apiResult.data = apiMapping.data();
+    apiResult.dataLength = kBufferSize;
+
+    DawnCreateBufferMappedResult result = dawnDeviceCreateBufferMapped(device, &descriptor);
+    ASSERT_NE(nullptr, result.data);
+    ASSERT_EQ(kBufferSize, result.dataLength);
+
+    EXPECT_CALL(api, DeviceCreateBufferMapped(apiDevice, _))
+        .WillOnce(Return(apiResult))
+        .RetiresOnSaturation();
+    FlushClient();
+
+    std::vector<uint8_t> data(kBufferSize);
+    FillPattern(&data);
+    memcpy(result.data, data.data(), data.size());
+
+    EXPECT_CALL(api, BufferUnmap(apiMappedBuffer)).Times(1);
+    dawnBufferUnmap(result.buffer);
+    FlushClient();
+
+    EXPECT_EQ(apiMapping, data);
+}
+
+namespace {
+
+    // A server WriteHandle that only implements DeserializeFlush to check the default chunk
+    // reassembly.
+    class RecordingWriteHandle : public server::MemoryTransferService::WriteHandle {
+      public:
+        bool DeserializeFlush(const void* deserializePointer, size_t deserializeSize) override {
+            const uint8_t* data = static_cast<const uint8_t*>(deserializePointer);
+            flushes.emplace_back(data, data + deserializeSize);
+            return true;
+        }
+
+        size_t GetMaxFlushInfoSize() const override {
+            return maxFlushInfoSize != 0 ? maxFlushInfoSize : WriteHandle::GetMaxFlushInfoSize();
+        }
+
+        std::vector<std::vector<uint8_t>> flushes;
+        size_t maxFlushInfoSize = 0;
+    };
+
+}  // anonymous namespace
+
+// Test that the default DeserializeFlushChunk reassembles in-order chunks and flushes once.
+TEST(WireFlushChunkTests, DefaultReassemblesInOrderChunks) {
+    std::vector<uint8_t> data(100);
+    FillPattern(&data);
+
+    std::vector<uint8_t> target(data.size());
+    RecordingWriteHandle handle;
+    handle.SetTarget(target.data(), target.size());
+    ASSERT_TRUE(handle.DeserializeFlushChunk(data.data(), 40, 0, data.size()));
+    ASSERT_TRUE(handle.DeserializeFlushChunk(data.data() + 40, 40, 40, data.size()));
+    ASSERT_TRUE(handle.flushes.empty());
+    ASSERT_TRUE(handle.DeserializeFlushChunk(data.data() + 80, 20, 80, data.size()));
+
+    ASSERT_EQ(1u, handle.flushes.size());
+    EXPECT_EQ(data, handle.flushes[0]);
+}
+
+// Test that the default DeserializeFlushChunk rejects chunks that are out of order, have an
+// inconsistent total size, overflow it, or a total size larger than the target.
+TEST(WireFlushChunkTests, DefaultRejectsInvalidChunks) {
+    std::vector<uint8_t> data(100);
+    std::vector<uint8_t> target(data.size());
+
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        ASSERT_TRUE(handle.DeserializeFlushChunk(data.data(), 40, 0, data.size()));
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 40, 60, data.size()));
+    }
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 40, 40, data.size()));
+    }
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        ASSERT_TRUE(handle.DeserializeFlushChunk(data.data(), 40, 0, data.size()));
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 40, 40, data.size() + 1));
+    }
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 101, 0, data.size()));
+    }
+    {
+        // The total size is checked before anything is allocated for it.
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 40, 0,
+                                                  std::numeric_limits<size_t>::max()));
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 40, 0, target.size() + 1));
+    }
+}
+
+// Test that the default DeserializeFlushChunk bounds the total size by the limit declared by the
+// handle instead of the size of the target.
+TEST(WireFlushChunkTests, DefaultUsesDeclaredMaxFlushInfoSize) {
+    constexpr size_t kHeaderSize = 8;
+    std::vector<uint8_t> data(100 + kHeaderSize);
+    FillPattern(&data);
+    std::vector<uint8_t> target(100);
+
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        handle.maxFlushInfoSize = data.size();
+        ASSERT_TRUE(handle.DeserializeFlushChunk(data.data(), 60, 0, data.size()));
+        ASSERT_TRUE(handle.DeserializeFlushChunk(data.data() + 60, 48, 60, data.size()));
+        ASSERT_EQ(1u, handle.flushes.size());
+        EXPECT_EQ(data, handle.flushes[0]);
+    }
+    {
+        RecordingWriteHandle handle;
+        handle.SetTarget(target.data(), target.size());
+        handle.maxFlushInfoSize = data.size();
+        EXPECT_FALSE(handle.DeserializeFlushChunk(data.data(), 60, 0, data.size() + 1));
+    }
+}
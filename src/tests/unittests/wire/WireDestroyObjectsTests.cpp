@@ -0,0 +1,189 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireCmd_autogen.h"
+#include "dawn_wire/WireServer.h"
+
+#include <vector>
+
+using namespace testing;
+using namespace dawn_wire;
+
+class WireDestroyObjectsTests : public WireTest {
+  public:
+    WireDestroyObjectsTests() {
+    }
+    ~WireDestroyObjectsTests() override = default;
+
+  protected:
+    // Creates |count| command encoders on the client and the matching API objects.
+    void CreateEncoders(size_t count,
+                        std::vector<DawnCommandEncoder>* encoders,
+                        std::vector<DawnCommandEncoder>* apiEncoders) {
+        for (size_t i = 0; i < count; ++i) {
+            encoders->push_back(dawnDeviceCreateCommandEncoder(device, nullptr));
+            apiEncoders->push_back(api.GetNewCommandEncoder());
+        }
+
+        Sequence s;
+        for (DawnCommandEncoder apiEncoder : *apiEncoders) {
+            EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+                .InSequence(s)
+                .WillOnce(Return(apiEncoder));
+        }
+        FlushClient();
+    }
+
+    // Sends a DestroyObjects command directly to the server and returns whether it succeeded.
+    bool HandleDestroyObjects(ObjectType objectType, const std::vector<ObjectId>& ids) {
+        DestroyObjectsCmd cmd;
+        cmd.objectType = objectType;
+        cmd.objectCount = static_cast<uint32_t>(ids.size());
+        cmd.objectIds = ids.data();
+
+        std::vector<char> buffer(cmd.GetRequiredSize());
+        cmd.Serialize(buffer.data());
+        return GetWireServer()->HandleCommands(buffer.data(), buffer.size()) != nullptr;
+    }
+
+  private:
+    bool CoalesceReleases() override {
+        return true;
+    }
+};
+
+// Test that the releases of several objects all reach the server on flush.
+TEST_F(WireDestroyObjectsTests, ReleasesAreCoalesced) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(3, &encoders, &apiEncoders);
+
+    for (DawnCommandEncoder encoder : encoders) {
+        dawnCommandEncoderRelease(encoder);
+    }
+    for (DawnCommandEncoder apiEncoder : apiEncoders) {
+        EXPECT_CALL(api, CommandEncoderRelease(apiEncoder)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that pending releases are serialized before the next command.
+TEST_F(WireDestroyObjectsTests, ReleasesAreSerializedBeforeNextCommand) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(2, &encoders, &apiEncoders);
+
+    dawnCommandEncoderRelease(encoders[0]);
+    dawnCommandEncoderInsertDebugMarker(encoders[1], "marker");
+
+    InSequence s;
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[0])).Times(1);
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoders[1], StrEq("marker"))).Times(1);
+    FlushClient();
+}
+
+// Test that an object created after a release gets a new ID while the release is pending, and
+// that the ID of the released object is reused once its destruction has been serialized.
+TEST_F(WireDestroyObjectsTests, ReleaseThenCreate) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(1, &encoders, &apiEncoders);
+
+    // The server would fail to allocate the new object if it reused the ID of the released
+    // object before the destruction is handled.
+    dawnCommandEncoderRelease(encoders[0]);
+    dawnDeviceCreateCommandEncoder(device, nullptr);
+
+    DawnCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    {
+        InSequence s;
+        EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[0])).Times(1);
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+    }
+    FlushClient();
+
+    // Now the ID of the released object can be reused.
+    encoders.clear();
+    apiEncoders.clear();
+    CreateEncoders(1, &encoders, &apiEncoders);
+}
+
+// Test that releasing more objects than are held back pending still destroys all of them.
+TEST_F(WireDestroyObjectsTests, ManyReleases) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(10000, &encoders, &apiEncoders);
+
+    for (DawnCommandEncoder encoder : encoders) {
+        dawnCommandEncoderRelease(encoder);
+    }
+    for (DawnCommandEncoder apiEncoder : apiEncoders) {
+        EXPECT_CALL(api, CommandEncoderRelease(apiEncoder)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that the server rejects batches containing invalid IDs.
+TEST_F(WireDestroyObjectsTests, ServerRejectsInvalidIds) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(1, &encoders, &apiEncoders);
+
+    // ID 0 is reserved for nullptr.
+    EXPECT_FALSE(HandleDestroyObjects(ObjectType::CommandEncoder, {0}));
+
+    // The ID of a device can't be destroyed through the wire.
+    EXPECT_FALSE(HandleDestroyObjects(ObjectType::Device, {1}));
+
+    // Unknown IDs are an error.
+    EXPECT_FALSE(HandleDestroyObjects(ObjectType::CommandEncoder, {1000}));
+}
+
+// Test that a batch rejected by the server doesn't destroy any of its objects.
+TEST_F(WireDestroyObjectsTests, ServerRejectedBatchDestroysNothing) {
+    std::vector<DawnCommandEncoder> encoders;
+    std::vector<DawnCommandEncoder> apiEncoders;
+    CreateEncoders(2, &encoders, &apiEncoders);
+
+    // The encoders got the first IDs of their type. The invalid ID comes after valid ones, and
+    // an ID present twice is invalid the second time.
+    EXPECT_CALL(api, CommandEncoderRelease(_)).Times(0);
+    EXPECT_FALSE(HandleDestroyObjects(ObjectType::CommandEncoder, {1, 2, 1000}));
+    EXPECT_FALSE(HandleDestroyObjects(ObjectType::CommandEncoder, {1, 2, 1}));
+
+    // Both objects are still known to the server and can be destroyed. These expectations take
+    // precedence over the one above.
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[0])).Times(1);
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoders[1])).Times(1);
+    EXPECT_TRUE(HandleDestroyObjects(ObjectType::CommandEncoder, {1, 2}));
+}
+
+// The default configuration, where releases aren't coalesced.
+class WireImmediateReleaseTests : public WireTest {};
+
+// Test that without coalescing each release reaches the server even when the embedder flushes the
+// serializer directly instead of calling WireClient::Flush.
+TEST_F(WireImmediateReleaseTests, ReleaseIsSerializedImmediately) {
+    DawnCommandEncoder encoder = dawnDeviceCreateCommandEncoder(device, nullptr);
+    DawnCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr)).WillOnce(Return(apiEncoder));
+    FlushClient();
+
+    dawnCommandEncoderRelease(encoder);
+    EXPECT_CALL(api, CommandEncoderRelease(apiEncoder)).Times(1);
+    FlushClientSerializer();
+}
@@ -0,0 +1,451 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireMultiServer.h"
+#include "utils/TerribleCommandBuffer.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    constexpr uint32_t kNumClients = 2;
+
+    class MockDeviceErrorCallback {
+      public:
+        MOCK_METHOD3(Call, void(DawnErrorType type, const char* message, void* userdata));
+    };
+
+    std::unique_ptr<StrictMock<MockDeviceErrorCallback>> mockDeviceErrorCallback;
+    void ToMockDeviceErrorCallback(DawnErrorType type, const char* message, void* userdata) {
+        mockDeviceErrorCallback->Call(type, message, userdata);
+    }
+
+    class MockBufferMapReadCallback {
+      public:
+        MOCK_METHOD4(Call,
+                     void(DawnBufferMapAsyncStatus status,
+                          const void* data,
+                          uint64_t dataLength,
+                          void* userdata));
+    };
+
+    std::unique_ptr<StrictMock<MockBufferMapReadCallback>> mockBufferMapReadCallback;
+    void ToMockBufferMapReadCallback(DawnBufferMapAsyncStatus status,
+                                     const void* data,
+                                     uint64_t dataLength,
+                                     void* userdata) {
+        mockBufferMapReadCallback->Call(status, data, dataLength, userdata);
+    }
+
+}  // anonymous namespace
+
+// Tests for a WireMultiServer hosting several clients. Unlike WireTest the clients are driven
+// through their proc table since there are several of them.
+class WireMultiServerTests : public Test {
+  public:
+    WireMultiServerTests() {
+    }
+    ~WireMultiServerTests() override = default;
+
+    void SetUp() override {
+        DawnProcTable mockProcs;
+        api.GetProcTableAndDevice(&mockProcs, &apiDevice);
+
+        // Only the multi-server sets the device error callback.
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, _, _)).Times(1);
+        EXPECT_CALL(api, DeviceTick(_)).Times(AnyNumber());
+
+        WireMultiServerDescriptor serverDesc = {};
+        serverDesc.device = apiDevice;
+        serverDesc.procs = &mockProcs;
+        serverDesc.clientQuotaPerRound = GetClientQuotaPerRound();
+        mWireServer.reset(new WireMultiServer(serverDesc));
+
+        for (uint32_t i = 0; i < kNumClients; ++i) {
+            mS2cBufs[i] = std::make_unique<utils::TerribleCommandBuffer>();
+            clientIds[i] = mWireServer->AddClient(mS2cBufs[i].get());
+
+            mC2sBufs[i] = std::make_unique<utils::TerribleCommandBuffer>(
+                mWireServer->GetCommandHandler(clientIds[i]));
+
+            WireClientDescriptor clientDesc = {};
+            clientDesc.serializer = mC2sBufs[i].get();
+            mWireClients[i].reset(new WireClient(clientDesc));
+            mS2cBufs[i]->SetHandler(mWireClients[i].get());
+
+            devices[i] = mWireClients[i]->GetDevice();
+        }
+        procs = mWireClients[0]->GetProcs();
+
+        mockDeviceErrorCallback = std::make_unique<StrictMock<MockDeviceErrorCallback>>();
+        mockBufferMapReadCallback = std::make_unique<StrictMock<MockBufferMapReadCallback>>();
+    }
+
+    void TearDown() override {
+        api.IgnoreAllReleaseCalls();
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(apiDevice, nullptr, nullptr))
+            .Times(1);
+
+        for (uint32_t i = 0; i < kNumClients; ++i) {
+            mWireClients[i] = nullptr;
+        }
+        mWireServer = nullptr;
+        mockDeviceErrorCallback = nullptr;
+        mockBufferMapReadCallback = nullptr;
+    }
+
+    void FlushClient(uint32_t client) {
+        ASSERT_TRUE(mWireClients[client]->Flush());
+    }
+
+    void FlushServer(uint32_t client) {
+        ASSERT_TRUE(mS2cBufs[client]->Flush());
+    }
+
+    void HandleAllQueuedCommands() {
+        while (mWireServer->HandleQueuedCommands()) {
+        }
+        Mock::VerifyAndClearExpectations(&api);
+        EXPECT_CALL(api, DeviceTick(_)).Times(AnyNumber());
+    }
+
+    // Creates a command encoder on |client| and makes the server return |apiEncoder| for it.
+    DawnCommandEncoder CreateEncoder(uint32_t client, DawnCommandEncoder apiEncoder) {
+        DawnCommandEncoder encoder = procs.deviceCreateCommandEncoder(devices[client], nullptr);
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder))
+            .RetiresOnSaturation();
+        FlushClient(client);
+        HandleAllQueuedCommands();
+        return encoder;
+    }
+
+    testing::StrictMock<MockProcTable> api;
+    DawnDevice apiDevice;
+    DawnProcTable procs;
+    uint32_t clientIds[kNumClients];
+    DawnDevice devices[kNumClients];
+
+  protected:
+    WireMultiServer* GetWireServer() {
+        return mWireServer.get();
+    }
+
+  private:
+    virtual size_t GetClientQuotaPerRound() {
+        return WireMultiServerDescriptor().clientQuotaPerRound;
+    }
+
+    std::unique_ptr<WireMultiServer> mWireServer;
+    std::unique_ptr<utils::TerribleCommandBuffer> mS2cBufs[kNumClients];
+    std::unique_ptr<utils::TerribleCommandBuffer> mC2sBufs[kNumClients];
+    std::unique_ptr<WireClient> mWireClients[kNumClients];
+};
+
+// Test that the commands of a client are only handled when the server handles its queues.
+TEST_F(WireMultiServerTests, CommandsAreQueued) {
+    procs.deviceCreateCommandEncoder(devices[0], nullptr);
+    FlushClient(0);
+    EXPECT_TRUE(GetWireServer()->HasQueuedCommands(clientIds[0]));
+    EXPECT_FALSE(GetWireServer()->HasQueuedCommands(clientIds[1]));
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(api.GetNewCommandEncoder()));
+    HandleAllQueuedCommands();
+    EXPECT_FALSE(GetWireServer()->HasQueuedCommands(clientIds[0]));
+}
+
+// Test that clients have their own object namespaces even though the client-side IDs collide.
+TEST_F(WireMultiServerTests, ClientsHaveSeparateNamespaces) {
+    DawnCommandEncoder apiEncoders[kNumClients];
+    DawnCommandEncoder encoders[kNumClients];
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        apiEncoders[i] = api.GetNewCommandEncoder();
+        encoders[i] = CreateEncoder(i, apiEncoders[i]);
+    }
+
+    for (uint32_t i = kNumClients; i > 0; --i) {
+        procs.commandEncoderFinish(encoders[i - 1], nullptr);
+        FlushClient(i - 1);
+    }
+
+    InSequence s;
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        EXPECT_CALL(api, CommandEncoderFinish(apiEncoders[i], nullptr))
+            .WillOnce(Return(api.GetNewCommandBuffer()));
+    }
+    HandleAllQueuedCommands();
+}
+
+// Test that uncaptured errors are sent to the client whose commands are being handled, and to all
+// clients when they happen outside of the handling of commands.
+TEST_F(WireMultiServerTests, UncapturedErrorRouting) {
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        procs.deviceSetUncapturedErrorCallback(devices[i], ToMockDeviceErrorCallback,
+                                               reinterpret_cast<void*>(uintptr_t(i + 1)));
+    }
+
+    procs.deviceCreateCommandEncoder(devices[1], nullptr);
+    FlushClient(1);
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallDeviceErrorCallback(apiDevice, DAWN_ERROR_TYPE_VALIDATION, "Client error");
+            return api.GetNewCommandEncoder();
+        }));
+    HandleAllQueuedCommands();
+
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(DAWN_ERROR_TYPE_VALIDATION, StrEq("Client error"), reinterpret_cast<void*>(2)))
+        .Times(1);
+    FlushServer(0);
+    FlushServer(1);
+    Mock::VerifyAndClearExpectations(mockDeviceErrorCallback.get());
+
+    api.CallDeviceErrorCallback(apiDevice, DAWN_ERROR_TYPE_OUT_OF_MEMORY, "Device error");
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        EXPECT_CALL(*mockDeviceErrorCallback,
+                    Call(DAWN_ERROR_TYPE_OUT_OF_MEMORY, StrEq("Device error"),
+                         reinterpret_cast<void*>(uintptr_t(i + 1))))
+            .Times(1);
+        FlushServer(i);
+    }
+}
+
+// Test that a client sending invalid commands is lost without affecting the other clients.
+TEST_F(WireMultiServerTests, InvalidCommandsLoseOnlyTheClient) {
+    const char kGarbage[] = "not a wire command";
+    CommandHandler* handler = GetWireServer()->GetCommandHandler(clientIds[0]);
+    ASSERT_NE(nullptr, handler->HandleCommands(kGarbage, sizeof(kGarbage)));
+
+    procs.deviceCreateCommandEncoder(devices[1], nullptr);
+    FlushClient(1);
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(api.GetNewCommandEncoder()));
+    HandleAllQueuedCommands();
+
+    EXPECT_TRUE(GetWireServer()->IsClientLost(clientIds[0]));
+    EXPECT_FALSE(GetWireServer()->IsClientLost(clientIds[1]));
+    EXPECT_EQ(nullptr, handler->HandleCommands(kGarbage, sizeof(kGarbage)));
+}
+
+// Test that the commands of the other clients wait while a client has an error scope open, so that
+// the scope only captures the errors of that client.
+TEST_F(WireMultiServerTests, ErrorScopesAreNotInterleaved) {
+    procs.devicePushErrorScope(devices[0], DAWN_ERROR_FILTER_VALIDATION);
+    FlushClient(0);
+    procs.deviceCreateCommandEncoder(devices[1], nullptr);
+    FlushClient(1);
+
+    EXPECT_CALL(api, DevicePushErrorScope(apiDevice, DAWN_ERROR_FILTER_VALIDATION)).Times(1);
+    HandleAllQueuedCommands();
+    EXPECT_TRUE(GetWireServer()->HasQueuedCommands(clientIds[1]));
+
+    // Errors outside of the batches go to the client with the scope open.
+    api.CallDeviceErrorCallback(apiDevice, DAWN_ERROR_TYPE_OUT_OF_MEMORY, "Scoped error");
+    procs.deviceSetUncapturedErrorCallback(devices[0], ToMockDeviceErrorCallback, nullptr);
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(DAWN_ERROR_TYPE_OUT_OF_MEMORY, StrEq("Scoped error"), nullptr))
+        .Times(1);
+    FlushServer(0);
+    FlushServer(1);
+    Mock::VerifyAndClearExpectations(mockDeviceErrorCallback.get());
+
+    procs.devicePopErrorScope(devices[0], ToMockDeviceErrorCallback, this);
+    FlushClient(0);
+
+    DawnErrorCallback popCallback = nullptr;
+    void* popUserdata = nullptr;
+    {
+        InSequence s;
+        EXPECT_CALL(api, OnDevicePopErrorScopeCallback(apiDevice, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&popCallback), SaveArg<2>(&popUserdata), Return(true)));
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(api.GetNewCommandEncoder()));
+    }
+    HandleAllQueuedCommands();
+    EXPECT_FALSE(GetWireServer()->HasQueuedCommands(clientIds[1]));
+
+    popCallback(DAWN_ERROR_TYPE_NO_ERROR, "", popUserdata);
+    EXPECT_CALL(*mockDeviceErrorCallback, Call(DAWN_ERROR_TYPE_NO_ERROR, StrEq(""), this)).Times(1);
+    FlushServer(0);
+}
+
+// Test that removing a client that has an error scope open pops the scope, and lets the other
+// clients use the device.
+TEST_F(WireMultiServerTests, RemoveClientWithOpenErrorScope) {
+    procs.devicePushErrorScope(devices[0], DAWN_ERROR_FILTER_VALIDATION);
+    FlushClient(0);
+    procs.deviceCreateCommandEncoder(devices[1], nullptr);
+    FlushClient(1);
+
+    EXPECT_CALL(api, DevicePushErrorScope(apiDevice, DAWN_ERROR_FILTER_VALIDATION)).Times(1);
+    HandleAllQueuedCommands();
+
+    api.IgnoreAllReleaseCalls();
+    EXPECT_CALL(api, OnDevicePopErrorScopeCallback(apiDevice, _, _)).WillOnce(Return(true));
+    GetWireServer()->RemoveClient(clientIds[0]);
+
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(api.GetNewCommandEncoder()));
+    HandleAllQueuedCommands();
+}
+
+// Test that removing a client with a fence signal and an error scope still pending on the device
+// is safe, and that the pending callbacks are dropped when they are called afterwards.
+TEST_F(WireMultiServerTests, RemoveClientWithPendingCallbacks) {
+    DawnQueue queue = procs.deviceCreateQueue(devices[0]);
+    DawnQueue apiQueue = api.GetNewQueue();
+    EXPECT_CALL(api, DeviceCreateQueue(apiDevice)).WillOnce(Return(apiQueue));
+
+    DawnFenceDescriptor fenceDesc = {};
+    fenceDesc.initialValue = 0;
+    DawnFence fence = procs.queueCreateFence(queue, &fenceDesc);
+    DawnFence apiFence = api.GetNewFence();
+    EXPECT_CALL(api, QueueCreateFence(apiQueue, _)).WillOnce(Return(apiFence));
+
+    procs.queueSignal(queue, fence, 1u);
+    EXPECT_CALL(api, QueueSignal(apiQueue, apiFence, 1u)).Times(1);
+    EXPECT_CALL(api, OnFenceOnCompletionCallback(apiFence, 1u, _, _)).Times(1);
+
+    DawnErrorCallback popCallback = nullptr;
+    void* popUserdata = nullptr;
+    procs.devicePushErrorScope(devices[0], DAWN_ERROR_FILTER_VALIDATION);
+    procs.devicePopErrorScope(devices[0], ToMockDeviceErrorCallback, nullptr);
+    EXPECT_CALL(api, DevicePushErrorScope(apiDevice, DAWN_ERROR_FILTER_VALIDATION)).Times(1);
+    EXPECT_CALL(api, OnDevicePopErrorScopeCallback(apiDevice, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&popCallback), SaveArg<2>(&popUserdata), Return(true)));
+
+    FlushClient(0);
+    HandleAllQueuedCommands();
+    ASSERT_NE(nullptr, popCallback);
+
+    api.IgnoreAllReleaseCalls();
+    GetWireServer()->RemoveClient(clientIds[0]);
+
+    // The device completes the work of the removed client. Nothing is sent to the client.
+    api.CallFenceOnCompletionCallback(apiFence, DAWN_FENCE_COMPLETION_STATUS_SUCCESS);
+    popCallback(DAWN_ERROR_TYPE_NO_ERROR, "", popUserdata);
+    FlushServer(0);
+
+    // The error scope of the removed client is never resolved by the server so it is rejected
+    // when the client is destroyed.
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(DAWN_ERROR_TYPE_UNKNOWN, StrEq("Device destroyed"), nullptr))
+        .Times(1);
+}
+
+// Test that removing a client while one of its buffers is being mapped is safe, and that the map
+// callback is dropped when the device calls it afterwards.
+TEST_F(WireMultiServerTests, RemoveClientWithPendingMap) {
+    DawnBufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = DAWN_BUFFER_USAGE_MAP_READ;
+    DawnBuffer buffer = procs.deviceCreateBuffer(devices[0], &descriptor);
+    DawnBuffer apiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+
+    procs.bufferMapReadAsync(buffer, ToMockBufferMapReadCallback, nullptr);
+    EXPECT_CALL(api, OnBufferMapReadAsyncCallback(apiBuffer, _, _)).Times(1);
+
+    FlushClient(0);
+    HandleAllQueuedCommands();
+
+    // The backend keeps the buffer alive until the map completes, after the client is removed.
+    api.IgnoreAllReleaseCalls();
+    GetWireServer()->RemoveClient(clientIds[0]);
+
+    uint32_t bufferContent = 31337;
+    api.CallMapReadCallback(apiBuffer, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, &bufferContent,
+                            sizeof(bufferContent));
+    FlushServer(0);
+
+    // The map request of the removed client is never resolved by the server so it is rejected
+    // when the client is destroyed.
+    EXPECT_CALL(*mockBufferMapReadCallback,
+                Call(DAWN_BUFFER_MAP_ASYNC_STATUS_UNKNOWN, nullptr, 0u, nullptr))
+        .Times(1);
+}
+
+namespace {
+
+    // Each batch in the scheduling tests is a single CommandEncoderInsertDebugMarker whose size
+    // is dominated by the marker.
+    constexpr size_t kMarkerLength = 1000;
+
+}  // anonymous namespace
+
+class WireMultiServerSchedulingTests : public WireMultiServerTests {
+  private:
+    // Enough for a single batch per round.
+    size_t GetClientQuotaPerRound() override {
+        return kMarkerLength + 100;
+    }
+};
+
+// Test that a client with a lot of queued commands doesn't delay the commands of another client
+// by more than one quota.
+TEST_F(WireMultiServerSchedulingTests, BusyClientDoesNotStarveOthers) {
+    constexpr uint32_t kBusyBatches = 5;
+
+    DawnCommandEncoder apiEncoders[kNumClients];
+    DawnCommandEncoder encoders[kNumClients];
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        apiEncoders[i] = api.GetNewCommandEncoder();
+        encoders[i] = CreateEncoder(i, apiEncoders[i]);
+    }
+
+    std::string marker(kMarkerLength, 'a');
+    for (uint32_t i = 0; i < kBusyBatches; ++i) {
+        procs.commandEncoderInsertDebugMarker(encoders[0], marker.c_str());
+        FlushClient(0);
+    }
+    procs.commandEncoderInsertDebugMarker(encoders[1], marker.c_str());
+    FlushClient(1);
+
+    // The first round handles one batch of each client.
+    {
+        InSequence s;
+        EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoders[0], _)).Times(1);
+        EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoders[1], _)).Times(1);
+    }
+    EXPECT_TRUE(GetWireServer()->HandleQueuedCommands());
+    Mock::VerifyAndClearExpectations(&api);
+    EXPECT_CALL(api, DeviceTick(_)).Times(AnyNumber());
+    EXPECT_FALSE(GetWireServer()->HasQueuedCommands(clientIds[1]));
+
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoders[0], _)).Times(kBusyBatches - 1);
+    HandleAllQueuedCommands();
+}
+
+// Test that a batch bigger than the quota is handled after accumulating the quota of several
+// rounds.
+TEST_F(WireMultiServerSchedulingTests, BigBatchAccumulatesQuota) {
+    DawnCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    DawnCommandEncoder encoder = CreateEncoder(0, apiEncoder);
+
+    std::string marker(3 * kMarkerLength, 'a');
+    procs.commandEncoderInsertDebugMarker(encoder, marker.c_str());
+    FlushClient(0);
+
+    EXPECT_TRUE(GetWireServer()->HandleQueuedCommands());
+    EXPECT_TRUE(GetWireServer()->HandleQueuedCommands());
+
+    EXPECT_CALL(api, CommandEncoderInsertDebugMarker(apiEncoder, _)).Times(1);
+    HandleAllQueuedCommands();
+}
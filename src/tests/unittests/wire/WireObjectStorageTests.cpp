@@ -0,0 +1,139 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_wire/server/ObjectStorage.h"
+
+#include <map>
+
+using namespace dawn_wire;
+using namespace dawn_wire::server;
+
+namespace {
+
+    DawnBuffer FakeBuffer(uintptr_t index) {
+        // Use pointer-like values so that hashing sees the same low bits as real handles.
+        return reinterpret_cast<DawnBuffer>((index + 1) * 16);
+    }
+
+}  // anonymous namespace
+
+// Test allocating, getting and freeing IDs in KnownObjects.
+TEST(WireObjectStorageTests, KnownObjectsAllocateAndFree) {
+    KnownObjects<DawnBuffer> known;
+
+    // ID 0 is reserved and isn't allocated initially.
+    EXPECT_EQ(nullptr, known.Get(0));
+
+    // IDs can only be allocated one past the end.
+    EXPECT_EQ(nullptr, known.Allocate(2));
+    ASSERT_NE(nullptr, known.Allocate(1));
+    EXPECT_EQ(nullptr, known.Allocate(1));
+    EXPECT_NE(nullptr, known.Get(1));
+    EXPECT_EQ(nullptr, known.Get(2));
+
+    // Freed IDs can be reallocated.
+    known.Free(1);
+    EXPECT_EQ(nullptr, known.Get(1));
+    ASSERT_NE(nullptr, known.Allocate(1));
+    EXPECT_NE(nullptr, known.Get(1));
+}
+
+// Test that KnownObjects lookups with a serial fail when the ID was reused.
+TEST(WireObjectStorageTests, KnownObjectsSerialCheck) {
+    KnownObjects<DawnBuffer> known;
+
+    auto* data = known.Allocate(1);
+    ASSERT_NE(nullptr, data);
+    data->serial = 3;
+
+    EXPECT_EQ(data, known.Get(1, 3));
+    EXPECT_EQ(nullptr, known.Get(1, 2));
+
+    known.Free(1);
+    EXPECT_EQ(nullptr, known.Get(1, 3));
+
+    data = known.Allocate(1);
+    ASSERT_NE(nullptr, data);
+    data->serial = 4;
+    EXPECT_EQ(nullptr, known.Get(1, 3));
+    EXPECT_EQ(data, known.Get(1, 4));
+}
+
+// Test that AcquireAllHandles returns the non-null handles of allocated IDs only.
+TEST(WireObjectStorageTests, KnownObjectsAcquireAllHandles) {
+    KnownObjects<DawnBuffer> known;
+
+    known.Allocate(1)->handle = FakeBuffer(1);
+    known.Allocate(2)->handle = FakeBuffer(2);
+    known.Allocate(3)->handle = nullptr;
+    known.Free(2);
+
+    std::vector<DawnBuffer> handles = known.AcquireAllHandles();
+    ASSERT_EQ(1u, handles.size());
+    EXPECT_EQ(FakeBuffer(1), handles[0]);
+
+    EXPECT_EQ(nullptr, known.Get(1));
+    EXPECT_TRUE(known.AcquireAllHandles().empty());
+}
+
+// Test basic usage of ObjectIdLookupTable.
+TEST(WireObjectStorageTests, LookupTableBasic) {
+    ObjectIdLookupTable<DawnBuffer> table;
+
+    // Lookups in an empty table and of nullptr return the 0 ID.
+    EXPECT_EQ(0u, table.Get(FakeBuffer(0)));
+    EXPECT_EQ(0u, table.Get(nullptr));
+    table.Remove(FakeBuffer(0));
+
+    table.Store(FakeBuffer(0), 1);
+    table.Store(FakeBuffer(1), 2);
+    EXPECT_EQ(1u, table.Get(FakeBuffer(0)));
+    EXPECT_EQ(2u, table.Get(FakeBuffer(1)));
+
+    // Storing an existing key overwrites its ID.
+    table.Store(FakeBuffer(0), 3);
+    EXPECT_EQ(3u, table.Get(FakeBuffer(0)));
+
+    table.Remove(FakeBuffer(0));
+    EXPECT_EQ(0u, table.Get(FakeBuffer(0)));
+    EXPECT_EQ(2u, table.Get(FakeBuffer(1)));
+}
+
+// Test ObjectIdLookupTable against std::map with interleaved insertions and removals that cause
+// growth and shifting of probe sequences.
+TEST(WireObjectStorageTests, LookupTableMatchesMap) {
+    ObjectIdLookupTable<DawnBuffer> table;
+    std::map<DawnBuffer, ObjectId> reference;
+
+    constexpr uint32_t kKeyCount = 2000;
+    for (uint32_t i = 0; i < kKeyCount; ++i) {
+        table.Store(FakeBuffer(i), i + 1);
+        reference[FakeBuffer(i)] = i + 1;
+
+        // Remove a pseudo-random previous key every other iteration.
+        if (i % 2 == 1) {
+            DawnBuffer removed = FakeBuffer((i * 7919) % i);
+            table.Remove(removed);
+            reference.erase(removed);
+        }
+    }
+
+    for (uint32_t i = 0; i < kKeyCount; ++i) {
+        auto it = reference.find(FakeBuffer(i));
+        ObjectId expected = it == reference.end() ? 0 : it->second;
+        ASSERT_EQ(expected, table.Get(FakeBuffer(i)));
+    }
+}
@@ -35,6 +35,14 @@ server::MemoryTransferService* WireTest::GetServerMemoryTransferService() {
     return nullptr;
 }
 
+size_t WireTest::GetC2sBufferSize() {
+    return utils::TerribleCommandBuffer::kDefaultBufferSize;
+}
+
+bool WireTest::CoalesceReleases() {
+    return false;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     DawnDevice mockDevice;
@@ -45,7 +53,8 @@ void WireTest::SetUp() {
     SetupIgnoredCallExpectations();
 
     mS2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
-    mC2sBuf = std::make_unique<utils::TerribleCommandBuffer>(mWireServer.get());
+    mC2sBuf =
+        std::make_unique<utils::TerribleCommandBuffer>(mWireServer.get(), GetC2sBufferSize());
 
     WireServerDescriptor serverDesc = {};
     serverDesc.device = mockDevice;
@@ -59,6 +68,7 @@ void WireTest::SetUp() {
     WireClientDescriptor clientDesc = {};
     clientDesc.serializer = mC2sBuf.get();
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
+    clientDesc.coalesceReleases = CoalesceReleases();
 
     mWireClient.reset(new WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
@@ -83,7 +93,14 @@ void WireTest::TearDown() {
 }
 
 void WireTest::FlushClient(bool success) {
-    ASSERT_EQ(mC2sBuf->Flush(), success);
+    ASSERT_EQ(mWireClient->Flush(), success);
+
+    Mock::VerifyAndClearExpectations(&api);
+    SetupIgnoredCallExpectations();
+}
+
+void WireTest::FlushClientSerializer() {
+    ASSERT_TRUE(mC2sBuf->Flush());
 
     Mock::VerifyAndClearExpectations(&api);
     SetupIgnoredCallExpectations();
@@ -120,6 +120,8 @@ class WireTest : public testing::Test {
 
     void FlushClient(bool success = true);
     void FlushServer(bool success = true);
+    // Flushes the client->server serializer without going through WireClient::Flush.
+    void FlushClientSerializer();
 
     testing::StrictMock<MockProcTable> api;
     DawnDevice apiDevice;
@@ -135,6 +137,8 @@ class WireTest : public testing::Test {
 
     virtual dawn_wire::client::MemoryTransferService* GetClientMemoryTransferService();
     virtual dawn_wire::server::MemoryTransferService* GetServerMemoryTransferService();
+    virtual size_t GetC2sBufferSize();
+    virtual bool CoalesceReleases();
 
     std::unique_ptr<dawn_wire::WireServer> mWireServer;
     std::unique_ptr<dawn_wire::WireClient> mWireClient;
@@ -0,0 +1,301 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_wire/WireTrace.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dawn_wire;
+
+namespace {
+
+    // A serializer that keeps its commands in memory and records the bytes of each flush.
+    class VectorSerializer : public CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            if (mUsed + size > mBuffer.size()) {
+                return nullptr;
+            }
+            char* result = mBuffer.data() + mUsed;
+            mUsed += size;
+            return result;
+        }
+
+        bool Flush() override {
+            flushes.emplace_back(mBuffer.data(), mBuffer.data() + mUsed);
+            mUsed = 0;
+            return flushResult;
+        }
+
+        size_t GetMaximumAllocationSize() const override {
+            return mBuffer.size();
+        }
+
+        std::vector<std::vector<char>> flushes;
+        bool flushResult = true;
+
+      private:
+        std::vector<char> mBuffer = std::vector<char>(1024);
+        size_t mUsed = 0;
+    };
+
+    // Records the commands in |serializer|, each filled with a different byte.
+    void WriteCommands(CommandSerializer* serializer, const std::vector<size_t>& sizes) {
+        for (size_t size : sizes) {
+            char* command = static_cast<char*>(serializer->GetCmdSpace(size));
+            ASSERT_NE(nullptr, command);
+            memset(command, static_cast<int>(size), size);
+        }
+    }
+
+    std::vector<char> ExpectedCommands(const std::vector<size_t>& sizes) {
+        std::vector<char> commands;
+        for (size_t size : sizes) {
+            commands.insert(commands.end(), size, static_cast<char>(size));
+        }
+        return commands;
+    }
+
+    std::vector<char> ReadFile(const std::string& path) {
+        std::vector<char> contents;
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return contents;
+        }
+        char buffer[256];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.insert(contents.end(), buffer, buffer + read);
+        }
+        fclose(file);
+        return contents;
+    }
+
+    void WriteFile(const std::string& path, const char* data, size_t size) {
+        FILE* file = fopen(path.c_str(), "wb");
+        ASSERT_NE(nullptr, file);
+        ASSERT_EQ(size, fwrite(data, 1, size, file));
+        fclose(file);
+    }
+
+}  // anonymous namespace
+
+class WireTraceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+        mPath = testing::TempDir() + "dawn_wire_trace_" + info->name() + ".bin";
+    }
+
+    void TearDown() override {
+        remove(mPath.c_str());
+    }
+
+    // Writes a trace with a client->server batch of three commands followed by a
+    // server->client batch of one command, and returns its contents.
+    std::vector<char> WriteValidTrace() {
+        std::unique_ptr<WireTraceWriter> writer = WireTraceWriter::Create(mPath.c_str());
+        EXPECT_NE(nullptr, writer);
+
+        VectorSerializer c2sSerializer;
+        VectorSerializer s2cSerializer;
+        RecordingCommandSerializer c2sRecorder(&c2sSerializer, writer.get(),
+                                               WireTraceDirection::ClientToServer);
+        RecordingCommandSerializer s2cRecorder(&s2cSerializer, writer.get(),
+                                               WireTraceDirection::ServerToClient);
+
+        WriteCommands(&c2sRecorder, {8, 16, 4});
+        EXPECT_TRUE(c2sRecorder.Flush());
+        WriteCommands(&s2cRecorder, {12});
+        EXPECT_TRUE(s2cRecorder.Flush());
+
+        writer = nullptr;
+        return ReadFile(mPath);
+    }
+
+    std::string mPath;
+};
+
+// Test that the batches recorded by RecordingCommandSerializer are read back in order with their
+// direction and commands.
+TEST_F(WireTraceTests, RoundTrip) {
+    WriteValidTrace();
+
+    std::unique_ptr<WireTraceReader> reader = WireTraceReader::Create(mPath.c_str());
+    ASSERT_NE(nullptr, reader);
+
+    WireTraceBatch batch;
+    ASSERT_TRUE(reader->ReadBatch(&batch));
+    EXPECT_EQ(WireTraceDirection::ClientToServer, batch.direction);
+    EXPECT_EQ(std::vector<uint32_t>({8, 16, 4}), batch.commandSizes);
+    EXPECT_EQ(ExpectedCommands({8, 16, 4}), batch.commands);
+    uint64_t firstTimestamp = batch.timestamp;
+
+    ASSERT_TRUE(reader->ReadBatch(&batch));
+    EXPECT_EQ(WireTraceDirection::ServerToClient, batch.direction);
+    EXPECT_EQ(std::vector<uint32_t>({12}), batch.commandSizes);
+    EXPECT_EQ(ExpectedCommands({12}), batch.commands);
+    EXPECT_GE(batch.timestamp, firstTimestamp);
+
+    EXPECT_FALSE(reader->ReadBatch(&batch));
+    EXPECT_TRUE(reader->IsAtEnd());
+}
+
+// Test that RecordingCommandSerializer forwards the commands and the result of Flush to the
+// wrapped serializer, and doesn't record empty batches.
+TEST_F(WireTraceTests, RecordingForwardsToSerializer) {
+    std::unique_ptr<WireTraceWriter> writer = WireTraceWriter::Create(mPath.c_str());
+    ASSERT_NE(nullptr, writer);
+
+    VectorSerializer serializer;
+    RecordingCommandSerializer recorder(&serializer, writer.get(),
+                                        WireTraceDirection::ClientToServer);
+    EXPECT_EQ(serializer.GetMaximumAllocationSize(), recorder.GetMaximumAllocationSize());
+
+    EXPECT_TRUE(recorder.Flush());
+    WriteCommands(&recorder, {4, 20});
+    serializer.flushResult = false;
+    EXPECT_FALSE(recorder.Flush());
+
+    ASSERT_EQ(2u, serializer.flushes.size());
+    EXPECT_TRUE(serializer.flushes[0].empty());
+    EXPECT_EQ(ExpectedCommands({4, 20}), serializer.flushes[1]);
+
+    writer = nullptr;
+    std::unique_ptr<WireTraceReader> reader = WireTraceReader::Create(mPath.c_str());
+    ASSERT_NE(nullptr, reader);
+
+    WireTraceBatch batch;
+    ASSERT_TRUE(reader->ReadBatch(&batch));
+    EXPECT_EQ(ExpectedCommands({4, 20}), batch.commands);
+    EXPECT_FALSE(reader->ReadBatch(&batch));
+}
+
+// Test that files that aren't wire traces are rejected.
+TEST_F(WireTraceTests, RejectsInvalidFileHeader) {
+    EXPECT_EQ(nullptr, WireTraceReader::Create(mPath.c_str()));
+
+    std::vector<char> trace = WriteValidTrace();
+
+    // Empty or truncated header.
+    WriteFile(mPath, trace.data(), 0);
+    EXPECT_EQ(nullptr, WireTraceReader::Create(mPath.c_str()));
+    WriteFile(mPath, trace.data(), sizeof(WireTraceFileHeader) - 1);
+    EXPECT_EQ(nullptr, WireTraceReader::Create(mPath.c_str()));
+
+    // Wrong magic.
+    std::vector<char> corrupt = trace;
+    corrupt[0] = 'X';
+    WriteFile(mPath, corrupt.data(), corrupt.size());
+    EXPECT_EQ(nullptr, WireTraceReader::Create(mPath.c_str()));
+
+    // Unknown version.
+    corrupt = trace;
+    corrupt[offsetof(WireTraceFileHeader, version)]++;
+    WriteFile(mPath, corrupt.data(), corrupt.size());
+    EXPECT_EQ(nullptr, WireTraceReader::Create(mPath.c_str()));
+}
+
+// Test that a trace truncated anywhere in its first batch is rejected.
+TEST_F(WireTraceTests, RejectsTruncatedBatch) {
+    std::vector<char> trace = WriteValidTrace();
+
+    // The first batch has three commands totalling 28 bytes.
+    size_t batchEnd = sizeof(WireTraceFileHeader) + sizeof(WireTraceBatchHeader) +
+                      3 * sizeof(uint32_t) + 28;
+    ASSERT_LT(batchEnd, trace.size());
+
+    for (size_t size = sizeof(WireTraceFileHeader) + 1; size < batchEnd; ++size) {
+        WriteFile(mPath, trace.data(), size);
+        std::unique_ptr<WireTraceReader> reader = WireTraceReader::Create(mPath.c_str());
+        ASSERT_NE(nullptr, reader);
+
+        WireTraceBatch batch;
+        EXPECT_FALSE(reader->ReadBatch(&batch)) << "Truncated at " << size;
+        EXPECT_FALSE(reader->IsAtEnd()) << "Truncated at " << size;
+    }
+}
+
+// Test that a trace truncated in the header of a batch after a complete one isn't mistaken for
+// the end of the trace.
+TEST_F(WireTraceTests, TruncatedBatchHeaderIsNotTheEnd) {
+    std::vector<char> trace = WriteValidTrace();
+
+    size_t batchEnd = sizeof(WireTraceFileHeader) + sizeof(WireTraceBatchHeader) +
+                      3 * sizeof(uint32_t) + 28;
+    WriteFile(mPath, trace.data(), batchEnd + sizeof(WireTraceBatchHeader) / 2);
+
+    std::unique_ptr<WireTraceReader> reader = WireTraceReader::Create(mPath.c_str());
+    ASSERT_NE(nullptr, reader);
+
+    WireTraceBatch batch;
+    ASSERT_TRUE(reader->ReadBatch(&batch));
+    EXPECT_FALSE(reader->ReadBatch(&batch));
+    EXPECT_FALSE(reader->IsAtEnd());
+}
+
+// Test that batches with an invalid header are rejected.
+TEST_F(WireTraceTests, RejectsCorruptBatch) {
+    std::vector<char> trace = WriteValidTrace();
+    const size_t batchOffset = sizeof(WireTraceFileHeader);
+
+    auto ExpectRejected = [&](const WireTraceBatchHeader& header) {
+        std::vector<char> corrupt = trace;
+        memcpy(corrupt.data() + batchOffset, &header, sizeof(header));
+        WriteFile(mPath, corrupt.data(), corrupt.size());
+
+        std::unique_ptr<WireTraceReader> reader = WireTraceReader::Create(mPath.c_str());
+        ASSERT_NE(nullptr, reader);
+        WireTraceBatch batch;
+        EXPECT_FALSE(reader->ReadBatch(&batch));
+    };
+
+    WireTraceBatchHeader header;
+    memcpy(&header, trace.data() + batchOffset, sizeof(header));
+    ASSERT_EQ(3u, header.commandCount);
+    ASSERT_EQ(28u, header.size);
+
+    // Unknown direction.
+    {
+        WireTraceBatchHeader corrupt = header;
+        corrupt.direction = static_cast<WireTraceDirection>(2);
+        ExpectRejected(corrupt);
+    }
+    // Size that doesn't match the sum of the command sizes.
+    {
+        WireTraceBatchHeader corrupt = header;
+        corrupt.size = 24;
+        ExpectRejected(corrupt);
+    }
+    // More commands than bytes.
+    {
+        WireTraceBatchHeader corrupt = header;
+        corrupt.commandCount = 29;
+        ExpectRejected(corrupt);
+    }
+    // A size too large to be allocated.
+    {
+        WireTraceBatchHeader corrupt = header;
+        corrupt.size = std::numeric_limits<uint64_t>::max();
+        ExpectRejected(corrupt);
+    }
+}
@@ -0,0 +1,158 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/vulkan/CommandBufferVk.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr uint32_t kRTSize = 16;
+    constexpr RGBA8 kRed(255, 0, 0, 255);
+    constexpr RGBA8 kBlue(0, 0, 255, 255);
+
+    class VulkanParallelRecordingTests : public DawnTest {
+      protected:
+        void TestSetUp() override {
+            DawnTest::TestSetUp();
+            if (UsesWire()) {
+                return;
+            }
+
+            // Shaders to draw a bottom-left triangle in blue.
+            dawn::ShaderModule vsModule =
+                utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+                #version 450
+                void main() {
+                    const vec2 pos[3] = vec2[3](
+                        vec2(-1.f, 1.f), vec2(1.f, -1.f), vec2(-1.f, -1.f));
+                    gl_Position = vec4(pos[gl_VertexIndex], 0.f, 1.f);
+                })");
+
+            dawn::ShaderModule fsModule =
+                utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+                #version 450
+                layout(location = 0) out vec4 fragColor;
+                void main() {
+                    fragColor = vec4(0.0, 0.0, 1.0, 1.0);
+                })");
+
+            utils::ComboRenderPipelineDescriptor descriptor(device);
+            descriptor.vertexStage.module = vsModule;
+            descriptor.cFragmentStage.module = fsModule;
+            descriptor.cColorStates[0].format = dawn::TextureFormat::RGBA8Unorm;
+
+            mPipeline = device.CreateRenderPipeline(&descriptor);
+        }
+
+        // Encodes a render pass that clears |renderTarget| to red and draws a blue triangle in
+        // its bottom left, which can be recorded in a secondary command buffer.
+        dawn::CommandBuffer EncodeDrawTo(const utils::BasicRenderPass& renderTarget) {
+            utils::ComboRenderPassDescriptor renderPass({renderTarget.color.CreateView()});
+            renderPass.cColorAttachments[0].clearColor = {1.0f, 0.0f, 0.0f, 1.0f};
+
+            dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.SetPipeline(mPipeline);
+            pass.Draw(3, 1, 0, 0);
+            pass.EndPass();
+            return encoder.Finish();
+        }
+
+        void ExpectDrawTo(const utils::BasicRenderPass& renderTarget) {
+            EXPECT_PIXEL_RGBA8_EQ(kBlue, renderTarget.color, 1, kRTSize - 1);
+            EXPECT_PIXEL_RGBA8_EQ(kRed, renderTarget.color, kRTSize - 1, 1);
+        }
+
+        // Waits for the commands submitted so far to complete, so that the pools of their
+        // secondary command buffers are reset and reused by the next submit.
+        void WaitForSubmittedCommands() {
+            dawn::FenceDescriptor descriptor;
+            descriptor.initialValue = 0u;
+            dawn::Fence fence = queue.CreateFence(&descriptor);
+            queue.Signal(fence, 1);
+            while (fence.GetCompletedValue() < 1u) {
+                WaitABit();
+            }
+        }
+
+        dawn_native::vulkan::CommandBuffer* ToVulkan(const dawn::CommandBuffer& commands) {
+            return reinterpret_cast<dawn_native::vulkan::CommandBuffer*>(commands.Get());
+        }
+
+        dawn::RenderPipeline mPipeline;
+    };
+
+}  // anonymous namespace
+
+// Test that the secondary command buffers a failed submit recorded are discarded, so that a later
+// submit of the command buffer records its render pass again instead of executing them after
+// their pool was reset. A submit fails after recording them when the primary command buffer
+// can't be recorded, which the API can't cause, so this does what the submit does until then.
+TEST_P(VulkanParallelRecordingTests, DiscardedAfterFailedSubmit) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    utils::BasicRenderPass renderTarget = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+    dawn::CommandBuffer commands = EncodeDrawTo(renderTarget);
+    dawn_native::vulkan::CommandBuffer* commandsVk = ToVulkan(commands);
+
+    {
+        dawn_native::MaybeError result = commandsVk->PrepareSecondaryRenderPasses();
+        ASSERT_TRUE(result.IsSuccess());
+    }
+    ASSERT_TRUE(commandsVk->HasSecondaryRenderPasses());
+    {
+        dawn_native::MaybeError result = commandsVk->RecordSecondaryRenderPasses();
+        ASSERT_TRUE(result.IsSuccess());
+    }
+
+    commandsVk->DiscardSecondaryRenderPasses();
+    EXPECT_FALSE(commandsVk->HasSecondaryRenderPasses());
+
+    WaitForSubmittedCommands();
+
+    queue.Submit(1, &commands);
+    ExpectDrawTo(renderTarget);
+}
+
+// Test that a submit executes the secondary command buffers recorded for it only once, so that
+// submitting the same command buffers again records their render passes again.
+TEST_P(VulkanParallelRecordingTests, ResubmittedCommandBuffers) {
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    utils::BasicRenderPass renderTargets[2] = {
+        utils::CreateBasicRenderPass(device, kRTSize, kRTSize),
+        utils::CreateBasicRenderPass(device, kRTSize, kRTSize),
+    };
+    dawn::CommandBuffer commands[2] = {EncodeDrawTo(renderTargets[0]),
+                                       EncodeDrawTo(renderTargets[1])};
+
+    queue.Submit(2, commands);
+    EXPECT_FALSE(ToVulkan(commands[0])->HasSecondaryRenderPasses());
+    EXPECT_FALSE(ToVulkan(commands[1])->HasSecondaryRenderPasses());
+    ExpectDrawTo(renderTargets[0]);
+    ExpectDrawTo(renderTargets[1]);
+
+    WaitForSubmittedCommands();
+    queue.Submit(2, commands);
+    queue.Submit(1, &commands[1]);
+    ExpectDrawTo(renderTargets[0]);
+    ExpectDrawTo(renderTargets[1]);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanParallelRecordingTests,
+                      VulkanBackend,
+                      ForceWorkarounds(VulkanBackend, {"record_vulkan_commands_in_parallel"}));
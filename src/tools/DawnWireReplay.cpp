@@ -0,0 +1,366 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// dawn_wire_replay feeds the client->server commands of a wire trace (see dawn_wire/WireTrace.h)
+// to a WireServer on top of the null backend and reports how long each type of command takes to
+// be handled. Raw command streams, like the inputs of DawnWireServerAndFrontendFuzzer, can be
+// replayed too but are timed as a whole.
+
+#include "dawn/dawncpp.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/WireCmd_autogen.h"
+#include "dawn_wire/WireServer.h"
+#include "dawn_wire/WireTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    class DevNull : public dawn_wire::CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            if (size > buf.size()) {
+                buf.resize(size);
+            }
+            return buf.data();
+        }
+        bool Flush() override {
+            return true;
+        }
+
+      private:
+        std::vector<char> buf;
+    };
+
+    DawnProcDeviceCreateSwapChain originalDeviceCreateSwapChain = nullptr;
+
+    // Swapchain implementations are pointers in the process that recorded the trace so always
+    // create error swapchains instead.
+    DawnSwapChain ErrorDeviceCreateSwapChain(DawnDevice device, const DawnSwapChainDescriptor*) {
+        DawnSwapChainDescriptor desc;
+        desc.nextInChain = nullptr;
+        desc.label = nullptr;
+        // A 0 implementation will trigger a swapchain creation error.
+        desc.implementation = 0;
+        return originalDeviceCreateSwapChain(device, &desc);
+    }
+
+    // The server ticks the device each time HandleCommands is called. Commands are handled one
+    // at a time to be timed individually, so the tick is done once per batch by the replay
+    // instead.
+    void NoopDeviceTick(DawnDevice) {
+    }
+
+    struct Options {
+        const char* tracePath = nullptr;
+        bool paced = false;
+        uint32_t iterations = 1;
+    };
+
+    struct Trace {
+        std::vector<dawn_wire::WireTraceBatch> batches;
+        size_t serverToClientBatchCount = 0;
+        size_t serverToClientSize = 0;
+    };
+
+    // The durations in nanoseconds of each replayed command, per command name.
+    using CommandDurations = std::map<std::string, std::vector<uint64_t>>;
+
+    bool LoadTrace(const char* path, Trace* trace) {
+        std::unique_ptr<dawn_wire::WireTraceReader> reader =
+            dawn_wire::WireTraceReader::Create(path);
+
+        if (reader != nullptr) {
+            dawn_wire::WireTraceBatch batch;
+            while (reader->ReadBatch(&batch)) {
+                if (batch.direction == dawn_wire::WireTraceDirection::ServerToClient) {
+                    trace->serverToClientBatchCount++;
+                    trace->serverToClientSize += batch.commands.size();
+                    continue;
+                }
+                trace->batches.push_back(std::move(batch));
+            }
+            if (!reader->IsAtEnd()) {
+                fprintf(stderr, "Malformed batch in %s, replaying the batches before it.\n", path);
+            }
+            return true;
+        }
+
+        // Not a trace, treat the file as a single raw batch of commands.
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            fprintf(stderr, "Couldn't open %s.\n", path);
+            return false;
+        }
+
+        dawn_wire::WireTraceBatch batch;
+        batch.direction = dawn_wire::WireTraceDirection::ClientToServer;
+        batch.timestamp = 0;
+        char buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            batch.commands.insert(batch.commands.end(), buffer, buffer + read);
+        }
+        fclose(file);
+
+        trace->batches.push_back(std::move(batch));
+        return true;
+    }
+
+    uint64_t ElapsedNanoseconds(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    bool Replay(const Trace& trace, bool paced, CommandDurations* durations) {
+        DawnProcTable procs = dawn_native::GetProcs();
+        originalDeviceCreateSwapChain = procs.deviceCreateSwapChain;
+        procs.deviceCreateSwapChain = ErrorDeviceCreateSwapChain;
+        dawnSetProcs(&procs);
+
+        std::unique_ptr<dawn_native::Instance> instance = std::make_unique<dawn_native::Instance>();
+        instance->DiscoverDefaultAdapters();
+
+        dawn::Device nullDevice;
+        for (dawn_native::Adapter adapter : instance->GetAdapters()) {
+            if (adapter.GetBackendType() == dawn_native::BackendType::Null) {
+                nullDevice = dawn::Device::Acquire(adapter.CreateDevice());
+                break;
+            }
+        }
+        if (nullDevice.Get() == nullptr) {
+            fprintf(stderr, "Couldn't create a null device.\n");
+            return false;
+        }
+
+        DawnProcTable serverProcs = procs;
+        serverProcs.deviceTick = NoopDeviceTick;
+
+        DevNull devNull;
+        dawn_wire::WireServerDescriptor serverDesc = {};
+        serverDesc.device = nullDevice.Get();
+        serverDesc.procs = &serverProcs;
+        serverDesc.serializer = &devNull;
+
+        std::unique_ptr<dawn_wire::WireServer> wireServer(new dawn_wire::WireServer(serverDesc));
+
+        bool success = true;
+        Clock::time_point replayStart = Clock::now();
+        for (const dawn_wire::WireTraceBatch& batch : trace.batches) {
+            if (paced) {
+                std::this_thread::sleep_until(replayStart +
+                                              std::chrono::nanoseconds(batch.timestamp));
+            }
+
+            if (batch.commandSizes.empty()) {
+                Clock::time_point start = Clock::now();
+                success = wireServer->HandleCommands(batch.commands.data(),
+                                                     batch.commands.size()) != nullptr;
+                (*durations)["(raw stream)"].push_back(ElapsedNanoseconds(start, Clock::now()));
+            } else {
+                const char* command = batch.commands.data();
+                for (uint32_t commandSize : batch.commandSizes) {
+                    dawn_wire::WireCmd commandId;
+                    if (commandSize < sizeof(commandId)) {
+                        success = false;
+                        break;
+                    }
+                    memcpy(&commandId, command, sizeof(commandId));
+
+                    Clock::time_point start = Clock::now();
+                    success = wireServer->HandleCommands(command, commandSize) != nullptr;
+                    uint64_t duration = ElapsedNanoseconds(start, Clock::now());
+
+                    (*durations)[dawn_wire::GetWireCmdName(commandId)].push_back(duration);
+                    command += commandSize;
+
+                    if (!success) {
+                        break;
+                    }
+                }
+            }
+
+            if (!success) {
+                fprintf(stderr, "The wire server failed to handle the trace.\n");
+                break;
+            }
+
+            Clock::time_point start = Clock::now();
+            nullDevice.Tick();
+            (*durations)["(device tick)"].push_back(ElapsedNanoseconds(start, Clock::now()));
+        }
+
+        // Destroy the server before the device because it needs to free all objects.
+        wireServer = nullptr;
+        nullDevice = nullptr;
+        instance = nullptr;
+
+        return success;
+    }
+
+    std::string FormatDuration(uint64_t nanoseconds) {
+        char buffer[32];
+        if (nanoseconds < 1000) {
+            snprintf(buffer, sizeof(buffer), "%uns", static_cast<unsigned int>(nanoseconds));
+        } else if (nanoseconds < 1000 * 1000) {
+            snprintf(buffer, sizeof(buffer), "%.1fus", nanoseconds / 1e3);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%.1fms", nanoseconds / 1e6);
+        }
+        return buffer;
+    }
+
+    void PrintReport(CommandDurations* durations) {
+        struct Entry {
+            const std::string* name;
+            std::vector<uint64_t>* durations;
+            uint64_t total;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t total = 0;
+        for (auto& it : *durations) {
+            std::sort(it.second.begin(), it.second.end());
+            uint64_t entryTotal = 0;
+            for (uint64_t duration : it.second) {
+                entryTotal += duration;
+            }
+            entries.push_back({&it.first, &it.second, entryTotal});
+            total += entryTotal;
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.total > b.total; });
+
+        auto Percentile = [](const std::vector<uint64_t>& sorted, double percentile) {
+            size_t index = static_cast<size_t>(sorted.size() * percentile);
+            return sorted[std::min(index, sorted.size() - 1)];
+        };
+
+        printf("%-40s %10s %10s %6s %10s %10s %10s %10s %10s\n", "command", "count", "total",
+               "share", "mean", "p50", "p90", "p99", "max");
+        for (const Entry& entry : entries) {
+            const std::vector<uint64_t>& sorted = *entry.durations;
+            printf("%-40s %10zu %10s %5.1f%% %10s %10s %10s %10s %10s\n", entry.name->c_str(),
+                   sorted.size(), FormatDuration(entry.total).c_str(),
+                   total == 0 ? 0.0 : 100.0 * entry.total / total,
+                   FormatDuration(entry.total / sorted.size()).c_str(),
+                   FormatDuration(Percentile(sorted, 0.5)).c_str(),
+                   FormatDuration(Percentile(sorted, 0.9)).c_str(),
+                   FormatDuration(Percentile(sorted, 0.99)).c_str(),
+                   FormatDuration(sorted.back()).c_str());
+        }
+
+        // Histograms with power-of-two buckets, only showing the range of non-empty buckets.
+        printf("\nHistograms:\n");
+        for (const Entry& entry : entries) {
+            std::vector<size_t> buckets(64, 0);
+            for (uint64_t duration : *entry.durations) {
+                uint32_t bucket = 0;
+                while (bucket < 63 && (uint64_t(1) << (bucket + 1)) <= duration) {
+                    bucket++;
+                }
+                buckets[bucket]++;
+            }
+
+            size_t first = 0;
+            while (buckets[first] == 0) {
+                first++;
+            }
+            size_t last = buckets.size() - 1;
+            while (buckets[last] == 0) {
+                last--;
+            }
+
+            printf("%s\n", entry.name->c_str());
+            for (size_t bucket = first; bucket <= last; ++bucket) {
+                std::string low = FormatDuration(uint64_t(1) << bucket);
+                std::string high = FormatDuration(uint64_t(1) << (bucket + 1));
+                printf("  [%8s, %8s) %10zu\n", low.c_str(), high.c_str(), buckets[bucket]);
+            }
+        }
+    }
+
+    bool ParseOptions(int argc, const char** argv, Options* options) {
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp("--paced", argv[i]) == 0) {
+                options->paced = true;
+                continue;
+            }
+            if (strcmp("--iterations", argv[i]) == 0) {
+                i++;
+                if (i >= argc || atoi(argv[i]) <= 0) {
+                    fprintf(stderr, "--iterations expects a positive number.\n");
+                    return false;
+                }
+                options->iterations = static_cast<uint32_t>(atoi(argv[i]));
+                continue;
+            }
+            if (argv[i][0] != '-' && options->tracePath == nullptr) {
+                options->tracePath = argv[i];
+                continue;
+            }
+            return false;
+        }
+        return options->tracePath != nullptr;
+    }
+
+}  // anonymous namespace
+
+int main(int argc, const char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, &options)) {
+        printf("Usage: %s [--paced] [--iterations N] TRACE_FILE\n", argv[0]);
+        printf("  --paced: replay the batches at the pace they were recorded at\n");
+        printf("  --iterations: number of times to replay the trace, on a new device each time\n");
+        return 1;
+    }
+
+    Trace trace;
+    if (!LoadTrace(options.tracePath, &trace)) {
+        return 1;
+    }
+
+    size_t commandCount = 0;
+    size_t size = 0;
+    for (const dawn_wire::WireTraceBatch& batch : trace.batches) {
+        commandCount += batch.commandSizes.size();
+        size += batch.commands.size();
+    }
+    printf("Replaying %zu batches, %zu commands, %zu bytes\n", trace.batches.size(), commandCount,
+           size);
+    printf("The trace also has %zu server->client batches, %zu bytes\n\n",
+           trace.serverToClientBatchCount, trace.serverToClientSize);
+
+    CommandDurations durations;
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < options.iterations; ++i) {
+        if (!Replay(trace, options.paced, &durations)) {
+            return 1;
+        }
+    }
+    printf("Replayed %u times in %s\n\n", options.iterations,
+           FormatDuration(ElapsedNanoseconds(start, Clock::now())).c_str());
+
+    PrintReport(&durations);
+    return 0;
+}
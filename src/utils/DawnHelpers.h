@@ -19,6 +19,7 @@
 
 #include <array>
 #include <initializer_list>
+#include <vector>
 
 #include "common/Constants.h"
 
@@ -32,6 +33,7 @@ namespace utils {
                                           SingleShaderStage stage,
                                           const char* source);
     dawn::ShaderModule CreateShaderModuleFromASM(const dawn::Device& device, const char* source);
+    std::vector<uint32_t> CompileGLSLToSpirv(SingleShaderStage stage, const char* source);
 
     dawn::Buffer CreateBufferFromData(const dawn::Device& device,
                                       const void* data,
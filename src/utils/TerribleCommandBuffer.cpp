@@ -18,11 +18,12 @@
 
 namespace utils {
 
-    TerribleCommandBuffer::TerribleCommandBuffer() {
+    TerribleCommandBuffer::TerribleCommandBuffer(size_t bufferSize) : mBuffer(bufferSize) {
     }
 
-    TerribleCommandBuffer::TerribleCommandBuffer(dawn_wire::CommandHandler* handler)
-        : mHandler(handler) {
+    TerribleCommandBuffer::TerribleCommandBuffer(dawn_wire::CommandHandler* handler,
+                                                 size_t bufferSize)
+        : mHandler(handler), mBuffer(bufferSize) {
     }
 
     void TerribleCommandBuffer::SetHandler(dawn_wire::CommandHandler* handler) {
@@ -34,27 +35,31 @@ namespace utils {
         //   (Here and/or in the caller?) It might be good to make the wire receiver get a nullptr
         //   instead of pointer to zero-sized allocation in mBuffer.
 
-        if (size > sizeof(mBuffer)) {
+        if (size > mBuffer.size()) {
             return nullptr;
         }
 
-        char* result = &mBuffer[mOffset];
-        mOffset += size;
-
-        if (mOffset > sizeof(mBuffer)) {
+        // Flush the previous commands if the allocation doesn't fit in the rest of the buffer.
+        // Only the space that was previously handed out must be flushed.
+        if (size > mBuffer.size() - mOffset) {
             if (!Flush()) {
                 return nullptr;
             }
-            return GetCmdSpace(size);
         }
 
+        char* result = mBuffer.data() + mOffset;
+        mOffset += size;
         return result;
     }
 
     bool TerribleCommandBuffer::Flush() {
-        bool success = mHandler->HandleCommands(mBuffer, mOffset) != nullptr;
+        bool success = mHandler->HandleCommands(mBuffer.data(), mOffset) != nullptr;
         mOffset = 0;
         return success;
     }
 
+    size_t TerribleCommandBuffer::GetMaximumAllocationSize() const {
+        return mBuffer.size();
+    }
+
 }  // namespace utils
@@ -23,18 +23,22 @@ namespace utils {
 
     class TerribleCommandBuffer : public dawn_wire::CommandSerializer {
       public:
-        TerribleCommandBuffer();
-        TerribleCommandBuffer(dawn_wire::CommandHandler* handler);
+        static constexpr size_t kDefaultBufferSize = 10000000;
+
+        explicit TerribleCommandBuffer(size_t bufferSize = kDefaultBufferSize);
+        TerribleCommandBuffer(dawn_wire::CommandHandler* handler,
+                              size_t bufferSize = kDefaultBufferSize);
 
         void SetHandler(dawn_wire::CommandHandler* handler);
 
         void* GetCmdSpace(size_t size) override;
         bool Flush() override;
+        size_t GetMaximumAllocationSize() const override;
 
       private:
         dawn_wire::CommandHandler* mHandler = nullptr;
         size_t mOffset = 0;
-        char mBuffer[10000000];
+        std::vector<char> mBuffer;
     };
 
 }  // namespace utils
@@ -0,0 +1,397 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/TracingPlatform.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "utils/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+namespace utils {
+
+    namespace {
+
+        // The values of TRACE_EVENT_FLAG_* and TRACE_VALUE_TYPE_* in TraceEvent.h, which isn't
+        // part of the public headers.
+        constexpr unsigned char kFlagCopy = 1 << 0;
+        constexpr unsigned char kFlagHasId = 1 << 1;
+
+        constexpr unsigned char kValueTypeBool = 1;
+        constexpr unsigned char kValueTypeUint = 2;
+        constexpr unsigned char kValueTypeInt = 3;
+        constexpr unsigned char kValueTypeDouble = 4;
+        constexpr unsigned char kValueTypePointer = 5;
+        constexpr unsigned char kValueTypeString = 6;
+        constexpr unsigned char kValueTypeCopyString = 7;
+
+        struct CategoryState {
+            unsigned char flag = 0;
+            // The number of live platforms that enable the category. The flag is set while it
+            // isn't zero.
+            uint32_t enabledPlatformCount = 0;
+        };
+
+        // The state of all the categories ever queried, and the live platforms. The states are
+        // never freed because the tracing macros keep pointers to their flags in static
+        // variables.
+        struct CategoryRegistry {
+            std::mutex mutex;
+            std::map<std::string, std::unique_ptr<CategoryState>> categories;
+            std::vector<TracingPlatform*> platforms;
+        };
+
+        CategoryRegistry* GetCategoryRegistry() {
+            static CategoryRegistry* registry = new CategoryRegistry;
+            return registry;
+        }
+
+        std::atomic<uint64_t> gNextPlatformSerial(1);
+
+        struct ThreadBufferCache {
+            uint64_t platformSerial = 0;
+            void* buffer = nullptr;
+        };
+        thread_local ThreadBufferCache tThreadBufferCache;
+
+        void WriteJSONString(std::ostream& out, const char* string) {
+            out << '"';
+            for (const char* c = string; *c != '\0'; ++c) {
+                switch (*c) {
+                    case '"':
+                        out << "\\\"";
+                        break;
+                    case '\\':
+                        out << "\\\\";
+                        break;
+                    case '\n':
+                        out << "\\n";
+                        break;
+                    default:
+                        // JSON strings can't contain control characters.
+                        if (static_cast<unsigned char>(*c) < 0x20) {
+                            char escaped[7];
+                            snprintf(escaped, sizeof(escaped), "\\u%04x",
+                                     static_cast<unsigned int>(*c));
+                            out << escaped;
+                        } else {
+                            out << *c;
+                        }
+                        break;
+                }
+            }
+            out << '"';
+        }
+
+        void WriteArgValue(std::ostream& out, unsigned char type, uint64_t value) {
+            switch (type) {
+                case kValueTypeBool:
+                    out << (value != 0 ? "true" : "false");
+                    break;
+                case kValueTypeUint:
+                    out << value;
+                    break;
+                case kValueTypeInt:
+                    out << static_cast<int64_t>(value);
+                    break;
+                case kValueTypeDouble: {
+                    double doubleValue;
+                    memcpy(&doubleValue, &value, sizeof(doubleValue));
+                    out << doubleValue;
+                    break;
+                }
+                case kValueTypePointer:
+                    out << "\"0x" << std::hex << value << std::dec << "\"";
+                    break;
+                case kValueTypeString:
+                case kValueTypeCopyString:
+                    WriteJSONString(out, reinterpret_cast<const char*>(value));
+                    break;
+                default:
+                    out << "null";
+                    break;
+            }
+        }
+
+    }  // anonymous namespace
+
+    TracingPlatform::ThreadBuffer::ThreadBuffer(uint32_t threadIndex, size_t capacity)
+        : mThreadIndex(threadIndex),
+          mEvents(NextPowerOfTwo(capacity)),
+          mIndexMask(mEvents.size() - 1),
+          mWriteIndex(0),
+          mReadIndex(0) {
+    }
+
+    bool TracingPlatform::ThreadBuffer::Push(const TraceEvent& event) {
+        uint64_t writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+        uint64_t readIndex = mReadIndex.load(std::memory_order_acquire);
+        if (writeIndex - readIndex == mEvents.size()) {
+            return false;
+        }
+
+        mEvents[writeIndex & mIndexMask] = event;
+        mWriteIndex.store(writeIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    void TracingPlatform::ThreadBuffer::PopAll(std::vector<TraceEvent>* events) {
+        uint64_t readIndex = mReadIndex.load(std::memory_order_relaxed);
+        uint64_t writeIndex = mWriteIndex.load(std::memory_order_acquire);
+        for (uint64_t i = readIndex; i < writeIndex; ++i) {
+            events->push_back(mEvents[i & mIndexMask]);
+            events->back().threadIndex = mThreadIndex;
+        }
+        mReadIndex.store(writeIndex, std::memory_order_release);
+    }
+
+    TracingPlatform::TracingPlatform(const std::string& categories, size_t eventsPerThread)
+        : mPlatformSerial(gNextPlatformSerial++),
+          mEventsPerThread(std::max(eventsPerThread, size_t(1))),
+          mTimer(CreateTimer()),
+          mDroppedEventCount(0) {
+        size_t start = 0;
+        while (start <= categories.size()) {
+            size_t end = std::min(categories.find(',', start), categories.size());
+            if (end > start) {
+                mCategoryFilters.push_back(categories.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+
+        mStartTime = mTimer->GetAbsoluteTime();
+
+        // Enable the categories that are already cached by the tracing macros.
+        CategoryRegistry* registry = GetCategoryRegistry();
+        std::lock_guard<std::mutex> lock(registry->mutex);
+        registry->platforms.push_back(this);
+        for (auto& it : registry->categories) {
+            if (IsCategoryGroupEnabled(it.first.c_str())) {
+                CategoryState* state = it.second.get();
+                state->enabledPlatformCount++;
+                state->flag = 1;
+                mEnabledCategoryFlags.insert(&state->flag);
+            }
+        }
+    }
+
+    TracingPlatform::~TracingPlatform() {
+        // Only disable the categories that no other live platform enables.
+        CategoryRegistry* registry = GetCategoryRegistry();
+        std::lock_guard<std::mutex> lock(registry->mutex);
+        registry->platforms.erase(
+            std::find(registry->platforms.begin(), registry->platforms.end(), this));
+        for (auto& it : registry->categories) {
+            CategoryState* state = it.second.get();
+            if (mEnabledCategoryFlags.count(&state->flag) != 0) {
+                ASSERT(state->enabledPlatformCount > 0);
+                state->enabledPlatformCount--;
+                state->flag = state->enabledPlatformCount > 0 ? 1 : 0;
+            }
+        }
+    }
+
+    const unsigned char* TracingPlatform::GetTraceCategoryEnabledFlag(const char* name) {
+        CategoryRegistry* registry = GetCategoryRegistry();
+        std::lock_guard<std::mutex> lock(registry->mutex);
+
+        std::unique_ptr<CategoryState>& state = registry->categories[name];
+        if (state == nullptr) {
+            state = std::make_unique<CategoryState>();
+            for (TracingPlatform* platform : registry->platforms) {
+                if (platform->IsCategoryGroupEnabled(name)) {
+                    state->enabledPlatformCount++;
+                    platform->mEnabledCategoryFlags.insert(&state->flag);
+                }
+            }
+            state->flag = state->enabledPlatformCount > 0 ? 1 : 0;
+        }
+        return &state->flag;
+    }
+
+    double TracingPlatform::MonotonicallyIncreasingTime() {
+        return mTimer->GetAbsoluteTime();
+    }
+
+    uint64_t TracingPlatform::AddTraceEvent(char phase,
+                                            const unsigned char* categoryGroupEnabled,
+                                            const char* name,
+                                            uint64_t id,
+                                            double timestamp,
+                                            int numArgs,
+                                            const char** argNames,
+                                            const unsigned char* argTypes,
+                                            const uint64_t* argValues,
+                                            unsigned char flags) {
+        TraceEvent event;
+        event.timestamp = timestamp;
+        event.id = id;
+        event.category = categoryGroupEnabled;
+        event.name = (flags & kFlagCopy) != 0 ? CopyString(name) : name;
+        event.numArgs = static_cast<uint8_t>(std::min(numArgs, static_cast<int>(kMaxArgs)));
+        event.flags = flags;
+        event.phase = phase;
+        event.threadIndex = 0;
+
+        for (uint32_t i = 0; i < event.numArgs; ++i) {
+            event.argNames[i] = (flags & kFlagCopy) != 0 ? CopyString(argNames[i]) : argNames[i];
+            event.argTypes[i] = argTypes[i];
+            event.argValues[i] = argValues[i];
+            if (argTypes[i] == kValueTypeCopyString) {
+                const char* copy = CopyString(reinterpret_cast<const char*>(argValues[i]));
+                event.argValues[i] = reinterpret_cast<uint64_t>(copy);
+            }
+        }
+
+        if (!GetCurrentThreadBuffer()->Push(event)) {
+            mDroppedEventCount++;
+        }
+        return 0;
+    }
+
+    void TracingPlatform::CollectTraceEvents() {
+        std::lock_guard<std::mutex> collectLock(mCollectMutex);
+        std::lock_guard<std::mutex> buffersLock(mThreadBuffersMutex);
+        for (auto& it : mThreadBuffers) {
+            it.second->PopAll(&mCollectedEvents);
+        }
+    }
+
+    void TracingPlatform::WriteTraceEvents(std::ostream& out) {
+        CollectTraceEvents();
+
+        std::map<const unsigned char*, std::string> categoryNames;
+        {
+            CategoryRegistry* registry = GetCategoryRegistry();
+            std::lock_guard<std::mutex> lock(registry->mutex);
+            for (const auto& it : registry->categories) {
+                categoryNames[&it.second->flag] = it.first;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mCollectMutex);
+
+        // The events of each thread are in order, but the threads are interleaved.
+        std::stable_sort(mCollectedEvents.begin(), mCollectedEvents.end(),
+                         [](const TraceEvent& a, const TraceEvent& b) {
+                             return a.timestamp < b.timestamp;
+                         });
+
+        out << std::setprecision(3) << std::fixed;
+        out << "{\"traceEvents\": [";
+        for (size_t i = 0; i < mCollectedEvents.size(); ++i) {
+            const TraceEvent& event = mCollectedEvents[i];
+
+            out << (i == 0 ? "\n" : ",\n") << "{\"name\": ";
+            WriteJSONString(out, event.name);
+            out << ", \"cat\": ";
+            WriteJSONString(out, categoryNames[event.category].c_str());
+            out << ", \"ph\": \"" << event.phase << "\"";
+            out << ", \"ts\": " << (event.timestamp - mStartTime) * 1e6;
+            out << ", \"pid\": 0, \"tid\": " << event.threadIndex;
+            if ((event.flags & kFlagHasId) != 0) {
+                out << ", \"id\": \"0x" << std::hex << event.id << std::dec << "\"";
+            }
+            if (event.phase == 'I') {
+                out << ", \"s\": \"t\"";
+            }
+
+            out << ", \"args\": {";
+            for (uint32_t arg = 0; arg < event.numArgs; ++arg) {
+                out << (arg == 0 ? "" : ", ");
+                WriteJSONString(out, event.argNames[arg]);
+                out << ": ";
+                WriteArgValue(out, event.argTypes[arg], event.argValues[arg]);
+            }
+            out << "}}";
+        }
+        out << "\n],\n\"displayTimeUnit\": \"ns\"}\n";
+    }
+
+    bool TracingPlatform::WriteTraceFile(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        WriteTraceEvents(out);
+        return static_cast<bool>(out);
+    }
+
+    uint64_t TracingPlatform::GetDroppedEventCount() const {
+        return mDroppedEventCount.load();
+    }
+
+    TracingPlatform::ThreadBuffer* TracingPlatform::GetCurrentThreadBuffer() {
+        ThreadBufferCache& cache = tThreadBufferCache;
+        if (cache.platformSerial == mPlatformSerial) {
+            return static_cast<ThreadBuffer*>(cache.buffer);
+        }
+
+        std::lock_guard<std::mutex> lock(mThreadBuffersMutex);
+        std::thread::id threadId = std::this_thread::get_id();
+
+        // The thread can already have a buffer if it recorded events for another platform since.
+        ThreadBuffer* buffer = nullptr;
+        for (auto& it : mThreadBuffers) {
+            if (it.first == threadId) {
+                buffer = it.second.get();
+                break;
+            }
+        }
+        if (buffer == nullptr) {
+            uint32_t threadIndex = static_cast<uint32_t>(mThreadBuffers.size());
+            mThreadBuffers.emplace_back(
+                threadId, std::make_unique<ThreadBuffer>(threadIndex, mEventsPerThread));
+            buffer = mThreadBuffers.back().second.get();
+        }
+
+        cache.platformSerial = mPlatformSerial;
+        cache.buffer = buffer;
+        return buffer;
+    }
+
+    bool TracingPlatform::IsCategoryGroupEnabled(const char* categoryGroup) const {
+        // A category group is a comma-separated list of categories and is enabled if any of its
+        // categories is.
+        std::string group = categoryGroup;
+        size_t start = 0;
+        while (start <= group.size()) {
+            size_t end = std::min(group.find(',', start), group.size());
+            std::string category = group.substr(start, end - start);
+            for (const std::string& filter : mCategoryFilters) {
+                if (filter.back() == '*' &&
+                    category.compare(0, filter.size() - 1, filter, 0, filter.size() - 1) == 0) {
+                    return true;
+                }
+                if (category == filter) {
+                    return true;
+                }
+            }
+            start = end + 1;
+        }
+        return false;
+    }
+
+    const char* TracingPlatform::CopyString(const char* string) {
+        std::lock_guard<std::mutex> lock(mCopiedStringsMutex);
+        return mCopiedStrings.insert(string).first->c_str();
+    }
+
+}  // namespace utils
@@ -0,0 +1,147 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_TRACINGPLATFORM_H_
+#define UTILS_TRACINGPLATFORM_H_
+
+#include <dawn_platform/DawnPlatform.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+    class Timer;
+
+    // A dawn_platform::Platform that records the trace events of Dawn and writes them in the JSON
+    // format of chrome://tracing. Each thread records its events in its own ring buffer, and the
+    // buffers are drained when the events are collected. Recording an event doesn't take a lock,
+    // except for the first event of a thread, which registers its buffer, and for the events with
+    // TRACE_EVENT_FLAG_COPY, whose strings are copied in a set shared by all the threads.
+    //
+    //   utils::TracingPlatform platform;
+    //   instance->SetPlatform(&platform);
+    //   DoWork();
+    //   platform.WriteTraceFile("trace.json");
+    //
+    // The tracing macros cache the category flags at each call site for the whole process, so the
+    // flags are shared by all the TracingPlatforms: a category is enabled while any of the live
+    // platforms enables it, and a platform records the events of all the enabled categories. The
+    // devices must not use the platform after it is destroyed.
+    class TracingPlatform : public dawn_platform::Platform {
+      public:
+        static constexpr size_t kDefaultEventsPerThread = 1 << 16;
+
+        // |categories| is a comma-separated list of the categories to record. "*" records all of
+        // them, including the "disabled-by-default-" ones, and a trailing "*" matches any suffix.
+        explicit TracingPlatform(const std::string& categories = "*",
+                                 size_t eventsPerThread = kDefaultEventsPerThread);
+        ~TracingPlatform() override;
+
+        const unsigned char* GetTraceCategoryEnabledFlag(const char* name) override;
+        double MonotonicallyIncreasingTime() override;
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override;
+
+        // Moves the events recorded by all the threads out of their buffers. It must be called
+        // often enough that the buffers don't fill up, as the events of a thread whose buffer is
+        // full are dropped.
+        void CollectTraceEvents();
+
+        // Collects the events then writes all the events collected so far.
+        void WriteTraceEvents(std::ostream& out);
+        bool WriteTraceFile(const std::string& path);
+
+        uint64_t GetDroppedEventCount() const;
+
+      private:
+        static constexpr uint32_t kMaxArgs = 2;
+
+        struct TraceEvent {
+            double timestamp;
+            uint64_t id;
+            const unsigned char* category;
+            const char* name;
+            const char* argNames[kMaxArgs];
+            uint64_t argValues[kMaxArgs];
+            unsigned char argTypes[kMaxArgs];
+            uint8_t numArgs;
+            unsigned char flags;
+            char phase;
+            uint32_t threadIndex;
+        };
+
+        // A single-producer single-consumer ring buffer. Only its thread pushes events, and only
+        // CollectTraceEvents pops them, under mCollectMutex.
+        class ThreadBuffer {
+          public:
+            ThreadBuffer(uint32_t threadIndex, size_t capacity);
+
+            bool Push(const TraceEvent& event);
+            void PopAll(std::vector<TraceEvent>* events);
+
+          private:
+            uint32_t mThreadIndex;
+            std::vector<TraceEvent> mEvents;
+            uint64_t mIndexMask;
+            std::atomic<uint64_t> mWriteIndex;
+            std::atomic<uint64_t> mReadIndex;
+        };
+
+        ThreadBuffer* GetCurrentThreadBuffer();
+        bool IsCategoryGroupEnabled(const char* categoryGroup) const;
+        const char* CopyString(const char* string);
+
+        // Identifies the platform in the thread-local cache of the buffers, as the address of a
+        // destroyed platform can be reused.
+        uint64_t mPlatformSerial;
+        std::vector<std::string> mCategoryFilters;
+        // The flags of the categories this platform enables, guarded by the mutex of the process-
+        // wide category registry.
+        std::set<const unsigned char*> mEnabledCategoryFlags;
+        size_t mEventsPerThread;
+
+        std::unique_ptr<Timer> mTimer;
+        double mStartTime;
+
+        std::mutex mThreadBuffersMutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<ThreadBuffer>>> mThreadBuffers;
+        std::atomic<uint64_t> mDroppedEventCount;
+
+        // The copies of the strings of the events with TRACE_EVENT_FLAG_COPY, which are kept until
+        // the events are written.
+        std::mutex mCopiedStringsMutex;
+        std::set<std::string> mCopiedStrings;
+
+        std::mutex mCollectMutex;
+        std::vector<TraceEvent> mCollectedEvents;
+    };
+
+}  // namespace utils
+
+#endif  // UTILS_TRACINGPLATFORM_H_